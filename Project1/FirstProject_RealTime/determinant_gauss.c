@@ -14,7 +14,10 @@ int determinant_gauss_partial_pivot(const Matrix *m, double *out_det) {
 
     int n = m->rows;
 
-    /* Allocate a contiguous copy of the matrix for in-place elimination */
+    /* Allocate a contiguous copy of the matrix for in-place elimination.
+     * data[i] is a column of a column-major matrix; the copy is then the
+     * transpose, which has the same determinant.
+     */
     double *A = (double *)malloc((size_t)n * (size_t)n * sizeof(double));
     if (!A) return 0;
 
@@ -1,5 +1,11 @@
 #include "determinant_parallel.h"
 #include "determinant_gauss.h"
+#include "lu_recursive.h"
+#include "matrix_sparse_factor.h"
+#include "matrix_band.h"
+#include "matrix_blocks.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,6 +13,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <errno.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -19,7 +26,10 @@ static double get_time() {
     struct timeval tv; gettimeofday(&tv, NULL); return tv.tv_sec + tv.tv_usec / 1000000.0;
 }
 
-/* Helper: copy matrix into contiguous array A (row-major n*n) */
+/* Helper: copy matrix into contiguous array A (n*n, storage order kept).
+ * For a column-major matrix A holds the transpose; det(A^T) = det(A), so the
+ * elimination below works on it unchanged.
+ */
 static double* copy_matrix_contiguous(const Matrix* m) {
     int n = m->rows;
     double* A = (double*)malloc((size_t)n * n * sizeof(double));
@@ -113,6 +123,24 @@ int determinant_openmp(const Matrix* m, double* out_det, double* exec_time) {
     *out_det = det; free(A); return 1;
 }
 
+typedef struct {
+    const double* A;
+    int n, k;
+    double akk;
+} RowUpdateJob;
+
+/* Child: updated segment [k..n-1] of row k+1+idx */
+static void row_update_task(void* ctx, int idx, double* buf) {
+    const RowUpdateJob* job = (const RowUpdateJob*)ctx;
+    int n = job->n, k = job->k, i = k + 1 + idx;
+    const double* A = job->A;
+    double factor = A[(size_t)i * n + k] / job->akk;
+    buf[0] = 0.0; /* column k becomes 0 */
+    for (int j = k + 1; j < n; ++j) {
+        buf[j - k] = A[(size_t)i * n + j] - factor * A[(size_t)k * n + j];
+    }
+}
+
 /* Multiprocess variant: for each k, spawn children to update rows i=k+1..n-1 */
 int determinant_multiprocess(const Matrix* m, double* out_det, double* exec_time) {
     if (!m || !out_det || m->rows != m->cols) return 0;
@@ -142,55 +170,19 @@ int determinant_multiprocess(const Matrix* m, double* out_det, double* exec_time
 
         int rowsBelow = n - (k + 1);
         if (rowsBelow <= 0) continue;
-        int (*pipes)[2] = malloc((size_t)rowsBelow * sizeof(int[2]));
-        pid_t* pids = (pid_t*)malloc((size_t)rowsBelow * sizeof(pid_t));
-        if (!pipes || !pids) { free(pipes); free(pids); free(A); return 0; }
+        int seg = n - k; /* columns k..n-1 inclusive */
+        double* rows = (double*)malloc((size_t)rowsBelow * seg * sizeof(double));
+        if (!rows) { free(A); return 0; }
 
-        /* Fork a child per row below pivot */
-        for (int idx = 0; idx < rowsBelow; ++idx) {
-            int i = k + 1 + idx;
-            if (pipe(pipes[idx]) == -1) { perror("pipe"); free(pipes); free(pids); free(A); return 0; }
-            pid_t pid = fork();
-            if (pid == -1) { perror("fork"); free(pipes); free(pids); free(A); return 0; }
-            if (pid == 0) {
-                /* Child: compute updated row segment [k..n-1] */
-                close(pipes[idx][0]);
-                int seg = n - k; /* columns k..n-1 inclusive */
-                double* buf = (double*)malloc((size_t)seg * sizeof(double));
-                if (!buf) { _exit(1); }
-                double factor = A[(size_t)i * n + k] / akk;
-                buf[0] = 0.0; /* column k becomes 0 */
-                for (int j = k + 1; j < n; ++j) {
-                    buf[j - k] = A[(size_t)i * n + j] - factor * A[(size_t)k * n + j];
-                }
-                write(pipes[idx][1], buf, (size_t)seg * sizeof(double));
-                close(pipes[idx][1]);
-                free(buf);
-                _exit(0);
-            } else {
-                pids[idx] = pid;
-                close(pipes[idx][1]);
-            }
-        }
+        /* A child per row below the pivot, in waves sized to the worker budget */
+        RowUpdateJob job = { A, n, k, akk };
+        if (!resource_fork_waves(rowsBelow, seg, row_update_task, &job, rows)) { free(rows); free(A); return 0; }
 
-        /* Parent: collect rows and store back into A */
+        /* Parent: store the updated rows back into A */
         for (int idx = 0; idx < rowsBelow; ++idx) {
-            int i = k + 1 + idx;
-            int seg = n - k;
-            size_t bytes = (size_t)seg * sizeof(double);
-            double* buf = (double*)malloc(bytes);
-            if (!buf) { free(pipes); free(pids); free(A); return 0; }
-            read(pipes[idx][0], buf, bytes);
-            close(pipes[idx][0]);
-            /* write back */
-            for (int j = k; j < n; ++j) {
-                A[(size_t)i * n + j] = buf[j - k];
-            }
-            free(buf);
-            waitpid(pids[idx], NULL, 0);
+            memcpy(A + (size_t)(k + 1 + idx) * n + k, rows + (size_t)idx * seg, (size_t)seg * sizeof(double));
         }
-        free(pipes);
-        free(pids);
+        free(rows);
     }
 
     double det = det_sign;
@@ -204,38 +196,39 @@ int run_determinant_comparison(const Matrix* m, PerformanceMetrics* metrics, dou
     if (!m || !metrics || !out_det) return 0;
     if (m->rows != m->cols) return 0;
 
-    printf("\n========================================\n");
-    printf("Performance Comparison: Determinant (Gaussian Elimination)\n");
-    printf("Matrix: %s (%dx%d)\n", m->name, m->rows, m->cols);
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Determinant (Gaussian Elimination)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
 
     double det1 = 0.0, det2 = 0.0, det3 = 0.0;
 
-    printf("[1/3] Running Single-threaded method...\n");
+    mat_log(MAT_LOG_INFO, "[1/3] Running Single-threaded method...");
     determinant_single(m, &det1, &metrics->single_thread_time);
-    printf("   ✓ Completed in %.6f seconds\n\n", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->single_thread_time);
 
-    printf("[2/3] Running OpenMP method...\n");
+    mat_log(MAT_LOG_INFO, "[2/3] Running OpenMP method...");
     determinant_openmp(m, &det2, &metrics->openmp_time);
-    printf("   ✓ Completed in %.6f seconds\n", metrics->openmp_time);
-    printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
 
-    printf("[3/3] Running Multiprocessing method...\n");
+    mat_log(MAT_LOG_INFO, "[3/3] Running Multiprocessing method...");
     determinant_multiprocess(m, &det3, &metrics->multiprocess_time);
-    printf("   ✓ Completed in %.6f seconds\n", metrics->multiprocess_time);
-    printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->multiprocess_time);
-
-    printf("========================================\n");
-    printf("PERFORMANCE SUMMARY\n");
-    printf("========================================\n");
-    printf("Single-threaded:   %.6f s (baseline)\n", metrics->single_thread_time);
-    printf("OpenMP:            %.6f s (%.2fx %s)\n", metrics->openmp_time,
-           metrics->single_thread_time / metrics->openmp_time,
-           metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
-    printf("Multiprocessing:   %.6f s (%.2fx %s)\n", metrics->multiprocess_time,
-           metrics->single_thread_time / metrics->multiprocess_time,
-           metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Single-threaded:   %.6f s (baseline)", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "OpenMP:            %.6f s (%.2fx %s)", metrics->openmp_time,
+            metrics->single_thread_time / metrics->openmp_time,
+            metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Multiprocessing:   %.6f s (%.2fx %s)", metrics->multiprocess_time,
+            metrics->single_thread_time / metrics->multiprocess_time,
+            metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "========================================\n");
 
     /* Sanity: det values should be close; choose det1 as reference */
     const char* fastest = "Single-threaded";
@@ -244,8 +237,125 @@ int run_determinant_comparison(const Matrix* m, PerformanceMetrics* metrics, dou
     if (metrics->openmp_time < fastest_time) { fastest = "OpenMP"; fastest_time = metrics->openmp_time; chosen_det = det2; }
     if (metrics->multiprocess_time < fastest_time) { fastest = "Multiprocessing"; fastest_time = metrics->multiprocess_time; chosen_det = det3; }
 
-    printf("★ Fastest method: %s (%.6f s)\n\n", fastest, fastest_time);
+    mat_log(MAT_LOG_INFO, "★ Fastest method: %s (%.6f s)\n", fastest, fastest_time);
 
     *out_det = chosen_det;
     return 1;
 }
+
+int determinant_single_backend(const Matrix* m, DeterminantBackend backend, double* out_det, double* exec_time) {
+    if (backend == DET_BACKEND_RECURSIVE_LU) return determinant_lu_single(m, out_det, exec_time);
+    if (backend == DET_BACKEND_SPARSE) return determinant_sparse(m, out_det, exec_time);
+    if (backend == DET_BACKEND_BLOCKS) return determinant_blocks_single(m, NULL, out_det, exec_time);
+    return determinant_single(m, out_det, exec_time);
+}
+
+int determinant_openmp_backend(const Matrix* m, DeterminantBackend backend, double* out_det, double* exec_time) {
+    if (backend == DET_BACKEND_RECURSIVE_LU) return determinant_lu_openmp(m, out_det, exec_time);
+    if (backend == DET_BACKEND_SPARSE) return determinant_sparse(m, out_det, exec_time);
+    if (backend == DET_BACKEND_BLOCKS) return determinant_blocks_openmp(m, NULL, out_det, exec_time);
+    return determinant_openmp(m, out_det, exec_time);
+}
+
+/* Dense Gaussian elimination against the reordered sparse and band paths */
+static int run_sparse_determinant_comparison(const Matrix* m, PerformanceMetrics* metrics, double* out_det) {
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Determinant (Sparse)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    double det1 = 0.0, det2 = 0.0, det3 = 0.0, start;
+
+    mat_log(MAT_LOG_INFO, "[1/3] Running Gaussian elimination (dense baseline)...");
+    if (!determinant_single(m, &det1, &metrics->single_thread_time)) return 0;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->single_thread_time);
+
+    mat_log(MAT_LOG_INFO, "[2/3] Running sparse factorization (%s ordering)...",
+            ordering_name(SPARSE_DEFAULT_ORDERING));
+    start = get_time();
+    SparseMatrix* s = dense_to_sparse(m);
+    SparseFactorStats stats;
+    int ok = s && sparse_determinant(s, SPARSE_DEFAULT_ORDERING, &det2, &stats, NULL);
+    metrics->openmp_time = get_time() - start;
+    if (!ok) { free_sparse_matrix(s); return 0; }
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds (%.1f%% nonzero)", metrics->openmp_time,
+            100.0 * (double)s->nnz / ((double)m->rows * m->cols));
+    sparse_log_fill(&stats);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
+
+    mat_log(MAT_LOG_INFO, "[3/3] Running banded LU (%s ordering)...", ordering_name(ORDER_RCM));
+    start = get_time();
+    BandMatrix* b = sparse_to_band(s, ORDER_RCM, m->name);
+    ok = b && band_determinant(b, &det3, NULL, NULL);
+    metrics->multiprocess_time = get_time() - start;
+    free_sparse_matrix(s);
+    if (!ok) { free_band_matrix(b); return 0; }
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   bandwidth %d/%d -> %d/%d (lower/upper)%s", b->kl_source, b->ku_source, b->kl, b->ku,
+            b->perm ? "" : ", original order kept");
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
+    free_band_matrix(b);
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Gaussian (dense):     %.6f s (baseline)", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "Sparse %-8s       %.6f s (%.2fx %s)",
+            stats.method == SPARSE_FACTOR_CHOLESKY ? "Cholesky:" : "LU:", metrics->openmp_time,
+            metrics->single_thread_time / metrics->openmp_time,
+            metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Banded LU:            %.6f s (%.2fx %s)", metrics->multiprocess_time,
+            metrics->single_thread_time / metrics->multiprocess_time,
+            metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    *out_det = metrics->multiprocess_time < metrics->openmp_time ? det3 : det2;
+    return 1;
+}
+
+int run_determinant_comparison_backend(const Matrix* m, DeterminantBackend backend,
+                                       PerformanceMetrics* metrics, double* out_det) {
+    if (backend == DET_BACKEND_GAUSS) return run_determinant_comparison(m, metrics, out_det);
+    if (!m || !metrics || !out_det) return 0;
+    if (m->rows != m->cols) return 0;
+    if (backend == DET_BACKEND_SPARSE) return run_sparse_determinant_comparison(m, metrics, out_det);
+    if (backend == DET_BACKEND_BLOCKS) return run_determinant_blocks_comparison(m, NULL, metrics, out_det);
+
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Determinant (Recursive LU)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    double det1 = 0.0, det2 = 0.0, det3 = 0.0;
+
+    mat_log(MAT_LOG_INFO, "[1/3] Running Gaussian elimination (single-threaded baseline)...");
+    if (!determinant_single(m, &det1, &metrics->single_thread_time)) return 0;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->single_thread_time);
+
+    mat_log(MAT_LOG_INFO, "[2/3] Running Recursive LU (single-threaded)...");
+    if (!determinant_lu_single(m, &det2, &metrics->openmp_time)) return 0;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
+
+    mat_log(MAT_LOG_INFO, "[3/3] Running Recursive LU (OpenMP tasks)...");
+    if (!determinant_lu_openmp(m, &det3, &metrics->multiprocess_time)) return 0;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Gaussian (single):    %.6f s (baseline)", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "Recursive LU:         %.6f s (%.2fx %s)", metrics->openmp_time,
+            metrics->single_thread_time / metrics->openmp_time,
+            metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Recursive LU (tasks): %.6f s (%.2fx %s)", metrics->multiprocess_time,
+            metrics->single_thread_time / metrics->multiprocess_time,
+            metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    *out_det = metrics->multiprocess_time < metrics->openmp_time ? det3 : det2;
+    return 1;
+}
@@ -10,7 +10,8 @@ int determinant_single(const Matrix* m, double* out_det, double* exec_time);
 /* OpenMP-parallel determinant (row updates per step in parallel) */
 int determinant_openmp(const Matrix* m, double* out_det, double* exec_time);
 
-/* Multiprocess determinant (per-row update children per elimination step) */
+/* Multiprocess determinant (per-row update children per elimination step,
+ * started in waves of at most resource_budget()->max_workers) */
 int determinant_multiprocess(const Matrix* m, double* out_det, double* exec_time);
 
 /* Runs all three determinant methods and prints a performance comparison.
@@ -18,4 +19,27 @@ int determinant_multiprocess(const Matrix* m, double* out_det, double* exec_time
  */
 int run_determinant_comparison(const Matrix* m, PerformanceMetrics* metrics, double* out_det);
 
+/* Factorization used for the determinant */
+typedef enum {
+    DET_BACKEND_GAUSS = 0,      /* right-looking elimination (functions above) */
+    DET_BACKEND_RECURSIVE_LU,   /* cache-oblivious recursive LU (lu_recursive.h) */
+    DET_BACKEND_SPARSE,         /* reordered sparse LU/Cholesky (matrix_sparse_factor.h) */
+    DET_BACKEND_BLOCKS          /* product over the irreducible blocks (matrix_blocks.h) */
+} DeterminantBackend;
+
+/* Single-threaded and OpenMP determinant with the chosen backend */
+int determinant_single_backend(const Matrix* m, DeterminantBackend backend, double* out_det, double* exec_time);
+int determinant_openmp_backend(const Matrix* m, DeterminantBackend backend, double* out_det, double* exec_time);
+
+/* Comparison for the chosen backend. For DET_BACKEND_RECURSIVE_LU this times
+ * Gaussian elimination (baseline) against recursive LU single-threaded and
+ * with OpenMP tasks, filling single_thread_time / openmp_time /
+ * multiprocess_time in that order. For DET_BACKEND_SPARSE the last two are
+ * the AMD-ordered sparse factorization and banded LU after RCM, with fill
+ * and bandwidth reported. DET_BACKEND_BLOCKS runs
+ * run_determinant_blocks_comparison().
+ */
+int run_determinant_comparison_backend(const Matrix* m, DeterminantBackend backend,
+                                       PerformanceMetrics* metrics, double* out_det);
+
 #endif /* DETERMINANT_PARALLEL_H */
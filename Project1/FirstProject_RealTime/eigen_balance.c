@@ -0,0 +1,191 @@
+#include "eigen_balance.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Scaling factors are powers of the radix so that balancing is exact in
+ * binary floating point (no rounding error is introduced).
+ */
+#define BALANCE_RADIX 2.0
+
+/* Below this size the OpenMP fork/join costs more than the O(n) loops it splits */
+#define BALANCE_PAR_MIN 128
+
+/* Swap rows and columns i and j: A <- P^T A P */
+static void swap_row_col(double* A, int n, int i, int j) {
+    if (i == j) return;
+    #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+    for (int k = 0; k < n; ++k) {
+        double tmp = A[(size_t)k * n + i];
+        A[(size_t)k * n + i] = A[(size_t)k * n + j];
+        A[(size_t)k * n + j] = tmp;
+    }
+    #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+    for (int k = 0; k < n; ++k) {
+        double tmp = A[(size_t)i * n + k];
+        A[(size_t)i * n + k] = A[(size_t)j * n + k];
+        A[(size_t)j * n + k] = tmp;
+    }
+}
+
+/* Row j isolates an eigenvalue if A[j][k] == 0 for all k in [lo, hi], k != j */
+static int row_is_isolated(const double* A, int n, int j, int lo, int hi) {
+    for (int k = lo; k <= hi; ++k) {
+        if (k != j && A[(size_t)j * n + k] != 0.0) return 0;
+    }
+    return 1;
+}
+
+/* Column j isolates an eigenvalue if A[k][j] == 0 for all k in [lo, hi], k != j */
+static int col_is_isolated(const double* A, int n, int j, int lo, int hi) {
+    for (int k = lo; k <= hi; ++k) {
+        if (k != j && A[(size_t)k * n + j] != 0.0) return 0;
+    }
+    return 1;
+}
+
+/* Find the highest row (or lowest column) in [lo, hi] that isolates an
+ * eigenvalue.  Candidates are tested in parallel; returns -1 if none.
+ */
+static int find_isolated_row(const double* A, int n, int lo, int hi) {
+    int found = -1;
+    #pragma omp parallel for schedule(dynamic, 16) reduction(max:found) if (n >= BALANCE_PAR_MIN)
+    for (int j = lo; j <= hi; ++j) {
+        if (row_is_isolated(A, n, j, lo, hi) && j > found) found = j;
+    }
+    return found;
+}
+
+static int find_isolated_col(const double* A, int n, int lo, int hi) {
+    int found = n;
+    #pragma omp parallel for schedule(dynamic, 16) reduction(min:found) if (n >= BALANCE_PAR_MIN)
+    for (int j = lo; j <= hi; ++j) {
+        if (col_is_isolated(A, n, j, lo, hi) && j < found) found = j;
+    }
+    return found == n ? -1 : found;
+}
+
+BalanceInfo* balance_matrix_flat(double* A, int n) {
+    if (!A || n <= 0) return NULL;
+    BalanceInfo* info = (BalanceInfo*)malloc(sizeof(BalanceInfo));
+    if (!info) return NULL;
+    info->scale = (double*)malloc((size_t)n * sizeof(double));
+    if (!info->scale) { free(info); return NULL; }
+    info->n = n;
+
+    int lo = 0, hi = n - 1;
+
+    /* Stage 1a: push rows isolating an eigenvalue to the bottom */
+    while (hi > 0) {
+        int j = find_isolated_row(A, n, lo, hi);
+        if (j < 0) break;
+        info->scale[hi] = (double)j;
+        swap_row_col(A, n, j, hi);
+        --hi;
+    }
+
+    /* Stage 1b: push columns isolating an eigenvalue to the left */
+    while (lo < hi) {
+        int j = find_isolated_col(A, n, lo, hi);
+        if (j < 0) break;
+        info->scale[lo] = (double)j;
+        swap_row_col(A, n, j, lo);
+        ++lo;
+    }
+
+    info->ilo = lo;
+    info->ihi = hi;
+    for (int i = lo; i <= hi; ++i) info->scale[i] = 1.0;
+
+    /* Stage 2: iterative diagonal scaling of the active window (EISPACK balanc) */
+    const double sqrdx = BALANCE_RADIX * BALANCE_RADIX;
+    int done = (lo >= hi);
+    while (!done) {
+        done = 1;
+        for (int i = lo; i <= hi; ++i) {
+            double c = 0.0, r = 0.0;
+            #pragma omp parallel for reduction(+:c,r) schedule(static) if (n >= BALANCE_PAR_MIN)
+            for (int k = lo; k <= hi; ++k) {
+                if (k == i) continue;
+                c += fabs(A[(size_t)k * n + i]);
+                r += fabs(A[(size_t)i * n + k]);
+            }
+            if (c == 0.0 || r == 0.0) continue;
+
+            double g = r / BALANCE_RADIX;
+            double f = 1.0;
+            double s = c + r;
+            while (c < g) { f *= BALANCE_RADIX; c *= sqrdx; }
+            g = r * BALANCE_RADIX;
+            while (c > g) { f /= BALANCE_RADIX; c /= sqrdx; }
+
+            if ((c + r) / f < 0.95 * s) {
+                done = 0;
+                g = 1.0 / f;
+                info->scale[i] *= f;
+                /* row i *= 1/f, column i *= f */
+                #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+                for (int k = 0; k < n; ++k) {
+                    A[(size_t)i * n + k] *= g;
+                }
+                #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+                for (int k = 0; k < n; ++k) {
+                    A[(size_t)k * n + i] *= f;
+                }
+            }
+        }
+    }
+
+    return info;
+}
+
+void balance_back_transform(const BalanceInfo* info, double* V, int n) {
+    if (!info || !V || info->n != n) return;
+
+    /* Undo scaling: V <- D * V */
+    #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+    for (int i = info->ilo; i <= info->ihi; ++i) {
+        double d = info->scale[i];
+        for (int j = 0; j < n; ++j) V[(size_t)i * n + j] *= d;
+    }
+
+    /* Undo permutations in reverse order of application */
+    for (int i = info->ilo - 1; i >= 0; --i) {
+        int k = (int)info->scale[i];
+        if (k == i) continue;
+        for (int j = 0; j < n; ++j) {
+            double tmp = V[(size_t)i * n + j];
+            V[(size_t)i * n + j] = V[(size_t)k * n + j];
+            V[(size_t)k * n + j] = tmp;
+        }
+    }
+    for (int i = info->ihi + 1; i < n; ++i) {
+        int k = (int)info->scale[i];
+        if (k == i) continue;
+        for (int j = 0; j < n; ++j) {
+            double tmp = V[(size_t)i * n + j];
+            V[(size_t)i * n + j] = V[(size_t)k * n + j];
+            V[(size_t)k * n + j] = tmp;
+        }
+    }
+
+    /* Scaling destroys unit length; renormalize each eigenvector column */
+    #pragma omp parallel for schedule(static) if (n >= BALANCE_PAR_MIN)
+    for (int j = 0; j < n; ++j) {
+        double norm = 0.0;
+        for (int i = 0; i < n; ++i) norm += V[(size_t)i * n + j] * V[(size_t)i * n + j];
+        norm = sqrt(norm);
+        if (norm > 0.0) {
+            for (int i = 0; i < n; ++i) V[(size_t)i * n + j] /= norm;
+        }
+    }
+}
+
+void free_balance_info(BalanceInfo* info) {
+    if (!info) return;
+    free(info->scale);
+    free(info);
+}
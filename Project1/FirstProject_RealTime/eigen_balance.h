@@ -0,0 +1,41 @@
+#ifndef EIGEN_BALANCE_H
+#define EIGEN_BALANCE_H
+
+/*
+ * Balancing and permutation preprocessing for the QR eigen solvers.
+ *
+ * balance_matrix_flat() performs the same two stages as LAPACK's xGEBAL:
+ *   1. Permutation: rows/columns that isolate an eigenvalue (all other
+ *      entries in the row or column are zero) are moved to the bottom/top,
+ *      leaving an active window [ilo, ihi].
+ *   2. Scaling: a diagonal similarity D^-1 * A * D with power-of-two entries
+ *      equalizes row and column norms inside the active window.
+ *
+ * Both stages are similarity transforms, so the eigenvalues are unchanged.
+ * Eigenvectors of the balanced matrix are mapped back to the original matrix
+ * with balance_back_transform().
+ */
+
+typedef struct {
+    int n;
+    int ilo;        /* first row/column of the active (non-isolated) window */
+    int ihi;        /* last row/column of the active window */
+    double* scale;  /* inside [ilo, ihi]: scaling factor d[i];
+                       outside: index of the row/column swapped with i */
+} BalanceInfo;
+
+/* Balance a row-major n*n matrix in place.
+ * Returns a BalanceInfo describing the transform, or NULL on allocation failure.
+ */
+BalanceInfo* balance_matrix_flat(double* A, int n);
+
+/* Map eigenvectors (columns of the row-major n*n matrix V) computed for the
+ * balanced matrix back to the original matrix, then normalize each column
+ * to unit 2-norm.
+ */
+void balance_back_transform(const BalanceInfo* info, double* V, int n);
+
+/* Free a BalanceInfo */
+void free_balance_info(BalanceInfo* info);
+
+#endif /* EIGEN_BALANCE_H */
@@ -0,0 +1,474 @@
+#include "eigen_generalized.h"
+#include "eigen_qr.h"
+#include "matrix_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <complex.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Relative tolerance for the symmetry test of the Cholesky path */
+#define SYM_EPS 1e-12
+
+/* QZ sweeps without a deflation before an exceptional shift is used */
+#define QZ_EXCEPTIONAL_EVERY 10
+
+static double get_time() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+void free_generalized_eigen_result(GeneralizedEigenResult* res) {
+    if (!res) return;
+    free(res->alpha_re);
+    free(res->alpha_im);
+    free(res->beta);
+    if (res->eigenvectors) free_matrix(res->eigenvectors);
+    if (res->eigenvectors_im) free_matrix(res->eigenvectors_im);
+    free(res);
+}
+
+static GeneralizedEigenResult* alloc_result(int n, int method) {
+    GeneralizedEigenResult* res = (GeneralizedEigenResult*)calloc(1, sizeof(GeneralizedEigenResult));
+    if (!res) return NULL;
+    res->n = n;
+    res->method = method;
+    res->alpha_re = (double*)calloc((size_t)n, sizeof(double));
+    res->alpha_im = (double*)calloc((size_t)n, sizeof(double));
+    res->beta = (double*)calloc((size_t)n, sizeof(double));
+    res->eigenvectors = create_matrix("Eigenvectors", n, n);
+    if (!res->alpha_re || !res->alpha_im || !res->beta || !res->eigenvectors) {
+        free_generalized_eigen_result(res);
+        return NULL;
+    }
+    return res;
+}
+
+static int is_symmetric(const Matrix* m) {
+    int n = m->rows;
+    double norm = 0.0;
+    for (int i = 0; i < n; ++i)
+        for (int j = 0; j < n; ++j) norm = fmax(norm, fabs(m->data[i][j]));
+    for (int i = 0; i < n; ++i)
+        for (int j = i + 1; j < n; ++j)
+            if (fabs(m->data[i][j] - m->data[j][i]) > SYM_EPS * norm) return 0;
+    return 1;
+}
+
+/* ========== Symmetric-definite path: Cholesky reduction ========== */
+
+/* Left-looking Cholesky B = L*L^T into row-major lower-triangular L.
+ * Row-major storage makes each L[i][0..j) . L[j][0..j) a contiguous dot
+ * product; the rows below the diagonal are independent for a fixed column.
+ * Returns 0 if B is not positive definite.
+ */
+static int cholesky_openmp(const Matrix* B, double* L, int n) {
+    memset(L, 0, (size_t)n * n * sizeof(double));
+    for (int j = 0; j < n; ++j) {
+        double d = B->data[j][j];
+        for (int k = 0; k < j; ++k) d -= L[(size_t)j * n + k] * L[(size_t)j * n + k];
+        if (d <= 0.0 || !isfinite(d)) return 0;
+        double ljj = sqrt(d);
+        L[(size_t)j * n + j] = ljj;
+        #pragma omp parallel for schedule(static)
+        for (int i = j + 1; i < n; ++i) {
+            double s = mat_get(B, i, j);
+            for (int k = 0; k < j; ++k) s -= L[(size_t)i * n + k] * L[(size_t)j * n + k];
+            L[(size_t)i * n + j] = s / ljj;
+        }
+    }
+    return 1;
+}
+
+GeneralizedEigenResult* eigen_generalized_cholesky(const Matrix* A, const Matrix* B, int max_iter,
+                                                   double tol, double* exec_time) {
+    if (!A || !B || A->rows != A->cols || B->rows != B->cols || A->rows != B->rows) return NULL;
+    if (!is_symmetric(A) || !is_symmetric(B)) return NULL;
+    int n = A->rows;
+    double start = get_time();
+
+    double* L = (double*)malloc((size_t)n * n * sizeof(double));
+    double* W = (double*)malloc((size_t)n * n * sizeof(double));
+    Matrix* C = create_matrix("Reduced", n, n);
+    if (!L || !W || !C) { free(L); free(W); free_matrix(C); return NULL; }
+
+    if (!cholesky_openmp(B, L, n)) {
+        free(L); free(W); free_matrix(C);
+        return NULL;
+    }
+
+    /* W = inv(L) * A, one forward substitution per column */
+    #pragma omp parallel for schedule(static)
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            double s = mat_get(A, i, j);
+            for (int k = 0; k < i; ++k) s -= L[(size_t)i * n + k] * W[(size_t)k * n + j];
+            W[(size_t)i * n + j] = s / L[(size_t)i * n + i];
+        }
+    }
+
+    /* C = inv(L) * W^T = inv(L) * A * inv(L)^T; column j uses row j of W */
+    #pragma omp parallel for schedule(static)
+    for (int j = 0; j < n; ++j) {
+        for (int i = 0; i < n; ++i) {
+            double s = W[(size_t)j * n + i];
+            for (int k = 0; k < i; ++k) s -= L[(size_t)i * n + k] * C->data[k][j];
+            C->data[i][j] = s / L[(size_t)i * n + i];
+        }
+    }
+
+    /* Remove rounding asymmetry before the symmetric eigen solve */
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            double v = 0.5 * (C->data[i][j] + C->data[j][i]);
+            C->data[i][j] = v;
+            C->data[j][i] = v;
+        }
+    }
+
+    EigenResult* er = eigen_qr_openmp(C, max_iter, tol, NULL);
+    free_matrix(C);
+    if (er && er->iterations >= max_iter) {
+        mat_log(MAT_LOG_WARN, "WARNING: QR iteration on the reduced pencil did not converge in %d iterations",
+                max_iter);
+        free_eigen_result(er);
+        er = NULL;
+    }
+    if (!er || !er->eigenvectors) {
+        free_eigen_result(er);
+        free(L); free(W);
+        return NULL;
+    }
+
+    GeneralizedEigenResult* res = alloc_result(n, GEN_EIG_CHOLESKY);
+    if (!res) { free_eigen_result(er); free(L); free(W); return NULL; }
+    res->iterations = er->iterations;
+    for (int k = 0; k < n; ++k) {
+        res->alpha_re[k] = er->eigenvalues[k];
+        res->beta[k] = 1.0;
+    }
+
+    /* x = inv(L)^T * y, one back substitution per eigenvector */
+    Matrix* X = res->eigenvectors;
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < n; ++k) {
+        for (int i = n - 1; i >= 0; --i) {
+            double s = er->eigenvectors->data[i][k];
+            for (int j = i + 1; j < n; ++j) s -= L[(size_t)j * n + i] * X->data[j][k];
+            X->data[i][k] = s / L[(size_t)i * n + i];
+        }
+    }
+
+    free_eigen_result(er);
+    free(L); free(W);
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+/* ========== General path: QZ ========== */
+
+/* Complex Givens rotation with real c: [c s; -conj(s) c] * [f; g] = [r; 0] */
+static void make_rot(double complex f, double complex g, double* c, double complex* s, double complex* r) {
+    double af = cabs(f), ag = cabs(g);
+    if (ag == 0.0) {
+        *c = 1.0; *s = 0.0; if (r) *r = f;
+    } else if (af == 0.0) {
+        *c = 0.0; *s = conj(g) / ag; if (r) *r = ag;
+    } else {
+        double nrm = hypot(af, ag);
+        double complex alpha = f / af;
+        *c = af / nrm;
+        *s = alpha * conj(g) / nrm;
+        if (r) *r = alpha * nrm;
+    }
+}
+
+/* Apply the rotation to rows p, q of M over columns [c0, c1) */
+static void rot_rows(double complex* M, int n, int p, int q, double c, double complex s, int c0, int c1) {
+    for (int k = c0; k < c1; ++k) {
+        double complex x = M[(size_t)p * n + k];
+        double complex y = M[(size_t)q * n + k];
+        M[(size_t)p * n + k] = c * x + s * y;
+        M[(size_t)q * n + k] = -conj(s) * x + c * y;
+    }
+}
+
+/* Apply a rotation from the right to columns p, q of M over rows [r0, r1).
+ * Built from make_rot(M[i][q], M[i][p]) it zeroes M[i][p].
+ */
+static void rot_cols(double complex* M, int n, int p, int q, double c, double complex s, int r0, int r1) {
+    for (int i = r0; i < r1; ++i) {
+        double complex x = M[(size_t)i * n + p];
+        double complex y = M[(size_t)i * n + q];
+        M[(size_t)i * n + p] = c * x - conj(s) * y;
+        M[(size_t)i * n + q] = s * x + c * y;
+    }
+}
+
+/* Reduce (H, T) to Hessenberg-triangular form, accumulating right rotations in Z */
+static void hessenberg_triangular(double complex* H, double complex* T, double complex* Z, int n) {
+    double c; double complex s, r;
+    /* T <- Q^H T upper triangular; the same row rotations hit H */
+    for (int j = 0; j < n - 1; ++j) {
+        for (int i = n - 1; i > j; --i) {
+            make_rot(T[(size_t)(i - 1) * n + j], T[(size_t)i * n + j], &c, &s, &r);
+            T[(size_t)(i - 1) * n + j] = r;
+            T[(size_t)i * n + j] = 0.0;
+            rot_rows(T, n, i - 1, i, c, s, j + 1, n);
+            rot_rows(H, n, i - 1, i, c, s, 0, n);
+        }
+    }
+    /* Zero H below the subdiagonal while keeping T triangular */
+    for (int j = 0; j < n - 2; ++j) {
+        for (int i = n - 1; i >= j + 2; --i) {
+            make_rot(H[(size_t)(i - 1) * n + j], H[(size_t)i * n + j], &c, &s, &r);
+            H[(size_t)(i - 1) * n + j] = r;
+            H[(size_t)i * n + j] = 0.0;
+            rot_rows(H, n, i - 1, i, c, s, j + 1, n);
+            rot_rows(T, n, i - 1, i, c, s, i - 1, n);
+            /* T fill at (i, i-1) */
+            make_rot(T[(size_t)i * n + i], T[(size_t)i * n + i - 1], &c, &s, &r);
+            T[(size_t)i * n + i] = r;
+            T[(size_t)i * n + i - 1] = 0.0;
+            rot_cols(T, n, i - 1, i, c, s, 0, i);
+            rot_cols(H, n, i - 1, i, c, s, 0, n);
+            rot_cols(Z, n, i - 1, i, c, s, 0, n);
+        }
+    }
+}
+
+/* Eigenvalue of the trailing 2x2 pencil closest to H[ihi][ihi]/T[ihi][ihi] */
+static double complex wilkinson_shift(const double complex* H, const double complex* T, int n, int ihi) {
+    int p = ihi - 1, q = ihi;
+    double complex a11 = H[(size_t)p * n + p], a12 = H[(size_t)p * n + q];
+    double complex a21 = H[(size_t)q * n + p], a22 = H[(size_t)q * n + q];
+    double complex b11 = T[(size_t)p * n + p], b12 = T[(size_t)p * n + q];
+    double complex b22 = T[(size_t)q * n + q];
+
+    double complex qa = b11 * b22;
+    double complex qb = -(a11 * b22 + a22 * b11 - a21 * b12);
+    double complex qc = a11 * a22 - a12 * a21;
+    double complex target = (cabs(b22) > 0.0) ? a22 / b22 : a22;
+
+    if (cabs(qa) <= DBL_EPSILON * (cabs(qb) + cabs(qc))) {
+        return (cabs(qb) > 0.0) ? -qc / qb : target;
+    }
+    double complex disc = csqrt(qb * qb - 4.0 * qa * qc);
+    double complex r1 = (-qb + disc) / (2.0 * qa);
+    double complex r2 = (-qb - disc) / (2.0 * qa);
+    return (cabs(r1 - target) <= cabs(r2 - target)) ? r1 : r2;
+}
+
+/* One implicit single-shift QZ sweep on the unreduced block [l, ihi] */
+static void qz_sweep(double complex* H, double complex* T, double complex* Z, int n,
+                     int l, int ihi, double complex shift) {
+    double c; double complex s, r;
+    for (int k = l; k < ihi; ++k) {
+        if (k == l) {
+            make_rot(H[(size_t)l * n + l] - shift * T[(size_t)l * n + l], H[(size_t)(l + 1) * n + l], &c, &s, NULL);
+            rot_rows(H, n, k, k + 1, c, s, k, n);
+        } else {
+            make_rot(H[(size_t)k * n + k - 1], H[(size_t)(k + 1) * n + k - 1], &c, &s, &r);
+            H[(size_t)k * n + k - 1] = r;
+            H[(size_t)(k + 1) * n + k - 1] = 0.0;
+            rot_rows(H, n, k, k + 1, c, s, k, n);
+        }
+        rot_rows(T, n, k, k + 1, c, s, k, n);
+
+        /* Chase the T fill at (k+1, k) with a column rotation */
+        make_rot(T[(size_t)(k + 1) * n + k + 1], T[(size_t)(k + 1) * n + k], &c, &s, &r);
+        T[(size_t)(k + 1) * n + k + 1] = r;
+        T[(size_t)(k + 1) * n + k] = 0.0;
+        rot_cols(T, n, k, k + 1, c, s, 0, k + 1);
+        rot_cols(H, n, k, k + 1, c, s, 0, (k + 2 < ihi ? k + 2 : ihi) + 1);
+        rot_cols(Z, n, k, k + 1, c, s, 0, n);
+    }
+}
+
+GeneralizedEigenResult* eigen_generalized_qz(const Matrix* A, const Matrix* B, int max_iter,
+                                             double tol, double* exec_time) {
+    if (!A || !B || A->rows != A->cols || B->rows != B->cols || A->rows != B->rows) return NULL;
+    int n = A->rows;
+    double start = get_time();
+    size_t nn = (size_t)n * n;
+
+    double complex* H = (double complex*)malloc(nn * sizeof(double complex));
+    double complex* T = (double complex*)malloc(nn * sizeof(double complex));
+    double complex* Z = (double complex*)calloc(nn, sizeof(double complex));
+    if (!H || !T || !Z) { free(H); free(T); free(Z); return NULL; }
+
+    double hnorm = 0.0, bnorm = 0.0;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            H[(size_t)i * n + j] = mat_get(A, i, j);
+            T[(size_t)i * n + j] = mat_get(B, i, j);
+            hnorm = fmax(hnorm, fabs(mat_get(A, i, j)));
+            bnorm = fmax(bnorm, fabs(mat_get(B, i, j)));
+        }
+        Z[(size_t)i * n + i] = 1.0;
+    }
+    if (tol <= 0.0) tol = DBL_EPSILON;
+
+    hessenberg_triangular(H, T, Z, n);
+
+    int ihi = n - 1, iter = 0, since_deflation = 0;
+    while (ihi > 0) {
+        /* Find the start l of the unreduced block ending at ihi */
+        int l = ihi;
+        while (l > 0) {
+            double sub = cabs(H[(size_t)l * n + l - 1]);
+            double diag = cabs(H[(size_t)(l - 1) * n + l - 1]) + cabs(H[(size_t)l * n + l]);
+            if (sub <= tol * diag || sub <= DBL_EPSILON * hnorm) {
+                H[(size_t)l * n + l - 1] = 0.0;
+                break;
+            }
+            --l;
+        }
+        if (l == ihi) {
+            --ihi;
+            since_deflation = 0;
+            continue;
+        }
+        if (iter >= max_iter) {
+            mat_log(MAT_LOG_ERROR, "ERROR: QZ iteration did not converge in %d sweeps", max_iter);
+            free(H); free(T); free(Z);
+            return NULL;
+        }
+
+        double complex shift;
+        if (since_deflation > 0 && since_deflation % QZ_EXCEPTIONAL_EVERY == 0) {
+            double complex t = T[(size_t)ihi * n + ihi];
+            double complex base = (cabs(t) > 0.0) ? H[(size_t)ihi * n + ihi] / t : 0.0;
+            shift = base + 1.5 * cabs(H[(size_t)ihi * n + ihi - 1]);
+        } else {
+            shift = wilkinson_shift(H, T, n, ihi);
+        }
+        if (!isfinite(creal(shift)) || !isfinite(cimag(shift))) {
+            shift = cabs(H[(size_t)ihi * n + ihi - 1]);
+        }
+
+        qz_sweep(H, T, Z, n, l, ihi, shift);
+        ++iter;
+        ++since_deflation;
+    }
+
+    GeneralizedEigenResult* res = alloc_result(n, GEN_EIG_QZ);
+    if (!res) { free(H); free(T); free(Z); return NULL; }
+    res->iterations = iter;
+    res->eigenvectors_im = create_matrix("Eigenvectors_im", n, n);
+
+    /* Right eigenvectors: (beta*H - alpha*T) y = 0 by back substitution
+     * on the triangular pair, then x = Z*y. Each column is independent.
+     */
+    double snorm = 0.0;
+    for (size_t k = 0; k < nn; ++k) snorm = fmax(snorm, cabs(H[k]) + cabs(T[k]));
+    double small = DBL_EPSILON * (snorm > 0.0 ? snorm : 1.0);
+    int have_vectors = (res->eigenvectors_im != NULL);
+    int all_real = 1;
+
+    /* Normalize so beta is real and non-negative; a beta at rounding level
+     * of a singular B is an infinite eigenvalue
+     */
+    for (int k = 0; k < n; ++k) {
+        double complex alpha = H[(size_t)k * n + k];
+        double complex beta = T[(size_t)k * n + k];
+        double ab = cabs(beta);
+        double complex a_out = (ab > 0.0) ? alpha * conj(beta) / ab : alpha;
+        if (ab <= n * DBL_EPSILON * bnorm) ab = 0.0;
+        res->alpha_re[k] = creal(a_out);
+        res->alpha_im[k] = cimag(a_out);
+        res->beta[k] = ab;
+    }
+    /* The complex QZ does not keep conjugate pairs exact. A pencil of real
+     * matrices has its complex eigenvalues in conjugate pairs, so an
+     * imaginary part is kept only above rounding level and when another
+     * eigenvalue lies nearer to the conjugate than to the real axis
+     */
+    char* is_real = (char*)malloc((size_t)n);
+    if (!is_real) { free_generalized_eigen_result(res); free(H); free(T); free(Z); return NULL; }
+    for (int k = 0; k < n; ++k) {
+        double im = res->alpha_im[k];
+        int partner = 0;
+        if (fabs(im) > n * DBL_EPSILON * snorm) {
+            for (int j = 0; j < n && !partner; ++j) {
+                if (j == k || (res->beta[j] > 0.0) != (res->beta[k] > 0.0)) continue;
+                /* Compare lambda_j with conj(lambda_k) (alpha for infinite ones) */
+                double sj = res->beta[j] > 0.0 ? res->beta[j] : 1.0;
+                double sk = res->beta[k] > 0.0 ? res->beta[k] : 1.0;
+                double complex lj = (res->alpha_re[j] + I * res->alpha_im[j]) / sj;
+                double complex ck = (res->alpha_re[k] - I * im) / sk;
+                partner = cabs(lj - ck) < fabs(im) / sk;
+            }
+        }
+        is_real[k] = !partner;
+        if (!partner) res->alpha_im[k] = 0.0;
+        else all_real = 0;
+    }
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < n; ++k) {
+        double complex alpha = H[(size_t)k * n + k];
+        double complex beta = T[(size_t)k * n + k];
+        int real = is_real[k];
+
+        double complex* y = (double complex*)calloc((size_t)n, sizeof(double complex));
+        if (!y) continue;
+        y[k] = 1.0;
+        for (int j = k - 1; j >= 0; --j) {
+            double complex sum = 0.0;
+            for (int l = j + 1; l <= k; ++l) {
+                sum += (beta * H[(size_t)j * n + l] - alpha * T[(size_t)j * n + l]) * y[l];
+            }
+            double complex d = beta * H[(size_t)j * n + j] - alpha * T[(size_t)j * n + j];
+            if (cabs(d) < small) d = small;
+            y[j] = -sum / d;
+        }
+        double complex* x = (double complex*)calloc((size_t)n, sizeof(double complex));
+        if (x && have_vectors) {
+            double norm = 0.0;
+            double complex big = 0.0;
+            for (int i = 0; i < n; ++i) {
+                double complex v = 0.0;
+                for (int l = 0; l <= k; ++l) v += Z[(size_t)i * n + l] * y[l];
+                x[i] = v;
+                norm += creal(v) * creal(v) + cimag(v) * cimag(v);
+                if (cabs(v) > cabs(big)) big = v;
+            }
+            /* Unit 2-norm, phase chosen so the largest component is real */
+            double complex phase = (cabs(big) > 0.0) ? conj(big) / cabs(big) : 1.0;
+            norm = sqrt(norm);
+            for (int i = 0; i < n; ++i) {
+                double complex v = (norm > 0.0) ? x[i] * phase / norm : 0.0;
+                /* A real eigenvalue has a real eigenvector once the phase is fixed */
+                res->eigenvectors->data[i][k] = creal(v);
+                res->eigenvectors_im->data[i][k] = real ? 0.0 : cimag(v);
+            }
+        }
+        free(x);
+        free(y);
+    }
+
+    free(is_real);
+    if (all_real && res->eigenvectors_im) {
+        free_matrix(res->eigenvectors_im);
+        res->eigenvectors_im = NULL;
+    }
+
+    free(H); free(T); free(Z);
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+GeneralizedEigenResult* eigen_generalized(const Matrix* A, const Matrix* B, int max_iter,
+                                          double tol, double* exec_time) {
+    if (!A || !B) return NULL;
+    GeneralizedEigenResult* res = eigen_generalized_cholesky(A, B, max_iter, tol, exec_time);
+    if (res) return res;
+    return eigen_generalized_qz(A, B, max_iter * (A->rows > 0 ? A->rows : 1), tol, exec_time);
+}
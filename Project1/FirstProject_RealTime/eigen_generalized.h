@@ -0,0 +1,61 @@
+#ifndef EIGEN_GENERALIZED_H
+#define EIGEN_GENERALIZED_H
+
+#include "matrix_types.h"
+
+/*
+ * Generalized eigenproblem A*x = lambda*B*x, solved without forming inv(B)*A.
+ *
+ * - Symmetric-definite pencils (A = A^T, B = B^T positive definite) are
+ *   reduced with the Cholesky factor B = L*L^T to the standard symmetric
+ *   problem C = inv(L)*A*inv(L)^T, which is handed to eigen_qr_openmp().
+ *   Eigenvalues are real and the eigenvectors are B-orthonormal.
+ * - General pencils use the QZ algorithm: Hessenberg-triangular reduction
+ *   followed by complex single-shift QZ sweeps. Eigenvalues come back as
+ *   (alpha, beta) pairs so that infinite eigenvalues (beta == 0) of a
+ *   singular B are represented exactly.
+ */
+
+#define GEN_EIG_CHOLESKY 1
+#define GEN_EIG_QZ       2
+
+typedef struct {
+    int n;
+    double* alpha_re;         /* lambda[k] = (alpha_re[k] + i*alpha_im[k]) / beta[k] */
+    double* alpha_im;
+    double* beta;             /* real, >= 0; 0 marks an infinite eigenvalue */
+    Matrix* eigenvectors;     /* n x n, columns are right eigenvectors (real part) */
+    Matrix* eigenvectors_im;  /* imaginary parts, NULL when all eigenvectors are real */
+    int iterations;
+    int method;               /* GEN_EIG_CHOLESKY or GEN_EIG_QZ */
+} GeneralizedEigenResult;
+
+/* Free a GeneralizedEigenResult */
+void free_generalized_eigen_result(GeneralizedEigenResult* res);
+
+/* Symmetric-definite pencil via Cholesky reduction (OpenMP).
+ * Returns NULL if A or B is not symmetric, B is not positive definite or
+ * the QR iteration does not converge in max_iter iterations.
+ */
+GeneralizedEigenResult* eigen_generalized_cholesky(const Matrix* A, const Matrix* B, int max_iter,
+                                                   double tol, double* exec_time);
+
+/* General pencil via QZ. tol is the relative deflation threshold on the
+ * subdiagonal of the Hessenberg factor; max_iter bounds the total QZ sweeps.
+ * An eigenvalue is reported as complex only when its imaginary part is
+ * above rounding level (n * eps of the triangular pair) and a conjugate
+ * partner was computed too; otherwise alpha_im is 0, so a real spectrum is
+ * reported as real.
+ */
+GeneralizedEigenResult* eigen_generalized_qz(const Matrix* A, const Matrix* B, int max_iter,
+                                             double tol, double* exec_time);
+
+/* Dispatch: Cholesky reduction when the pencil is symmetric-definite, QZ
+ * otherwise or when that QR iteration does not converge. max_iter has the
+ * eigen_qr_* meaning; the QZ fallback gets max_iter sweeps per eigenvalue
+ * since it counts sweeps over all deflations.
+ */
+GeneralizedEigenResult* eigen_generalized(const Matrix* A, const Matrix* B, int max_iter,
+                                          double tol, double* exec_time);
+
+#endif /* EIGEN_GENERALIZED_H */
@@ -1,4 +1,7 @@
 #include "eigen_qr.h"
+#include "eigen_balance.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -6,6 +9,7 @@
 #include <sys/time.h>
 #include <unistd.h>
 #include <sys/wait.h>
+#include <errno.h>
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -16,6 +20,17 @@ static double get_time() {
     return tv.tv_sec + tv.tv_usec / 1000000.0;
 }
 
+/* Balancing is on by default; see eigen_balance.h */
+static int g_balance_enabled = 1;
+
+void eigen_qr_set_balancing(int enabled) {
+    g_balance_enabled = enabled ? 1 : 0;
+}
+
+int eigen_qr_balancing_enabled(void) {
+    return g_balance_enabled;
+}
+
 void free_eigen_result(EigenResult* res) {
     if (!res) return;
     free(res->eigenvalues);
@@ -30,7 +45,7 @@ static double* copy_matrix_flat(const Matrix* m) {
     if (!A) return NULL;
     for (int i = 0; i < n; ++i) {
         for (int j = 0; j < n; ++j) {
-            A[i * n + j] = m->data[i][j];
+            A[i * n + j] = mat_get(m, i, j);
         }
     }
     return A;
@@ -102,11 +117,15 @@ static void matmul_single(const double* A, const double* B, double* C, int n) {
     }
 }
 
-/* Check convergence: max off-diagonal element < tol */
+/* Check convergence: max subdiagonal element < tol.
+ * QR iteration drives A towards upper-triangular (Schur) form; the strictly
+ * upper part of a non-symmetric matrix never vanishes, and for a symmetric
+ * input it mirrors the lower part, so only the lower triangle is tested.
+ */
 static int is_converged(const double* A, int n, double tol) {
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            if (i != j && fabs(A[i * n + j]) > tol) {
+    for (int i = 1; i < n; ++i) {
+        for (int j = 0; j < i; ++j) {
+            if (fabs(A[i * n + j]) > tol) {
                 return 0;
             }
         }
@@ -130,6 +149,9 @@ EigenResult* eigen_qr_single(const Matrix* m, int max_iter, double tol, double*
     double* A = copy_matrix_flat(m);
     if (!A) return NULL;
     
+    /* Permute and scale before iterating; undone on V at the end */
+    BalanceInfo* bal = g_balance_enabled ? balance_matrix_flat(A, n) : NULL;
+    
     double* Q = (double*)malloc((size_t)n * n * sizeof(double));
     double* R = (double*)malloc((size_t)n * n * sizeof(double));
     double* A_next = (double*)malloc((size_t)n * n * sizeof(double));
@@ -138,6 +160,7 @@ EigenResult* eigen_qr_single(const Matrix* m, int max_iter, double tol, double*
     
     if (!Q || !R || !A_next || !V || !V_temp) {
         free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+        free_balance_info(bal);
         return NULL;
     }
     
@@ -152,8 +175,9 @@ EigenResult* eigen_qr_single(const Matrix* m, int max_iter, double tol, double*
         if (is_converged(A, n, tol)) break;
         
         if (!qr_decompose_single(A, Q, R, n)) {
-            fprintf(stderr, "ERROR: QR decomposition failed (matrix may be singular or numerically rank-deficient)\n");
+            mat_log(MAT_LOG_ERROR, "ERROR: QR decomposition failed (matrix may be singular or numerically rank-deficient)");
             free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+            free_balance_info(bal);
             return NULL;
         }
         
@@ -166,6 +190,11 @@ EigenResult* eigen_qr_single(const Matrix* m, int max_iter, double tol, double*
         memcpy(A, A_next, (size_t)n * n * sizeof(double));
     }
     
+    if (bal) {
+        balance_back_transform(bal, V, n);
+        free_balance_info(bal);
+    }
+    
     EigenResult* res = (EigenResult*)malloc(sizeof(EigenResult));
     res->n = n;
     res->iterations = iter;
@@ -248,6 +277,9 @@ EigenResult* eigen_qr_openmp(const Matrix* m, int max_iter, double tol, double*
     double* A = copy_matrix_flat(m);
     if (!A) return NULL;
     
+    /* Permute and scale before iterating; undone on V at the end */
+    BalanceInfo* bal = g_balance_enabled ? balance_matrix_flat(A, n) : NULL;
+    
     double* Q = (double*)malloc((size_t)n * n * sizeof(double));
     double* R = (double*)malloc((size_t)n * n * sizeof(double));
     double* A_next = (double*)malloc((size_t)n * n * sizeof(double));
@@ -256,6 +288,7 @@ EigenResult* eigen_qr_openmp(const Matrix* m, int max_iter, double tol, double*
     
     if (!Q || !R || !A_next || !V || !V_temp) {
         free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+        free_balance_info(bal);
         return NULL;
     }
     
@@ -270,8 +303,9 @@ EigenResult* eigen_qr_openmp(const Matrix* m, int max_iter, double tol, double*
         if (is_converged(A, n, tol)) break;
         
         if (!qr_decompose_openmp(A, Q, R, n)) {
-            fprintf(stderr, "ERROR: QR decomposition failed (matrix may be singular or numerically rank-deficient)\n");
+            mat_log(MAT_LOG_ERROR, "ERROR: QR decomposition failed (matrix may be singular or numerically rank-deficient)");
             free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+            free_balance_info(bal);
             return NULL;
         }
         
@@ -283,6 +317,11 @@ EigenResult* eigen_qr_openmp(const Matrix* m, int max_iter, double tol, double*
         memcpy(A, A_next, (size_t)n * n * sizeof(double));
     }
     
+    if (bal) {
+        balance_back_transform(bal, V, n);
+        free_balance_info(bal);
+    }
+    
     EigenResult* res = (EigenResult*)malloc(sizeof(EigenResult));
     res->n = n;
     res->iterations = iter;
@@ -312,6 +351,9 @@ EigenResult* eigen_qr_multiprocess(const Matrix* m, int max_iter, double tol, do
     double* A = copy_matrix_flat(m);
     if (!A) return NULL;
     
+    /* Permute and scale before iterating; undone on V at the end */
+    BalanceInfo* bal = g_balance_enabled ? balance_matrix_flat(A, n) : NULL;
+    
     double* Q = (double*)malloc((size_t)n * n * sizeof(double));
     double* R = (double*)malloc((size_t)n * n * sizeof(double));
     double* A_next = (double*)malloc((size_t)n * n * sizeof(double));
@@ -320,6 +362,7 @@ EigenResult* eigen_qr_multiprocess(const Matrix* m, int max_iter, double tol, do
     
     if (!Q || !R || !A_next || !V || !V_temp) {
         free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+        free_balance_info(bal);
         return NULL;
     }
     
@@ -336,15 +379,17 @@ EigenResult* eigen_qr_multiprocess(const Matrix* m, int max_iter, double tol, do
         /* Fork a child to compute QR decomposition */
         int pipeQR[2];
         if (pipe(pipeQR) == -1) {
-            perror("pipe");
+            mat_log(MAT_LOG_ERROR, "pipe: %s", strerror(errno));
             free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+            free_balance_info(bal);
             return NULL;
         }
         
         pid_t pid = fork();
         if (pid == -1) {
-            perror("fork");
+            mat_log(MAT_LOG_ERROR, "fork: %s", strerror(errno));
             free(A); free(Q); free(R); free(A_next); free(V); free(V_temp);
+            free_balance_info(bal);
             return NULL;
         }
         
@@ -378,6 +423,11 @@ EigenResult* eigen_qr_multiprocess(const Matrix* m, int max_iter, double tol, do
         }
     }
     
+    if (bal) {
+        balance_back_transform(bal, V, n);
+        free_balance_info(bal);
+    }
+    
     EigenResult* res = (EigenResult*)malloc(sizeof(EigenResult));
     res->n = n;
     res->iterations = iter;
@@ -399,74 +449,74 @@ EigenResult* eigen_qr_multiprocess(const Matrix* m, int max_iter, double tol, do
 EigenResult* run_eigen_comparison(const Matrix* m, int max_iter, double tol, PerformanceMetrics* metrics) {
     if (!m || !metrics || m->rows != m->cols) return NULL;
     
-    printf("\n========================================\n");
-    printf("Performance Comparison: QR Iteration (Eigenvalues)\n");
-    printf("Matrix: %s (%dx%d)\n", m->name, m->rows, m->cols);
-    printf("Max iterations: %d, Tolerance: %.2e\n", max_iter, tol);
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: QR Iteration (Eigenvalues)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    mat_log(MAT_LOG_INFO, "Max iterations: %d, Tolerance: %.2e", max_iter, tol);
+    mat_log(MAT_LOG_INFO, "Balancing: %s", g_balance_enabled ? "on (permute + scale)" : "off");
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
     
     EigenResult *res1 = NULL, *res2 = NULL, *res3 = NULL;
     
-    printf("[1/3] Running Single-threaded method...\n");
+    mat_log(MAT_LOG_INFO, "[1/3] Running Single-threaded method...");
     res1 = eigen_qr_single(m, max_iter, tol, &metrics->single_thread_time);
     if (res1) {
-        printf("   ✓ Completed in %.6f seconds (%d iterations)\n\n", 
-               metrics->single_thread_time, res1->iterations);
+        mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds (%d iterations)\n", 
+                metrics->single_thread_time, res1->iterations);
     } else {
-        printf("   ✗ Failed\n\n");
+        mat_log(MAT_LOG_INFO, "   ✗ Failed\n");
     }
     
-    printf("[2/3] Running OpenMP method...\n");
+    mat_log(MAT_LOG_INFO, "[2/3] Running OpenMP method...");
     res2 = eigen_qr_openmp(m, max_iter, tol, &metrics->openmp_time);
     if (res2) {
-        printf("   ✓ Completed in %.6f seconds (%d iterations)\n", 
-               metrics->openmp_time, res2->iterations);
+        mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds (%d iterations)", 
+                metrics->openmp_time, res2->iterations);
         if (res1) {
-            printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->openmp_time);
+            mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
         } else {
-            printf("\n");
+            mat_log(MAT_LOG_INFO, "%s", "");
         }
     } else {
-        printf("   ✗ Failed\n\n");
+        mat_log(MAT_LOG_INFO, "   ✗ Failed\n");
     }
     
-    printf("[3/3] Running Multiprocessing method...\n");
+    mat_log(MAT_LOG_INFO, "[3/3] Running Multiprocessing method...");
     res3 = eigen_qr_multiprocess(m, max_iter, tol, &metrics->multiprocess_time);
     if (res3) {
-        printf("   ✓ Completed in %.6f seconds (%d iterations)\n", 
-               metrics->multiprocess_time, res3->iterations);
+        mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds (%d iterations)", 
+                metrics->multiprocess_time, res3->iterations);
         if (res1) {
-            printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->multiprocess_time);
+            mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
         } else {
-            printf("\n");
+            mat_log(MAT_LOG_INFO, "%s", "");
         }
     } else {
-        printf("   ✗ Failed\n\n");
+        mat_log(MAT_LOG_INFO, "   ✗ Failed\n");
     }
     
-    printf("========================================\n");
-    printf("PERFORMANCE SUMMARY\n");
-    printf("========================================\n");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
     if (res1) {
-        printf("Single-threaded:   %.6f s (baseline)\n", metrics->single_thread_time);
+        mat_log(MAT_LOG_INFO, "Single-threaded:   %.6f s (baseline)", metrics->single_thread_time);
     }
-    if (res2) {
-        printf("OpenMP:            %.6f s", metrics->openmp_time);
-        if (res1) {
-            printf(" (%.2fx %s)", metrics->single_thread_time / metrics->openmp_time,
-                   metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
-        }
-        printf("\n");
+    if (res2 && res1) {
+        mat_log(MAT_LOG_INFO, "OpenMP:            %.6f s (%.2fx %s)", metrics->openmp_time,
+                metrics->single_thread_time / metrics->openmp_time,
+                metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    } else if (res2) {
+        mat_log(MAT_LOG_INFO, "OpenMP:            %.6f s", metrics->openmp_time);
     }
-    if (res3) {
-        printf("Multiprocessing:   %.6f s", metrics->multiprocess_time);
-        if (res1) {
-            printf(" (%.2fx %s)", metrics->single_thread_time / metrics->multiprocess_time,
-                   metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
-        }
-        printf("\n");
+    if (res3 && res1) {
+        mat_log(MAT_LOG_INFO, "Multiprocessing:   %.6f s (%.2fx %s)", metrics->multiprocess_time,
+                metrics->single_thread_time / metrics->multiprocess_time,
+                metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    } else if (res3) {
+        mat_log(MAT_LOG_INFO, "Multiprocessing:   %.6f s", metrics->multiprocess_time);
     }
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "========================================\n");
     
     /* Choose the fastest result that succeeded */
     EigenResult* fastest = res1;
@@ -485,7 +535,7 @@ EigenResult* run_eigen_comparison(const Matrix* m, int max_iter, double tol, Per
     }
     
     if (fastest) {
-        printf("★ Fastest method: %s (%.6f s)\n\n", fastest_name, fastest_time);
+        mat_log(MAT_LOG_INFO, "★ Fastest method: %s (%.6f s)\n", fastest_name, fastest_time);
     }
     
     /* Clean up non-fastest results */
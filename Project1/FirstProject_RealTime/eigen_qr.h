@@ -12,6 +12,12 @@ typedef struct {
     int iterations;
 } EigenResult;
 
+/* Enable/disable balancing + permutation preprocessing (eigen_balance.h)
+ * before QR iteration. Enabled by default for all three engines.
+ */
+void eigen_qr_set_balancing(int enabled);
+int eigen_qr_balancing_enabled(void);
+
 /* Free an EigenResult */
 void free_eigen_result(EigenResult* res);
 
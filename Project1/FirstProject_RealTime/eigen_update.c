@@ -0,0 +1,445 @@
+#include "eigen_update.h"
+#include "matrix_gemm.h"
+#include "matrix_log.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Refinement gives up when the off-diagonal part of Q^T A Q exceeds this
+ * fraction of its norm, or when Jacobi needs more sweeps than this
+ */
+#define EIGEN_UPDATE_MAX_OFFDIAG 0.3
+#define EIGEN_UPDATE_MAX_SWEEPS 12
+/* Secular equation root finder iteration cap (bisection guarantees progress) */
+#define SECULAR_MAX_ITER 200
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* ===== Flat buffers (row-major n x n; column j of Q is eigenvector j) ===== */
+
+static double *flatten(const Matrix *m) {
+    double *buf = (double *)malloc((size_t)m->rows * m->cols * sizeof(double));
+    if (!buf) return NULL;
+    for (int i = 0; i < m->rows; i++)
+        for (int j = 0; j < m->cols; j++) buf[(size_t)i * m->cols + j] = mat_get(m, i, j);
+    return buf;
+}
+
+typedef struct {
+    double key;
+    int index;
+} KeyIndex;
+
+/* Ties keep index order, so equal eigenvalues come out deterministically */
+static int cmp_ascending(const void *x, const void *y) {
+    const KeyIndex *a = (const KeyIndex *)x, *b = (const KeyIndex *)y;
+    if (a->key != b->key) return (a->key > b->key) - (a->key < b->key);
+    return (a->index > b->index) - (a->index < b->index);
+}
+
+/* Indices of d in ascending order */
+static int *sorted_order(const double *d, int n) {
+    int *idx = (int *)malloc((size_t)n * sizeof(int));
+    KeyIndex *pairs = (KeyIndex *)malloc((size_t)n * sizeof(KeyIndex));
+    if (!idx || !pairs) { free(idx); free(pairs); return NULL; }
+    for (int i = 0; i < n; i++) { pairs[i].key = d[i]; pairs[i].index = i; }
+    qsort(pairs, (size_t)n, sizeof(KeyIndex), cmp_ascending);
+    for (int i = 0; i < n; i++) idx[i] = pairs[i].index;
+    free(pairs);
+    return idx;
+}
+
+/* EigenResult with the pairs (d[j], column j of Q) in ascending order */
+static EigenResult *make_result(int n, const double *d, const double *Q, int iterations) {
+    int *idx = sorted_order(d, n);
+    EigenResult *res = (EigenResult *)calloc(1, sizeof(EigenResult));
+    if (!idx || !res) {
+        free(idx); free(res);
+        return NULL;
+    }
+    res->n = n;
+    res->iterations = iterations;
+    res->eigenvalues = (double *)malloc((size_t)n * sizeof(double));
+    res->eigenvectors = create_matrix("Eigenvectors", n, n);
+    if (!res->eigenvalues || !res->eigenvectors) {
+        free(idx);
+        free_eigen_result(res);
+        return NULL;
+    }
+    for (int j = 0; j < n; j++) res->eigenvalues[j] = d[idx[j]];
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) *mat_at(res->eigenvectors, i, j) = Q[(size_t)i * n + idx[j]];
+    free(idx);
+    return res;
+}
+
+/* ===== Rank-one update ===== */
+
+/* Root of 1 + r sum_i w_i^2 / (d_i - origin - tau) = 0 for tau in (lo, hi),
+ * where f increases from -inf to +inf: Newton steps kept inside a shrinking
+ * bracket, bisecting whenever Newton would leave it.
+ */
+static double secular_root(const double *d, const double *w, int k, double r, double origin,
+                           double lo, double hi) {
+    double tau = 0.5 * (lo + hi);
+    for (int it = 0; it < SECULAR_MAX_ITER; it++) {
+        double f = 1.0, fp = 0.0;
+        for (int i = 0; i < k; i++) {
+            double t = w[i] / ((d[i] - origin) - tau);
+            f += r * w[i] * t;
+            fp += r * t * t;
+        }
+        if (f == 0.0) break;
+        if (f > 0.0) hi = tau;
+        else lo = tau;
+        double next = tau - f / fp;
+        if (!(next > lo && next < hi)) next = 0.5 * (lo + hi);
+        if (fabs(next - tau) <= 2.0 * DBL_EPSILON * fabs(next) || hi - lo <= 2.0 * DBL_EPSILON * fmax(fabs(lo), fabs(hi))) {
+            tau = next;
+            break;
+        }
+        tau = next;
+    }
+    return tau;
+}
+
+/* Replace (d, Q) by the eigenpairs of Q diag(d) Q^T + rho z z^T, in place */
+static int rank_one_flat(int n, double *d, double *Q, double rho, const double *z) {
+    if (rho == 0.0) return 1;
+    /* For rho < 0 solve for -A' = -A + |rho| z z^T and negate the roots */
+    double s = rho > 0.0 ? 1.0 : -1.0, r = fabs(rho);
+    int *perm = sorted_order(d, n);
+    int *order = (int *)malloc((size_t)n * sizeof(int));
+    int *kept = (int *)malloc((size_t)n * sizeof(int));
+    double *dd = (double *)malloc((size_t)n * sizeof(double));
+    double *w = (double *)malloc((size_t)n * sizeof(double));
+    if (!perm || !order || !kept || !dd || !w) {
+        free(perm); free(order); free(kept); free(dd); free(w);
+        return 0;
+    }
+    for (int t = 0; t < n; t++) {
+        order[t] = s > 0.0 ? perm[t] : perm[n - 1 - t];
+        dd[t] = s * d[order[t]];
+    }
+    free(perm);
+
+    /* w = Q^T z */
+    #pragma omp parallel for schedule(static) if (n > 256)
+    for (int t = 0; t < n; t++) {
+        double sum = 0.0;
+        for (int i = 0; i < n; i++) sum += Q[(size_t)i * n + order[t]] * z[i];
+        w[t] = sum;
+    }
+    double wn2 = 0.0;
+    for (int t = 0; t < n; t++) wn2 += w[t] * w[t];
+    double tol = 8.0 * DBL_EPSILON * fmax(fmax(fabs(dd[0]), fabs(dd[n - 1])), r * wn2);
+
+    /* Deflation: negligible w_t, then equal d's (rotate w onto one of them) */
+    int k = 0, prev = -1;
+    for (int t = 0; t < n; t++) {
+        if (r * fabs(w[t]) <= tol) continue;
+        if (prev >= 0 && dd[t] - dd[prev] <= tol) {
+            double h = hypot(w[prev], w[t]), c = w[t] / h, sn = w[prev] / h;
+            int cp = order[prev], ct = order[t];
+            for (int i = 0; i < n; i++) {
+                double qp = Q[(size_t)i * n + cp], qt = Q[(size_t)i * n + ct];
+                Q[(size_t)i * n + cp] = c * qp - sn * qt;
+                Q[(size_t)i * n + ct] = sn * qp + c * qt;
+            }
+            w[prev] = 0.0;
+            w[t] = h;
+            kept[k - 1] = t;
+        } else {
+            kept[k++] = t;
+        }
+        prev = t;
+    }
+    if (k == 0) {
+        free(order); free(kept); free(dd); free(w);
+        return 1;
+    }
+
+    double *dk = (double *)malloc((size_t)k * sizeof(double));
+    double *wk = (double *)malloc((size_t)k * sizeof(double));
+    double *tau = (double *)malloc((size_t)k * sizeof(double));
+    int *origin = (int *)malloc((size_t)k * sizeof(int));
+    double *D = (double *)malloc((size_t)k * k * sizeof(double));     /* D[i][j] = dk_i - mu_j */
+    double *S = (double *)malloc((size_t)k * k * sizeof(double));
+    double *Qk = (double *)malloc((size_t)n * k * sizeof(double));
+    double *V = (double *)calloc((size_t)n * k, sizeof(double));
+    double *what = (double *)malloc((size_t)k * sizeof(double));
+    int ok = dk && wk && tau && origin && D && S && Qk && V && what;
+    if (ok) {
+        double wk2 = 0.0;
+        for (int j = 0; j < k; j++) {
+            dk[j] = dd[kept[j]];
+            wk[j] = w[kept[j]];
+            wk2 += wk[j] * wk[j];
+        }
+
+        /* Root j lies in (dk_j, dk_{j+1}), the last one in (dk_{k-1}, dk_{k-1} + r |w|^2].
+         * Measure it from the nearer pole so that mu_j - dk_i keeps full precision.
+         */
+        #pragma omp parallel for schedule(dynamic, 16) if (k > 64)
+        for (int j = 0; j < k; j++) {
+            double lo, hi;
+            if (j < k - 1) {
+                double half = 0.5 * (dk[j + 1] - dk[j]), f = 1.0;
+                for (int i = 0; i < k; i++) f += r * wk[i] * wk[i] / ((dk[i] - dk[j]) - half);
+                if (f >= 0.0) { origin[j] = j;     lo = 0.0;   hi = half; }
+                else          { origin[j] = j + 1; lo = -half; hi = 0.0;  }
+            } else {
+                origin[j] = j;
+                lo = 0.0;
+                hi = r * wk2;
+            }
+            tau[j] = secular_root(dk, wk, k, r, dk[origin[j]], lo, hi);
+            for (int i = 0; i < k; i++) {
+                D[(size_t)i * k + j] = (dk[i] - dk[origin[j]]) - tau[j];
+                if (D[(size_t)i * k + j] == 0.0) D[(size_t)i * k + j] = (i <= j ? -1.0 : 1.0) * DBL_MIN;
+            }
+        }
+
+        /* Gu-Eisenstat: the w for which the computed roots are exact,
+         * what_i^2 = prod_j (mu_j - d_i) / (r prod_{j != i} (d_j - d_i)),
+         * paired into factors in (0, 1] so the product cannot overflow.
+         */
+        for (int i = 0; i < k; i++) {
+            double prod = -D[(size_t)i * k + (k - 1)] / r;
+            for (int j = 0; j < k; j++) {
+                if (j < i) prod *= -D[(size_t)i * k + j] / (dk[j] - dk[i]);
+                else if (j > i) prod *= -D[(size_t)i * k + (j - 1)] / (dk[j] - dk[i]);
+            }
+            what[i] = copysign(sqrt(fabs(prod)), wk[i]);
+        }
+        for (int j = 0; j < k; j++) {
+            double norm = 0.0;
+            for (int i = 0; i < k; i++) {
+                double v = what[i] / D[(size_t)i * k + j];
+                S[(size_t)i * k + j] = v;
+                norm += v * v;
+            }
+            norm = 1.0 / sqrt(norm);
+            for (int i = 0; i < k; i++) S[(size_t)i * k + j] *= norm;
+        }
+
+        /* New eigenvectors: columns of Q_K S */
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < k; j++) Qk[(size_t)i * k + j] = Q[(size_t)i * n + order[kept[j]]];
+        gemm_recursive(n, k, k, 1.0, Qk, k, S, k, V, k, 1);
+        for (int j = 0; j < k; j++) {
+            int c = order[kept[j]];
+            d[c] = s * (dk[origin[j]] + tau[j]);
+            for (int i = 0; i < n; i++) Q[(size_t)i * n + c] = V[(size_t)i * k + j];
+        }
+    }
+    free(dk); free(wk); free(tau); free(origin); free(D); free(S); free(Qk); free(V); free(what);
+    free(order); free(kept); free(dd); free(w);
+    return ok;
+}
+
+/* Flat copies of old's eigenvalues and eigenvectors */
+static int load_old(const EigenResult *old, double **d, double **Q) {
+    *d = (double *)malloc((size_t)old->n * sizeof(double));
+    *Q = flatten(old->eigenvectors);
+    if (!*d || !*Q) {
+        free(*d); free(*Q);
+        return 0;
+    }
+    memcpy(*d, old->eigenvalues, (size_t)old->n * sizeof(double));
+    return 1;
+}
+
+EigenResult *eigen_update_rank_one(const EigenResult *old, double rho, const double *z, double *exec_time) {
+    double start = get_time();
+    if (!old || !old->eigenvectors || !z) return NULL;
+    double *d, *Q;
+    if (!load_old(old, &d, &Q)) return NULL;
+    EigenResult *res = rank_one_flat(old->n, d, Q, rho, z) ? make_result(old->n, d, Q, 1) : NULL;
+    free(d); free(Q);
+    if (res && exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+EigenResult *eigen_update_edits(const EigenResult *old, const SymmetricEdit *edits, int count,
+                                double *exec_time) {
+    double start = get_time();
+    if (!old || !old->eigenvectors || count < 0 || (count > 0 && !edits)) return NULL;
+    int n = old->n;
+    double *d, *Q;
+    if (!load_old(old, &d, &Q)) return NULL;
+    double *z = (double *)calloc((size_t)n, sizeof(double));
+    int ok = z != NULL, steps = 0;
+
+    for (int e = 0; ok && e < count; e++) {
+        int i = edits[e].i, j = edits[e].j;
+        double delta = edits[e].delta;
+        if (i < 0 || j < 0 || i >= n || j >= n) { ok = 0; break; }
+        if (i == j) {
+            /* delta e_i e_i^T */
+            z[i] = 1.0;
+            ok = rank_one_flat(n, d, Q, delta, z);
+            z[i] = 0.0;
+            steps++;
+        } else {
+            /* delta (e_i e_j^T + e_j e_i^T) = delta/2 (u u^T - v v^T), u, v = e_i +- e_j */
+            z[i] = 1.0; z[j] = 1.0;
+            ok = rank_one_flat(n, d, Q, 0.5 * delta, z);
+            z[j] = -1.0;
+            ok = ok && rank_one_flat(n, d, Q, -0.5 * delta, z);
+            z[i] = 0.0; z[j] = 0.0;
+            steps += 2;
+        }
+    }
+    EigenResult *res = ok ? make_result(n, d, Q, steps) : NULL;
+    free(d); free(Q); free(z);
+    if (res && exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+/* ===== Refinement from the old eigenbasis ===== */
+
+static double off_diagonal_norm(const double *B, int n, double *total) {
+    double off = 0.0, all = 0.0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) {
+            double v = B[(size_t)i * n + j] * B[(size_t)i * n + j];
+            all += v;
+            if (i != j) off += v;
+        }
+    *total = sqrt(all);
+    return sqrt(off);
+}
+
+EigenResult *eigen_update_refine(const Matrix *a, const EigenResult *old, double tol, double *exec_time) {
+    double start = get_time();
+    if (!a || !old || !old->eigenvectors || a->rows != a->cols || old->n != a->rows) return NULL;
+    int n = a->rows;
+    size_t nn = (size_t)n * n;
+    double *A = flatten(a), *Q = flatten(old->eigenvectors);
+    double *Qt = (double *)malloc(nn * sizeof(double));
+    double *T = (double *)calloc(nn, sizeof(double));
+    double *B = (double *)calloc(nn, sizeof(double));
+    double *W = (double *)calloc(nn, sizeof(double));
+    EigenResult *res = NULL;
+    if (!A || !Q || !Qt || !T || !B || !W) goto done;
+
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) Qt[(size_t)j * n + i] = Q[(size_t)i * n + j];
+
+    /* Q must be orthonormal for Q^T A Q to keep the spectrum */
+    gemm_recursive(n, n, n, 1.0, Qt, n, Q, n, B, n, 1);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            if (fabs(B[(size_t)i * n + j] - (i == j)) > 1e-8) {
+                mat_log(MAT_LOG_INFO, "Eigen update: cached eigenvectors are not orthonormal");
+                goto done;
+            }
+
+    /* B = Q^T A Q, symmetrized */
+    gemm_recursive(n, n, n, 1.0, A, n, Q, n, T, n, 1);
+    memset(B, 0, nn * sizeof(double));
+    gemm_recursive(n, n, n, 1.0, Qt, n, T, n, B, n, 1);
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++) {
+            double v = 0.5 * (B[(size_t)i * n + j] + B[(size_t)j * n + i]);
+            B[(size_t)i * n + j] = B[(size_t)j * n + i] = v;
+        }
+    double norm, off = off_diagonal_norm(B, n, &norm);
+    if (off > EIGEN_UPDATE_MAX_OFFDIAG * norm) {
+        mat_log(MAT_LOG_INFO, "Eigen update: change too large for a warm start (off-diagonal %.3g of %.3g)",
+                off, norm);
+        goto done;
+    }
+
+    /* Cyclic Jacobi on B, accumulating the rotations in W */
+    for (int i = 0; i < n; i++) W[(size_t)i * n + i] = 1.0;
+    int sweep = 0;
+    while (off > tol * norm && sweep < EIGEN_UPDATE_MAX_SWEEPS) {
+        for (int p = 0; p < n - 1; p++)
+            for (int q = p + 1; q < n; q++) {
+                double bpq = B[(size_t)p * n + q];
+                if (bpq == 0.0) continue;
+                double theta = (B[(size_t)q * n + q] - B[(size_t)p * n + p]) / (2.0 * bpq);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                double c = 1.0 / sqrt(t * t + 1.0), s = t * c;
+                for (int k = 0; k < n; k++) {
+                    double bkp = B[(size_t)k * n + p], bkq = B[(size_t)k * n + q];
+                    B[(size_t)k * n + p] = c * bkp - s * bkq;
+                    B[(size_t)k * n + q] = s * bkp + c * bkq;
+                }
+                for (int k = 0; k < n; k++) {
+                    double bpk = B[(size_t)p * n + k], bqk = B[(size_t)q * n + k];
+                    B[(size_t)p * n + k] = c * bpk - s * bqk;
+                    B[(size_t)q * n + k] = s * bpk + c * bqk;
+                }
+                for (int k = 0; k < n; k++) {
+                    double wkp = W[(size_t)k * n + p], wkq = W[(size_t)k * n + q];
+                    W[(size_t)k * n + p] = c * wkp - s * wkq;
+                    W[(size_t)k * n + q] = s * wkp + c * wkq;
+                }
+            }
+        sweep++;
+        off = off_diagonal_norm(B, n, &norm);
+    }
+    if (off > tol * norm) {
+        mat_log(MAT_LOG_INFO, "Eigen update: Jacobi did not settle in %d sweeps", sweep);
+        goto done;
+    }
+
+    /* Eigenvectors Q W, eigenvalues diag(B) */
+    memset(T, 0, nn * sizeof(double));
+    gemm_recursive(n, n, n, 1.0, Q, n, W, n, T, n, 1);
+    for (int i = 0; i < n; i++) A[i] = B[(size_t)i * n + i];
+    res = make_result(n, A, T, sweep);
+
+done:
+    free(A); free(Q); free(Qt); free(T); free(B); free(W);
+    if (res && exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+/* ===== Dispatch ===== */
+
+int is_symmetric_matrix(const Matrix *a) {
+    if (a->rows != a->cols) return 0;
+    double scale = 0.0;
+    for (int i = 0; i < a->rows; i++)
+        for (int j = 0; j < a->cols; j++) scale = fmax(scale, fabs(mat_get(a, i, j)));
+    for (int i = 0; i < a->rows; i++)
+        for (int j = i + 1; j < a->cols; j++)
+            if (fabs(mat_get(a, i, j) - mat_get(a, j, i)) > 1e-12 * scale) return 0;
+    return 1;
+}
+
+EigenResult *eigen_update(const Matrix *a, const EigenResult *old, const SymmetricEdit *edits,
+                          int edit_count, int max_iter, double tol, EigenUpdateMethod *used,
+                          double *exec_time) {
+    double start = get_time();
+    if (!a || a->rows != a->cols) return NULL;
+    EigenResult *res = NULL;
+    EigenUpdateMethod method = EIGEN_UPDATE_FULL;
+
+    if (old && old->eigenvectors && old->n == a->rows && is_symmetric_matrix(a)) {
+        if (edit_count >= 0 && edit_count <= EIGEN_UPDATE_MAX_EDITS) {
+            res = eigen_update_edits(old, edits, edit_count, NULL);
+            method = EIGEN_UPDATE_SECULAR;
+        }
+        if (!res) {
+            res = eigen_update_refine(a, old, tol, NULL);
+            method = EIGEN_UPDATE_SUBSPACE;
+        }
+    }
+    if (!res) {
+        res = eigen_qr_openmp(a, max_iter, tol, NULL);
+        method = EIGEN_UPDATE_FULL;
+    }
+    if (used) *used = method;
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
@@ -0,0 +1,70 @@
+#ifndef EIGEN_UPDATE_H
+#define EIGEN_UPDATE_H
+
+#include "matrix_types.h"
+#include "eigen_qr.h"
+
+/*
+ * Eigenpairs of a symmetric matrix after a small change, starting from the
+ * decomposition A = Q diag(d) Q^T of the matrix before the change instead of
+ * rerunning QR iteration.
+ *
+ * - Rank-one change A + rho z z^T: with w = Q^T z the new eigenvalues are
+ *   the roots of the secular equation 1 + rho sum_i w_i^2 / (d_i - mu) = 0,
+ *   one in each gap between consecutive d_i (O(n^2) for all of them). The
+ *   eigenvectors are Q (D - mu_j I)^-1 w, with w recomputed from the roots
+ *   (Gu-Eisenstat) so that they stay orthogonal; forming them is one GEMM.
+ *   Entries of w that are negligible, and pairs of equal d_i, deflate: those
+ *   eigenpairs carry over unchanged.
+ * - A symmetric edit of a[i][j] and a[j][i] is one or two rank-one changes.
+ * - Any other change: Rayleigh-Ritz in the old eigenbasis (Q^T A Q is nearly
+ *   diagonal if the change is small) finished by cyclic Jacobi sweeps. If
+ *   Q^T A Q is far from diagonal the change is too large for a warm start.
+ *
+ * Updated results list the eigenvalues in ascending order.
+ */
+
+/* More edits than this are handled as an unrecorded change */
+#define EIGEN_UPDATE_MAX_EDITS 8
+
+/* One edit of a symmetric matrix: a[i][j] and a[j][i] both changed by delta
+ * (for i == j, the diagonal entry once)
+ */
+typedef struct {
+    int i, j;
+    double delta;
+} SymmetricEdit;
+
+typedef enum {
+    EIGEN_UPDATE_SECULAR = 0,   /* rank-one updates from the recorded edits */
+    EIGEN_UPDATE_SUBSPACE,      /* Rayleigh-Ritz + Jacobi from the old eigenvectors */
+    EIGEN_UPDATE_FULL           /* fell back to QR iteration from scratch */
+} EigenUpdateMethod;
+
+/* a is square and a[i][j] == a[j][i] to within 1e-12 of the largest entry */
+int is_symmetric_matrix(const Matrix *a);
+
+/* Eigenpairs of A + rho z z^T given those of symmetric A (z has old->n
+ * entries). Returns NULL on allocation failure.
+ */
+EigenResult *eigen_update_rank_one(const EigenResult *old, double rho, const double *z, double *exec_time);
+
+/* Apply count symmetric edits in turn */
+EigenResult *eigen_update_edits(const EigenResult *old, const SymmetricEdit *edits, int count,
+                                double *exec_time);
+
+/* Eigenpairs of symmetric a, refined from the (orthonormal) eigenvectors of
+ * old. Returns NULL if the change is too large or the sweeps do not reach
+ * tol within a few passes.
+ */
+EigenResult *eigen_update_refine(const Matrix *a, const EigenResult *old, double tol, double *exec_time);
+
+/* Pick the cheapest method that applies: the recorded edits (edit_count < 0
+ * means the change is unknown), then refinement, then QR iteration on a with
+ * max_iter / tol. old may be NULL. *used reports the method taken.
+ */
+EigenResult *eigen_update(const Matrix *a, const EigenResult *old, const SymmetricEdit *edits,
+                          int edit_count, int max_iter, double tol, EigenUpdateMethod *used,
+                          double *exec_time);
+
+#endif /* EIGEN_UPDATE_H */
@@ -0,0 +1,145 @@
+#include "lu_recursive.h"
+#include "matrix_gemm.h"
+#include "matrix_trsm.h"
+#include <math.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef PIVOT_EPS
+#define PIVOT_EPS 1e-12
+#endif
+
+/* Swapped columns are split into tasks above this width */
+#define LU_TASK_COLS 256
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* Apply the row swaps piv[0..count) in order to ncols columns of A */
+static void apply_swaps(double *A, int lda, int ncols, const int *piv, int count, int parallel) {
+    if (ncols <= 0) return;
+    if (parallel && ncols > LU_TASK_COLS) {
+        int h = ncols / 2;
+        #pragma omp task
+        apply_swaps(A, lda, h, piv, count, parallel);
+        apply_swaps(A + h, lda, ncols - h, piv, count, parallel);
+        #pragma omp taskwait
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        if (piv[i] == i) continue;
+        double *r1 = A + (size_t)i * lda, *r2 = A + (size_t)piv[i] * lda;
+        for (int j = 0; j < ncols; j++) {
+            double t = r1[j];
+            r1[j] = r2[j];
+            r2[j] = t;
+        }
+    }
+}
+
+/* Factor the m x w panel at A (m >= w). piv receives w row indices
+ * relative to the top of the panel.
+ */
+static void lu_rec(double *A, int lda, int m, int w, int *piv, int parallel, int *sign, int *singular) {
+    if (w == 1) {
+        int p = 0;
+        double best = fabs(A[0]);
+        for (int i = 1; i < m; i++) {
+            double v = fabs(A[(size_t)i * lda]);
+            if (v > best) { best = v; p = i; }
+        }
+        piv[0] = p;
+        if (p != 0) {
+            double t = A[0];
+            A[0] = A[(size_t)p * lda];
+            A[(size_t)p * lda] = t;
+            *sign = -*sign;
+        }
+        if (best < PIVOT_EPS) { *singular = 1; return; }
+        double inv = 1.0 / A[0];
+        for (int i = 1; i < m; i++) A[(size_t)i * lda] *= inv;
+        return;
+    }
+
+    int n1 = w / 2, n2 = w - n1;
+    double *A12 = A + n1, *A21 = A + (size_t)n1 * lda, *A22 = A21 + n1;
+
+    lu_rec(A, lda, m, n1, piv, parallel, sign, singular);
+    apply_swaps(A12, lda, n2, piv, n1, parallel);
+    trsm_left_raw(TRI_LOWER, TRI_UNIT, n1, n2, A, lda, A12, lda, parallel);
+    gemm_recursive_task(m - n1, n2, n1, -1.0, A21, lda, A12, lda, A22, lda, parallel);
+
+    lu_rec(A22, lda, m - n1, n2, piv + n1, parallel, sign, singular);
+    apply_swaps(A21, lda, n1, piv + n1, n2, parallel);
+    for (int i = n1; i < w; i++) piv[i] += n1;
+}
+
+LUFactor *lu_factor_recursive(const Matrix *m, int parallel, double *exec_time) {
+    if (!m || m->rows != m->cols) return NULL;
+    double start = get_time();
+    int n = m->rows;
+
+    LUFactor *f = (LUFactor*)calloc(1, sizeof(LUFactor));
+    if (!f) return NULL;
+    f->n = n;
+    f->sign = 1;
+    f->lu = (double*)malloc((size_t)n * n * sizeof(double));
+    f->piv = (int*)malloc((size_t)n * sizeof(int));
+    if (!f->lu || !f->piv) { free_lu_factor(f); return NULL; }
+    if (m->layout == MAT_ROW_MAJOR) {
+        for (int i = 0; i < n; i++) memcpy(f->lu + (size_t)i * n, m->data[i], (size_t)n * sizeof(double));
+    } else {
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++) f->lu[(size_t)i * n + j] = m->data[j][i];
+    }
+
+#ifdef _OPENMP
+    if (parallel) {
+        #pragma omp parallel
+        #pragma omp single
+        lu_rec(f->lu, n, n, n, f->piv, 1, &f->sign, &f->singular);
+    } else
+#endif
+    {
+        lu_rec(f->lu, n, n, n, f->piv, 0, &f->sign, &f->singular);
+    }
+
+    if (exec_time) *exec_time = get_time() - start;
+    return f;
+}
+
+void free_lu_factor(LUFactor *f) {
+    if (!f) return;
+    free(f->lu);
+    free(f->piv);
+    free(f);
+}
+
+double lu_determinant(const LUFactor *f) {
+    if (!f || f->singular) return 0.0;
+    double det = f->sign;
+    for (int i = 0; i < f->n; i++) det *= f->lu[(size_t)i * f->n + i];
+    return det;
+}
+
+static int determinant_lu(const Matrix *m, double *out_det, double *exec_time, int parallel) {
+    if (!m || !out_det || m->rows != m->cols) return 0;
+    LUFactor *f = lu_factor_recursive(m, parallel, exec_time);
+    if (!f) return 0;
+    *out_det = lu_determinant(f);
+    free_lu_factor(f);
+    return 1;
+}
+
+int determinant_lu_single(const Matrix *m, double *out_det, double *exec_time) {
+    return determinant_lu(m, out_det, exec_time, 0);
+}
+
+int determinant_lu_openmp(const Matrix *m, double *out_det, double *exec_time) {
+    return determinant_lu(m, out_det, exec_time, 1);
+}
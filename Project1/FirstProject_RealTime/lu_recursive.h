@@ -0,0 +1,41 @@
+#ifndef LU_RECURSIVE_H
+#define LU_RECURSIVE_H
+
+#include "matrix_types.h"
+
+/*
+ * Recursive LU factorization with partial pivoting (Toledo's algorithm).
+ *
+ * The column range is split in halves: factor the left half, apply its row
+ * swaps to the right half, solve for the U12 block with a recursive
+ * triangular solve, update the trailing block with one recursive GEMM, then
+ * factor the trailing block. Almost all work ends up in the GEMM calls,
+ * which are cache-oblivious (matrix_gemm.h), instead of n rank-1 sweeps over
+ * the whole trailing matrix. The triangular solve is the one of
+ * matrix_trsm.h. The OpenMP variant runs the GEMM/TRSM halves and row swaps
+ * as tasks at the upper recursion levels.
+ */
+
+typedef struct {
+    int n;
+    double *lu;     /* n x n row-major; below the diagonal L (unit diagonal implied), on/above U */
+    int *piv;       /* step i swapped rows i and piv[i] (piv[i] >= i) */
+    int sign;       /* (-1)^(number of actual swaps) */
+    int singular;   /* some pivot was below the singularity threshold */
+} LUFactor;
+
+/* P*A = L*U for a square matrix of either layout (the factors are always
+ * row-major). parallel selects the OpenMP task version.
+ * Returns NULL if m is not square or on allocation failure.
+ */
+LUFactor *lu_factor_recursive(const Matrix *m, int parallel, double *exec_time);
+void free_lu_factor(LUFactor *f);
+
+/* sign * prod(diag(U)), or 0 for a singular factorization */
+double lu_determinant(const LUFactor *f);
+
+/* Determinant backends with the determinant_single/openmp signature */
+int determinant_lu_single(const Matrix *m, double *out_det, double *exec_time);
+int determinant_lu_openmp(const Matrix *m, double *out_det, double *exec_time);
+
+#endif /* LU_RECURSIVE_H */
@@ -0,0 +1,528 @@
+#include "matcore.h"
+#include "matrix_arithmetic_parallel.h"
+#include "determinant_parallel.h"
+#include "matrix_file_ops.h"
+#include "matrix_stream.h"
+#include <unistd.h>
+
+typedef Matrix* (*BinaryKernel)(const Matrix*, const Matrix*, const char*, double*);
+
+static const BinaryKernel add_kernels[] = {
+    add_matrices_single, add_matrices_openmp, add_matrices_multiprocess
+};
+static const BinaryKernel subtract_kernels[] = {
+    subtract_matrices_single, subtract_matrices_openmp, subtract_matrices_multiprocess
+};
+static const BinaryKernel multiply_kernels[] = {
+    multiply_matrices_single, multiply_matrices_openmp, multiply_matrices_multiprocess
+};
+
+static int valid_engine(MatEngine engine) {
+    return engine >= MAT_ENGINE_SINGLE && engine <= MAT_ENGINE_MULTIPROCESS;
+}
+
+/* Arguments were validated, so a NULL/0 from a kernel is a resource failure */
+static MatStatus resource_failure(MatEngine engine) {
+    return engine == MAT_ENGINE_MULTIPROCESS ? MAT_ERR_SYSTEM : MAT_ERR_NO_MEMORY;
+}
+
+const char *mat_status_string(MatStatus status) {
+    switch (status) {
+        case MAT_OK:               return "success";
+        case MAT_ERR_INVALID_ARG:  return "invalid argument";
+        case MAT_ERR_DIMENSION:    return "incompatible matrix dimensions";
+        case MAT_ERR_NOT_SQUARE:   return "matrix is not square";
+        case MAT_ERR_NO_MEMORY:    return "out of memory";
+        case MAT_ERR_IO:           return "I/O error";
+        case MAT_ERR_FORMAT:       return "malformed matrix data";
+        case MAT_ERR_NUMERIC:      return "numerical breakdown or no convergence";
+        case MAT_ERR_SYSTEM:       return "process/thread creation failed";
+    }
+    return "unknown status";
+}
+
+MatStatus mat_resources(ResourceBudget *out, int apply_openmp) {
+    if (!out) return MAT_ERR_INVALID_ARG;
+    *out = *resource_budget();
+    if (apply_openmp) resource_apply_openmp();
+    return MAT_OK;
+}
+
+static MatStatus run_binary(const BinaryKernel *kernels, const Matrix *a, const Matrix *b,
+                            MatEngine engine, const char *name, Matrix **out, double *seconds) {
+    double t = 0.0;
+    *out = kernels[engine](a, b, name, &t);
+    if (!*out) return resource_failure(engine);
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_add(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                  Matrix **out, double *seconds) {
+    if (!a || !b || !name || !out || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->rows != b->rows || a->cols != b->cols) return MAT_ERR_DIMENSION;
+    return run_binary(add_kernels, a, b, engine, name, out, seconds);
+}
+
+MatStatus mat_subtract(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                       Matrix **out, double *seconds) {
+    if (!a || !b || !name || !out || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->rows != b->rows || a->cols != b->cols) return MAT_ERR_DIMENSION;
+    return run_binary(subtract_kernels, a, b, engine, name, out, seconds);
+}
+
+MatStatus mat_multiply(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                       Matrix **out, double *seconds) {
+    if (!a || !b || !name || !out || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->cols != b->rows) return MAT_ERR_DIMENSION;
+    return run_binary(multiply_kernels, a, b, engine, name, out, seconds);
+}
+
+MatStatus mat_multiply_morton(const Matrix *a, const Matrix *b, int tile, const char *name,
+                              Matrix **out, double *seconds) {
+    if (!a || !b || !name || !out || tile < 0 || (tile & (tile - 1))) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->cols != b->rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = multiply_matrices_morton(a, b, name, tile, &t);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_multiply_approx(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                              const ApproxOptions *opt, ApproxInfo *info, Matrix **out, double *seconds) {
+    if (!a || !b || !name || !out) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (opt && (opt->samples < 0 || (opt->samples == 0 && !(opt->tolerance > 0.0)))) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->cols != b->rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = engine == MAT_ENGINE_OPENMP ? multiply_matrices_approx_openmp(a, b, name, opt, info, &t)
+                                       : multiply_matrices_approx_single(a, b, name, opt, info, &t);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_gemm(double alpha, const Matrix *a, const Matrix *b, double beta, Matrix *c,
+                   const GemmEpilogue *epi, MatEngine engine, double *seconds) {
+    if (!a || !b || !c || c == a || c == b) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (epi && epi->clamp && !(epi->lo <= epi->hi)) return MAT_ERR_INVALID_ARG;
+    if (a->cols != b->rows || c->rows != a->rows || c->cols != b->cols) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    int ok = engine == MAT_ENGINE_OPENMP ? gemm_matrices_openmp(alpha, a, b, beta, c, epi, &t)
+                                         : gemm_matrices_single(alpha, a, b, beta, c, epi, &t);
+    if (!ok) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_complex_multiply(const ComplexMatrix *a, const ComplexMatrix *b, ComplexGemmMethod method,
+                               MatEngine engine, const char *name, ComplexMatrix **out, double *seconds) {
+    if (!a || !b || !name || !out) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (method != COMPLEX_GEMM_4M && method != COMPLEX_GEMM_3M) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->cols != b->rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = engine == MAT_ENGINE_OPENMP ? complex_multiply_openmp(a, b, name, method, &t)
+                                       : complex_multiply_single(a, b, name, method, &t);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_complex_determinant(const ComplexMatrix *m, MatEngine engine, double complex *det,
+                                  double *seconds) {
+    if (!m || !det) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    int ok = engine == MAT_ENGINE_OPENMP ? complex_determinant_openmp(m, det, &t)
+                                         : complex_determinant_single(m, det, &t);
+    if (!ok) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_toeplitz_multiply(const ToeplitzMatrix *t, const Matrix *x, MatEngine engine, const char *name,
+                                Matrix **out, double *seconds) {
+    if (!t || !x || !name || !out) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (t->cols != x->rows) return MAT_ERR_DIMENSION;
+
+    double s = 0.0;
+    *out = engine == MAT_ENGINE_OPENMP ? toeplitz_multiply_openmp(t, x, name, &s)
+                                       : toeplitz_multiply_single(t, x, name, &s);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = s;
+    return MAT_OK;
+}
+
+MatStatus mat_toeplitz_solve(const ToeplitzMatrix *t, const Matrix *b, const char *name, Matrix **out,
+                             double *seconds) {
+    if (!t || !b || !name || !out) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (t->rows != t->cols) return MAT_ERR_NOT_SQUARE;
+    if (b->rows != t->rows) return MAT_ERR_DIMENSION;
+
+    double s = 0.0;
+    *out = toeplitz_solve(t, b, name, &s);
+    if (!*out) return MAT_ERR_NUMERIC;
+    if (seconds) *seconds = s;
+    return MAT_OK;
+}
+
+MatStatus mat_toeplitz_determinant(const ToeplitzMatrix *t, double *det, double *logabs, double *seconds) {
+    if (!t || !det) return MAT_ERR_INVALID_ARG;
+    if (t->rows != t->cols) return MAT_ERR_NOT_SQUARE;
+
+    double s = 0.0;
+    if (!toeplitz_determinant(t, det, logabs, &s)) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = s;
+    return MAT_OK;
+}
+
+MatStatus mat_determinant(const Matrix *m, MatEngine engine, double *det, double *seconds) {
+    if (!m || !det || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    int ok;
+    switch (engine) {
+        case MAT_ENGINE_SINGLE:  ok = determinant_single(m, det, &t); break;
+        case MAT_ENGINE_OPENMP:  ok = determinant_openmp(m, det, &t); break;
+        default:                 ok = determinant_multiprocess(m, det, &t); break;
+    }
+    if (!ok) return resource_failure(engine);
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_determinant_backend(const Matrix *m, MatEngine engine, DeterminantBackend backend,
+                                  double *det, double *seconds) {
+    if (backend == DET_BACKEND_GAUSS) return mat_determinant(m, engine, det, seconds);
+    if (!m || !det) return MAT_ERR_INVALID_ARG;
+    if (backend == DET_BACKEND_BLOCKS) {
+        if (!valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+        if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+        double t = 0.0;
+        int ok;
+        switch (engine) {
+            case MAT_ENGINE_SINGLE:  ok = determinant_blocks_single(m, NULL, det, &t); break;
+            case MAT_ENGINE_OPENMP:  ok = determinant_blocks_openmp(m, NULL, det, &t); break;
+            default:                 ok = determinant_blocks_multiprocess(m, NULL, det, &t); break;
+        }
+        if (!ok) return resource_failure(engine);
+        if (seconds) *seconds = t;
+        return MAT_OK;
+    }
+    if (backend != DET_BACKEND_RECURSIVE_LU && backend != DET_BACKEND_SPARSE) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    int ok = engine == MAT_ENGINE_OPENMP ? determinant_openmp_backend(m, backend, det, &t)
+                                         : determinant_single_backend(m, backend, det, &t);
+    if (!ok) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_sparse_determinant(const SparseMatrix *s, OrderingMethod ordering, double *det,
+                                 SparseFactorStats *stats, double *seconds) {
+    if (!s || !det) return MAT_ERR_INVALID_ARG;
+    if (ordering != ORDER_NATURAL && ordering != ORDER_RCM && ordering != ORDER_AMD) return MAT_ERR_INVALID_ARG;
+    if (s->rows != s->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    if (!sparse_determinant(s, ordering, det, stats, &t)) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_lu_factor(const Matrix *m, MatEngine engine, LUFactor **out, double *seconds) {
+    if (!m || !out) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    *out = lu_factor_recursive(m, engine == MAT_ENGINE_OPENMP, &t);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+typedef Matrix *(*TriKernel)(const Matrix *, const Matrix *, TriOptions, double, const char *, double *);
+static const TriKernel trsm_kernels[] = { trsm_single, trsm_openmp, trsm_multiprocess };
+static const TriKernel trmm_kernels[] = { trmm_single, trmm_openmp, trmm_multiprocess };
+
+static MatStatus run_triangular(const TriKernel *kernels, const Matrix *a, const Matrix *b, TriOptions op,
+                                double alpha, MatEngine engine, const char *name, Matrix **out,
+                                double *seconds) {
+    if (!a || !b || !name || !out || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->rows != a->cols) return MAT_ERR_NOT_SQUARE;
+    if ((op.side == TRI_LEFT ? b->rows : b->cols) != a->rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = kernels[engine](a, b, op, alpha, name, &t);
+    if (!*out) {
+        if (kernels == trsm_kernels && op.diag == TRI_NON_UNIT) {
+            for (int i = 0; i < a->rows; i++) {
+                if (mat_get(a, i, i) == 0.0) return MAT_ERR_NUMERIC;
+            }
+        }
+        return resource_failure(engine);
+    }
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_trsm(const Matrix *a, const Matrix *b, TriOptions op, double alpha, MatEngine engine,
+                   const char *name, Matrix **out, double *seconds) {
+    return run_triangular(trsm_kernels, a, b, op, alpha, engine, name, out, seconds);
+}
+
+MatStatus mat_trmm(const Matrix *a, const Matrix *b, TriOptions op, double alpha, MatEngine engine,
+                   const char *name, Matrix **out, double *seconds) {
+    return run_triangular(trmm_kernels, a, b, op, alpha, engine, name, out, seconds);
+}
+
+static MatStatus lstsq_status(LstsqResult **out, double t, double *seconds) {
+    if ((*out)->rank_deficient) {
+        free_lstsq_result(*out);
+        *out = NULL;
+        return MAT_ERR_NUMERIC;
+    }
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_lstsq(const Matrix *a, const Matrix *b, MatEngine engine, LstsqResult **out, double *seconds) {
+    if (!a || !b || !out || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->rows != b->rows || a->rows < a->cols) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    switch (engine) {
+        case MAT_ENGINE_SINGLE:  *out = lstsq_tsqr_single(a, b, &t); break;
+        case MAT_ENGINE_OPENMP:  *out = lstsq_tsqr_openmp(a, b, &t); break;
+        default:                 *out = lstsq_tsqr_multiprocess(a, b, 0, &t); break;
+    }
+    if (!*out) return resource_failure(engine);
+    return lstsq_status(out, t, seconds);
+}
+
+MatStatus mat_lstsq_file(const char *filepath, int nrhs, LstsqResult **out, double *seconds) {
+    if (!filepath || !out || nrhs <= 0) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (access(filepath, R_OK) != 0) return MAT_ERR_IO;
+
+    double t = 0.0;
+    *out = lstsq_tsqr_file(filepath, nrhs, 0, &t);
+    /* The file exists, so a failure is in its contents or shape */
+    if (!*out) return MAT_ERR_FORMAT;
+    return lstsq_status(out, t, seconds);
+}
+
+MatStatus mat_krylov(const KrylovOperator *op, const Matrix *b, const KrylovOptions *opt,
+                     KrylovResult **out, double *seconds) {
+    if (!op || !b || !out || (!op->dense == !op->sparse)) return MAT_ERR_INVALID_ARG;
+    if (opt && (opt->max_iter < 0 || !(opt->tol >= 0.0))) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    int rows = op->dense ? op->dense->rows : op->sparse->rows;
+    int cols = op->dense ? op->dense->cols : op->sparse->cols;
+    if (rows != cols) return MAT_ERR_NOT_SQUARE;
+    if (b->rows != rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = krylov_solve(op, b, NULL, opt, &t);
+    /* Shapes are checked, so a failure is a preconditioner breakdown or memory */
+    if (!*out) return MAT_ERR_NUMERIC;
+    if (seconds) *seconds = t;
+    for (int r = 0; r < (*out)->nrhs; r++)
+        if (!(*out)->converged[r]) return MAT_ERR_NUMERIC;
+    return MAT_OK;
+}
+
+static MatStatus kron_check(const KronOperator *op, MatEngine engine, int square) {
+    if (!op || !op->a || !op->b) return MAT_ERR_INVALID_ARG;
+    if (engine != MAT_ENGINE_SINGLE && engine != MAT_ENGINE_OPENMP) return MAT_ERR_INVALID_ARG;
+    if (square && (op->a->rows != op->a->cols || op->b->rows != op->b->cols)) return MAT_ERR_NOT_SQUARE;
+    return MAT_OK;
+}
+
+MatStatus mat_kron_multiply(const KronOperator *op, const Matrix *x, MatEngine engine,
+                            const char *name, Matrix **out, double *seconds) {
+    if (!x || !name || !out) return MAT_ERR_INVALID_ARG;
+    MatStatus st = kron_check(op, engine, 0);
+    if (st != MAT_OK) return st;
+    *out = NULL;
+    if (x->rows != kron_cols(op)) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = engine == MAT_ENGINE_OPENMP ? kron_multiply_openmp(op, x, name, &t)
+                                       : kron_multiply_single(op, x, name, &t);
+    if (!*out) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_kron_solve(const KronOperator *op, const Matrix *c, MatEngine engine,
+                         const char *name, Matrix **out, double *seconds) {
+    if (!c || !name || !out) return MAT_ERR_INVALID_ARG;
+    MatStatus st = kron_check(op, engine, 1);
+    if (st != MAT_OK) return st;
+    *out = NULL;
+    if (c->rows != kron_rows(op)) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = engine == MAT_ENGINE_OPENMP ? kron_solve_openmp(op, c, name, &t)
+                                       : kron_solve_single(op, c, name, &t);
+    /* Shapes are checked, so a failure is a singular factor (or memory) */
+    if (!*out) return MAT_ERR_NUMERIC;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_kron_determinant(const KronOperator *op, MatEngine engine, double *det, double *seconds) {
+    if (!det) return MAT_ERR_INVALID_ARG;
+    MatStatus st = kron_check(op, engine, 1);
+    if (st != MAT_OK) return st;
+
+    double t = 0.0;
+    if (!kron_determinant(op, engine == MAT_ENGINE_OPENMP, det, &t)) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_cov_window_push(CovarianceWindow *w, const Matrix *m, double *seconds) {
+    if (!w || !m) return MAT_ERR_INVALID_ARG;
+    if (m->cols != cov_window_vars(w)) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    if (!cov_window_push_matrix(w, m, &t)) return MAT_ERR_NO_MEMORY;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_cov_window_logdet(CovarianceWindow *w, double *logdet) {
+    if (!w || !logdet) return MAT_ERR_INVALID_ARG;
+    return cov_window_logdet(w, logdet) ? MAT_OK : MAT_ERR_NUMERIC;
+}
+
+MatStatus mat_eigen(const Matrix *m, MatEngine engine, int max_iter, double tol,
+                    EigenResult **out, double *seconds) {
+    if (!m || !out || max_iter <= 0 || tol <= 0.0 || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    switch (engine) {
+        case MAT_ENGINE_SINGLE:  *out = eigen_qr_single(m, max_iter, tol, &t); break;
+        case MAT_ENGINE_OPENMP:  *out = eigen_qr_openmp(m, max_iter, tol, &t); break;
+        default:                 *out = eigen_qr_multiprocess(m, max_iter, tol, &t); break;
+    }
+    /* The QR engines fail on allocation or on a rank-deficient factorization */
+    if (!*out) return engine == MAT_ENGINE_MULTIPROCESS ? MAT_ERR_SYSTEM : MAT_ERR_NUMERIC;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_eigen_blocks(const Matrix *m, MatEngine engine, int max_iter, double tol,
+                           EigenResult **out, double *seconds) {
+    if (!m || !out || max_iter <= 0 || tol <= 0.0 || !valid_engine(engine)) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+
+    double t = 0.0;
+    switch (engine) {
+        case MAT_ENGINE_SINGLE:  *out = eigen_blocks_single(m, NULL, max_iter, tol, &t); break;
+        case MAT_ENGINE_OPENMP:  *out = eigen_blocks_openmp(m, NULL, max_iter, tol, &t); break;
+        default:                 *out = eigen_blocks_multiprocess(m, NULL, max_iter, tol, &t); break;
+    }
+    if (!*out) return engine == MAT_ENGINE_MULTIPROCESS ? MAT_ERR_SYSTEM : MAT_ERR_NUMERIC;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_block_structure(const Matrix *m, BlockStructure **out) {
+    if (!m || !out) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (m->rows != m->cols) return MAT_ERR_NOT_SQUARE;
+    *out = matrix_block_structure(m);
+    return *out ? MAT_OK : MAT_ERR_NO_MEMORY;
+}
+
+MatStatus mat_eigen_generalized(const Matrix *a, const Matrix *b, int max_iter, double tol,
+                                GeneralizedEigenResult **out, double *seconds) {
+    if (!a || !b || !out || max_iter <= 0 || tol <= 0.0) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (a->rows != a->cols || b->rows != b->cols) return MAT_ERR_NOT_SQUARE;
+    if (a->rows != b->rows) return MAT_ERR_DIMENSION;
+
+    double t = 0.0;
+    *out = eigen_generalized(a, b, max_iter, tol, &t);
+    if (!*out) return MAT_ERR_NUMERIC;
+    if (seconds) *seconds = t;
+    return MAT_OK;
+}
+
+MatStatus mat_read(const char *path, Matrix **out) {
+    if (!path || !out) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (access(path, R_OK) != 0) return MAT_ERR_IO;
+    *out = read_matrix_from_file(path);
+    return *out ? MAT_OK : MAT_ERR_FORMAT;
+}
+
+MatStatus mat_write(const Matrix *m, const char *path) {
+    if (!m || !path) return MAT_ERR_INVALID_ARG;
+    return write_matrix_to_file(m, path) ? MAT_OK : MAT_ERR_IO;
+}
+
+MatStatus mat_read_complex(const char *path, ComplexMatrix **out) {
+    if (!path || !out) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (access(path, R_OK) != 0) return MAT_ERR_IO;
+    *out = read_complex_matrix_from_file(path);
+    return *out ? MAT_OK : MAT_ERR_FORMAT;
+}
+
+MatStatus mat_write_complex(const ComplexMatrix *m, const char *path) {
+    if (!m || !path) return MAT_ERR_INVALID_ARG;
+    return write_complex_matrix_to_file(m, path) ? MAT_OK : MAT_ERR_IO;
+}
+
+MatStatus mat_read_toeplitz(const char *path, ToeplitzMatrix **out) {
+    if (!path || !out) return MAT_ERR_INVALID_ARG;
+    *out = NULL;
+    if (access(path, R_OK) != 0) return MAT_ERR_IO;
+    *out = read_toeplitz_matrix_from_file(path);
+    return *out ? MAT_OK : MAT_ERR_FORMAT;
+}
+
+MatStatus mat_write_toeplitz(const ToeplitzMatrix *t, const char *path) {
+    if (!t || !path) return MAT_ERR_INVALID_ARG;
+    return write_toeplitz_matrix_to_file(t, path) ? MAT_OK : MAT_ERR_IO;
+}
+
+MatStatus mat_read_stream(int fd, const char *label, MatrixCollection *col, int *count) {
+    if (fd < 0 || !col) return MAT_ERR_INVALID_ARG;
+    int added = read_matrices_from_stream(fd, label, col);
+    if (count) *count = added < 0 ? 0 : added;
+    return added < 0 ? MAT_ERR_FORMAT : MAT_OK;
+}
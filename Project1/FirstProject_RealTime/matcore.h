@@ -0,0 +1,214 @@
+#ifndef MATCORE_H
+#define MATCORE_H
+
+/*
+ * libmatcore: embeddable entry points for the matrix kernels.
+ *
+ * Every function returns a MatStatus and hands results back through out
+ * parameters; nothing here writes to the console. Diagnostics go to the
+ * optional logger from matrix_log.h. The lower-level headers stay usable,
+ * but they report failure only as NULL/0.
+ *
+ * Build: make -f Makefile_demo lib  ->  libmatcore.a, libmatcore.so
+ */
+
+#include "matrix_types.h"
+#include "matrix_log.h"
+#include "eigen_qr.h"
+#include "eigen_generalized.h"
+#include "determinant_parallel.h"
+#include "lu_recursive.h"
+#include "matrix_trsm.h"
+#include "matrix_tsqr.h"
+#include "matrix_krylov.h"
+#include "matrix_kron.h"
+#include "matrix_resources.h"
+#include "matrix_covariance.h"
+#include "matrix_approx.h"
+#include "matrix_sparse_factor.h"
+#include "matrix_band.h"
+#include "matrix_blocks.h"
+#include "matrix_complex.h"
+#include "matrix_toeplitz.h"
+#include "matrix_morton.h"
+
+typedef enum {
+    MAT_OK = 0,
+    MAT_ERR_INVALID_ARG,    /* NULL pointer or out-of-range parameter */
+    MAT_ERR_DIMENSION,      /* operand shapes are incompatible */
+    MAT_ERR_NOT_SQUARE,     /* operation needs a square matrix */
+    MAT_ERR_NO_MEMORY,
+    MAT_ERR_IO,             /* file missing, unreadable or unwritable */
+    MAT_ERR_FORMAT,         /* file or stream contents are malformed */
+    MAT_ERR_NUMERIC,        /* breakdown or no convergence */
+    MAT_ERR_SYSTEM          /* fork/pipe/thread creation failed */
+} MatStatus;
+
+/* Execution engine, matching the three implementations of each kernel */
+typedef enum {
+    MAT_ENGINE_SINGLE = 0,
+    MAT_ENGINE_OPENMP,
+    MAT_ENGINE_MULTIPROCESS
+} MatEngine;
+
+/* Human-readable description of a status code */
+const char *mat_status_string(MatStatus status);
+
+/* CPU, memory and process budget of this process (matrix_resources.h).
+ * With apply_openmp the OpenMP engines use budget->cpus threads from now
+ * on, unless OMP_NUM_THREADS is set.
+ */
+MatStatus mat_resources(ResourceBudget *out, int apply_openmp);
+
+/* Element-wise a + b, a - b, and the product a * b into a new matrix *out
+ * named name. seconds (optional) receives the kernel time.
+ */
+MatStatus mat_add(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                  Matrix **out, double *seconds);
+MatStatus mat_subtract(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                       Matrix **out, double *seconds);
+MatStatus mat_multiply(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                       Matrix **out, double *seconds);
+
+/* a * b through the tiled Morton layout (matrix_morton.h): recursive
+ * quadrant products on contiguous tiles, OpenMP tasks. tile 0 selects
+ * MORTON_DEFAULT_TILE, otherwise it must be a power of two. seconds
+ * includes the layout conversions.
+ */
+MatStatus mat_multiply_morton(const Matrix *a, const Matrix *b, int tile, const char *name,
+                              Matrix **out, double *seconds);
+
+/* c = epi(alpha * a * b + beta * c) in place (matrix_arithmetic_parallel.h);
+ * single and OpenMP engines. epi may be NULL.
+ */
+MatStatus mat_gemm(double alpha, const Matrix *a, const Matrix *b, double beta, Matrix *c,
+                   const GemmEpilogue *epi, MatEngine engine, double *seconds);
+
+/* Approximate a * b by sampling or sketching (matrix_approx.h); single and
+ * OpenMP engines. opt NULL uses the defaults; info (optional) receives the
+ * sample count and the error bound and estimate.
+ */
+MatStatus mat_multiply_approx(const Matrix *a, const Matrix *b, MatEngine engine, const char *name,
+                              const ApproxOptions *opt, ApproxInfo *info, Matrix **out, double *seconds);
+
+/* Complex product (matrix_complex.h), 4M or 3M; single and OpenMP engines */
+MatStatus mat_complex_multiply(const ComplexMatrix *a, const ComplexMatrix *b, ComplexGemmMethod method,
+                               MatEngine engine, const char *name, ComplexMatrix **out, double *seconds);
+/* Complex determinant by LU with partial pivoting; single and OpenMP engines */
+MatStatus mat_complex_determinant(const ComplexMatrix *m, MatEngine engine, double complex *det,
+                                  double *seconds);
+
+/* Toeplitz/circulant times dense by FFT (matrix_toeplitz.h); single and
+ * OpenMP engines
+ */
+MatStatus mat_toeplitz_multiply(const ToeplitzMatrix *t, const Matrix *x, MatEngine engine, const char *name,
+                                Matrix **out, double *seconds);
+/* T X = B by Levinson (the DFT for a circulant). A singular leading minor
+ * falls back to dense LU. MAT_ERR_NUMERIC when T is singular
+ */
+MatStatus mat_toeplitz_solve(const ToeplitzMatrix *t, const Matrix *b, const char *name, Matrix **out,
+                             double *seconds);
+/* det(T) in O(n^2) (O(n log n) for a circulant, O(n^3) dense LU after a
+ * Levinson breakdown); logabs (optional) gets log|det|
+ */
+MatStatus mat_toeplitz_determinant(const ToeplitzMatrix *t, double *det, double *logabs, double *seconds);
+
+/* Determinant by Gaussian elimination with partial pivoting */
+MatStatus mat_determinant(const Matrix *m, MatEngine engine, double *det, double *seconds);
+/* Same with an explicit factorization. DET_BACKEND_RECURSIVE_LU and
+ * DET_BACKEND_SPARSE run on the SINGLE and OPENMP engines only
+ * (MAT_ERR_INVALID_ARG for MULTIPROCESS); DET_BACKEND_BLOCKS on all three.
+ */
+MatStatus mat_determinant_backend(const Matrix *m, MatEngine engine, DeterminantBackend backend,
+                                  double *det, double *seconds);
+/* Determinant of a sparse matrix after a fill-reducing ordering
+ * (matrix_sparse_factor.h); stats (optional) receives the fill and
+ * bandwidth figures
+ */
+MatStatus mat_sparse_determinant(const SparseMatrix *s, OrderingMethod ordering, double *det,
+                                 SparseFactorStats *stats, double *seconds);
+/* Recursive LU factorization (P*A = L*U); free with free_lu_factor */
+MatStatus mat_lu_factor(const Matrix *m, MatEngine engine, LUFactor **out, double *seconds);
+
+/* Triangular solve / multiply with many right-hand sides (matrix_trsm.h):
+ * X = alpha * inv(op(A)) * B, alpha * op(A) * B, or the right-side forms.
+ * MAT_ERR_NUMERIC for a zero diagonal in a non-unit solve.
+ */
+MatStatus mat_trsm(const Matrix *a, const Matrix *b, TriOptions op, double alpha, MatEngine engine,
+                   const char *name, Matrix **out, double *seconds);
+MatStatus mat_trmm(const Matrix *a, const Matrix *b, TriOptions op, double alpha, MatEngine engine,
+                   const char *name, Matrix **out, double *seconds);
+
+/* Least squares min ||A X - B|| by TSQR (matrix_tsqr.h); free *out with
+ * free_lstsq_result(). MAT_ERR_NUMERIC if A is rank deficient. The file
+ * variant reads [A | B] with the last nrhs columns as B.
+ */
+MatStatus mat_lstsq(const Matrix *a, const Matrix *b, MatEngine engine, LstsqResult **out, double *seconds);
+MatStatus mat_lstsq_file(const char *filepath, int nrhs, LstsqResult **out, double *seconds);
+
+/* Iterative solve of A X = B (matrix_krylov.h); opt NULL uses the defaults.
+ * Free *out with free_krylov_result(). If some right-hand side did not
+ * converge the result is kept (for its history) and MAT_ERR_NUMERIC is
+ * returned; a preconditioner that cannot be built also gives
+ * MAT_ERR_NUMERIC, with *out NULL.
+ */
+MatStatus mat_krylov(const KrylovOperator *op, const Matrix *b, const KrylovOptions *opt,
+                     KrylovResult **out, double *seconds);
+
+/* Implicit Kronecker operator A (x) B (matrix_kron.h); single and OpenMP
+ * engines. Products and solves return mn x k column-major matrices; a
+ * singular factor gives MAT_ERR_NUMERIC.
+ */
+MatStatus mat_kron_multiply(const KronOperator *op, const Matrix *x, MatEngine engine,
+                            const char *name, Matrix **out, double *seconds);
+MatStatus mat_kron_solve(const KronOperator *op, const Matrix *c, MatEngine engine,
+                         const char *name, Matrix **out, double *seconds);
+MatStatus mat_kron_determinant(const KronOperator *op, MatEngine engine, double *det, double *seconds);
+
+/* Sliding-window covariance (matrix_covariance.h): append the rows of m
+ * (DIMENSION if m->cols differs from the window's variables), and the
+ * log-determinant of the current covariance (NUMERIC if it is not
+ * positive definite).
+ */
+MatStatus mat_cov_window_push(CovarianceWindow *w, const Matrix *m, double *seconds);
+MatStatus mat_cov_window_logdet(CovarianceWindow *w, double *logdet);
+
+/* Eigen decomposition by QR iteration; free *out with free_eigen_result() */
+MatStatus mat_eigen(const Matrix *m, MatEngine engine, int max_iter, double tol,
+                    EigenResult **out, double *seconds);
+/* Same, one QR iteration per irreducible block (matrix_blocks.h), the
+ * blocks spread over the engine's threads or workers
+ */
+MatStatus mat_eigen_blocks(const Matrix *m, MatEngine engine, int max_iter, double tol,
+                           EigenResult **out, double *seconds);
+
+/* Strongly connected components of the pattern of m; free *out with
+ * free_block_structure()
+ */
+MatStatus mat_block_structure(const Matrix *m, BlockStructure **out);
+
+/* Generalized problem A*x = lambda*B*x (eigen_generalized.h);
+ * free *out with free_generalized_eigen_result()
+ */
+MatStatus mat_eigen_generalized(const Matrix *a, const Matrix *b, int max_iter, double tol,
+                                GeneralizedEigenResult **out, double *seconds);
+
+/* Load one matrix (.txt, .npy, .mtx, or a FIFO) / save one (.npy or text).
+ * A FIFO holding several matrices gives the first and a MAT_LOG_WARN
+ * message; use mat_read_stream to load all of them
+ */
+MatStatus mat_read(const char *path, Matrix **out);
+MatStatus mat_write(const Matrix *m, const char *path);
+
+/* Load / save one complex matrix (text with the "complex" tag, or c16 .npy) */
+MatStatus mat_read_complex(const char *path, ComplexMatrix **out);
+MatStatus mat_write_complex(const ComplexMatrix *m, const char *path);
+
+/* Load / save one Toeplitz or circulant matrix (tagged text format) */
+MatStatus mat_read_toeplitz(const char *path, ToeplitzMatrix **out);
+MatStatus mat_write_toeplitz(const ToeplitzMatrix *t, const char *path);
+
+/* Load every matrix streamed on fd into col; *count (optional) = matrices added */
+MatStatus mat_read_stream(int fd, const char *label, MatrixCollection *col, int *count);
+
+#endif /* MATCORE_H */
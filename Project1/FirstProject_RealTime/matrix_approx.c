@@ -0,0 +1,296 @@
+#include "matrix_approx.h"
+#include "matrix_arithmetic_parallel.h"
+#include "matrix_gemm.h"
+#include "matrix_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define APPROX_DEFAULT_TOLERANCE 0.05
+#define APPROX_DEFAULT_SEED 0x9e3779b97f4a7c15ULL
+/* Columns of B per task when summing rows into the sketch */
+#define APPROX_COL_BLOCK 64
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+ApproxOptions approx_default_options(void) {
+    ApproxOptions opt;
+    opt.method = APPROX_SAMPLING;
+    opt.samples = 0;
+    opt.tolerance = APPROX_DEFAULT_TOLERANCE;
+    opt.seed = APPROX_DEFAULT_SEED;
+    return opt;
+}
+
+/* splitmix64: small, fast and good enough for sampling */
+static unsigned long long next_random(unsigned long long *state) {
+    unsigned long long z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static double next_uniform(unsigned long long *state) {
+    return (double)(next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Squared norms of the columns (cols set) or rows of m. Along the storage
+ * lines each norm is one contiguous pass; across them the lines are summed
+ * into a reduction array.
+ */
+static void squared_norms(const Matrix *m, int cols, double *out, int parallel) {
+    int major = mat_major_count(m), minor = mat_minor_count(m);
+    if (cols == (m->layout == MAT_COL_MAJOR)) {
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int l = 0; l < major; l++) {
+            const double *line = m->data[l];
+            double s = 0.0;
+            #pragma omp simd reduction(+:s)
+            for (int x = 0; x < minor; x++) s += line[x] * line[x];
+            out[l] = s;
+        }
+    } else {
+        memset(out, 0, (size_t)minor * sizeof(double));
+        #pragma omp parallel for schedule(static) reduction(+:out[:minor]) if (parallel)
+        for (int l = 0; l < major; l++) {
+            const double *line = m->data[l];
+            for (int x = 0; x < minor; x++) out[x] += line[x] * line[x];
+        }
+    }
+}
+
+static double frobenius2(const Matrix *c, int parallel) {
+    size_t len = (size_t)c->rows * c->cols;
+    const double *p = c->data[0];
+    double s = 0.0;
+    #pragma omp parallel for simd reduction(+:s) if (parallel)
+    for (size_t t = 0; t < len; t++) s += p[t] * p[t];
+    return s;
+}
+
+/* ===== Sampling ===== */
+
+/* Draw c indices with probability w_i / total; returns the number of
+ * distinct ones, with idx[] and their multiplicities in mult[]
+ */
+static int draw_indices(const double *w, int k, double total, int c, unsigned long long seed,
+                        int *idx, int *mult) {
+    double *cdf = (double *)malloc((size_t)k * sizeof(double));
+    int *count = (int *)calloc((size_t)k, sizeof(int));
+    if (!cdf || !count) { free(cdf); free(count); return -1; }
+    double run = 0.0;
+    for (int i = 0; i < k; i++) { run += w[i]; cdf[i] = run; }
+
+    unsigned long long state = seed;
+    for (int s = 0; s < c; s++) {
+        double u = next_uniform(&state) * total;
+        int lo = 0, hi = k - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] > u) hi = mid; else lo = mid + 1;
+        }
+        while (lo > 0 && w[lo] == 0.0) lo--;    /* rounding at the top end */
+        count[lo]++;
+    }
+    int d = 0;
+    for (int i = 0; i < k; i++) {
+        if (count[i]) { idx[d] = i; mult[d] = count[i]; d++; }
+    }
+    free(cdf);
+    free(count);
+    return d;
+}
+
+static Matrix *approx_sampling(const Matrix *A, const Matrix *B, const char *name, int c,
+                               unsigned long long seed, const double *an2, const double *bn2,
+                               int parallel, ApproxInfo *info) {
+    int m = A->rows, k = A->cols, n = B->cols;
+    double *w = (double *)malloc((size_t)k * sizeof(double));
+    int *idx = (int *)malloc((size_t)k * sizeof(int));
+    int *mult = (int *)malloc((size_t)k * sizeof(int));
+    if (!w || !idx || !mult) { free(w); free(idx); free(mult); return NULL; }
+    double total = 0.0;
+    for (int i = 0; i < k; i++) { w[i] = sqrt(an2[i] * bn2[i]); total += w[i]; }
+
+    Matrix *C = create_matrix(name, m, n);
+    int d = 0;
+    if (C && total > 0.0) d = draw_indices(w, k, total, c, seed, idx, mult);
+    double *As = NULL, *Bs = NULL;
+    if (C && d > 0) {
+        As = (double *)malloc((size_t)m * d * sizeof(double));
+        Bs = (double *)malloc((size_t)d * n * sizeof(double));
+    }
+    if (!C || d < 0 || (d > 0 && (!As || !Bs))) {
+        free_matrix(C); C = NULL;
+        goto done;
+    }
+
+    if (d > 0) {
+        /* A(:,i) * mult / (c p_i) with p_i = w_i / total; w is reused for
+         * the scale of each distinct index
+         */
+        for (int t = 0; t < d; t++) w[t] = (double)mult[t] * total / ((double)c * w[idx[t]]);
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int r = 0; r < m; r++) {
+            double *row = As + (size_t)r * d;
+            for (int t = 0; t < d; t++) row[t] = mat_get(A, r, idx[t]) * w[t];
+        }
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int t = 0; t < d; t++) {
+            for (int j = 0; j < n; j++) Bs[(size_t)t * n + j] = mat_get(B, idx[t], j);
+        }
+        gemm_recursive(m, n, d, 1.0, As, d, Bs, n, C->data[0], n, parallel);
+    }
+
+    if (info) {
+        double c2 = frobenius2(C, parallel);
+        info->samples = c;
+        info->distinct = d;
+        info->error_bound = total / sqrt((double)c);
+        /* E||C||^2 = ||AB||^2 + V and V = (total^2 - ||AB||^2) / c */
+        double v = c > 1 ? (total * total - c2) / (double)(c - 1) : total * total;
+        info->error_estimate = sqrt(v > 0.0 ? v : 0.0);
+        info->relative_error = c2 > 0.0 ? info->error_estimate / sqrt(c2) : 0.0;
+    }
+
+done:
+    free(w); free(idx); free(mult); free(As); free(Bs);
+    return C;
+}
+
+/* ===== Count sketch ===== */
+
+static Matrix *approx_sketch(const Matrix *A, const Matrix *B, const char *name, int c,
+                             unsigned long long seed, const double *an2, const double *bn2,
+                             int parallel, ApproxInfo *info) {
+    int m = A->rows, k = A->cols, n = B->cols;
+    int *bucket = (int *)malloc((size_t)k * sizeof(int));
+    double *sign = (double *)malloc((size_t)k * sizeof(double));
+    double *AS = (double *)calloc((size_t)m * c, sizeof(double));
+    double *SB = (double *)calloc((size_t)c * n, sizeof(double));
+    Matrix *C = create_matrix(name, m, n);
+    if (!bucket || !sign || !AS || !SB || !C) {
+        free_matrix(C); C = NULL;
+        goto done;
+    }
+
+    unsigned long long state = seed;
+    for (int i = 0; i < k; i++) {
+        unsigned long long r = next_random(&state);
+        bucket[i] = (int)((r >> 1) % (unsigned long long)c);
+        sign[i] = (r & 1) ? 1.0 : -1.0;
+    }
+
+    /* A S^T: row r sums sign_i A(r,i) into column bucket_i */
+    #pragma omp parallel for schedule(static) if (parallel)
+    for (int r = 0; r < m; r++) {
+        double *row = AS + (size_t)r * c;
+        for (int i = 0; i < k; i++) row[bucket[i]] += sign[i] * mat_get(A, r, i);
+    }
+    /* S B: rows of B sum into rows of SB; split by column blocks so that
+     * tasks never share an output entry
+     */
+    #pragma omp parallel for schedule(static) if (parallel)
+    for (int j0 = 0; j0 < n; j0 += APPROX_COL_BLOCK) {
+        int j1 = j0 + APPROX_COL_BLOCK < n ? j0 + APPROX_COL_BLOCK : n;
+        for (int i = 0; i < k; i++) {
+            double *out = SB + (size_t)bucket[i] * n;
+            for (int j = j0; j < j1; j++) out[j] += sign[i] * mat_get(B, i, j);
+        }
+    }
+    gemm_recursive(m, n, c, 1.0, AS, c, SB, n, C->data[0], n, parallel);
+
+    if (info) {
+        double fa = 0.0, fb = 0.0, q = 0.0;
+        for (int i = 0; i < k; i++) { fa += an2[i]; fb += bn2[i]; q += an2[i] * bn2[i]; }
+        double c2 = frobenius2(C, parallel);
+        info->samples = c;
+        info->distinct = c;
+        info->error_bound = sqrt(2.0 * fa * fb / (double)c);
+        /* V = (||A||^2 ||B||^2 + ||AB||^2 - 2 q) / c with E||C||^2 = ||AB||^2 + V */
+        double v = (fa * fb + c2 - 2.0 * q) / (double)(c + 1);
+        info->error_estimate = sqrt(v > 0.0 ? v : 0.0);
+        info->relative_error = c2 > 0.0 ? info->error_estimate / sqrt(c2) : 0.0;
+    }
+
+done:
+    free(bucket); free(sign); free(AS); free(SB);
+    return C;
+}
+
+/* ===== Drivers ===== */
+
+static Matrix *approx_multiply(const Matrix *m1, const Matrix *m2, const char *result_name,
+                               const ApproxOptions *opt, ApproxInfo *info, int parallel, double *exec_time) {
+    if (!m1 || !m2 || !result_name) return NULL;
+    if (m1->cols != m2->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return NULL;
+    }
+    ApproxOptions o = opt ? *opt : approx_default_options();
+    if (o.samples < 0 || (o.samples == 0 && !(o.tolerance > 0.0))) {
+        mat_log(MAT_LOG_ERROR, "Error: approximate multiply needs a sample count or a positive tolerance");
+        return NULL;
+    }
+
+    double start = get_time();
+    int k = m1->cols;
+    double *an2 = (double *)malloc((size_t)k * sizeof(double));
+    double *bn2 = (double *)malloc((size_t)k * sizeof(double));
+    if (!an2 || !bn2) { free(an2); free(bn2); return NULL; }
+    squared_norms(m1, 1, an2, parallel);
+    squared_norms(m2, 0, bn2, parallel);
+
+    long c = o.samples;
+    if (c == 0) {
+        double tol2 = o.tolerance * o.tolerance, ratio;
+        if (o.method == APPROX_COUNTSKETCH) {
+            ratio = 2.0 / tol2;
+        } else {
+            /* bound^2 / (||A|| ||B||)^2 = (sum_i ||A_i|| ||B_i||)^2 / (c ||A||^2 ||B||^2) */
+            double s = 0.0, fa = 0.0, fb = 0.0;
+            for (int i = 0; i < k; i++) { s += sqrt(an2[i] * bn2[i]); fa += an2[i]; fb += bn2[i]; }
+            ratio = fa > 0.0 && fb > 0.0 ? s * s / (fa * fb * tol2) : 1.0;
+        }
+        c = ratio < (double)k ? (long)ceil(ratio) : k;
+        if (c < 1) c = 1;
+    }
+
+    Matrix *C;
+    if (c >= k) {
+        double t;
+        C = parallel ? multiply_matrices_openmp(m1, m2, result_name, &t)
+                     : multiply_matrices_single(m1, m2, result_name, &t);
+        if (C && info) {
+            info->samples = k;
+            info->distinct = k;
+            info->error_bound = info->error_estimate = info->relative_error = 0.0;
+        }
+    } else if (o.method == APPROX_COUNTSKETCH) {
+        C = approx_sketch(m1, m2, result_name, (int)c, o.seed, an2, bn2, parallel, info);
+    } else {
+        C = approx_sampling(m1, m2, result_name, (int)c, o.seed, an2, bn2, parallel, info);
+    }
+    free(an2);
+    free(bn2);
+    if (C && exec_time) *exec_time = get_time() - start;
+    return C;
+}
+
+Matrix* multiply_matrices_approx_single(const Matrix* m1, const Matrix* m2, const char* result_name,
+                                        const ApproxOptions* opt, ApproxInfo* info, double* exec_time) {
+    return approx_multiply(m1, m2, result_name, opt, info, 0, exec_time);
+}
+
+Matrix* multiply_matrices_approx_openmp(const Matrix* m1, const Matrix* m2, const char* result_name,
+                                        const ApproxOptions* opt, ApproxInfo* info, double* exec_time) {
+    return approx_multiply(m1, m2, result_name, opt, info, 1, exec_time);
+}
@@ -0,0 +1,58 @@
+#ifndef MATRIX_APPROX_H
+#define MATRIX_APPROX_H
+
+#include "matrix_types.h"
+
+/*
+ * Approximate product A * B (A m x k, B k x n) for when a few percent of
+ * error is acceptable, at a fraction of the O(mkn) cost.
+ *
+ * - Sampling: c inner indices i are drawn (with replacement) with
+ *   probability p_i proportional to ||A(:,i)|| * ||B(i,:)||, and
+ *   C = sum over the draws of A(:,i) B(i,:) / (c p_i). C is unbiased and
+ *       E ||AB - C||_F^2 <= (sum_i ||A(:,i)|| ||B(i,:)||)^2 / c.
+ * - Count sketch: every inner index is hashed to one of c buckets with a
+ *   random sign, C = (A S^T)(S B). Forming A S^T and S B reads each
+ *   operand once, and
+ *       E ||AB - C||_F^2 <= 2 ||A||_F^2 ||B||_F^2 / c.
+ *
+ * Both finish with one m x c by c x n GEMM, so the cost is O(mcn) plus a
+ * pass over the operands. For c = k/10 ... k/100 that is 10-100x less work
+ * than the exact product.
+ */
+
+typedef enum {
+    APPROX_SAMPLING = 0,    /* norm-proportional column/row pairs */
+    APPROX_COUNTSKETCH      /* hashed signed sums of columns/rows */
+} ApproxMethod;
+
+typedef struct {
+    ApproxMethod method;
+    int samples;            /* c; 0: derived from tolerance */
+    double tolerance;       /* target RMS error relative to ||A||_F ||B||_F */
+    unsigned long long seed;
+} ApproxOptions;
+
+/* Sampling, samples derived from a 5% tolerance, fixed seed */
+ApproxOptions approx_default_options(void);
+
+typedef struct {
+    int samples;            /* c actually used; k means the product is exact */
+    int distinct;           /* distinct inner indices (sampling) or buckets */
+    double error_bound;     /* bound on sqrt(E ||AB - C||_F^2), a priori */
+    double error_estimate;  /* same quantity estimated from this C */
+    double relative_error;  /* error_estimate / ||C||_F */
+} ApproxInfo;
+
+/* C ~ m1 * m2 (either layouts; result row-major). With c >= k the exact
+ * product of multiply_matrices_single/openmp is returned instead. By
+ * Markov, ||AB - C||_F <= error_bound / sqrt(d) with probability at least
+ * 1 - d. info is optional; opt NULL uses the defaults. Returns NULL on a
+ * dimension mismatch or allocation failure.
+ */
+Matrix* multiply_matrices_approx_single(const Matrix* m1, const Matrix* m2, const char* result_name,
+                                        const ApproxOptions* opt, ApproxInfo* info, double* exec_time);
+Matrix* multiply_matrices_approx_openmp(const Matrix* m1, const Matrix* m2, const char* result_name,
+                                        const ApproxOptions* opt, ApproxInfo* info, double* exec_time);
+
+#endif /* MATRIX_APPROX_H */
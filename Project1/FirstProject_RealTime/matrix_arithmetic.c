@@ -1,4 +1,5 @@
 #include "matrix_arithmetic.h"
+#include "matrix_log.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,14 +9,14 @@
  */
 Matrix* add_matrices(const Matrix* m1, const Matrix* m2, const char* result_name) {
     if (!m1 || !m2 || !result_name) {
-        fprintf(stderr, "Error: NULL parameter in add_matrices\n");
+        mat_log(MAT_LOG_ERROR, "Error: NULL parameter in add_matrices");
         return NULL;
     }
     
     // Check dimensions compatibility
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for addition\n");
-        fprintf(stderr, "Matrix '%s' is %dx%d, Matrix '%s' is %dx%d\n",
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for addition");
+        mat_log(MAT_LOG_ERROR, "Matrix '%s' is %dx%d, Matrix '%s' is %dx%d",
                 m1->name, m1->rows, m1->cols, m2->name, m2->rows, m2->cols);
         return NULL;
     }
@@ -23,19 +24,19 @@ Matrix* add_matrices(const Matrix* m1, const Matrix* m2, const char* result_name
     // Create result matrix
     Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
     if (!result) {
-        fprintf(stderr, "Error: Failed to create result matrix\n");
+        mat_log(MAT_LOG_ERROR, "Error: Failed to create result matrix");
         return NULL;
     }
     
     // Perform addition
     for (int i = 0; i < m1->rows; i++) {
         for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] + m2->data[i][j];
+            result->data[i][j] = mat_get(m1, i, j) + mat_get(m2, i, j);
         }
     }
     
-    printf("Matrix addition successful: '%s' + '%s' = '%s' (%dx%d)\n",
-           m1->name, m2->name, result->name, result->rows, result->cols);
+    mat_log(MAT_LOG_INFO, "Matrix addition successful: '%s' + '%s' = '%s' (%dx%d)",
+            m1->name, m2->name, result->name, result->rows, result->cols);
     
     return result;
 }
@@ -45,14 +46,14 @@ Matrix* add_matrices(const Matrix* m1, const Matrix* m2, const char* result_name
  */
 Matrix* subtract_matrices(const Matrix* m1, const Matrix* m2, const char* result_name) {
     if (!m1 || !m2 || !result_name) {
-        fprintf(stderr, "Error: NULL parameter in subtract_matrices\n");
+        mat_log(MAT_LOG_ERROR, "Error: NULL parameter in subtract_matrices");
         return NULL;
     }
     
     // Check dimensions compatibility
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for subtraction\n");
-        fprintf(stderr, "Matrix '%s' is %dx%d, Matrix '%s' is %dx%d\n",
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for subtraction");
+        mat_log(MAT_LOG_ERROR, "Matrix '%s' is %dx%d, Matrix '%s' is %dx%d",
                 m1->name, m1->rows, m1->cols, m2->name, m2->rows, m2->cols);
         return NULL;
     }
@@ -60,19 +61,19 @@ Matrix* subtract_matrices(const Matrix* m1, const Matrix* m2, const char* result
     // Create result matrix
     Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
     if (!result) {
-        fprintf(stderr, "Error: Failed to create result matrix\n");
+        mat_log(MAT_LOG_ERROR, "Error: Failed to create result matrix");
         return NULL;
     }
     
     // Perform subtraction
     for (int i = 0; i < m1->rows; i++) {
         for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] - m2->data[i][j];
+            result->data[i][j] = mat_get(m1, i, j) - mat_get(m2, i, j);
         }
     }
     
-    printf("Matrix subtraction successful: '%s' - '%s' = '%s' (%dx%d)\n",
-           m1->name, m2->name, result->name, result->rows, result->cols);
+    mat_log(MAT_LOG_INFO, "Matrix subtraction successful: '%s' - '%s' = '%s' (%dx%d)",
+            m1->name, m2->name, result->name, result->rows, result->cols);
     
     return result;
 }
@@ -82,23 +83,23 @@ Matrix* subtract_matrices(const Matrix* m1, const Matrix* m2, const char* result
  */
 Matrix* multiply_matrices(const Matrix* m1, const Matrix* m2, const char* result_name) {
     if (!m1 || !m2 || !result_name) {
-        fprintf(stderr, "Error: NULL parameter in multiply_matrices\n");
+        mat_log(MAT_LOG_ERROR, "Error: NULL parameter in multiply_matrices");
         return NULL;
     }
     
     // Check dimensions compatibility (m1 cols must equal m2 rows)
     if (m1->cols != m2->rows) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for multiplication\n");
-        fprintf(stderr, "Matrix '%s' has %d columns, Matrix '%s' has %d rows\n",
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        mat_log(MAT_LOG_ERROR, "Matrix '%s' has %d columns, Matrix '%s' has %d rows",
                 m1->name, m1->cols, m2->name, m2->rows);
-        fprintf(stderr, "For multiplication, columns of first matrix must equal rows of second matrix\n");
+        mat_log(MAT_LOG_ERROR, "For multiplication, columns of first matrix must equal rows of second matrix");
         return NULL;
     }
     
     // Create result matrix (rows from m1, cols from m2)
     Matrix* result = create_matrix(result_name, m1->rows, m2->cols);
     if (!result) {
-        fprintf(stderr, "Error: Failed to create result matrix\n");
+        mat_log(MAT_LOG_ERROR, "Error: Failed to create result matrix");
         return NULL;
     }
     
@@ -107,14 +108,14 @@ Matrix* multiply_matrices(const Matrix* m1, const Matrix* m2, const char* result
         for (int j = 0; j < m2->cols; j++) {
             double sum = 0.0;
             for (int k = 0; k < m1->cols; k++) {
-                sum += m1->data[i][k] * m2->data[k][j];
+                sum += mat_get(m1, i, k) * mat_get(m2, k, j);
             }
             result->data[i][j] = sum;
         }
     }
     
-    printf("Matrix multiplication successful: '%s' × '%s' = '%s' (%dx%d)\n",
-           m1->name, m2->name, result->name, result->rows, result->cols);
+    mat_log(MAT_LOG_INFO, "Matrix multiplication successful: '%s' × '%s' = '%s' (%dx%d)",
+            m1->name, m2->name, result->name, result->rows, result->cols);
     
     return result;
 }
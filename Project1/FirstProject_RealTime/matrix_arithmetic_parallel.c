@@ -1,4 +1,6 @@
 #include "matrix_arithmetic_parallel.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -7,6 +9,7 @@
 #include <sys/wait.h>
 #include <signal.h>
 #include <omp.h>
+#include <errno.h>
 
 // Get current time in seconds
 static double get_time() {
@@ -15,6 +18,117 @@ static double get_time() {
     return tv.tv_sec + tv.tv_usec / 1000000.0;
 }
 
+// ============================================================================
+// LAYOUT-AWARE LOOPS
+// ============================================================================
+
+// result = m1 + m2 or m1 - m2, line by line in m1's storage order (result has
+// m1's layout). When m2 is stored the other way, m2->data[l][k] is the
+// element at the same position as m1->data[k][l].
+static void elementwise_lines(Matrix* result, const Matrix* m1, const Matrix* m2, int subtract, int parallel) {
+    int major = mat_major_count(m1), minor = mat_minor_count(m1);
+    int same = (m1->layout == m2->layout);
+    #pragma omp parallel for collapse(2) schedule(static) if (parallel)
+    for (int k = 0; k < major; k++) {
+        for (int l = 0; l < minor; l++) {
+            double b = same ? m2->data[k][l] : m2->data[l][k];
+            result->data[k][l] = subtract ? m1->data[k][l] - b : m1->data[k][l] + b;
+        }
+    }
+}
+
+// Layout the product is stored in: column-major only when both factors are,
+// so every case below streams over contiguous lines
+static MatrixLayout product_layout(const Matrix* m1, const Matrix* m2) {
+    return (m1->layout == MAT_COL_MAJOR && m2->layout == MAT_COL_MAJOR) ? MAT_COL_MAJOR : MAT_ROW_MAJOR;
+}
+
+// result = m1 * m2 with the loop order picked from the operand layouts
+static void multiply_lines(Matrix* result, const Matrix* m1, const Matrix* m2, int parallel) {
+    int n_rows = m1->rows, n_cols = m2->cols, n_inner = m1->cols;
+
+    if (m1->layout == MAT_ROW_MAJOR && m2->layout == MAT_COL_MAJOR) {
+        // Row of m1 and column of m2 are both contiguous: plain dot products
+        #pragma omp parallel for collapse(2) schedule(static) if (parallel)
+        for (int i = 0; i < n_rows; i++) {
+            for (int j = 0; j < n_cols; j++) {
+                const double* a = m1->data[i];
+                const double* b = m2->data[j];
+                double sum = 0.0;
+                for (int k = 0; k < n_inner; k++) sum += a[k] * b[k];
+                result->data[i][j] = sum;
+            }
+        }
+    } else if (m2->layout == MAT_ROW_MAJOR) {
+        // Result row i accumulates scaled rows of m2 (i-k-j order)
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int i = 0; i < n_rows; i++) {
+            double* c = result->data[i];
+            for (int k = 0; k < n_inner; k++) {
+                double s = mat_get(m1, i, k);
+                const double* b = m2->data[k];
+                for (int j = 0; j < n_cols; j++) c[j] += s * b[j];
+            }
+        }
+    } else {
+        // Both column-major: result column j accumulates scaled columns of m1
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int j = 0; j < n_cols; j++) {
+            double* c = result->data[j];
+            for (int k = 0; k < n_inner; k++) {
+                double s = m2->data[j][k];
+                const double* a = m1->data[k];
+                for (int i = 0; i < n_rows; i++) c[i] += s * a[i];
+            }
+        }
+    }
+}
+
+// ============================================================================
+// PROCESS WORKERS
+// ============================================================================
+
+typedef enum { ELEMENT_ADD, ELEMENT_SUB, ELEMENT_MUL } ElementOp;
+
+typedef struct {
+    const Matrix* m1;
+    const Matrix* m2;
+    int cols;       // columns of the result
+    ElementOp op;
+} ElementJob;
+
+// Child process body: compute result element task = i * cols + j
+static void element_task(void* ctx, int task, double* out) {
+    const ElementJob* job = (const ElementJob*)ctx;
+    int i = task / job->cols, j = task % job->cols;
+    if (job->op == ELEMENT_MUL) {
+        double sum = 0.0;
+        for (int k = 0; k < job->m1->cols; k++) {
+            sum += mat_get(job->m1, i, k) * mat_get(job->m2, k, j);
+        }
+        *out = sum;
+    } else if (job->op == ELEMENT_SUB) {
+        *out = mat_get(job->m1, i, j) - mat_get(job->m2, i, j);
+    } else {
+        *out = mat_get(job->m1, i, j) + mat_get(job->m2, i, j);
+    }
+}
+
+// One child process per result element, started in waves of at most the
+// worker budget (matrix_resources.h) so a large matrix cannot exhaust the
+// process limit. The result is row-major, so element t lands in data[0][t].
+static Matrix* run_element_workers(const Matrix* m1, const Matrix* m2, const char* result_name,
+                                   int rows, int cols, ElementOp op) {
+    Matrix* result = create_matrix(result_name, rows, cols);
+    if (!result) return NULL;
+    ElementJob job = { m1, m2, cols, op };
+    if (!resource_fork_waves(rows * cols, 1, element_task, &job, result->data[0])) {
+        free_matrix(result);
+        return NULL;
+    }
+    return result;
+}
+
 // ============================================================================
 // ADDITION OPERATIONS
 // ============================================================================
@@ -22,21 +136,17 @@ static double get_time() {
 Matrix* add_matrices_single(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for addition\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for addition");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m1->cols, m1->layout);
     if (!result) return NULL;
 
     // Single-threaded computation
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] + m2->data[i][j];
-        }
-    }
+    elementwise_lines(result, m1, m2, 0, 0);
 
     double end = get_time();
     *exec_time = end - start;
@@ -47,22 +157,17 @@ Matrix* add_matrices_single(const Matrix* m1, const Matrix* m2, const char* resu
 Matrix* add_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for addition\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for addition");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m1->cols, m1->layout);
     if (!result) return NULL;
 
     // OpenMP parallelization
-    #pragma omp parallel for collapse(2) schedule(static)
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] + m2->data[i][j];
-        }
-    }
+    elementwise_lines(result, m1, m2, 0, 1);
 
     double end = get_time();
     *exec_time = end - start;
@@ -73,78 +178,14 @@ Matrix* add_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* resu
 Matrix* add_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for addition\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for addition");
         return NULL;
     }
 
     double start = get_time();
-    
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = run_element_workers(m1, m2, result_name, m1->rows, m1->cols, ELEMENT_ADD);
     if (!result) return NULL;
 
-    int total_elements = m1->rows * m1->cols;
-    int pipes[total_elements][2];  // One pipe per element
-    pid_t* pids = malloc(total_elements * sizeof(pid_t));
-    
-    if (!pids) {
-        free_matrix(result);
-        return NULL;
-    }
-
-    // Create one child process per element
-    int elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            if (pipe(pipes[elem_idx]) == -1) {
-                perror("pipe");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
-
-            pid_t pid = fork();
-            if (pid == -1) {
-                perror("fork");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
-
-            if (pid == 0) {
-                // Child process: compute one element
-                close(pipes[elem_idx][0]);  // Close read end
-                
-                double sum = m1->data[i][j] + m2->data[i][j];
-                write(pipes[elem_idx][1], &sum, sizeof(double));
-                
-                close(pipes[elem_idx][1]);
-                exit(0);
-            } else {
-                // Parent process
-                pids[elem_idx] = pid;
-                close(pipes[elem_idx][1]);  // Close write end
-                elem_idx++;
-            }
-        }
-    }
-
-    // Collect results from all children
-    elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            double sum;
-            read(pipes[elem_idx][0], &sum, sizeof(double));
-            result->data[i][j] = sum;
-            close(pipes[elem_idx][0]);
-            
-            // Wait for child
-            waitpid(pids[elem_idx], NULL, 0);
-            elem_idx++;
-        }
-    }
-
-    free(pids);
-
     double end = get_time();
     *exec_time = end - start;
 
@@ -158,21 +199,17 @@ Matrix* add_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char
 Matrix* subtract_matrices_single(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for subtraction\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for subtraction");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m1->cols, m1->layout);
     if (!result) return NULL;
 
     // Single-threaded computation
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] - m2->data[i][j];
-        }
-    }
+    elementwise_lines(result, m1, m2, 1, 0);
 
     double end = get_time();
     *exec_time = end - start;
@@ -183,22 +220,17 @@ Matrix* subtract_matrices_single(const Matrix* m1, const Matrix* m2, const char*
 Matrix* subtract_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for subtraction\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for subtraction");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m1->cols, m1->layout);
     if (!result) return NULL;
 
     // OpenMP parallelization
-    #pragma omp parallel for collapse(2) schedule(static)
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            result->data[i][j] = m1->data[i][j] - m2->data[i][j];
-        }
-    }
+    elementwise_lines(result, m1, m2, 1, 1);
 
     double end = get_time();
     *exec_time = end - start;
@@ -209,77 +241,14 @@ Matrix* subtract_matrices_openmp(const Matrix* m1, const Matrix* m2, const char*
 Matrix* subtract_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->rows != m2->rows || m1->cols != m2->cols) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for subtraction\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for subtraction");
         return NULL;
     }
 
     double start = get_time();
-    
-    Matrix* result = create_matrix(result_name, m1->rows, m1->cols);
+    Matrix* result = run_element_workers(m1, m2, result_name, m1->rows, m1->cols, ELEMENT_SUB);
     if (!result) return NULL;
 
-    int total_elements = m1->rows * m1->cols;
-    int pipes[total_elements][2];
-    pid_t* pids = malloc(total_elements * sizeof(pid_t));
-    
-    if (!pids) {
-        free_matrix(result);
-        return NULL;
-    }
-
-    // Create one child process per element
-    int elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            if (pipe(pipes[elem_idx]) == -1) {
-                perror("pipe");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
-
-            pid_t pid = fork();
-            if (pid == -1) {
-                perror("fork");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
-
-            if (pid == 0) {
-                // Child process: compute one element
-                close(pipes[elem_idx][0]);
-                
-                double diff = m1->data[i][j] - m2->data[i][j];
-                write(pipes[elem_idx][1], &diff, sizeof(double));
-                
-                close(pipes[elem_idx][1]);
-                exit(0);
-            } else {
-                // Parent process
-                pids[elem_idx] = pid;
-                close(pipes[elem_idx][1]);
-                elem_idx++;
-            }
-        }
-    }
-
-    // Collect results from all children
-    elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m1->cols; j++) {
-            double diff;
-            read(pipes[elem_idx][0], &diff, sizeof(double));
-            result->data[i][j] = diff;
-            close(pipes[elem_idx][0]);
-            
-            waitpid(pids[elem_idx], NULL, 0);
-            elem_idx++;
-        }
-    }
-
-    free(pids);
-
     double end = get_time();
     *exec_time = end - start;
 
@@ -293,25 +262,17 @@ Matrix* subtract_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const
 Matrix* multiply_matrices_single(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->cols != m2->rows) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for multiplication\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m2->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m2->cols, product_layout(m1, m2));
     if (!result) return NULL;
 
     // Single-threaded computation
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m2->cols; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < m1->cols; k++) {
-                sum += m1->data[i][k] * m2->data[k][j];
-            }
-            result->data[i][j] = sum;
-        }
-    }
+    multiply_lines(result, m1, m2, 0);
 
     double end = get_time();
     *exec_time = end - start;
@@ -322,26 +283,17 @@ Matrix* multiply_matrices_single(const Matrix* m1, const Matrix* m2, const char*
 Matrix* multiply_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->cols != m2->rows) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for multiplication\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
         return NULL;
     }
 
     double start = get_time();
     
-    Matrix* result = create_matrix(result_name, m1->rows, m2->cols);
+    Matrix* result = create_matrix_layout(result_name, m1->rows, m2->cols, product_layout(m1, m2));
     if (!result) return NULL;
 
     // OpenMP parallelization
-    #pragma omp parallel for collapse(2) schedule(static)
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m2->cols; j++) {
-            double sum = 0.0;
-            for (int k = 0; k < m1->cols; k++) {
-                sum += m1->data[i][k] * m2->data[k][j];
-            }
-            result->data[i][j] = sum;
-        }
-    }
+    multiply_lines(result, m1, m2, 1);
 
     double end = get_time();
     *exec_time = end - start;
@@ -352,84 +304,84 @@ Matrix* multiply_matrices_openmp(const Matrix* m1, const Matrix* m2, const char*
 Matrix* multiply_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time) {
     if (!m1 || !m2 || !result_name) return NULL;
     if (m1->cols != m2->rows) {
-        fprintf(stderr, "Error: Matrix dimensions incompatible for multiplication\n");
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
         return NULL;
     }
 
     double start = get_time();
-    
-    Matrix* result = create_matrix(result_name, m1->rows, m2->cols);
+    Matrix* result = run_element_workers(m1, m2, result_name, m1->rows, m2->cols, ELEMENT_MUL);
     if (!result) return NULL;
 
-    int total_elements = m1->rows * m2->cols;
-    int pipes[total_elements][2];
-    pid_t* pids = malloc(total_elements * sizeof(pid_t));
-    
-    if (!pids) {
-        free_matrix(result);
-        return NULL;
-    }
+    double end = get_time();
+    *exec_time = end - start;
 
-    // Create one child process per result element
-    int elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m2->cols; j++) {
-            if (pipe(pipes[elem_idx]) == -1) {
-                perror("pipe");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
+    return result;
+}
 
-            pid_t pid = fork();
-            if (pid == -1) {
-                perror("fork");
-                free(pids);
-                free_matrix(result);
-                return NULL;
-            }
+// ============================================================================
+// GENERAL MULTIPLY (ALPHA, BETA, EPILOGUE)
+// ============================================================================
 
-            if (pid == 0) {
-                // Child process: compute one element (row i × column j)
-                close(pipes[elem_idx][0]);
-                
-                double sum = 0.0;
-                for (int k = 0; k < m1->cols; k++) {
-                    sum += m1->data[i][k] * m2->data[k][j];
-                }
-                
-                write(pipes[elem_idx][1], &sum, sizeof(double));
-                close(pipes[elem_idx][1]);
-                exit(0);
-            } else {
-                // Parent process
-                pids[elem_idx] = pid;
-                close(pipes[elem_idx][1]);
-                elem_idx++;
-            }
-        }
+// m, or a copy of it in the given layout (*copy is set when one was made)
+static const Matrix* in_layout(const Matrix* m, MatrixLayout layout, Matrix** copy) {
+    *copy = NULL;
+    if (m->layout == layout) return m;
+    *copy = copy_matrix_layout(m, m->name, layout);
+    return *copy;
+}
+
+// gemm_recursive_ex works on row-major buffers. A column-major c is the
+// row-major buffer of c^T = m2^T * m1^T, where the column-major buffers of
+// m2 and m1 are m2^T and m1^T; a bias along c's rows runs along c^T's columns.
+static int gemm_lines(double alpha, const Matrix* m1, const Matrix* m2, double beta, Matrix* c,
+                      const GemmEpilogue* epi, int parallel) {
+    if (!m1 || !m2 || !c) return 0;
+    if (m1->cols != m2->rows || c->rows != m1->rows || c->cols != m2->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return 0;
+    }
+    if (c == m1 || c == m2) {
+        mat_log(MAT_LOG_ERROR, "Error: GEMM result must not be one of its operands");
+        return 0;
     }
 
-    // Collect results from all children
-    elem_idx = 0;
-    for (int i = 0; i < m1->rows; i++) {
-        for (int j = 0; j < m2->cols; j++) {
-            double product;
-            read(pipes[elem_idx][0], &product, sizeof(double));
-            result->data[i][j] = product;
-            close(pipes[elem_idx][0]);
-            
-            waitpid(pids[elem_idx], NULL, 0);
-            elem_idx++;
+    Matrix *copy1, *copy2;
+    const Matrix* a = in_layout(m1, c->layout, &copy1);
+    const Matrix* b = in_layout(m2, c->layout, &copy2);
+    if (!a || !b) { free_matrix(copy1); free_matrix(copy2); return 0; }
+
+    int m = c->rows, n = c->cols, k = m1->cols;
+    if (c->layout == MAT_ROW_MAJOR) {
+        gemm_recursive_ex(m, n, k, alpha, a->data[0], (int)a->row_stride, b->data[0], (int)b->row_stride,
+                          beta, c->data[0], (int)c->row_stride, epi, parallel);
+    } else {
+        GemmEpilogue flipped;
+        if (epi) {
+            flipped = *epi;
+            flipped.bias_per_row = !epi->bias_per_row;
         }
+        gemm_recursive_ex(n, m, k, alpha, b->data[0], (int)b->col_stride, a->data[0], (int)a->col_stride,
+                          beta, c->data[0], (int)c->col_stride, epi ? &flipped : NULL, parallel);
     }
+    free_matrix(copy1);
+    free_matrix(copy2);
+    return 1;
+}
 
-    free(pids);
-
-    double end = get_time();
-    *exec_time = end - start;
+int gemm_matrices_single(double alpha, const Matrix* m1, const Matrix* m2, double beta, Matrix* c,
+                         const GemmEpilogue* epi, double* exec_time) {
+    double start = get_time();
+    if (!gemm_lines(alpha, m1, m2, beta, c, epi, 0)) return 0;
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
 
-    return result;
+int gemm_matrices_openmp(double alpha, const Matrix* m1, const Matrix* m2, double beta, Matrix* c,
+                         const GemmEpilogue* epi, double* exec_time) {
+    double start = get_time();
+    if (!gemm_lines(alpha, m1, m2, beta, c, epi, 1)) return 0;
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
 }
 
 // ============================================================================
@@ -440,17 +392,18 @@ Matrix* run_operation_comparison(const Matrix* m1, const Matrix* m2, const char*
                                   const char* operation, PerformanceMetrics* metrics) {
     if (!m1 || !m2 || !result_name || !operation || !metrics) return NULL;
 
-    printf("\n========================================\n");
-    printf("Performance Comparison: %s\n", operation);
-    printf("Matrix 1: %s (%dx%d), Matrix 2: %s (%dx%d)\n", 
-           m1->name, m1->rows, m1->cols, m2->name, m2->rows, m2->cols);
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: %s", operation);
+    mat_log(MAT_LOG_INFO, "Matrix 1: %s (%dx%d), Matrix 2: %s (%dx%d)", 
+            m1->name, m1->rows, m1->cols, m2->name, m2->rows, m2->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
 
     Matrix *result1 = NULL, *result2 = NULL, *result3 = NULL;
     char temp_name[128];
 
     // Method 1: Single-threaded
-    printf("[1/3] Running Single-threaded method...\n");
+    mat_log(MAT_LOG_INFO, "[1/3] Running Single-threaded method...");
     snprintf(temp_name, sizeof(temp_name), "%s_single", result_name);
     if (strcmp(operation, "Addition") == 0) {
         result1 = add_matrices_single(m1, m2, temp_name, &metrics->single_thread_time);
@@ -459,10 +412,10 @@ Matrix* run_operation_comparison(const Matrix* m1, const Matrix* m2, const char*
     } else if (strcmp(operation, "Multiplication") == 0) {
         result1 = multiply_matrices_single(m1, m2, temp_name, &metrics->single_thread_time);
     }
-    printf("   ✓ Completed in %.6f seconds\n\n", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->single_thread_time);
 
     // Method 2: OpenMP
-    printf("[2/3] Running OpenMP method...\n");
+    mat_log(MAT_LOG_INFO, "[2/3] Running OpenMP method...");
     snprintf(temp_name, sizeof(temp_name), "%s_openmp", result_name);
     if (strcmp(operation, "Addition") == 0) {
         result2 = add_matrices_openmp(m1, m2, temp_name, &metrics->openmp_time);
@@ -471,11 +424,11 @@ Matrix* run_operation_comparison(const Matrix* m1, const Matrix* m2, const char*
     } else if (strcmp(operation, "Multiplication") == 0) {
         result2 = multiply_matrices_openmp(m1, m2, temp_name, &metrics->openmp_time);
     }
-    printf("   ✓ Completed in %.6f seconds\n", metrics->openmp_time);
-    printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
 
     // Method 3: Multiprocessing
-    printf("[3/3] Running Multiprocessing method...\n");
+    mat_log(MAT_LOG_INFO, "[3/3] Running Multiprocessing method...");
     snprintf(temp_name, sizeof(temp_name), "%s_multiproc", result_name);
     if (strcmp(operation, "Addition") == 0) {
         result3 = add_matrices_multiprocess(m1, m2, temp_name, &metrics->multiprocess_time);
@@ -484,23 +437,23 @@ Matrix* run_operation_comparison(const Matrix* m1, const Matrix* m2, const char*
     } else if (strcmp(operation, "Multiplication") == 0) {
         result3 = multiply_matrices_multiprocess(m1, m2, temp_name, &metrics->multiprocess_time);
     }
-    printf("   ✓ Completed in %.6f seconds\n", metrics->multiprocess_time);
-    printf("   Speedup: %.2fx\n\n", metrics->single_thread_time / metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
 
     // Summary
-    printf("========================================\n");
-    printf("PERFORMANCE SUMMARY\n");
-    printf("========================================\n");
-    printf("Single-threaded:   %.6f s (baseline)\n", metrics->single_thread_time);
-    printf("OpenMP:            %.6f s (%.2fx %s)\n", 
-           metrics->openmp_time, 
-           metrics->single_thread_time / metrics->openmp_time,
-           metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
-    printf("Multiprocessing:   %.6f s (%.2fx %s)\n", 
-           metrics->multiprocess_time,
-           metrics->single_thread_time / metrics->multiprocess_time,
-           metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
-    printf("========================================\n\n");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Single-threaded:   %.6f s (baseline)", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "OpenMP:            %.6f s (%.2fx %s)", 
+            metrics->openmp_time, 
+            metrics->single_thread_time / metrics->openmp_time,
+            metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Multiprocessing:   %.6f s (%.2fx %s)", 
+            metrics->multiprocess_time,
+            metrics->single_thread_time / metrics->multiprocess_time,
+            metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "========================================\n");
 
     // Determine fastest method
     const char* fastest = "Single-threaded";
@@ -518,7 +471,7 @@ Matrix* run_operation_comparison(const Matrix* m1, const Matrix* m2, const char*
         fastest_result = result3;
     }
 
-    printf("★ Fastest method: %s (%.6f s)\n\n", fastest, fastest_time);
+    mat_log(MAT_LOG_INFO, "★ Fastest method: %s (%.6f s)\n", fastest, fastest_time);
 
     // Clean up temporary results (keep the fastest one to return)
     if (result1 && result1 != fastest_result) free_matrix(result1);
@@ -2,6 +2,7 @@
 #define MATRIX_ARITHMETIC_PARALLEL_H
 
 #include "matrix_types.h"
+#include "matrix_gemm.h" /* For GemmEpilogue */
 
 /**
  * Performance comparison structure
@@ -23,7 +24,8 @@ Matrix* add_matrices_single(const Matrix* m1, const Matrix* m2, const char* resu
 Matrix* add_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
 /**
- * Add two matrices using multiprocessing (one child per element)
+ * Add two matrices using multiprocessing (one child per element, at most
+ * resource_budget()->max_workers alive at once)
  */
 Matrix* add_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
@@ -38,7 +40,8 @@ Matrix* subtract_matrices_single(const Matrix* m1, const Matrix* m2, const char*
 Matrix* subtract_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
 /**
- * Subtract two matrices using multiprocessing (one child per element)
+ * Subtract two matrices using multiprocessing (one child per element, at most
+ * resource_budget()->max_workers alive at once)
  */
 Matrix* subtract_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
@@ -53,10 +56,24 @@ Matrix* multiply_matrices_single(const Matrix* m1, const Matrix* m2, const char*
 Matrix* multiply_matrices_openmp(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
 /**
- * Multiply two matrices using multiprocessing (one child per result element)
+ * Multiply two matrices using multiprocessing (one child per result element, at most
+ * resource_budget()->max_workers alive at once)
  */
 Matrix* multiply_matrices_multiprocess(const Matrix* m1, const Matrix* m2, const char* result_name, double* exec_time);
 
+/**
+ * General multiply in place: c = epi(alpha * m1 * m2 + beta * c), any
+ * layouts. Scaling by beta and the epilogue (bias, clamp, custom map; may
+ * be NULL) happen on each tile of c as it is finished, so there is no
+ * separate pass over c. c must not be m1 or m2. An operand whose layout
+ * differs from c's is copied once (O(size) next to O(mnk) work).
+ * Returns 1 on success, 0 on a dimension mismatch or allocation failure.
+ */
+int gemm_matrices_single(double alpha, const Matrix* m1, const Matrix* m2, double beta, Matrix* c,
+                         const GemmEpilogue* epi, double* exec_time);
+int gemm_matrices_openmp(double alpha, const Matrix* m1, const Matrix* m2, double beta, Matrix* c,
+                         const GemmEpilogue* epi, double* exec_time);
+
 /**
  * Run all three methods and compare performance
  */
@@ -0,0 +1,53 @@
+#ifndef MATRIX_BAND_H
+#define MATRIX_BAND_H
+
+#include "matrix_types.h"
+#include "matrix_sparse.h"
+#include "matrix_ordering.h"
+
+/*
+ * Banded storage in the LAPACK general band layout: column j of the band
+ * holds A(j - ku .. j + kl, j), so storage and LU cost are O(n (kl + ku))
+ * and O(n kl (kl + ku)) instead of O(n^2) and O(n^3). The kl extra rows at
+ * the top receive the fill from row interchanges during factorization.
+ *
+ * The conversion reorders first (RCM by default), since the bandwidth of a
+ * matrix as numbered is often far larger than it needs to be. The band
+ * then holds P A P^T, which has the same determinant as A.
+ */
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int n;
+    int kl, ku;             /* sub- and superdiagonals */
+    int ldab;               /* 2 kl + ku + 1 */
+    double *ab;             /* ldab x n, column-major; see band_entry() */
+    int *perm;              /* row/column k is k = perm[k] of the source; NULL: identity */
+    int kl_source;          /* bandwidths before reordering */
+    int ku_source;
+} BandMatrix;
+
+/* Position of A(i, j) (|i - j| within the band) in b->ab */
+#define band_entry(b, i, j) ((b)->ab[(size_t)(j) * (b)->ldab + (b)->kl + (b)->ku + (i) - (j)])
+
+/* Band copy of square s after the given symmetric ordering (ORDER_NATURAL
+ * keeps the numbering). Returns NULL if s is not square or on allocation
+ * failure.
+ */
+BandMatrix *sparse_to_band(const SparseMatrix *s, OrderingMethod ordering, const char *name);
+
+/* Same from a dense matrix (exact zeros are outside the band) */
+BandMatrix *dense_to_band(const Matrix *m, OrderingMethod ordering, const char *name);
+
+void free_band_matrix(BandMatrix *b);
+
+/* The (reordered) band as a dense row-major matrix */
+Matrix *band_to_dense(const BandMatrix *b);
+
+/* det by banded LU with partial pivoting on a copy of the band. log_abs_det
+ * (optional) receives log |det|, which stays finite when det overflows.
+ * Returns 0 on allocation failure.
+ */
+int band_determinant(const BandMatrix *b, double *out_det, double *log_abs_det, double *exec_time);
+
+#endif /* MATRIX_BAND_H */
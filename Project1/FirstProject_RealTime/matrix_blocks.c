@@ -0,0 +1,651 @@
+#include "matrix_blocks.h"
+#include "determinant_parallel.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* Kernel used for one block */
+enum { BLOCK_SINGLE = 0, BLOCK_OPENMP };
+
+/* ===== Structure ===== */
+
+/* Tarjan's algorithm without recursion over the graph (ptr, idx). Tarjan
+ * completes sink components first, so numbering blocks in reverse puts
+ * every edge i -> j at or above the diagonal block of i.
+ */
+static BlockStructure *strong_components(int n, const long *ptr, const int *idx) {
+    BlockStructure *bs = (BlockStructure *)calloc(1, sizeof(BlockStructure));
+    int *index = (int *)malloc((size_t)n * sizeof(int));
+    int *low = (int *)malloc((size_t)n * sizeof(int));
+    int *comp = (int *)malloc((size_t)n * sizeof(int));
+    int *stack = (int *)malloc((size_t)n * sizeof(int));
+    int *call = (int *)malloc((size_t)n * sizeof(int));
+    long *edge = (long *)malloc((size_t)n * sizeof(long));
+    char *on_stack = (char *)calloc((size_t)n, 1);
+    if (bs) {
+        bs->perm = (int *)malloc((size_t)n * sizeof(int));
+        bs->block_ptr = (int *)calloc((size_t)n + 1, sizeof(int));
+    }
+    if (!bs || !index || !low || !comp || !stack || !call || !edge || !on_stack || !bs->perm || !bs->block_ptr) {
+        free(index); free(low); free(comp); free(stack); free(call); free(edge); free(on_stack);
+        free_block_structure(bs);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) index[i] = -1;
+    int counter = 0, ncomp = 0, sp = 0;
+    for (int r = 0; r < n; r++) {
+        if (index[r] >= 0) continue;
+        int depth = 0;
+        call[0] = r;
+        edge[0] = ptr[r];
+        index[r] = low[r] = counter++;
+        stack[sp++] = r;
+        on_stack[r] = 1;
+        while (depth >= 0) {
+            int v = call[depth];
+            if (edge[depth] < ptr[v + 1]) {
+                int w = idx[edge[depth]++];
+                if (index[w] < 0) {
+                    index[w] = low[w] = counter++;
+                    stack[sp++] = w;
+                    on_stack[w] = 1;
+                    call[++depth] = w;
+                    edge[depth] = ptr[w];
+                } else if (on_stack[w] && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+            if (low[v] == index[v]) {
+                int w;
+                do {
+                    w = stack[--sp];
+                    on_stack[w] = 0;
+                    comp[w] = ncomp;
+                } while (w != v);
+                ncomp++;
+            }
+            if (--depth >= 0 && low[v] < low[call[depth]]) low[call[depth]] = low[v];
+        }
+    }
+
+    bs->n = n;
+    bs->nblocks = ncomp;
+    for (int i = 0; i < n; i++) {
+        comp[i] = ncomp - 1 - comp[i];
+        bs->block_ptr[comp[i] + 1]++;
+    }
+    for (int b = 0; b < ncomp; b++) {
+        int size = bs->block_ptr[b + 1];
+        if (size > bs->largest) bs->largest = size;
+        bs->block_ptr[b + 1] += bs->block_ptr[b];
+    }
+    memcpy(stack, bs->block_ptr, (size_t)ncomp * sizeof(int));
+    for (int i = 0; i < n; i++) bs->perm[stack[comp[i]]++] = i;
+    for (int i = 0; i < n && !bs->coupled; i++) {
+        for (long p = ptr[i]; p < ptr[i + 1]; p++) {
+            if (comp[idx[p]] != comp[i]) { bs->coupled = 1; break; }
+        }
+    }
+
+    free(index); free(low); free(comp); free(stack); free(call); free(edge); free(on_stack);
+    return bs;
+}
+
+BlockStructure *matrix_block_structure(const Matrix *m) {
+    if (!m || m->rows != m->cols || m->rows <= 0) return NULL;
+    int n = m->rows;
+    long *ptr = (long *)calloc((size_t)n + 1, sizeof(long));
+    if (!ptr) return NULL;
+    for (int i = 0; i < n; i++) {
+        long count = 0;
+        for (int j = 0; j < n; j++) count += (j != i && mat_get(m, i, j) != 0.0);
+        ptr[i + 1] = ptr[i] + count;
+    }
+    int *idx = (int *)malloc((size_t)(ptr[n] > 0 ? ptr[n] : 1) * sizeof(int));
+    if (!idx) { free(ptr); return NULL; }
+    for (int i = 0; i < n; i++) {
+        long p = ptr[i];
+        for (int j = 0; j < n; j++) {
+            if (j != i && mat_get(m, i, j) != 0.0) idx[p++] = j;
+        }
+    }
+    BlockStructure *bs = strong_components(n, ptr, idx);
+    free(ptr);
+    free(idx);
+    return bs;
+}
+
+BlockStructure *sparse_block_structure(const SparseMatrix *s) {
+    if (!s || s->rows != s->cols) return NULL;
+    return strong_components(s->rows, s->row_ptr, s->col_idx);
+}
+
+void free_block_structure(BlockStructure *bs) {
+    if (!bs) return;
+    free(bs->perm);
+    free(bs->block_ptr);
+    free(bs);
+}
+
+Matrix *extract_diagonal_block(const Matrix *m, const BlockStructure *bs, int b, const char *name) {
+    if (!m || !bs || b < 0 || b >= bs->nblocks) return NULL;
+    int lo = bs->block_ptr[b], size = bs->block_ptr[b + 1] - lo;
+    Matrix *blk = create_matrix(name, size, size);
+    if (!blk) return NULL;
+    for (int r = 0; r < size; r++) {
+        for (int c = 0; c < size; c++) blk->data[r][c] = mat_get(m, bs->perm[lo + r], bs->perm[lo + c]);
+    }
+    return blk;
+}
+
+/* ===== Scheduling ===== */
+
+static int block_size(const BlockStructure *bs, int b) {
+    return bs->block_ptr[b + 1] - bs->block_ptr[b];
+}
+
+static int cmp_desc(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x < y) - (x > y);
+}
+
+/* Blocks in order of decreasing size. *dominant (optional) is the number
+ * of leading blocks (0 or 1) heavy enough to get a parallel kernel of
+ * their own.
+ */
+static int *largest_first(const BlockStructure *bs, int *dominant) {
+    int *order = (int *)malloc((size_t)bs->nblocks * sizeof(int));
+    long long *keys = (long long *)malloc((size_t)bs->nblocks * sizeof(long long));
+    if (!order || !keys) { free(order); free(keys); return NULL; }
+    double total = 0.0;
+    for (int b = 0; b < bs->nblocks; b++) {
+        double s = block_size(bs, b);
+        total += s * s * s;
+        keys[b] = ((long long)block_size(bs, b) << 32) | (long long)b;
+    }
+    qsort(keys, (size_t)bs->nblocks, sizeof(long long), cmp_desc);
+    for (int b = 0; b < bs->nblocks; b++) order[b] = (int)(keys[b] & 0xffffffffLL);
+    double big = bs->largest;
+    if (dominant) *dominant = big > 1 && big * big * big > 0.5 * total;
+    free(keys);
+    return order;
+}
+
+/* Longest-processing-time packing of the blocks (largest first in order)
+ * onto at most bins workers: bin k holds packed[bin_ptr[k] .. bin_ptr[k+1])
+ */
+static int pack_bins(const BlockStructure *bs, const int *order, int bins, int **packed, int **bin_ptr) {
+    int count = bs->nblocks;
+    if (bins > count) bins = count;
+    double *load = (double *)calloc((size_t)bins, sizeof(double));
+    int *bin_of = (int *)malloc((size_t)count * sizeof(int));
+    *packed = (int *)malloc((size_t)count * sizeof(int));
+    *bin_ptr = (int *)calloc((size_t)bins + 1, sizeof(int));
+    if (!load || !bin_of || !*packed || !*bin_ptr) {
+        free(load); free(bin_of); free(*packed); free(*bin_ptr);
+        *packed = *bin_ptr = NULL;
+        return 0;
+    }
+    for (int t = 0; t < count; t++) {
+        int best = 0;
+        for (int k = 1; k < bins; k++) if (load[k] < load[best]) best = k;
+        double s = block_size(bs, order[t]);
+        load[best] += s * s * s;
+        bin_of[t] = best;
+        (*bin_ptr)[best + 1]++;
+    }
+    for (int k = 0; k < bins; k++) (*bin_ptr)[k + 1] += (*bin_ptr)[k];
+    for (int k = 0; k < bins; k++) load[k] = (*bin_ptr)[k];
+    for (int t = 0; t < count; t++) (*packed)[(int)load[bin_of[t]]++] = order[t];
+    free(load);
+    free(bin_of);
+    return bins;
+}
+
+static int worker_count(void) {
+    int w = resource_budget()->max_workers;
+    return w > 0 ? w : 1;
+}
+
+/* ===== Determinant ===== */
+
+static int block_determinant(const Matrix *m, const BlockStructure *bs, int b, int kernel, double *det) {
+    int lo = bs->block_ptr[b];
+    if (block_size(bs, b) == 1) {
+        *det = mat_get(m, bs->perm[lo], bs->perm[lo]);
+        return 1;
+    }
+    Matrix *blk = extract_diagonal_block(m, bs, b, "block");
+    if (!blk) return 0;
+    double t = 0.0;
+    int ok;
+    switch (kernel) {
+        case BLOCK_OPENMP:       ok = determinant_openmp(blk, det, &t); break;
+        default:                 ok = determinant_single(blk, det, &t); break;
+    }
+    free_matrix(blk);
+    return ok;
+}
+
+/* Finds the structure when the caller did not pass one */
+static const BlockStructure *ensure_structure(const Matrix *m, const BlockStructure *bs, BlockStructure **owned) {
+    *owned = NULL;
+    if (bs) return bs->n == m->rows ? bs : NULL;
+    *owned = matrix_block_structure(m);
+    return *owned;
+}
+
+int determinant_blocks_single(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time) {
+    if (!m || !out_det || m->rows != m->cols) return 0;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return 0;
+
+    double det = 1.0;
+    int ok = 1;
+    for (int b = 0; b < bs->nblocks && ok; b++) {
+        double d = 0.0;
+        ok = block_determinant(m, bs, b, BLOCK_SINGLE, &d);
+        det *= d;
+    }
+    free_block_structure(owned);
+    if (!ok) return 0;
+    *out_det = det;
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
+
+int determinant_blocks_openmp(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time) {
+    if (!m || !out_det || m->rows != m->cols) return 0;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return 0;
+    int dominant;
+    int *order = largest_first(bs, &dominant);
+    if (!order) { free_block_structure(owned); return 0; }
+
+    double det = 1.0;
+    int failed = 0;
+    if (dominant) failed = !block_determinant(m, bs, order[0], BLOCK_OPENMP, &det);
+    if (!failed) {
+        #pragma omp parallel for schedule(dynamic, 1) reduction(*:det) reduction(||:failed)
+        for (int t = dominant; t < bs->nblocks; t++) {
+            double d = 0.0;
+            if (!block_determinant(m, bs, order[t], BLOCK_SINGLE, &d)) failed = 1;
+            det *= d;
+        }
+    }
+    free(order);
+    free_block_structure(owned);
+    if (failed) return 0;
+    *out_det = det;
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
+
+typedef struct {
+    const Matrix *m;
+    const BlockStructure *bs;
+    const int *packed;
+    const int *bin_ptr;
+    int max_iter;           /* eigen jobs only */
+    double tol;
+} BlockJob;
+
+/* Child: out = { ok, product of the bin's block determinants } */
+static void determinant_bin_task(void *ctx, int bin, double *out) {
+    const BlockJob *job = (const BlockJob *)ctx;
+    double det = 1.0;
+    out[0] = 1.0;
+    for (int t = job->bin_ptr[bin]; t < job->bin_ptr[bin + 1]; t++) {
+        double d = 0.0;
+        if (!block_determinant(job->m, job->bs, job->packed[t], BLOCK_SINGLE, &d)) { out[0] = 0.0; break; }
+        det *= d;
+    }
+    out[1] = det;
+}
+
+int determinant_blocks_multiprocess(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time) {
+    if (!m || !out_det || m->rows != m->cols) return 0;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return 0;
+    int *order = largest_first(bs, NULL);
+    int *packed = NULL, *bin_ptr = NULL;
+    double *out = NULL;
+    double det = 1.0;
+    int ok = order != NULL;
+
+    if (ok) {
+        int bins = pack_bins(bs, order, worker_count(), &packed, &bin_ptr);
+        out = bins ? (double *)malloc((size_t)bins * 2 * sizeof(double)) : NULL;
+        BlockJob job = { m, bs, packed, bin_ptr, 0, 0.0 };
+        ok = out && resource_fork_waves(bins, 2, determinant_bin_task, &job, out);
+        for (int k = 0; ok && k < bins; k++) {
+            if (out[2 * k] == 0.0) ok = 0;
+            det *= out[2 * k + 1];
+        }
+    }
+    free(order); free(packed); free(bin_ptr); free(out);
+    free_block_structure(owned);
+    if (!ok) return 0;
+    *out_det = det;
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
+
+/* ===== Eigenvalues ===== */
+
+/* Eigenvalues of block b into out[0..s), its vectors row-major into
+ * out[s .. s + s*s)
+ */
+static int block_eigen(const Matrix *m, const BlockStructure *bs, int b, int kernel, int max_iter, double tol,
+                       double *out, int *iterations) {
+    int lo = bs->block_ptr[b], s = block_size(bs, b);
+    *iterations = 0;
+    if (s == 1) {
+        out[0] = mat_get(m, bs->perm[lo], bs->perm[lo]);
+        out[1] = 1.0;
+        return 1;
+    }
+    Matrix *blk = extract_diagonal_block(m, bs, b, "block");
+    if (!blk) return 0;
+    double t = 0.0;
+    EigenResult *r;
+    switch (kernel) {
+        case BLOCK_OPENMP:       r = eigen_qr_openmp(blk, max_iter, tol, &t); break;
+        default:                 r = eigen_qr_single(blk, max_iter, tol, &t); break;
+    }
+    free_matrix(blk);
+    if (!r) return 0;
+    memcpy(out, r->eigenvalues, (size_t)s * sizeof(double));
+    for (int i = 0; i < s; i++) {
+        for (int j = 0; j < s; j++) out[s + (size_t)i * s + j] = r->eigenvectors ? mat_get(r->eigenvectors, i, j) : (i == j);
+    }
+    *iterations = r->iterations;
+    free_eigen_result(r);
+    return 1;
+}
+
+/* Scatter the result of block b into the full result (rows through perm) */
+static void store_block(EigenResult *res, const BlockStructure *bs, int b, const double *vals) {
+    int lo = bs->block_ptr[b], s = block_size(bs, b);
+    const double *vecs = vals + s;
+    for (int j = 0; j < s; j++) res->eigenvalues[lo + j] = vals[j];
+    for (int i = 0; i < s; i++) {
+        for (int j = 0; j < s; j++) *mat_at(res->eigenvectors, bs->perm[lo + i], lo + j) = vecs[(size_t)i * s + j];
+    }
+}
+
+static EigenResult *create_block_result(int n) {
+    EigenResult *res = (EigenResult *)calloc(1, sizeof(EigenResult));
+    if (!res) return NULL;
+    res->n = n;
+    res->eigenvalues = (double *)malloc((size_t)n * sizeof(double));
+    res->eigenvectors = create_matrix("Eigenvectors", n, n);
+    if (!res->eigenvalues || !res->eigenvectors) { free_eigen_result(res); return NULL; }
+    return res;
+}
+
+static size_t block_width(int s) {
+    return (size_t)s + (size_t)s * s;
+}
+
+EigenResult *eigen_blocks_single(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                 double *exec_time) {
+    if (!m || m->rows != m->cols) return NULL;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return NULL;
+    EigenResult *res = create_block_result(m->rows);
+    double *buf = (double *)malloc(block_width(bs->largest) * sizeof(double));
+    int ok = res && buf;
+    for (int b = 0; b < bs->nblocks && ok; b++) {
+        int it = 0;
+        ok = block_eigen(m, bs, b, BLOCK_SINGLE, max_iter, tol, buf, &it);
+        if (ok) store_block(res, bs, b, buf);
+        if (it > res->iterations) res->iterations = it;
+    }
+    free(buf);
+    free_block_structure(owned);
+    if (!ok) { free_eigen_result(res); return NULL; }
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+EigenResult *eigen_blocks_openmp(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                 double *exec_time) {
+    if (!m || m->rows != m->cols) return NULL;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return NULL;
+    int dominant = 0, failed = 0, iterations = 0;
+    int *order = largest_first(bs, &dominant);
+    EigenResult *res = create_block_result(m->rows);
+    if (!order || !res) failed = 1;
+
+    if (!failed && dominant) {
+        double *buf = (double *)malloc(block_width(bs->largest) * sizeof(double));
+        failed = !buf || !block_eigen(m, bs, order[0], BLOCK_OPENMP, max_iter, tol, buf, &iterations);
+        if (!failed) store_block(res, bs, order[0], buf);
+        free(buf);
+    }
+    if (!failed) {
+        #pragma omp parallel for schedule(dynamic, 1) reduction(||:failed) reduction(max:iterations)
+        for (int t = dominant; t < bs->nblocks; t++) {
+            int b = order[t], it = 0;
+            double *buf = (double *)malloc(block_width(block_size(bs, b)) * sizeof(double));
+            if (buf && block_eigen(m, bs, b, BLOCK_SINGLE, max_iter, tol, buf, &it)) store_block(res, bs, b, buf);
+            else failed = 1;
+            if (it > iterations) iterations = it;
+            free(buf);
+        }
+    }
+    free(order);
+    free_block_structure(owned);
+    if (failed) { free_eigen_result(res); return NULL; }
+    res->iterations = iterations;
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+/* Child: out = { ok, iterations, then the results of the bin's blocks } */
+static void eigen_bin_task(void *ctx, int bin, double *out) {
+    const BlockJob *job = (const BlockJob *)ctx;
+    double *next = out + 2;
+    out[0] = 1.0;
+    out[1] = 0.0;
+    for (int t = job->bin_ptr[bin]; t < job->bin_ptr[bin + 1]; t++) {
+        int b = job->packed[t], it = 0;
+        if (!block_eigen(job->m, job->bs, b, BLOCK_SINGLE, job->max_iter, job->tol, next, &it)) { out[0] = 0.0; break; }
+        if (it > out[1]) out[1] = it;
+        next += block_width(block_size(job->bs, b));
+    }
+}
+
+EigenResult *eigen_blocks_multiprocess(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                       double *exec_time) {
+    if (!m || m->rows != m->cols) return NULL;
+    double start = get_time();
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return NULL;
+    int iterations = 0;
+    int *order = largest_first(bs, NULL);
+    int *packed = NULL, *bin_ptr = NULL;
+    double *out = NULL;
+    EigenResult *res = create_block_result(m->rows);
+    int ok = order && res;
+
+    if (ok) {
+        int bins = pack_bins(bs, order, worker_count(), &packed, &bin_ptr);
+        size_t width = 2;
+        for (int k = 0; k < bins; k++) {
+            size_t w = 2;
+            for (int t = bin_ptr[k]; t < bin_ptr[k + 1]; t++) w += block_width(block_size(bs, packed[t]));
+            if (w > width) width = w;
+        }
+        out = bins ? (double *)malloc((size_t)bins * width * sizeof(double)) : NULL;
+        BlockJob job = { m, bs, packed, bin_ptr, max_iter, tol };
+        ok = out && resource_fork_waves(bins, (int)width, eigen_bin_task, &job, out);
+        for (int k = 0; ok && k < bins; k++) {
+            const double *slot = out + (size_t)k * width;
+            if (slot[0] == 0.0) { ok = 0; break; }
+            if (slot[1] > iterations) iterations = (int)slot[1];
+            const double *next = slot + 2;
+            for (int t = bin_ptr[k]; t < bin_ptr[k + 1]; t++) {
+                store_block(res, bs, packed[t], next);
+                next += block_width(block_size(bs, packed[t]));
+            }
+        }
+    }
+    free(order); free(packed); free(bin_ptr); free(out);
+    free_block_structure(owned);
+    if (!ok) { free_eigen_result(res); return NULL; }
+    res->iterations = iterations;
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+/* ===== Comparisons ===== */
+
+static void log_structure(const BlockStructure *bs) {
+    double work = 0.0, n = bs->n;
+    for (int b = 0; b < bs->nblocks; b++) {
+        double s = block_size(bs, b);
+        work += s * s * s;
+    }
+    mat_log(MAT_LOG_INFO, "Blocks: %d, largest %d, %s; sum b^3 / n^3 = %.4f", bs->nblocks, bs->largest,
+            bs->coupled ? "block triangular" : "block diagonal", work / (n * n * n));
+}
+
+int run_determinant_blocks_comparison(const Matrix *m, const BlockStructure *bs,
+                                      PerformanceMetrics *metrics, double *out_det) {
+    if (!m || !metrics || !out_det || m->rows != m->cols) return 0;
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return 0;
+
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Determinant (Block Decomposition)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    log_structure(bs);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    double det1 = 0.0, det2 = 0.0, det3 = 0.0;
+    int ok = 0;
+
+    mat_log(MAT_LOG_INFO, "[1/3] Running Single-threaded method (block by block)...");
+    if (!determinant_blocks_single(m, bs, &det1, &metrics->single_thread_time)) goto done;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->single_thread_time);
+
+    mat_log(MAT_LOG_INFO, "[2/3] Running OpenMP method (blocks across threads)...");
+    if (!determinant_blocks_openmp(m, bs, &det2, &metrics->openmp_time)) goto done;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->openmp_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->openmp_time);
+
+    mat_log(MAT_LOG_INFO, "[3/3] Running Multiprocessing method (blocks across workers)...");
+    if (!determinant_blocks_multiprocess(m, bs, &det3, &metrics->multiprocess_time)) goto done;
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->multiprocess_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->single_thread_time / metrics->multiprocess_time);
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Single-threaded:   %.6f s (baseline)", metrics->single_thread_time);
+    mat_log(MAT_LOG_INFO, "OpenMP:            %.6f s (%.2fx %s)", metrics->openmp_time,
+            metrics->single_thread_time / metrics->openmp_time,
+            metrics->openmp_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Multiprocessing:   %.6f s (%.2fx %s)", metrics->multiprocess_time,
+            metrics->single_thread_time / metrics->multiprocess_time,
+            metrics->multiprocess_time < metrics->single_thread_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    *out_det = det1;
+    if (metrics->openmp_time < metrics->single_thread_time) *out_det = det2;
+    if (metrics->multiprocess_time < metrics->single_thread_time && metrics->multiprocess_time < metrics->openmp_time)
+        *out_det = det3;
+    ok = 1;
+
+done:
+    if (!ok) mat_log(MAT_LOG_INFO, "   ✗ Failed\n");
+    free_block_structure(owned);
+    return ok;
+}
+
+EigenResult *run_eigen_blocks_comparison(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                         PerformanceMetrics *metrics) {
+    if (!m || !metrics || m->rows != m->cols) return NULL;
+    BlockStructure *owned;
+    bs = ensure_structure(m, bs, &owned);
+    if (!bs) return NULL;
+
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: QR Iteration per Block (Eigenvalues)");
+    mat_log(MAT_LOG_INFO, "Matrix: %s (%dx%d)", m->name, m->rows, m->cols);
+    mat_log(MAT_LOG_INFO, "Max iterations: %d, Tolerance: %.2e", max_iter, tol);
+    log_structure(bs);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    static const char *names[3] = { "Single-threaded", "OpenMP", "Multiprocessing" };
+    double *times[3] = { &metrics->single_thread_time, &metrics->openmp_time, &metrics->multiprocess_time };
+    EigenResult *res[3] = { NULL, NULL, NULL };
+    for (int k = 0; k < 3; k++) {
+        mat_log(MAT_LOG_INFO, "[%d/3] Running %s method...", k + 1, names[k]);
+        if (k == 0) res[k] = eigen_blocks_single(m, bs, max_iter, tol, times[k]);
+        else if (k == 1) res[k] = eigen_blocks_openmp(m, bs, max_iter, tol, times[k]);
+        else res[k] = eigen_blocks_multiprocess(m, bs, max_iter, tol, times[k]);
+        if (!res[k]) {
+            mat_log(MAT_LOG_INFO, "   ✗ Failed\n");
+            continue;
+        }
+        mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds (at most %d iterations per block)", *times[k],
+                res[k]->iterations);
+        if (k > 0 && res[0]) mat_log(MAT_LOG_INFO, "   Speedup: %.2fx", metrics->single_thread_time / *times[k]);
+        mat_log(MAT_LOG_INFO, "%s", "");
+    }
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    int fastest = -1;
+    for (int k = 0; k < 3; k++) {
+        if (!res[k]) continue;
+        if (k == 0) mat_log(MAT_LOG_INFO, "%-18s %.6f s (baseline)", "Single-threaded:", *times[k]);
+        else if (res[0]) mat_log(MAT_LOG_INFO, "%-18s %.6f s (%.2fx %s)", k == 1 ? "OpenMP:" : "Multiprocessing:",
+                                 *times[k], metrics->single_thread_time / *times[k],
+                                 *times[k] < metrics->single_thread_time ? "faster" : "slower");
+        else mat_log(MAT_LOG_INFO, "%-18s %.6f s", k == 1 ? "OpenMP:" : "Multiprocessing:", *times[k]);
+        if (fastest < 0 || *times[k] < *times[fastest]) fastest = k;
+    }
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    for (int k = 0; k < 3; k++) {
+        if (k != fastest) free_eigen_result(res[k]);
+    }
+    free_block_structure(owned);
+    if (fastest < 0) return NULL;
+    mat_log(MAT_LOG_INFO, "★ Fastest method: %s (%.6f s)\n", names[fastest], *times[fastest]);
+    return res[fastest];
+}
@@ -0,0 +1,77 @@
+#ifndef MATRIX_BLOCKS_H
+#define MATRIX_BLOCKS_H
+
+#include "matrix_types.h"
+#include "matrix_sparse.h"
+#include "eigen_qr.h"
+#include "matrix_arithmetic_parallel.h" /* For PerformanceMetrics */
+
+/*
+ * Reducible structure. Read the nonzero pattern as a directed graph, with
+ * an edge i -> j for every A(i, j) != 0. Its strongly connected components
+ * (Tarjan), in topological order, give a symmetric permutation P such that
+ * P A P^T is block upper triangular. When no entry couples two components,
+ * it is block diagonal. Then
+ *
+ *     det A = prod det A_bb,     eig A = union eig A_bb,
+ *
+ * so one O(n^3) problem becomes sum O(b_i^3) over independent blocks.
+ * Only symmetric permutations are used, with no row matching first, so a
+ * structurally zero diagonal can leave the blocks coarser than the full
+ * Dulmage-Mendelsohn form. The results are exact either way.
+ *
+ * The OpenMP and multiprocess variants solve the blocks concurrently. The
+ * blocks are packed largest-first onto the threads or worker processes.
+ * In the OpenMP variant, a block carrying more than half of the total
+ * work gets the OpenMP kernel to itself. The multiprocess kernels fork
+ * once per elimination step, so every block goes to a worker whole.
+ */
+
+typedef struct {
+    int n;
+    int nblocks;
+    int *perm;          /* new index k is old index perm[k] */
+    int *block_ptr;     /* block b is new indices block_ptr[b] .. block_ptr[b+1] - 1 */
+    int largest;        /* size of the largest block */
+    int coupled;        /* entries between blocks: triangular rather than diagonal */
+} BlockStructure;
+
+/* Components of the pattern of square m (exact zeros are absent entries).
+ * Returns NULL if m is not square or on allocation failure.
+ */
+BlockStructure *matrix_block_structure(const Matrix *m);
+BlockStructure *sparse_block_structure(const SparseMatrix *s);
+void free_block_structure(BlockStructure *bs);
+
+/* Diagonal block b of P A P^T as a new row-major matrix */
+Matrix *extract_diagonal_block(const Matrix *m, const BlockStructure *bs, int b, const char *name);
+
+/* det(m) as the product of block determinants (Gaussian elimination per
+ * block). bs NULL: the structure is found first, inside the timing.
+ * Return 1 on success like determinant_single().
+ */
+int determinant_blocks_single(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time);
+int determinant_blocks_openmp(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time);
+int determinant_blocks_multiprocess(const Matrix *m, const BlockStructure *bs, double *out_det, double *exec_time);
+
+/* Eigenvalues as the union over blocks (QR iteration per block), block by
+ * block in the order of bs. The eigenvector matrix is P^T diag(V_b): the
+ * eigenvectors of each block for a block diagonal matrix, and its Schur
+ * vectors otherwise, as eigen_qr_* would give for the whole matrix.
+ */
+EigenResult *eigen_blocks_single(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                 double *exec_time);
+EigenResult *eigen_blocks_openmp(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                 double *exec_time);
+EigenResult *eigen_blocks_multiprocess(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                       double *exec_time);
+
+/* Comparisons of the three block variants, like run_determinant_comparison()
+ * and run_eigen_comparison(); bs NULL finds the structure first
+ */
+int run_determinant_blocks_comparison(const Matrix *m, const BlockStructure *bs,
+                                      PerformanceMetrics *metrics, double *out_det);
+EigenResult *run_eigen_blocks_comparison(const Matrix *m, const BlockStructure *bs, int max_iter, double tol,
+                                         PerformanceMetrics *metrics);
+
+#endif /* MATRIX_BLOCKS_H */
@@ -0,0 +1,130 @@
+#include "matrix_cache.h"
+
+/* Free the current and stale decompositions of an entry */
+static void drop_eigen(CachedResult *e) {
+    free_eigen_result(e->eigen);
+    free_eigen_result(e->stale_eigen);
+    free(e->edits);
+    e->eigen = e->stale_eigen = NULL;
+    e->edits = NULL;
+    e->edit_count = 0;
+}
+
+ResultCache *create_result_cache(void) {
+    ResultCache *cache = (ResultCache*)calloc(1, sizeof(ResultCache));
+    if (!cache) return NULL;
+    cache->capacity = 8;
+    cache->items = (CachedResult*)calloc(cache->capacity, sizeof(CachedResult));
+    if (!cache->items) { free(cache); return NULL; }
+    return cache;
+}
+
+void free_result_cache(ResultCache *cache) {
+    if (!cache) return;
+    for (int i = 0; i < cache->count; i++) drop_eigen(&cache->items[i]);
+    free(cache->items);
+    free(cache);
+}
+
+static CachedResult *find_entry(const ResultCache *cache, const char *name) {
+    if (!cache || !name) return NULL;
+    for (int i = 0; i < cache->count; i++) {
+        if (strcmp(cache->items[i].name, name) == 0) return &cache->items[i];
+    }
+    return NULL;
+}
+
+static CachedResult *find_or_add_entry(ResultCache *cache, const char *name) {
+    CachedResult *e = find_entry(cache, name);
+    if (e || !cache || !name) return e;
+    if (cache->count >= cache->capacity) {
+        int newcap = cache->capacity * 2;
+        CachedResult *tmp = (CachedResult*)realloc(cache->items, newcap * sizeof(CachedResult));
+        if (!tmp) return NULL;
+        cache->items = tmp;
+        cache->capacity = newcap;
+    }
+    e = &cache->items[cache->count++];
+    memset(e, 0, sizeof(*e));
+    strncpy(e->name, name, MAX_NAME_LENGTH - 1);
+    return e;
+}
+
+int result_cache_get_determinant(const ResultCache *cache, const char *name, double *det) {
+    const CachedResult *e = find_entry(cache, name);
+    if (!e || !e->has_determinant) return 0;
+    if (det) *det = e->determinant;
+    return 1;
+}
+
+void result_cache_put_determinant(ResultCache *cache, const char *name, double det) {
+    CachedResult *e = find_or_add_entry(cache, name);
+    if (!e) return;
+    e->has_determinant = 1;
+    e->determinant = det;
+}
+
+const EigenResult *result_cache_get_eigen(const ResultCache *cache, const char *name) {
+    const CachedResult *e = find_entry(cache, name);
+    return e ? e->eigen : NULL;
+}
+
+void result_cache_put_eigen(ResultCache *cache, const char *name, EigenResult *res) {
+    CachedResult *e = find_or_add_entry(cache, name);
+    if (!e) { free_eigen_result(res); return; }
+    if (e->eigen != res) free_eigen_result(e->eigen);
+    e->eigen = res;
+    /* A current result makes any warm start obsolete */
+    free_eigen_result(e->stale_eigen);
+    free(e->edits);
+    e->stale_eigen = NULL;
+    e->edits = NULL;
+    e->edit_count = 0;
+}
+
+void result_cache_mark_modified(ResultCache *cache, const char *name, const SymmetricEdit *edit) {
+    CachedResult *e = find_entry(cache, name);
+    if (!e) return;
+    e->has_determinant = 0;
+    if (e->eigen) {
+        free_eigen_result(e->stale_eigen);
+        free(e->edits);
+        e->stale_eigen = e->eigen;
+        e->eigen = NULL;
+        e->edits = NULL;
+        e->edit_count = 0;
+    }
+    if (!e->stale_eigen || e->edit_count < 0) return;
+    if (!edit || e->edit_count >= EIGEN_UPDATE_MAX_EDITS) {
+        free(e->edits);
+        e->edits = NULL;
+        e->edit_count = -1;
+        return;
+    }
+    if (!e->edits) {
+        e->edits = (SymmetricEdit*)malloc(EIGEN_UPDATE_MAX_EDITS * sizeof(SymmetricEdit));
+        if (!e->edits) { e->edit_count = -1; return; }
+    }
+    e->edits[e->edit_count++] = *edit;
+}
+
+const EigenResult *result_cache_get_stale_eigen(const ResultCache *cache, const char *name,
+                                                const SymmetricEdit **edits, int *edit_count) {
+    const CachedResult *e = find_entry(cache, name);
+    if (!e || !e->stale_eigen) return NULL;
+    if (edits) *edits = e->edits;
+    if (edit_count) *edit_count = e->edit_count;
+    return e->stale_eigen;
+}
+
+void result_cache_invalidate(ResultCache *cache, const char *name) {
+    if (!cache || !name) return;
+    for (int i = 0; i < cache->count; i++) {
+        if (strcmp(cache->items[i].name, name) == 0) {
+            drop_eigen(&cache->items[i]);
+            cache->items[i] = cache->items[cache->count - 1];
+            cache->count--;
+            return;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef MATRIX_CACHE_H
+#define MATRIX_CACHE_H
+
+#include "matrix_types.h"
+#include "eigen_qr.h"
+#include "eigen_update.h"
+
+/*
+ * Per-matrix cache of expensive results (determinant, eigen decomposition),
+ * keyed by matrix name. Anything that changes a matrix's contents must call
+ * result_cache_mark_modified() (in-place edits, where the old eigenpairs
+ * remain a useful starting point) or result_cache_invalidate() (deletes,
+ * folder watch reloads).
+ */
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int has_determinant;
+    double determinant;
+    EigenResult *eigen;       /* owned by the cache, NULL if not computed */
+    EigenResult *stale_eigen; /* decomposition of an earlier version of the matrix */
+    SymmetricEdit *edits;     /* changes made since stale_eigen */
+    int edit_count;           /* -1 once some change could not be recorded */
+} CachedResult;
+
+typedef struct {
+    CachedResult *items;
+    int count;
+    int capacity;
+} ResultCache;
+
+ResultCache *create_result_cache(void);
+void free_result_cache(ResultCache *cache);
+
+/* Returns: 1 and *det on a hit, 0 on a miss */
+int result_cache_get_determinant(const ResultCache *cache, const char *name, double *det);
+void result_cache_put_determinant(ResultCache *cache, const char *name, double det);
+
+/* Returns: cached result (still owned by the cache) or NULL on a miss */
+const EigenResult *result_cache_get_eigen(const ResultCache *cache, const char *name);
+/* Stores res, taking ownership (a previous result for name is freed) */
+void result_cache_put_eigen(ResultCache *cache, const char *name, EigenResult *res);
+
+/* The matrix was edited in place: drop the determinant and keep the eigen
+ * decomposition as a stale starting point for eigen_update(). edit describes
+ * the change, or is NULL if it is not a single symmetric edit.
+ */
+void result_cache_mark_modified(ResultCache *cache, const char *name, const SymmetricEdit *edit);
+
+/* Returns the stale decomposition (still owned by the cache) and the edits
+ * since (*edit_count -1 if unknown), or NULL if there is none
+ */
+const EigenResult *result_cache_get_stale_eigen(const ResultCache *cache, const char *name,
+                                                const SymmetricEdit **edits, int *edit_count);
+
+/* Drop every cached result for name */
+void result_cache_invalidate(ResultCache *cache, const char *name);
+
+#endif /* MATRIX_CACHE_H */
@@ -0,0 +1,489 @@
+#include "matrix_complex.h"
+#include "matrix_gemm.h"
+#include "matrix_arithmetic_parallel.h"
+#include "matrix_formats.h"
+#include "matrix_file_ops.h"
+#include "matrix_resources.h"
+#include "matrix_log.h"
+#include <math.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+/* |re| + |im| of a pivot below this counts as zero (as PIVOT_EPS for real) */
+#define COMPLEX_PIVOT_EPS 1e-12
+
+/* Element-wise loops over fewer doubles than this stay on one thread */
+#define COMPLEX_PAR_MIN 65536L
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void stop_clock(double start, double *exec_time) {
+    if (exec_time) *exec_time = get_time() - start;
+}
+
+/* ===== Conversion ===== */
+
+ComplexMatrix *complex_from_parts(const Matrix *re, const Matrix *im, const char *name) {
+    if (!re || !name) return NULL;
+    if (im && (im->rows != re->rows || im->cols != re->cols)) {
+        mat_log(MAT_LOG_ERROR, "Error: real part is %dx%d, imaginary part %dx%d",
+                re->rows, re->cols, im->rows, im->cols);
+        return NULL;
+    }
+    ComplexMatrix *c = create_complex_matrix(name, re->rows, re->cols);
+    if (!c) return NULL;
+    for (int i = 0; i < re->rows; i++) {
+        for (int j = 0; j < re->cols; j++) {
+            double *z = complex_at(c, i, j);
+            z[0] = mat_get(re, i, j);
+            z[1] = im ? mat_get(im, i, j) : 0.0;
+        }
+    }
+    return c;
+}
+
+static Matrix *complex_part(const ComplexMatrix *m, const char *name, int part) {
+    if (!m || !name) return NULL;
+    Matrix *r = create_matrix(name, m->rows, m->cols);
+    if (!r) return NULL;
+    size_t count = (size_t)m->rows * m->cols;
+    double *dst = r->data[0];
+    for (size_t t = 0; t < count; t++) dst[t] = m->v[2 * t + part];
+    return r;
+}
+
+Matrix *complex_real_part(const ComplexMatrix *m, const char *name) {
+    return complex_part(m, name, 0);
+}
+
+Matrix *complex_imag_part(const ComplexMatrix *m, const char *name) {
+    return complex_part(m, name, 1);
+}
+
+/* ===== Addition / subtraction ===== */
+
+/* Interleaved storage makes both a plain real loop over 2 * rows * cols */
+static ComplexMatrix *complex_elementwise(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                          int subtract, int parallel, double *exec_time) {
+    if (!a || !b || !name) return NULL;
+    if (a->rows != b->rows || a->cols != b->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for %s",
+                subtract ? "subtraction" : "addition");
+        return NULL;
+    }
+
+    double start = get_time();
+    ComplexMatrix *c = create_complex_matrix(name, a->rows, a->cols);
+    if (!c) return NULL;
+
+    long count = 2L * a->rows * a->cols;
+    const double *restrict x = a->v, *restrict y = b->v;
+    double *restrict z = c->v;
+    if (subtract) {
+        #pragma omp parallel for simd schedule(static) if (parallel && count >= COMPLEX_PAR_MIN)
+        for (long t = 0; t < count; t++) z[t] = x[t] - y[t];
+    } else {
+        #pragma omp parallel for simd schedule(static) if (parallel && count >= COMPLEX_PAR_MIN)
+        for (long t = 0; t < count; t++) z[t] = x[t] + y[t];
+    }
+
+    stop_clock(start, exec_time);
+    return c;
+}
+
+ComplexMatrix *complex_add_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                  double *exec_time) {
+    return complex_elementwise(a, b, name, 0, 0, exec_time);
+}
+
+ComplexMatrix *complex_add_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                  double *exec_time) {
+    return complex_elementwise(a, b, name, 0, 1, exec_time);
+}
+
+ComplexMatrix *complex_subtract_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       double *exec_time) {
+    return complex_elementwise(a, b, name, 1, 0, exec_time);
+}
+
+ComplexMatrix *complex_subtract_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       double *exec_time) {
+    return complex_elementwise(a, b, name, 1, 1, exec_time);
+}
+
+/* ===== Multiplication ===== */
+
+/* 4M: rows 2p and 2p + 1 of the packed operand are B(p, :) and i B(p, :),
+ * so that A, read as an m x 2k real matrix, times it is the product
+ */
+static int multiply_4m(const ComplexMatrix *a, const ComplexMatrix *b, ComplexMatrix *c, int parallel) {
+    int m = a->rows, k = a->cols, n = b->cols;
+    size_t ld = 2 * (size_t)n;
+    double *q = (double *)malloc(2 * (size_t)k * ld * sizeof(double));
+    if (!q) return 0;
+
+    #pragma omp parallel for schedule(static) if (parallel && (long)k * n >= COMPLEX_PAR_MIN)
+    for (int p = 0; p < k; p++) {
+        const double *restrict src = b->v + (size_t)p * ld;
+        double *restrict re = q + 2 * (size_t)p * ld;
+        double *restrict im = re + ld;
+        memcpy(re, src, ld * sizeof(double));
+        #pragma omp simd
+        for (int j = 0; j < n; j++) {
+            im[2 * j] = -src[2 * j + 1];
+            im[2 * j + 1] = src[2 * j];
+        }
+    }
+
+    gemm_recursive_ex(m, 2 * n, 2 * k, 1.0, a->v, 2 * k, q, (int)ld, 0.0, c->v, (int)ld, NULL, parallel);
+    free(q);
+    return 1;
+}
+
+/* 3M: three real products of the split parts, recombined into c */
+static int multiply_3m(const ComplexMatrix *a, const ComplexMatrix *b, ComplexMatrix *c, int parallel) {
+    int m = a->rows, k = a->cols, n = b->cols;
+    size_t mk = (size_t)m * k, kn = (size_t)k * n, mn = (size_t)m * n;
+    double *buf = (double *)malloc(3 * (mk + kn + mn) * sizeof(double));
+    if (!buf) return 0;
+    double *ar = buf, *ai = ar + mk, *as = ai + mk;
+    double *br = as + mk, *bi = br + kn, *bs = bi + kn;
+    double *t1 = bs + kn, *t2 = t1 + mn, *t3 = t2 + mn;
+
+    #pragma omp parallel if (parallel)
+    {
+        #pragma omp for simd schedule(static)
+        for (size_t t = 0; t < mk; t++) {
+            ar[t] = a->v[2 * t];
+            ai[t] = a->v[2 * t + 1];
+            as[t] = ar[t] + ai[t];
+        }
+        #pragma omp for simd schedule(static)
+        for (size_t t = 0; t < kn; t++) {
+            br[t] = b->v[2 * t];
+            bi[t] = b->v[2 * t + 1];
+            bs[t] = br[t] + bi[t];
+        }
+    }
+
+    gemm_recursive_ex(m, n, k, 1.0, ar, k, br, n, 0.0, t1, n, NULL, parallel);
+    gemm_recursive_ex(m, n, k, 1.0, ai, k, bi, n, 0.0, t2, n, NULL, parallel);
+    gemm_recursive_ex(m, n, k, 1.0, as, k, bs, n, 0.0, t3, n, NULL, parallel);
+
+    #pragma omp parallel for simd schedule(static) if (parallel && (long)mn >= COMPLEX_PAR_MIN)
+    for (size_t t = 0; t < mn; t++) {
+        c->v[2 * t] = t1[t] - t2[t];
+        c->v[2 * t + 1] = t3[t] - t1[t] - t2[t];
+    }
+    free(buf);
+    return 1;
+}
+
+static ComplexMatrix *complex_multiply(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       ComplexGemmMethod method, int parallel, double *exec_time) {
+    if (!a || !b || !name) return NULL;
+    if (a->cols != b->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return NULL;
+    }
+
+    double start = get_time();
+    ComplexMatrix *c = create_complex_matrix(name, a->rows, b->cols);
+    if (!c) return NULL;
+    int ok = method == COMPLEX_GEMM_3M ? multiply_3m(a, b, c, parallel) : multiply_4m(a, b, c, parallel);
+    if (!ok) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate complex product workspace.");
+        free_complex_matrix(c);
+        return NULL;
+    }
+    stop_clock(start, exec_time);
+    return c;
+}
+
+ComplexMatrix *complex_multiply_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       ComplexGemmMethod method, double *exec_time) {
+    return complex_multiply(a, b, name, method, 0, exec_time);
+}
+
+ComplexMatrix *complex_multiply_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       ComplexGemmMethod method, double *exec_time) {
+    return complex_multiply(a, b, name, method, 1, exec_time);
+}
+
+ComplexMatrix *complex_multiply_split(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                      double *exec_time) {
+    if (!a || !b || !name) return NULL;
+    if (a->cols != b->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return NULL;
+    }
+
+    double start = get_time(), t;
+    Matrix *ar = complex_real_part(a, "a_re"), *ai = complex_imag_part(a, "a_im");
+    Matrix *br = complex_real_part(b, "b_re"), *bi = complex_imag_part(b, "b_im");
+    Matrix *p[4] = { NULL, NULL, NULL, NULL }, *re = NULL, *im = NULL;
+    ComplexMatrix *c = NULL;
+    if (ar && ai && br && bi) {
+        p[0] = multiply_matrices_openmp(ar, br, "re_re", &t);
+        p[1] = multiply_matrices_openmp(ai, bi, "im_im", &t);
+        p[2] = multiply_matrices_openmp(ar, bi, "re_im", &t);
+        p[3] = multiply_matrices_openmp(ai, br, "im_re", &t);
+    }
+    if (p[0] && p[1] && p[2] && p[3]) {
+        re = subtract_matrices_openmp(p[0], p[1], "re", &t);
+        im = add_matrices_openmp(p[2], p[3], "im", &t);
+    }
+    if (re && im) c = complex_from_parts(re, im, name);
+
+    free_matrix(ar); free_matrix(ai); free_matrix(br); free_matrix(bi);
+    for (int q = 0; q < 4; q++) free_matrix(p[q]);
+    free_matrix(re); free_matrix(im);
+    if (c) stop_clock(start, exec_time);
+    return c;
+}
+
+/* ===== Determinant ===== */
+
+/* c -= l * b over n interleaved elements */
+static void complex_row_update(double *restrict c, const double *restrict b, int n, double lr, double li) {
+    #pragma omp simd
+    for (int t = 0; t < n; t++) {
+        double br = b[2 * t], bi = b[2 * t + 1];
+        c[2 * t] -= lr * br - li * bi;
+        c[2 * t + 1] -= lr * bi + li * br;
+    }
+}
+
+static int complex_determinant(const ComplexMatrix *m, double complex *out_det, double *exec_time, int parallel) {
+    if (!m || !out_det || m->rows != m->cols) return 0;
+    int n = m->rows;
+    size_t ld = 2 * (size_t)n;
+    double *A = (double *)malloc(ld * n * sizeof(double));
+    if (!A) return 0;
+    memcpy(A, m->v, ld * n * sizeof(double));
+    double start = get_time();
+
+    double sign = 1.0;
+    for (int k = 0; k < n; ++k) {
+        /* pivot search (serial) */
+        int pivot_row = k;
+        double max_abs = -1.0;
+        for (int i = k; i < n; ++i) {
+            const double *z = A + i * ld + 2 * k;
+            double v = fabs(z[0]) + fabs(z[1]);
+            if (v > max_abs) { max_abs = v; pivot_row = i; }
+        }
+        if (max_abs < COMPLEX_PIVOT_EPS) {
+            *out_det = 0.0;
+            stop_clock(start, exec_time);
+            free(A);
+            return 1;
+        }
+        double *rowk = A + k * ld;
+        if (pivot_row != k) {
+            double *rowp = A + pivot_row * ld;
+            for (size_t j = 2 * (size_t)k; j < ld; ++j) {
+                double tmp = rowk[j]; rowk[j] = rowp[j]; rowp[j] = tmp;
+            }
+            sign = -sign;
+        }
+        /* 1 / pivot */
+        double pr = rowk[2 * k], pi = rowk[2 * k + 1];
+        double d = pr * pr + pi * pi;
+        double ir = pr / d, ii = -pi / d;
+        /* parallel row updates below pivot */
+        #pragma omp parallel for schedule(static) if (parallel)
+        for (int i = k + 1; i < n; ++i) {
+            double *row = A + i * ld;
+            double xr = row[2 * k], xi = row[2 * k + 1];
+            double lr = xr * ir - xi * ii, li = xr * ii + xi * ir;
+            row[2 * k] = row[2 * k + 1] = 0.0;
+            complex_row_update(row + 2 * (k + 1), rowk + 2 * (k + 1), n - k - 1, lr, li);
+        }
+    }
+
+    double dr = sign, di = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double *z = A + i * ld + 2 * i;
+        double r = dr * z[0] - di * z[1];
+        di = dr * z[1] + di * z[0];
+        dr = r;
+    }
+    stop_clock(start, exec_time);
+    *out_det = CMPLX(dr, di);
+    free(A);
+    return 1;
+}
+
+int complex_determinant_single(const ComplexMatrix *m, double complex *out_det, double *exec_time) {
+    return complex_determinant(m, out_det, exec_time, 0);
+}
+
+int complex_determinant_openmp(const ComplexMatrix *m, double complex *out_det, double *exec_time) {
+    return complex_determinant(m, out_det, exec_time, 1);
+}
+
+/* ===== Comparison ===== */
+
+/* Largest |x - y| over the elements (real and imaginary parts apart) */
+static double max_difference(const ComplexMatrix *x, const ComplexMatrix *y) {
+    if (!x || !y) return NAN;
+    double worst = 0.0;
+    long count = 2L * x->rows * x->cols;
+    for (long t = 0; t < count; t++) {
+        double d = fabs(x->v[t] - y->v[t]);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+ComplexMatrix *run_complex_multiply_comparison(const ComplexMatrix *a, const ComplexMatrix *b,
+                                               const char *name, ComplexMultiplyMetrics *metrics) {
+    if (!a || !b || !name || !metrics) return NULL;
+
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Complex Multiplication");
+    mat_log(MAT_LOG_INFO, "Matrix 1: %s (%dx%d), Matrix 2: %s (%dx%d)",
+            a->name, a->rows, a->cols, b->name, b->rows, b->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    char temp_name[128];
+    mat_log(MAT_LOG_INFO, "[1/3] Running split real/imaginary emulation (4 real products)...");
+    snprintf(temp_name, sizeof(temp_name), "%s_split", name);
+    ComplexMatrix *split = complex_multiply_split(a, b, temp_name, &metrics->split_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->split_time);
+
+    mat_log(MAT_LOG_INFO, "[2/3] Running interleaved 4M product...");
+    ComplexMatrix *c4 = complex_multiply_openmp(a, b, name, COMPLEX_GEMM_4M, &metrics->interleaved_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->interleaved_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->split_time / metrics->interleaved_time);
+
+    mat_log(MAT_LOG_INFO, "[3/3] Running interleaved 3M product...");
+    snprintf(temp_name, sizeof(temp_name), "%s_3m", name);
+    ComplexMatrix *c3 = complex_multiply_openmp(a, b, temp_name, COMPLEX_GEMM_3M, &metrics->gauss3m_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->gauss3m_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->split_time / metrics->gauss3m_time);
+
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Split emulation:   %.6f s (baseline)", metrics->split_time);
+    mat_log(MAT_LOG_INFO, "Interleaved 4M:    %.6f s (%.2fx %s)", metrics->interleaved_time,
+            metrics->split_time / metrics->interleaved_time,
+            metrics->interleaved_time < metrics->split_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Interleaved 3M:    %.6f s (%.2fx %s)", metrics->gauss3m_time,
+            metrics->split_time / metrics->gauss3m_time,
+            metrics->gauss3m_time < metrics->split_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Max |difference| from 4M: split %.3e, 3M %.3e",
+            max_difference(c4, split), max_difference(c4, c3));
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    free_complex_matrix(split);
+    free_complex_matrix(c3);
+    return c4;
+}
+
+/* ===== File I/O ===== */
+
+static int regular_file(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISREG(st.st_mode);
+}
+
+/* Reads the name and dimensions; *tagged = 1 if "complex" follows them */
+static int read_text_header(FILE *f, char *name, int *rows, int *cols, int *tagged) {
+    char tag[16];
+    if (fscanf(f, "%63s", name) != 1) return 0;
+    if (fscanf(f, "%d %d", rows, cols) != 2 || *rows <= 0 || *cols <= 0) return 0;
+    *tagged = fscanf(f, " %15[A-Za-z]", tag) == 1 && strcmp(tag, "complex") == 0;
+    return 1;
+}
+
+int matrix_file_is_complex(const char *filepath) {
+    if (!filepath || !regular_file(filepath)) return 0;
+    if (matrix_path_has_ext(filepath, ".npy")) return npy_file_is_complex(filepath);
+    char tag[16];
+    return matrix_file_tag(filepath, tag, sizeof(tag)) && strcmp(tag, "complex") == 0;
+}
+
+ComplexMatrix *read_complex_matrix_from_file(const char *filepath) {
+    if (!filepath || !regular_file(filepath)) {
+        mat_log(MAT_LOG_ERROR, "File '%s' not found or invalid.", filepath);
+        return NULL;
+    }
+    if (matrix_path_has_ext(filepath, ".npy")) return read_complex_matrix_npy(filepath);
+
+    FILE *f = fopen(filepath, "r");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return NULL;
+    }
+
+    char name[MAX_NAME_LENGTH];
+    int rows, cols, tagged = 0;
+    if (!read_text_header(f, name, &rows, &cols, &tagged)) {
+        mat_log(MAT_LOG_ERROR, "Invalid header in %s", filepath);
+        fclose(f);
+        return NULL;
+    }
+    if (!tagged) {
+        mat_log(MAT_LOG_ERROR, "%s is not a complex matrix file (expected \"rows cols complex\")", filepath);
+        fclose(f);
+        return NULL;
+    }
+
+    ComplexMatrix *m = create_complex_matrix(name, rows, cols);
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        fclose(f);
+        return NULL;
+    }
+
+    for (int i = 0; i < rows; i++) {
+        for (int j = 0; j < cols; j++) {
+            double *z = complex_at(m, i, j);
+            if (fscanf(f, "%lf %lf", &z[0], &z[1]) != 2) {
+                mat_log(MAT_LOG_ERROR, "Failed to read element [%d][%d] from %s", i, j, filepath);
+                free_complex_matrix(m);
+                fclose(f);
+                return NULL;
+            }
+        }
+    }
+
+    fclose(f);
+    mat_log(MAT_LOG_INFO, "Successfully loaded complex matrix '%s' (%dx%d) from %s", name, rows, cols, filepath);
+    return m;
+}
+
+int write_complex_matrix_to_file(const ComplexMatrix *m, const char *filepath) {
+    if (!m || !filepath) return 0;
+    if (matrix_path_has_ext(filepath, ".npy")) return write_complex_matrix_npy(m, filepath);
+
+    FILE *f = fopen(filepath, "w");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return 0;
+    }
+
+    fprintf(f, "%s\n", m->name);
+    fprintf(f, "%d %d complex\n", m->rows, m->cols);
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            const double *z = complex_at(m, i, j);
+            fprintf(f, "%.10f %.10f", z[0], z[1]);
+            if (j < m->cols - 1) fprintf(f, "  ");
+        }
+        fprintf(f, "\n");
+    }
+
+    fclose(f);
+    mat_log(MAT_LOG_INFO, "Complex matrix '%s' saved to %s", m->name, filepath);
+    return 1;
+}
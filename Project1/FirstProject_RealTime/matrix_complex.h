@@ -0,0 +1,124 @@
+#ifndef MATRIX_COMPLEX_H
+#define MATRIX_COMPLEX_H
+
+#include <complex.h>
+#include "matrix_types.h"
+
+/*
+ * Complex (complex128) matrices, stored interleaved: see ComplexMatrix in
+ * matrix_types.h.
+ *
+ * With interleaved storage, a complex sum is a real sum over twice as many
+ * doubles. A product row C(i, :) += a * B(k, :) with a = ar + i ai is
+ * ar * B(k, :) + ai * (i B(k, :)), where i B(k, :) is the row
+ * (-Bi, Br, ...). So the whole product is one real GEMM,
+ *
+ *     [C] (m x 2n) = [A as m x 2k reals] * [B(0,:); iB(0,:); B(1,:); ...],
+ *
+ * against a packed copy of B only. It runs the recursive kernel of
+ * matrix_gemm.h at the same 8 real flops per complex multiply-add as
+ * splitting A and B into real and imaginary matrices, but with no split
+ * copies of A, no extra real products and no add/subtract passes.
+ *
+ * COMPLEX_GEMM_3M (Gauss) trades one real product for three additions:
+ *     T1 = Ar Br,  T2 = Ai Bi,  T3 = (Ar + Ai)(Br + Bi)
+ *     Re C = T1 - T2,  Im C = T3 - T1 - T2
+ * That is 25% fewer flops. The error bound for Im C grows with
+ * |Ar| + |Ai| and |Br| + |Bi| instead of the products of the parts, so
+ * operands whose real and imaginary parts differ greatly in scale should
+ * use the 4M method.
+ */
+
+typedef enum {
+    COMPLEX_GEMM_4M,     /* one packed real product, 4 real multiplies per element */
+    COMPLEX_GEMM_3M      /* Gauss: three real products */
+} ComplexGemmMethod;
+
+/* Times of the three methods in run_complex_multiply_comparison() */
+typedef struct {
+    double split_time;       /* split real/imaginary emulation (4 products + add/subtract) */
+    double interleaved_time; /* COMPLEX_GEMM_4M */
+    double gauss3m_time;     /* COMPLEX_GEMM_3M */
+} ComplexMultiplyMetrics;
+
+static inline double *complex_at(const ComplexMatrix *m, int i, int j) {
+    return m->v + 2 * ((size_t)i * m->cols + j);
+}
+
+static inline double complex complex_get(const ComplexMatrix *m, int i, int j) {
+    const double *p = complex_at(m, i, j);
+    return CMPLX(p[0], p[1]);
+}
+
+static inline void complex_set(ComplexMatrix *m, int i, int j, double complex z) {
+    double *p = complex_at(m, i, j);
+    p[0] = creal(z);
+    p[1] = cimag(z);
+}
+
+/* re + i im; im may be NULL (real matrix). NULL on a shape mismatch */
+ComplexMatrix *complex_from_parts(const Matrix *re, const Matrix *im, const char *name);
+
+/* Real or imaginary part as a row-major matrix */
+Matrix *complex_real_part(const ComplexMatrix *m, const char *name);
+Matrix *complex_imag_part(const ComplexMatrix *m, const char *name);
+
+/* Element-wise sum/difference. Return NULL on dimension mismatch or
+ * allocation failure, like add_matrices_single()
+ */
+ComplexMatrix *complex_add_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                  double *exec_time);
+ComplexMatrix *complex_add_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                  double *exec_time);
+ComplexMatrix *complex_subtract_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       double *exec_time);
+ComplexMatrix *complex_subtract_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       double *exec_time);
+
+/* Product a * b. Returns NULL if a->cols != b->rows or on allocation failure */
+ComplexMatrix *complex_multiply_single(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       ComplexGemmMethod method, double *exec_time);
+ComplexMatrix *complex_multiply_openmp(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                       ComplexGemmMethod method, double *exec_time);
+
+/* The same product by the old route: separate real and imaginary matrices,
+ * four multiply_matrices_openmp() calls, then a subtraction and an addition.
+ * Kept as the baseline for the comparison.
+ */
+ComplexMatrix *complex_multiply_split(const ComplexMatrix *a, const ComplexMatrix *b, const char *name,
+                                      double *exec_time);
+
+/* Determinant by LU with partial pivoting (largest |re| + |im|, as in
+ * LAPACK zgetrf). A pivot below 1e-12 in that measure gives det 0, like
+ * determinant_single(). Return 1 on success, 0 if m is not square or on
+ * allocation failure.
+ */
+int complex_determinant_single(const ComplexMatrix *m, double complex *out_det, double *exec_time);
+int complex_determinant_openmp(const ComplexMatrix *m, double complex *out_det, double *exec_time);
+
+/* Run the split emulation, the 4M and the 3M product (all OpenMP) and log
+ * the times and the largest deviation of each from the 4M result, which is
+ * the one returned
+ */
+ComplexMatrix *run_complex_multiply_comparison(const ComplexMatrix *a, const ComplexMatrix *b,
+                                               const char *name, ComplexMultiplyMetrics *metrics);
+
+/* ===== File I/O ===== */
+
+/* Text format: like the real one with "complex" after the dimensions,
+ *     name
+ *     rows cols complex
+ *     re im  re im  ...     (one row per line)
+ * .npy paths use the c16 dtype (matrix_formats.h).
+ */
+
+/* 1 if filepath holds a complex matrix (text header or .npy dtype) */
+int matrix_file_is_complex(const char *filepath);
+
+/* Returns: ComplexMatrix pointer or NULL on error */
+ComplexMatrix *read_complex_matrix_from_file(const char *filepath);
+
+/* Returns: 1 on success, 0 on failure */
+int write_complex_matrix_to_file(const ComplexMatrix *m, const char *filepath);
+
+#endif /* MATRIX_COMPLEX_H */
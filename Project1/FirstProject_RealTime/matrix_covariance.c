@@ -0,0 +1,366 @@
+#include "matrix_covariance.h"
+#include "matrix_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Flops (k * n^2) below which a rank-k update stays on one thread */
+#define COV_PARALLEL_WORK 200000L
+/* A pivot below this fraction of its diagonal entry counts as singular */
+#define COV_PIVOT_EPS 1e-12
+/* Rows centered at a time when recomputing from the window */
+#define COV_REBUILD_BLOCK 256
+
+struct CovarianceWindow {
+    int n;
+    int window;             /* 0: unbounded */
+    int track_cholesky;
+    int parallel;
+    long count;
+    double *mean;           /* n */
+    double *S;              /* n x n scatter, upper triangle only */
+    double *R;              /* n x n upper factor, R^T R = S */
+    int factor_valid;
+    double *ring;           /* window x n, the rows in the window */
+    int head;               /* ring slot of the oldest row */
+    long retired;           /* rows downdated since the last recompute */
+    double *scratch;        /* COV_REBUILD_BLOCK x n, for recomputes */
+};
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* ===== Kernels ===== */
+
+/* Upper triangle of C (n x n) += alpha * X^T X for X k x n row-major. Row i
+ * of C only reads column i of X and the tails of its rows, so the rows of
+ * C are independent; the triangle makes their cost uneven, hence dynamic.
+ */
+static void syrk_upper(int n, int k, double alpha, const double *X, double *C, int parallel) {
+    #pragma omp parallel for schedule(dynamic, 8) if (parallel && (long)k * n * n > COV_PARALLEL_WORK)
+    for (int i = 0; i < n; i++) {
+        double *ci = C + (size_t)i * n;
+        for (int r = 0; r < k; r++) {
+            const double *xr = X + (size_t)r * n;
+            double a = alpha * xr[i];
+            if (a == 0.0) continue;
+            #pragma omp simd
+            for (int j = i; j < n; j++) ci[j] += a * xr[j];
+        }
+    }
+}
+
+/* R^T R += x x^T (sign > 0) or -= x x^T (sign < 0) for upper R; x is
+ * overwritten. Returns 0 if a downdate loses positive definiteness.
+ */
+static int chol_rank_one(double *R, int n, double *x, int sign) {
+    for (int k = 0; k < n; k++) {
+        double *rk = R + (size_t)k * n;
+        double rkk = rk[k], xk = x[k];
+        if (xk == 0.0) continue;
+        double r;
+        if (sign > 0) {
+            r = hypot(rkk, xk);
+        } else {
+            double r2 = (rkk - xk) * (rkk + xk);
+            if (!(r2 > COV_PIVOT_EPS * rkk * rkk)) return 0;
+            r = sqrt(r2);
+        }
+        double c = r / rkk, s = xk / rkk;
+        rk[k] = r;
+        if (sign > 0) {
+            for (int j = k + 1; j < n; j++) {
+                rk[j] = (rk[j] + s * x[j]) / c;
+                x[j] = c * x[j] - s * rk[j];
+            }
+        } else {
+            for (int j = k + 1; j < n; j++) {
+                rk[j] = (rk[j] - s * x[j]) / c;
+                x[j] = c * x[j] - s * rk[j];
+            }
+        }
+    }
+    return 1;
+}
+
+/* R = upper Cholesky factor of S (upper triangle), right-looking by rows */
+static int chol_factor(const double *S, double *R, int n, int parallel) {
+    for (int i = 0; i < n; i++) {
+        memset(R + (size_t)i * n, 0, (size_t)i * sizeof(double));
+        memcpy(R + (size_t)i * n + i, S + (size_t)i * n + i, (size_t)(n - i) * sizeof(double));
+    }
+    for (int k = 0; k < n; k++) {
+        double *rk = R + (size_t)k * n;
+        double p = rk[k];
+        if (!(p > COV_PIVOT_EPS * S[(size_t)k * n + k]) || !(p > 0.0)) return 0;
+        double r = sqrt(p);
+        rk[k] = r;
+        for (int j = k + 1; j < n; j++) rk[j] /= r;
+        #pragma omp parallel for schedule(dynamic, 8) if (parallel && (long)(n - k) * (n - k) > COV_PARALLEL_WORK)
+        for (int i = k + 1; i < n; i++) {
+            double *ri = R + (size_t)i * n;
+            double a = rk[i];
+            #pragma omp simd
+            for (int j = i; j < n; j++) ri[j] -= a * rk[j];
+        }
+    }
+    return 1;
+}
+
+/* ===== Window statistics ===== */
+
+static void reset_stats(CovarianceWindow *w) {
+    size_t nn = (size_t)w->n * w->n;
+    w->count = 0;
+    memset(w->mean, 0, (size_t)w->n * sizeof(double));
+    memset(w->S, 0, nn * sizeof(double));
+    w->factor_valid = 0;
+}
+
+/* Merge (sign > 0) or remove (sign < 0) the k rows of X. X has room for
+ * k + 1 rows and is overwritten with the centered rows and the mean
+ * correction, which are then applied to S (and R) in one pass.
+ */
+static void apply_block(CovarianceWindow *w, double *X, int k, int sign) {
+    int n = w->n;
+    long N = w->count;
+    if (sign < 0 && N <= k) { reset_stats(w); return; }
+
+    double *d = X + (size_t)k * n;      /* the extra row */
+    memset(d, 0, (size_t)n * sizeof(double));
+    for (int r = 0; r < k; r++) {
+        const double *xr = X + (size_t)r * n;
+        for (int j = 0; j < n; j++) d[j] += xr[j];
+    }
+    for (int j = 0; j < n; j++) d[j] /= k;      /* block mean b */
+
+    long after = sign > 0 ? N + k : N - k;
+    double scale;
+    for (int r = 0; r < k; r++) {
+        double *xr = X + (size_t)r * n;
+        for (int j = 0; j < n; j++) xr[j] -= d[j];
+    }
+    if (sign > 0) {
+        /* d = b - m, weight N k / (N + k); m += (k / (N + k)) d */
+        scale = (double)N * k / (double)after;
+        for (int j = 0; j < n; j++) {
+            d[j] -= w->mean[j];
+            w->mean[j] += d[j] * k / (double)after;
+        }
+    } else {
+        /* m' = (N m - k b) / (N - k), d = b - m', weight (N - k) k / N */
+        scale = (double)after * k / (double)N;
+        for (int j = 0; j < n; j++) {
+            double m = (N * w->mean[j] - k * d[j]) / (double)after;
+            w->mean[j] = m;
+            d[j] -= m;
+        }
+    }
+    double root = sqrt(scale);
+    for (int j = 0; j < n; j++) d[j] *= root;
+
+    syrk_upper(n, k + 1, sign > 0 ? 1.0 : -1.0, X, w->S, w->parallel);
+    w->count = after;
+
+    if (w->track_cholesky && w->factor_valid) {
+        for (int r = 0; r <= k && w->factor_valid; r++) {
+            w->factor_valid = chol_rank_one(w->R, n, X + (size_t)r * n, sign);
+        }
+    } else {
+        w->factor_valid = 0;
+    }
+}
+
+/* Recompute count, mean, S (and R) from the rows in the ring */
+static void rebuild(CovarianceWindow *w) {
+    int n = w->n;
+    long N = w->count;
+    double *buf = w->scratch;
+    reset_stats(w);
+    w->count = N;
+    for (long r = 0; r < N; r++) {
+        const double *x = w->ring + (size_t)((w->head + r) % w->window) * n;
+        for (int j = 0; j < n; j++) w->mean[j] += x[j];
+    }
+    for (int j = 0; j < n; j++) w->mean[j] /= (N > 0 ? N : 1);
+
+    for (long r0 = 0; r0 < N; r0 += COV_REBUILD_BLOCK) {
+        int rows = N - r0 < COV_REBUILD_BLOCK ? (int)(N - r0) : COV_REBUILD_BLOCK;
+        for (int r = 0; r < rows; r++) {
+            const double *x = w->ring + (size_t)((w->head + r0 + r) % w->window) * n;
+            double *y = buf + (size_t)r * n;
+            for (int j = 0; j < n; j++) y[j] = x[j] - w->mean[j];
+        }
+        syrk_upper(n, rows, 1.0, buf, w->S, w->parallel);
+    }
+    w->retired = 0;
+    if (w->track_cholesky && N > n) w->factor_valid = chol_factor(w->S, w->R, n, w->parallel);
+}
+
+/* ===== Public API ===== */
+
+CovarianceWindow *cov_window_create(int n, int window, int track_cholesky, int parallel) {
+    if (n <= 0 || window < 0) return NULL;
+    CovarianceWindow *w = (CovarianceWindow *)calloc(1, sizeof(CovarianceWindow));
+    if (!w) return NULL;
+    size_t nn = (size_t)n * n;
+    w->n = n;
+    w->window = window;
+    w->track_cholesky = track_cholesky;
+    w->parallel = parallel;
+    w->mean = (double *)calloc((size_t)n, sizeof(double));
+    w->S = (double *)calloc(nn, sizeof(double));
+    w->R = (double *)calloc(nn, sizeof(double));
+    if (window > 0) {
+        w->ring = (double *)malloc((size_t)window * n * sizeof(double));
+        w->scratch = (double *)malloc((size_t)COV_REBUILD_BLOCK * n * sizeof(double));
+    }
+    if (!w->mean || !w->S || !w->R || (window > 0 && (!w->ring || !w->scratch))) {
+        cov_window_free(w);
+        return NULL;
+    }
+    return w;
+}
+
+void cov_window_free(CovarianceWindow *w) {
+    if (!w) return;
+    free(w->mean);
+    free(w->S);
+    free(w->R);
+    free(w->ring);
+    free(w->scratch);
+    free(w);
+}
+
+int cov_window_push(CovarianceWindow *w, const double *rows, int k, double *exec_time) {
+    if (!w || !rows || k < 0) return 0;
+    double start = get_time();
+    int n = w->n;
+
+    if (w->window > 0 && k >= w->window) {
+        /* Everything in the window is replaced: start over from the tail */
+        memcpy(w->ring, rows + (size_t)(k - w->window) * n, (size_t)w->window * n * sizeof(double));
+        w->head = 0;
+        w->count = w->window;
+        rebuild(w);
+        if (exec_time) *exec_time = get_time() - start;
+        return 1;
+    }
+
+    long expire = 0;
+    if (w->window > 0 && w->count + k > w->window) expire = w->count + k - w->window;
+    int width = (int)(expire > k ? expire : k);
+    double *X = (double *)malloc((size_t)(width + 1) * n * sizeof(double));
+    if (!X) return 0;
+
+    if (expire > 0) {
+        for (long r = 0; r < expire; r++) {
+            memcpy(X + (size_t)r * n, w->ring + (size_t)((w->head + r) % w->window) * n, (size_t)n * sizeof(double));
+        }
+        apply_block(w, X, (int)expire, -1);
+        w->head = (int)((w->head + expire) % w->window);
+        w->retired += expire;
+    }
+    if (k > 0) {
+        memcpy(X, rows, (size_t)k * n * sizeof(double));
+        long tail = w->count;
+        apply_block(w, X, k, 1);
+        for (int r = 0; r < k && w->window > 0; r++) {
+            memcpy(w->ring + (size_t)((w->head + tail + r) % w->window) * n, rows + (size_t)r * n,
+                   (size_t)n * sizeof(double));
+        }
+    }
+    free(X);
+
+    /* Downdates drift; start afresh once max(window, n) rows have left */
+    long period = w->window > n ? w->window : n;
+    if (w->window > 0 && w->retired >= period) rebuild(w);
+
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
+
+int cov_window_push_matrix(CovarianceWindow *w, const Matrix *m, double *exec_time) {
+    if (!w || !m) return 0;
+    if (m->cols != w->n) {
+        mat_log(MAT_LOG_ERROR, "Error: covariance window has %d variables, matrix '%s' has %d columns",
+                w->n, m->name, m->cols);
+        return 0;
+    }
+    if (m->layout == MAT_ROW_MAJOR) return cov_window_push(w, m->data[0], m->rows, exec_time);
+
+    double *rows = (double *)malloc((size_t)m->rows * m->cols * sizeof(double));
+    if (!rows) return 0;
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) rows[(size_t)i * m->cols + j] = mat_get(m, i, j);
+    }
+    int ok = cov_window_push(w, rows, m->rows, exec_time);
+    free(rows);
+    return ok;
+}
+
+int cov_window_vars(const CovarianceWindow *w) {
+    return w ? w->n : 0;
+}
+
+long cov_window_count(const CovarianceWindow *w) {
+    return w ? w->count : 0;
+}
+
+const double *cov_window_mean(const CovarianceWindow *w) {
+    return w ? w->mean : NULL;
+}
+
+Matrix *cov_window_covariance(const CovarianceWindow *w, const char *name) {
+    if (!w || !name || w->count < 2) return NULL;
+    int n = w->n;
+    Matrix *c = create_matrix(name, n, n);
+    if (!c) return NULL;
+    double inv = 1.0 / (double)(w->count - 1);
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) {
+            double v = w->S[(size_t)i * n + j] * inv;
+            c->data[i][j] = v;
+            c->data[j][i] = v;
+        }
+    }
+    return c;
+}
+
+/* Make R current, factoring S from scratch if the updates could not */
+static int ensure_factor(CovarianceWindow *w) {
+    if (w->factor_valid) return 1;
+    if (w->count <= w->n) return 0;
+    w->factor_valid = chol_factor(w->S, w->R, w->n, w->parallel);
+    return w->factor_valid;
+}
+
+int cov_window_logdet(CovarianceWindow *w, double *logdet) {
+    if (!w || !logdet) return 0;
+    *logdet = -INFINITY;
+    if (w->count < 2 || !ensure_factor(w)) return 0;
+    int n = w->n;
+    double s = 0.0;
+    for (int i = 0; i < n; i++) s += log(w->R[(size_t)i * n + i]);
+    *logdet = 2.0 * s - n * log((double)(w->count - 1));
+    return 1;
+}
+
+Matrix *cov_window_cholesky(CovarianceWindow *w, const char *name) {
+    if (!w || !name || w->count < 2 || !ensure_factor(w)) return NULL;
+    int n = w->n;
+    Matrix *l = create_matrix(name, n, n);
+    if (!l) return NULL;
+    double scale = 1.0 / sqrt((double)(w->count - 1));
+    for (int i = 0; i < n; i++) {
+        for (int j = i; j < n; j++) l->data[j][i] = w->R[(size_t)i * n + j] * scale;
+    }
+    return l;
+}
@@ -0,0 +1,68 @@
+#ifndef MATRIX_COVARIANCE_H
+#define MATRIX_COVARIANCE_H
+
+#include "matrix_types.h"
+
+/*
+ * Sample covariance of the last `window` rows of a stream, kept up to date
+ * as rows arrive instead of being rebuilt from the whole window.
+ *
+ * The window holds the count N, the mean m and the scatter matrix
+ * S = sum (x - m)(x - m)^T; the covariance is S / (N - 1). Merging a block
+ * of k rows with mean b and centered rows Bc into the window gives
+ *
+ *     S += Bc^T Bc + (N k / (N + k)) d d^T,   d = b - m,
+ *
+ * and removing the k oldest rows is the same with the signs reversed and
+ * the counts swapped. Both are one SYRK-style rank-(k + 1) update of the
+ * upper triangle of S: O(k n^2) per step, independent of the window size.
+ *
+ * With track_cholesky the upper factor R (R^T R = S) follows the same
+ * k + 1 vectors through rank-one updates and hyperbolic downdates, so the
+ * log-determinant is always O(n) away. A downdate that would make S
+ * indefinite (too few rows left, or rounding) drops the factor; it is
+ * rebuilt from S, O(n^3), the next time it is asked for.
+ *
+ * Rounding in the downdates accumulates, so once max(window, n) rows have
+ * left the window the statistics (and R) are recomputed from the retained
+ * rows: an amortized O(n^2) per row.
+ */
+
+typedef struct CovarianceWindow CovarianceWindow;
+
+/* n variables over the last window rows (window 0: every row pushed, never
+ * downdated). parallel runs the rank-k updates with OpenMP. Returns NULL
+ * on bad arguments or allocation failure.
+ */
+CovarianceWindow *cov_window_create(int n, int window, int track_cholesky, int parallel);
+void cov_window_free(CovarianceWindow *w);
+
+/* Append k rows (k x n, row-major). Rows that fall out of the window are
+ * removed first. Returns 0 on allocation failure (the window is then
+ * unchanged).
+ */
+int cov_window_push(CovarianceWindow *w, const double *rows, int k, double *exec_time);
+
+/* Append every row of m (m->cols == n, either layout) */
+int cov_window_push_matrix(CovarianceWindow *w, const Matrix *m, double *exec_time);
+
+int cov_window_vars(const CovarianceWindow *w);
+long cov_window_count(const CovarianceWindow *w);      /* rows in the window */
+const double *cov_window_mean(const CovarianceWindow *w);
+
+/* Sample covariance (divisor N - 1) as a new n x n matrix; NULL with fewer
+ * than two rows
+ */
+Matrix *cov_window_covariance(const CovarianceWindow *w, const char *name);
+
+/* log det of the sample covariance. Returns 0 if it is not positive
+ * definite (e.g. N <= n), and then *logdet = -INFINITY.
+ */
+int cov_window_logdet(CovarianceWindow *w, double *logdet);
+
+/* Lower Cholesky factor of the sample covariance as a new matrix; NULL if
+ * it is not positive definite
+ */
+Matrix *cov_window_cholesky(CovarianceWindow *w, const char *name);
+
+#endif /* MATRIX_COVARIANCE_H */
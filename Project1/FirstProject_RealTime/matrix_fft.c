@@ -0,0 +1,136 @@
+#include "matrix_fft.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+struct FftPlan {
+    int n;
+    double complex *twiddle;   /* radix-2: e^{-2 pi i k / n}, k < n / 2 */
+    /* Bluestein (n not a power of two) */
+    double complex *chirp;     /* e^{-i pi k^2 / n}, k < n */
+    double complex *filter;    /* transform of the conjugate chirp, length inner->n */
+    FftPlan *inner;            /* power-of-two plan for the convolution */
+};
+
+int fft_next_pow2(int n) {
+    int p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static int is_pow2(int n) {
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+/* Forward radix-2 transform: bit-reversal permutation, then log2(n) stages */
+static void radix2(const FftPlan *p, double complex *x) {
+    int n = p->n;
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j |= bit;
+        if (i < j) { double complex t = x[i]; x[i] = x[j]; x[j] = t; }
+    }
+    for (int len = 2; len <= n; len <<= 1) {
+        int half = len >> 1, step = n / len;
+        for (int s = 0; s < n; s += len) {
+            for (int k = 0; k < half; k++) {
+                double complex w = p->twiddle[k * step];
+                double complex u = x[s + k];
+                double complex v = x[s + k + half];
+                /* Explicit product: no NaN/Inf recovery (__muldc3) on the hot path */
+                double vr = creal(v) * creal(w) - cimag(v) * cimag(w);
+                double vi = creal(v) * cimag(w) + cimag(v) * creal(w);
+                x[s + k] = CMPLX(creal(u) + vr, cimag(u) + vi);
+                x[s + k + half] = CMPLX(creal(u) - vr, cimag(u) - vi);
+            }
+        }
+    }
+}
+
+static int bluestein(const FftPlan *p, double complex *x) {
+    int n = p->n, m = p->inner->n;
+    double complex *a = (double complex *)calloc((size_t)m, sizeof(double complex));
+    if (!a) return 0;
+    for (int k = 0; k < n; k++) a[k] = x[k] * p->chirp[k];
+    radix2(p->inner, a);
+    for (int k = 0; k < m; k++) a[k] *= p->filter[k];
+    /* Inverse by conjugation: conj(F(conj(a))) / m */
+    for (int k = 0; k < m; k++) a[k] = conj(a[k]);
+    radix2(p->inner, a);
+    for (int k = 0; k < n; k++) x[k] = p->chirp[k] * conj(a[k]) / m;
+    free(a);
+    return 1;
+}
+
+FftPlan *fft_plan_create(int n) {
+    if (n < 1) return NULL;
+    FftPlan *p = (FftPlan *)calloc(1, sizeof(FftPlan));
+    if (!p) return NULL;
+    p->n = n;
+
+    if (is_pow2(n)) {
+        p->twiddle = (double complex *)malloc((size_t)(n / 2 + 1) * sizeof(double complex));
+        if (!p->twiddle) { free(p); return NULL; }
+        for (int k = 0; k < n / 2; k++) {
+            double a = -2.0 * M_PI * k / n;
+            p->twiddle[k] = CMPLX(cos(a), sin(a));
+        }
+        return p;
+    }
+
+    int m = fft_next_pow2(2 * n - 1);
+    p->inner = fft_plan_create(m);
+    p->chirp = (double complex *)malloc((size_t)n * sizeof(double complex));
+    p->filter = (double complex *)calloc((size_t)m, sizeof(double complex));
+    if (!p->inner || !p->chirp || !p->filter) { fft_plan_free(p); return NULL; }
+    for (int k = 0; k < n; k++) {
+        /* k^2 mod 2n keeps the angle small, so it stays exact for large k */
+        long long q = (long long)k * k % (2LL * n);
+        double a = -M_PI * (double)q / n;
+        p->chirp[k] = CMPLX(cos(a), sin(a));
+    }
+    /* Filter h_j = conj(chirp_|j|) for j in (-n, n), stored circularly */
+    p->filter[0] = conj(p->chirp[0]);
+    for (int k = 1; k < n; k++) p->filter[k] = p->filter[m - k] = conj(p->chirp[k]);
+    radix2(p->inner, p->filter);
+    return p;
+}
+
+void fft_plan_free(FftPlan *p) {
+    if (!p) return;
+    fft_plan_free(p->inner);
+    free(p->twiddle);
+    free(p->chirp);
+    free(p->filter);
+    free(p);
+}
+
+int fft_execute(const FftPlan *p, double complex *x, int inverse) {
+    if (!p || !x) return 0;
+    int n = p->n;
+    /* inverse(x) = conj(forward(conj(x))) / n */
+    if (inverse) for (int k = 0; k < n; k++) x[k] = conj(x[k]);
+    if (p->inner) {
+        if (!bluestein(p, x)) return 0;
+    } else {
+        radix2(p, x);
+    }
+    if (inverse) {
+        double s = 1.0 / n;
+        for (int k = 0; k < n; k++) x[k] = CMPLX(creal(x[k]) * s, -cimag(x[k]) * s);
+    }
+    return 1;
+}
+
+int fft_complex(double complex *x, int n, int inverse) {
+    FftPlan *p = fft_plan_create(n);
+    if (!p) return 0;
+    int ok = fft_execute(p, x, inverse);
+    fft_plan_free(p);
+    return ok;
+}
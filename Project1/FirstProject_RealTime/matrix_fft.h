@@ -0,0 +1,39 @@
+#ifndef MATRIX_FFT_H
+#define MATRIX_FFT_H
+
+#include <complex.h>
+
+/*
+ * Self-contained discrete Fourier transform for the structured kernels
+ * (matrix_toeplitz.h):
+ *
+ *     forward  X_k = sum_j x_j e^{-2 pi i jk / n}
+ *     inverse  x_j = (1 / n) sum_k X_k e^{+2 pi i jk / n}
+ *
+ * Power-of-two lengths use an iterative radix-2 transform with a twiddle
+ * table. Any other length uses Bluestein's chirp-z algorithm, which
+ * rewrites the DFT as a convolution computed with power-of-two transforms
+ * of length >= 2n - 1. Both are O(n log n).
+ *
+ * A plan holds the tables for one length. It is read-only once created,
+ * so one plan can run on many threads at once.
+ */
+
+typedef struct FftPlan FftPlan;
+
+/* Plan for length n >= 1. Returns NULL on allocation failure */
+FftPlan *fft_plan_create(int n);
+void fft_plan_free(FftPlan *p);
+
+/* Transform the plan's n values in place. Returns 1, or 0 if the
+ * Bluestein scratch buffer cannot be allocated
+ */
+int fft_execute(const FftPlan *p, double complex *x, int inverse);
+
+/* One-shot transform (creates and frees a plan) */
+int fft_complex(double complex *x, int n, int inverse);
+
+/* Smallest power of two >= n */
+int fft_next_pow2(int n);
+
+#endif /* MATRIX_FFT_H */
@@ -1,7 +1,18 @@
 #include "matrix_types.h"
+#include "matrix_file_ops.h"
+#include "matrix_formats.h"
+#include "matrix_complex.h"
+#include "matrix_toeplitz.h"
+#include "matrix_int.h"
+#include "matrix_stream.h"
+#include "matrix_log.h"
 #include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/stat.h>
 #include <ctype.h>
+#include <string.h>
+#include <errno.h>
 
 /*
  * File I/O and bulk operations for matrix collection (options 5-9)
@@ -14,6 +25,13 @@ static int file_exists(const char *path) {
     return (stat(path, &st) == 0 && S_ISREG(st.st_mode));
 }
 
+/* Pipes, FIFOs, sockets and devices can only be read front to back */
+static int is_stream_file(const char *path) {
+    struct stat st;
+    return (stat(path, &st) == 0 &&
+            (S_ISFIFO(st.st_mode) || S_ISCHR(st.st_mode) || S_ISSOCK(st.st_mode)));
+}
+
 static int dir_exists(const char *path) {
     struct stat st;
     return (stat(path, &st) == 0 && S_ISDIR(st.st_mode));
@@ -30,14 +48,35 @@ static void trim_newline(char *s) {
 
 /* ===== Option 5: Read matrix from file ===== */
 Matrix *read_matrix_from_file(const char *filepath) {
+    if (filepath && is_stream_file(filepath)) {
+        int fd = open(filepath, O_RDONLY);
+        if (fd < 0) { mat_log(MAT_LOG_ERROR, "open: %s", strerror(errno)); return NULL; }
+        MatrixStream *s = matrix_stream_open(fd, filepath);
+        Matrix *m = matrix_stream_next(s);
+        /* Only one matrix is returned. Waiting for the writer to send or
+         * close would block, so warn only about input already received.
+         */
+        if (m && matrix_stream_pending(s)) {
+            mat_log(MAT_LOG_WARN, "%s holds more than one matrix; kept '%s' and discarded the rest "
+                    "(read_matrices_from_stream_path / mat_read_stream load them all)", filepath, m->name);
+        }
+        matrix_stream_close(s);
+        close(fd);
+        return m;
+    }
+
     if (!filepath || !file_exists(filepath)) {
-        fprintf(stderr, "File '%s' not found or invalid.\n", filepath);
+        mat_log(MAT_LOG_ERROR, "File '%s' not found or invalid.", filepath);
         return NULL;
     }
 
+    // Binary/interop formats are recognized by extension
+    if (matrix_path_has_ext(filepath, ".npy")) return read_matrix_npy(filepath);
+    if (matrix_path_has_ext(filepath, ".mtx")) return read_matrix_mtx(filepath);
+
     FILE *f = fopen(filepath, "r");
     if (!f) {
-        perror("fopen");
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
         return NULL;
     }
 
@@ -46,20 +85,28 @@ Matrix *read_matrix_from_file(const char *filepath) {
 
     // Read: name, rows, cols
     if (fscanf(f, "%63s", name) != 1) {
-        fprintf(stderr, "Failed to read matrix name from %s\n", filepath);
+        mat_log(MAT_LOG_ERROR, "Failed to read matrix name from %s", filepath);
         fclose(f);
         return NULL;
     }
 
     if (fscanf(f, "%d %d", &rows, &cols) != 2 || rows <= 0 || cols <= 0) {
-        fprintf(stderr, "Invalid dimensions in %s\n", filepath);
+        mat_log(MAT_LOG_ERROR, "Invalid dimensions in %s", filepath);
+        fclose(f);
+        return NULL;
+    }
+
+    // A word after the dimensions tags another matrix type (see matrix_file_tag)
+    char tag[16];
+    if (fscanf(f, " %15[A-Za-z]", tag) == 1) {
+        mat_log(MAT_LOG_ERROR, "%s holds a %s matrix, not a dense real one", filepath, tag);
         fclose(f);
         return NULL;
     }
 
     Matrix *m = create_matrix(name, rows, cols);
     if (!m) {
-        fprintf(stderr, "Failed to allocate matrix.\n");
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
         fclose(f);
         return NULL;
     }
@@ -68,7 +115,7 @@ Matrix *read_matrix_from_file(const char *filepath) {
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
             if (fscanf(f, "%lf", &m->data[i][j]) != 1) {
-                fprintf(stderr, "Failed to read element [%d][%d] from %s\n", i, j, filepath);
+                mat_log(MAT_LOG_ERROR, "Failed to read element [%d][%d] from %s", i, j, filepath);
                 free_matrix(m);
                 fclose(f);
                 return NULL;
@@ -77,21 +124,40 @@ Matrix *read_matrix_from_file(const char *filepath) {
     }
 
     fclose(f);
-    printf("Successfully loaded matrix '%s' (%dx%d) from %s\n", name, rows, cols, filepath);
+    mat_log(MAT_LOG_INFO, "Successfully loaded matrix '%s' (%dx%d) from %s", name, rows, cols, filepath);
     return m;
 }
 
+int matrix_file_tag(const char *filepath, char *tag, size_t n) {
+    if (!tag || n == 0) return 0;
+    tag[0] = '\0';
+    /* Never peek at a pipe: the bytes would be gone for the real reader */
+    if (!filepath || !file_exists(filepath)) return 0;
+    if (matrix_path_has_ext(filepath, ".npy") || matrix_path_has_ext(filepath, ".mtx")) return 0;
+
+    FILE *f = fopen(filepath, "r");
+    if (!f) return 0;
+    char name[MAX_NAME_LENGTH], word[16];
+    int rows, cols;
+    int found = fscanf(f, "%63s", name) == 1 && fscanf(f, "%d %d", &rows, &cols) == 2 &&
+                fscanf(f, " %15[A-Za-z]", word) == 1;
+    fclose(f);
+    if (!found) return 0;
+    snprintf(tag, n, "%s", word);
+    return 1;
+}
+
 /* ===== Option 6: Read all matrices from a folder ===== */
 int read_matrices_from_folder(const char *folder, MatrixCollection *col) {
     if (!folder || !col) return 0;
     if (!dir_exists(folder)) {
-        fprintf(stderr, "Directory '%s' not found.\n", folder);
+        mat_log(MAT_LOG_ERROR, "Directory '%s' not found.", folder);
         return 0;
     }
 
     DIR *dir = opendir(folder);
     if (!dir) {
-        perror("opendir");
+        mat_log(MAT_LOG_ERROR, "opendir: %s", strerror(errno));
         return 0;
     }
 
@@ -101,37 +167,73 @@ int read_matrices_from_folder(const char *folder, MatrixCollection *col) {
         // Skip . and ..
         if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) continue;
 
-        // Only process .txt files
-        size_t len = strlen(ent->d_name);
-        if (len < 5 || strcmp(ent->d_name + len - 4, ".txt") != 0) continue;
+        // Only process .txt, .npy and .mtx files
+        if (!matrix_path_has_ext(ent->d_name, ".txt") &&
+            !matrix_path_has_ext(ent->d_name, ".npy") &&
+            !matrix_path_has_ext(ent->d_name, ".mtx")) continue;
 
         // Build full path
         char path[512];
         snprintf(path, sizeof(path), "%s/%s", folder, ent->d_name);
 
+        // Complex files go to the collection's complex list
+        if (matrix_file_is_complex(path)) {
+            ComplexMatrix *z = read_complex_matrix_from_file(path);
+            if (z && add_complex_matrix(col, z)) {
+                loaded++;
+            } else if (z) {
+                mat_log(MAT_LOG_ERROR, "Matrix '%s' already exists or failed to add.", z->name);
+                free_complex_matrix(z);
+            }
+            continue;
+        }
+        // Toeplitz/circulant files go to the Toeplitz list
+        if (matrix_file_is_toeplitz(path)) {
+            ToeplitzMatrix *t = read_toeplitz_matrix_from_file(path);
+            if (t && add_toeplitz_matrix(col, t)) {
+                loaded++;
+            } else if (t) {
+                mat_log(MAT_LOG_ERROR, "Matrix '%s' already exists or failed to add.", t->name);
+                free_toeplitz_matrix(t);
+            }
+            continue;
+        }
+        // Integer files are parsed exactly into the integer list
+        if (matrix_file_is_int(path)) {
+            IntMatrix *im = read_int_matrix_from_file(path);
+            if (im && add_int_matrix(col, im)) {
+                loaded++;
+            } else if (im) {
+                mat_log(MAT_LOG_ERROR, "Matrix '%s' already exists or failed to add.", im->name);
+                free_int_matrix(im);
+            }
+            continue;
+        }
+
         Matrix *m = read_matrix_from_file(path);
         if (m) {
             if (add_matrix(col, m)) {
                 loaded++;
             } else {
-                fprintf(stderr, "Matrix '%s' already exists or failed to add.\n", m->name);
+                mat_log(MAT_LOG_ERROR, "Matrix '%s' already exists or failed to add.", m->name);
                 free_matrix(m);
             }
         }
     }
 
     closedir(dir);
-    printf("Loaded %d matri%s from '%s'.\n", loaded, loaded == 1 ? "x" : "ces", folder);
+    mat_log(MAT_LOG_INFO, "Loaded %d matri%s from '%s'.", loaded, loaded == 1 ? "x" : "ces", folder);
     return loaded;
 }
 
 /* ===== Option 7: Save matrix to file ===== */
 int write_matrix_to_file(const Matrix *m, const char *filepath) {
     if (!m || !filepath) return 0;
+    if (matrix_path_has_ext(filepath, ".npy")) return write_matrix_npy(m, filepath);
 
     FILE *f = fopen(filepath, "w");
     if (!f) {
-        perror("fopen");
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
         return 0;
     }
 
@@ -141,40 +243,67 @@ int write_matrix_to_file(const Matrix *m, const char *filepath) {
 
     for (int i = 0; i < m->rows; i++) {
         for (int j = 0; j < m->cols; j++) {
-            fprintf(f, "%.10f", m->data[i][j]);
+            fprintf(f, "%.10f", mat_get(m, i, j));
             if (j < m->cols - 1) fprintf(f, " ");
         }
         fprintf(f, "\n");
     }
 
     fclose(f);
-    printf("Matrix '%s' saved to %s\n", m->name, filepath);
+    mat_log(MAT_LOG_INFO, "Matrix '%s' saved to %s", m->name, filepath);
     return 1;
 }
 
 /* ===== Option 8: Save all matrices to folder ===== */
 int save_all_matrices_to_folder(const MatrixCollection *col, const char *folder) {
-    if (!col || !folder) return 0;
+    return save_all_matrices_to_folder_as(col, folder, ".txt");
+}
+
+int save_all_matrices_to_folder_as(const MatrixCollection *col, const char *folder, const char *ext) {
+    if (!col || !folder || !ext) return 0;
 
     // Create directory if it doesn't exist
     if (!dir_exists(folder)) {
         if (mkdir(folder, 0755) != 0) {
-            perror("mkdir");
+            mat_log(MAT_LOG_ERROR, "mkdir: %s", strerror(errno));
             return 0;
         }
-        printf("Created directory '%s'.\n", folder);
+        mat_log(MAT_LOG_INFO, "Created directory '%s'.", folder);
     }
 
     int saved = 0;
     for (int i = 0; i < col->count; i++) {
         char path[512];
-        snprintf(path, sizeof(path), "%s/%s.txt", folder, col->items[i]->name);
+        snprintf(path, sizeof(path), "%s/%s%s", folder, col->items[i]->name, ext);
         if (write_matrix_to_file(col->items[i], path)) {
             saved++;
         }
     }
+    for (int i = 0; i < col->complex_count; i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s%s", folder, col->complex_items[i]->name, ext);
+        if (write_complex_matrix_to_file(col->complex_items[i], path)) {
+            saved++;
+        }
+    }
+    // Toeplitz matrices have no .npy form: always their own text format
+    for (int i = 0; i < col->toeplitz_count; i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.txt", folder, col->toeplitz_items[i]->name);
+        if (write_toeplitz_matrix_to_file(col->toeplitz_items[i], path)) {
+            saved++;
+        }
+    }
+    // Integer matrices likewise: .npy would go through double and round
+    for (int i = 0; i < col->int_count; i++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.txt", folder, col->int_items[i]->name);
+        if (write_int_matrix_to_file(col->int_items[i], path)) {
+            saved++;
+        }
+    }
 
-    printf("Saved %d matri%s to '%s'.\n", saved, saved == 1 ? "x" : "ces", folder);
+    mat_log(MAT_LOG_INFO, "Saved %d matri%s to '%s'.", saved, saved == 1 ? "x" : "ces", folder);
     return saved;
 }
 
@@ -185,13 +314,14 @@ void display_all_matrices(const MatrixCollection *c) {
         return;
     }
 
-    if (c->count == 0) {
+    int total = c->count + c->complex_count + c->toeplitz_count + c->int_count;
+    if (total == 0) {
         puts("\nNo matrices in memory.\n");
         return;
     }
 
     printf("\n========================================\n");
-    printf("MATRICES IN MEMORY (%d total)\n", c->count);
+    printf("MATRICES IN MEMORY (%d total)\n", total);
     printf("========================================\n");
 
     for (int i = 0; i < c->count; i++) {
@@ -201,6 +331,27 @@ void display_all_matrices(const MatrixCollection *c) {
                c->items[i]->rows,
                c->items[i]->cols);
     }
+    for (int i = 0; i < c->complex_count; i++) {
+        printf("%d. %s - %dx%d complex\n",
+               c->count + i + 1,
+               c->complex_items[i]->name,
+               c->complex_items[i]->rows,
+               c->complex_items[i]->cols);
+    }
+    for (int i = 0; i < c->toeplitz_count; i++) {
+        const ToeplitzMatrix *t = c->toeplitz_items[i];
+        printf("%d. %s - %dx%d %s\n",
+               c->count + c->complex_count + i + 1,
+               t->name, t->rows, t->cols,
+               t->kind == STRUCTURE_CIRCULANT ? "circulant" : "toeplitz");
+    }
+    for (int i = 0; i < c->int_count; i++) {
+        const IntMatrix *im = c->int_items[i];
+        printf("%d. %s - %dx%d %s\n",
+               c->count + c->complex_count + c->toeplitz_count + i + 1,
+               im->name, im->rows, im->cols,
+               im->type == INT_ELEM_I32 ? "int32" : "int64");
+    }
 
     printf("========================================\n\n");
 }
@@ -10,26 +10,47 @@
 
 /* Option 5: Read a single matrix from a file
  * File format: name\n rows cols\n data...
+ * Files ending in .npy or .mtx are read as NumPy / MatrixMarket (matrix_formats.h)
+ * FIFOs and devices are read with the stream reader (first matrix only,
+ * without waiting for more input; a warning is logged if another matrix was
+ * already received: use read_matrices_from_stream_path to load all of them)
  * Returns: Matrix pointer or NULL on error
  */
 Matrix *read_matrix_from_file(const char *filepath);
 
-/* Option 6: Read all .txt matrices from a folder into collection
+/* Word after the dimensions in a text matrix file ("complex", "toeplitz",
+ * "circulant", "int") marking a matrix that is not dense real. Regular
+ * files only.
+ * Returns: 1 and the word in tag, or 0 (tag empty) for an untagged file
+ */
+int matrix_file_tag(const char *filepath, char *tag, size_t n);
+
+/* Option 6: Read all .txt, .npy and .mtx matrices from a folder into collection
+ * (complex files, see matrix_complex.h, Toeplitz files, see
+ * matrix_toeplitz.h, and integer files, see matrix_int.h, go to their own
+ * lists)
  * Returns: number of matrices successfully loaded
  */
 int read_matrices_from_folder(const char *folder, MatrixCollection *col);
 
 /* Option 7: Write a single matrix to a file
+ * A path ending in .npy writes a NumPy file, anything else the text format
  * Returns: 1 on success, 0 on failure
  */
 int write_matrix_to_file(const Matrix *m, const char *filepath);
 
-/* Option 8: Save all matrices in collection to a folder (one file per matrix)
+/* Option 8: Save all matrices in collection, complex, Toeplitz and integer
+ * ones included, to a folder (one file per matrix)
  * Creates folder if it doesn't exist
  * Returns: number of matrices successfully saved
  */
 int save_all_matrices_to_folder(const MatrixCollection *col, const char *folder);
 
+/* Same as save_all_matrices_to_folder, one <name><ext> file per matrix
+ * (ext is ".txt" or ".npy")
+ */
+int save_all_matrices_to_folder_as(const MatrixCollection *col, const char *folder, const char *ext);
+
 /* Option 9: Display summary of all matrices in collection
  * (Already declared in matrix_types.h, but included here for completeness)
  */
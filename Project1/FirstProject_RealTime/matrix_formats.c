@@ -0,0 +1,710 @@
+#include "matrix_formats.h"
+#include "matrix_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <errno.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* ===== Helpers ===== */
+
+int matrix_path_has_ext(const char *filepath, const char *ext) {
+    if (!filepath || !ext) return 0;
+    size_t len = strlen(filepath), elen = strlen(ext);
+    return len > elen && strcmp(filepath + len - elen, ext) == 0;
+}
+
+/* Matrix name = file name without directory and extension */
+static void name_from_path(const char *filepath, char *name) {
+    const char *base = strrchr(filepath, '/');
+    base = base ? base + 1 : filepath;
+    strncpy(name, base, MAX_NAME_LENGTH - 1);
+    name[MAX_NAME_LENGTH - 1] = '\0';
+    char *dot = strrchr(name, '.');
+    if (dot && dot != name) *dot = '\0';
+}
+
+static int host_is_little_endian(void) {
+    const uint16_t probe = 1;
+    return *(const uint8_t *)&probe == 1;
+}
+
+static void swap_bytes(void *p, size_t size) {
+    uint8_t *b = (uint8_t *)p;
+    for (size_t i = 0; i < size / 2; ++i) {
+        uint8_t t = b[i]; b[i] = b[size - 1 - i]; b[size - 1 - i] = t;
+    }
+}
+
+/* ===== NumPy .npy ===== */
+
+/* Find the value following 'key': in the header dict */
+static const char *npy_find_key(const char *hdr, const char *key) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "'%s'", key);
+    const char *p = strstr(hdr, pattern);
+    if (!p) return NULL;
+    p = strchr(p + strlen(pattern), ':');
+    if (!p) return NULL;
+    ++p;
+    while (*p && isspace((unsigned char)*p)) ++p;
+    return p;
+}
+
+/* want_complex selects the accepted dtypes: f4/f8, or c8/c16 */
+static int npy_parse_dict(const char *hdr, NpyHeader *h, int want_complex) {
+    const char *p = npy_find_key(hdr, "descr");
+    if (!p || (*p != '\'' && *p != '"')) return 0;
+    char bo = p[1], kind = p[2];
+    int size = atoi(p + 3);
+    if (want_complex ? (kind != 'c' || (size != 8 && size != 16))
+                     : (kind != 'f' || (size != 4 && size != 8))) return 0;
+    h->is_complex = want_complex;
+    if (bo == '<') h->little_endian = 1;
+    else if (bo == '>') h->little_endian = 0;
+    else if (bo == '=' || bo == '|') h->little_endian = host_is_little_endian();
+    else return 0;
+    h->itemsize = size;
+
+    p = npy_find_key(hdr, "fortran_order");
+    if (!p) return 0;
+    h->fortran_order = (strncmp(p, "True", 4) == 0);
+
+    p = npy_find_key(hdr, "shape");
+    if (!p || *p != '(') return 0;
+    long dims[2] = {0, 0};
+    int ndim = 0;
+    ++p;
+    while (*p && *p != ')') {
+        while (*p && (isspace((unsigned char)*p) || *p == ',')) ++p;
+        if (*p == ')') break;
+        char *end = NULL;
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0 || v > 0x7fffffffL) return 0;
+        if (ndim >= 2) return 0;
+        dims[ndim++] = v;
+        p = end;
+    }
+    if (ndim == 1) { h->rows = (int)dims[0]; h->cols = 1; }
+    else if (ndim == 2) { h->rows = (int)dims[0]; h->cols = (int)dims[1]; }
+    else return 0;
+    return 1;
+}
+
+int npy_parse_header(const char *hdr, NpyHeader *h) {
+    return npy_parse_dict(hdr, h, 0);
+}
+
+int npy_header_extent(const unsigned char *pre, size_t *hstart, size_t *hlen) {
+    if (memcmp(pre, NPY_MAGIC, NPY_MAGIC_LEN) != 0) return 0;
+    int major = pre[6];
+    if (major == 1) {
+        *hlen = (size_t)pre[8] | ((size_t)pre[9] << 8);
+        *hstart = 10;
+    } else if (major == 2 || major == 3) {
+        *hlen = (size_t)pre[8] | ((size_t)pre[9] << 8) | ((size_t)pre[10] << 16) | ((size_t)pre[11] << 24);
+        *hstart = 12;
+    } else {
+        return 0;
+    }
+    return major;
+}
+
+void npy_convert_data(const unsigned char *src, const NpyHeader *h, Matrix *m) {
+    int isz = h->itemsize;
+    int native = (h->little_endian == host_is_little_endian());
+    /* Walk the payload in file order; the destination follows m's strides */
+    int major = h->fortran_order ? h->cols : h->rows;
+    int minor = h->fortran_order ? h->rows : h->cols;
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < major; ++k) {
+        for (int l = 0; l < minor; ++l) {
+            size_t idx = (size_t)k * minor + l;
+            unsigned char buf[8];
+            memcpy(buf, src + idx * isz, (size_t)isz);
+            if (!native) swap_bytes(buf, (size_t)isz);
+            double *dst = h->fortran_order ? mat_at(m, l, k) : mat_at(m, k, l);
+            if (isz == 8) {
+                double v; memcpy(&v, buf, 8); *dst = v;
+            } else {
+                float v; memcpy(&v, buf, 4); *dst = v;
+            }
+        }
+    }
+}
+
+int npy_is_native_f8(const NpyHeader *h) {
+    return h->itemsize == 8 && h->little_endian == host_is_little_endian();
+}
+
+MatrixLayout npy_layout(const NpyHeader *h) {
+    return h->fortran_order ? MAT_COL_MAJOR : MAT_ROW_MAJOR;
+}
+
+/* Open filepath and parse its header (f4/f8 or, with want_complex, c8/c16),
+ * checking that the payload is all there. Returns the open descriptor with
+ * h and *file_len filled in, or -1 after logging the reason.
+ */
+static int npy_open(const char *filepath, int want_complex, NpyHeader *h, size_t *file_len) {
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) { mat_log(MAT_LOG_ERROR, "open: %s", strerror(errno)); return -1; }
+
+    struct stat st;
+    unsigned char pre[12];
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(pre) ||
+        pread(fd, pre, sizeof(pre), 0) != (ssize_t)sizeof(pre) ||
+        memcmp(pre, NPY_MAGIC, NPY_MAGIC_LEN) != 0) {
+        mat_log(MAT_LOG_ERROR, "'%s' is not a valid .npy file", filepath);
+        close(fd);
+        return -1;
+    }
+
+    size_t hlen, hstart;
+    if (!npy_header_extent(pre, &hstart, &hlen)) {
+        mat_log(MAT_LOG_ERROR, "Unsupported .npy version %d in %s", pre[6], filepath);
+        close(fd);
+        return -1;
+    }
+
+    char *hdr = (char *)malloc(hlen + 1);
+    if (!hdr || pread(fd, hdr, hlen, (off_t)hstart) != (ssize_t)hlen) {
+        mat_log(MAT_LOG_ERROR, "Truncated .npy header in %s", filepath);
+        free(hdr); close(fd);
+        return -1;
+    }
+    hdr[hlen] = '\0';
+
+    memset(h, 0, sizeof(*h));
+    int ok = npy_parse_dict(hdr, h, want_complex);
+    int other = !ok && npy_parse_dict(hdr, h, !want_complex);
+    free(hdr);
+    if (!ok) {
+        if (other) {
+            mat_log(MAT_LOG_ERROR, "%s holds a %s matrix; load it with %s", filepath,
+                    want_complex ? "real" : "complex",
+                    want_complex ? "read_matrix_npy" : "read_complex_matrix_npy");
+        } else {
+            mat_log(MAT_LOG_ERROR, "Unsupported .npy dtype/shape in %s (need 1-D/2-D %s)", filepath,
+                    want_complex ? "c8 or c16" : "f4 or f8");
+        }
+        close(fd);
+        return -1;
+    }
+    h->data_offset = hstart + hlen;
+
+    size_t count = (size_t)h->rows * (size_t)h->cols;
+    *file_len = (size_t)st.st_size;
+    if (h->data_offset + count * (size_t)h->itemsize > *file_len) {
+        mat_log(MAT_LOG_ERROR, "Truncated .npy data in %s", filepath);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+Matrix *read_matrix_npy(const char *filepath) {
+    if (!filepath) return NULL;
+    NpyHeader h;
+    size_t file_len;
+    int fd = npy_open(filepath, 0, &h, &file_len);
+    if (fd < 0) return NULL;
+
+    char name[MAX_NAME_LENGTH];
+    name_from_path(filepath, name);
+    /* Zero-copy path: rows (or columns, for fortran_order) point straight
+     * into a private file mapping
+     */
+    if (npy_is_native_f8(&h) && h.data_offset % sizeof(double) == 0) {
+        void *map = mmap(NULL, file_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (map == MAP_FAILED) { mat_log(MAT_LOG_ERROR, "mmap: %s", strerror(errno)); return NULL; }
+        Matrix *m = create_matrix_mapped(name, h.rows, h.cols, npy_layout(&h),
+                                         (double *)((char *)map + h.data_offset), map, file_len);
+        if (!m) { munmap(map, file_len); return NULL; }
+        mat_log(MAT_LOG_INFO, "Successfully mapped matrix '%s' (%dx%d) from %s", name, h.rows, h.cols, filepath);
+        return m;
+    }
+
+    /* Converting path: map read-only and convert dtype/byte order in parallel */
+    void *map = mmap(NULL, file_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { mat_log(MAT_LOG_ERROR, "mmap: %s", strerror(errno)); return NULL; }
+    Matrix *m = create_matrix_layout(name, h.rows, h.cols, npy_layout(&h));
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        munmap(map, file_len);
+        return NULL;
+    }
+
+    npy_convert_data((const unsigned char *)map + h.data_offset, &h, m);
+    munmap(map, file_len);
+    mat_log(MAT_LOG_INFO, "Successfully loaded matrix '%s' (%dx%d) from %s", name, h.rows, h.cols, filepath);
+    return m;
+}
+
+/* Version 1.0 preamble and header dict for a rows x cols array of dtype
+ * kind/itemsize, padded so that the data starts 64-byte aligned (this is
+ * what lets read_matrix_npy map it back without a copy).
+ * Returns: 1 on success, 0 on a write error
+ */
+static int npy_write_header(FILE *f, char kind, int itemsize, int fortran_order, int rows, int cols) {
+    char dict[256];
+    int dlen = snprintf(dict, sizeof(dict), "{'descr': '%c%c%d', 'fortran_order': %s, 'shape': (%d, %d), }",
+                        host_is_little_endian() ? '<' : '>', kind, itemsize,
+                        fortran_order ? "True" : "False", rows, cols);
+    if (dlen < 0 || dlen >= (int)sizeof(dict) - NPY_ALIGN) return 0;
+
+    /* Pad with spaces and a final newline */
+    size_t total = 10 + (size_t)dlen + 1;
+    size_t padded = (total + NPY_ALIGN - 1) / NPY_ALIGN * NPY_ALIGN;
+    size_t hlen = padded - 10;
+    memset(dict + dlen, ' ', hlen - 1 - (size_t)dlen);
+    dict[hlen - 1] = '\n';
+
+    unsigned char pre[10] = {0x93, 'N', 'U', 'M', 'P', 'Y', 1, 0,
+                             (unsigned char)(hlen & 0xff), (unsigned char)(hlen >> 8)};
+    return fwrite(pre, 1, sizeof(pre), f) == sizeof(pre) &&
+           fwrite(dict, 1, hlen, f) == hlen;
+}
+
+int write_matrix_npy(const Matrix *m, const char *filepath) {
+    if (!m || !filepath) return 0;
+
+    FILE *f = fopen(filepath, "wb");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return 0;
+    }
+    int ok = npy_write_header(f, 'f', 8, m->layout == MAT_COL_MAJOR, m->rows, m->cols);
+    /* Lines go out in storage order; the header records which order that is */
+    int major = mat_major_count(m);
+    size_t minor = (size_t)mat_minor_count(m);
+    for (int k = 0; ok && k < major; ++k) {
+        ok = fwrite(m->data[k], sizeof(double), minor, f) == minor;
+    }
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        mat_log(MAT_LOG_ERROR, "Failed to write %s", filepath);
+        return 0;
+    }
+    mat_log(MAT_LOG_INFO, "Matrix '%s' saved to %s", m->name, filepath);
+    return 1;
+}
+
+/* ===== Complex .npy (c8 / c16) ===== */
+
+int npy_file_is_complex(const char *filepath) {
+    if (!filepath) return 0;
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) return 0;
+    unsigned char pre[NPY_PREAMBLE_LEN];
+    size_t hstart, hlen;
+    int is_complex = 0;
+    if (pread(fd, pre, sizeof(pre), 0) == (ssize_t)sizeof(pre) && npy_header_extent(pre, &hstart, &hlen)) {
+        char *hdr = (char *)malloc(hlen + 1);
+        if (hdr && pread(fd, hdr, hlen, (off_t)hstart) == (ssize_t)hlen) {
+            hdr[hlen] = '\0';
+            NpyHeader h;
+            is_complex = npy_parse_dict(hdr, &h, 1);
+        }
+        free(hdr);
+    }
+    close(fd);
+    return is_complex;
+}
+
+ComplexMatrix *read_complex_matrix_npy(const char *filepath) {
+    if (!filepath) return NULL;
+    NpyHeader h;
+    size_t file_len;
+    int fd = npy_open(filepath, 1, &h, &file_len);
+    if (fd < 0) return NULL;
+
+    void *map = mmap(NULL, file_len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) { mat_log(MAT_LOG_ERROR, "mmap: %s", strerror(errno)); return NULL; }
+
+    char name[MAX_NAME_LENGTH];
+    name_from_path(filepath, name);
+    ComplexMatrix *m = create_complex_matrix(name, h.rows, h.cols);
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        munmap(map, file_len);
+        return NULL;
+    }
+
+    /* Each item is a (re, im) pair of floats or doubles; the storage is
+     * always row-major, so Fortran order is transposed on the way in
+     */
+    const unsigned char *src = (const unsigned char *)map + h.data_offset;
+    int half = h.itemsize / 2;
+    int native = (h.little_endian == host_is_little_endian());
+    int major = h.fortran_order ? h.cols : h.rows;
+    int minor = h.fortran_order ? h.rows : h.cols;
+    #pragma omp parallel for schedule(static)
+    for (int k = 0; k < major; ++k) {
+        for (int l = 0; l < minor; ++l) {
+            const unsigned char *item = src + ((size_t)k * minor + l) * h.itemsize;
+            size_t dst = h.fortran_order ? (size_t)l * h.cols + k : (size_t)k * h.cols + l;
+            for (int part = 0; part < 2; ++part) {
+                unsigned char buf[8];
+                memcpy(buf, item + part * half, (size_t)half);
+                if (!native) swap_bytes(buf, (size_t)half);
+                double v;
+                if (half == 8) { memcpy(&v, buf, 8); }
+                else { float x; memcpy(&x, buf, 4); v = x; }
+                m->v[2 * dst + part] = v;
+            }
+        }
+    }
+    munmap(map, file_len);
+    mat_log(MAT_LOG_INFO, "Successfully loaded complex matrix '%s' (%dx%d) from %s", name, h.rows, h.cols, filepath);
+    return m;
+}
+
+int write_complex_matrix_npy(const ComplexMatrix *m, const char *filepath) {
+    if (!m || !filepath) return 0;
+
+    FILE *f = fopen(filepath, "wb");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return 0;
+    }
+    /* The interleaved block already is a C-order c16 payload */
+    size_t count = 2 * (size_t)m->rows * (size_t)m->cols;
+    int ok = npy_write_header(f, 'c', 16, 0, m->rows, m->cols) &&
+             fwrite(m->v, sizeof(double), count, f) == count;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) {
+        mat_log(MAT_LOG_ERROR, "Failed to write %s", filepath);
+        return 0;
+    }
+    mat_log(MAT_LOG_INFO, "Complex matrix '%s' saved to %s", m->name, filepath);
+    return 1;
+}
+
+/* ===== MatrixMarket .mtx ===== */
+
+#define MTX_GENERAL   0
+#define MTX_SYMMETRIC 1
+#define MTX_SKEW      2
+
+typedef struct {
+    int coordinate;      /* 1 = coordinate, 0 = array */
+    int pattern;         /* pattern field: every listed entry is 1.0 */
+    int symmetry;        /* MTX_GENERAL / MTX_SYMMETRIC / MTX_SKEW */
+    int rows, cols;
+    long entries;        /* listed entries expected in the body */
+} MtxHeader;
+
+/* Parsed body: 0-based coordinates (coordinate format) and values */
+typedef struct {
+    int *ti, *tj;
+    double *tv;
+    long count;
+} MtxBody;
+
+static int is_blank_or_comment(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p >= end || *p == '\n' || *p == '%';
+}
+
+static const char *next_line(const char *p, const char *end) {
+    const char *q = (const char *)memchr(p, '\n', (size_t)(end - p));
+    return q ? q + 1 : end;
+}
+
+/* Read the whole file into a NUL-terminated buffer so strtod never runs
+ * past the end of the data
+ */
+static char *slurp_file(const char *filepath, size_t *len_out) {
+    int fd = open(filepath, O_RDONLY);
+    if (fd < 0) { mat_log(MAT_LOG_ERROR, "open: %s", strerror(errno)); return NULL; }
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); return NULL; }
+    size_t len = (size_t)st.st_size;
+    char *buf = (char *)malloc(len + 1);
+    if (!buf) { close(fd); return NULL; }
+    size_t got = 0;
+    while (got < len) {
+        ssize_t r = read(fd, buf + got, len - got);
+        if (r <= 0) break;
+        got += (size_t)r;
+    }
+    close(fd);
+    buf[got] = '\0';
+    *len_out = got;
+    return buf;
+}
+
+/* Parse banner and size line; returns pointer to the first body line */
+static const char *mtx_parse_header(const char *buf, const char *end, MtxHeader *h, const char *filepath) {
+    char object[32], format[32], field[32], symmetry[32];
+    if (sscanf(buf, "%%%%MatrixMarket %31s %31s %31s %31s", object, format, field, symmetry) != 4 ||
+        strcasecmp(object, "matrix") != 0) {
+        mat_log(MAT_LOG_ERROR, "Missing or invalid MatrixMarket banner in %s", filepath);
+        return NULL;
+    }
+    if (strcasecmp(format, "coordinate") == 0) h->coordinate = 1;
+    else if (strcasecmp(format, "array") == 0) h->coordinate = 0;
+    else { mat_log(MAT_LOG_ERROR, "Unknown MatrixMarket format '%s'", format); return NULL; }
+
+    if (strcasecmp(field, "pattern") == 0) h->pattern = 1;
+    else if (strcasecmp(field, "real") == 0 || strcasecmp(field, "integer") == 0 ||
+             strcasecmp(field, "double") == 0) h->pattern = 0;
+    else { mat_log(MAT_LOG_ERROR, "Unsupported MatrixMarket field '%s'", field); return NULL; }
+    if (h->pattern && !h->coordinate) { mat_log(MAT_LOG_ERROR, "Pattern field requires coordinate format"); return NULL; }
+
+    if (strcasecmp(symmetry, "general") == 0) h->symmetry = MTX_GENERAL;
+    else if (strcasecmp(symmetry, "symmetric") == 0 || strcasecmp(symmetry, "hermitian") == 0) h->symmetry = MTX_SYMMETRIC;
+    else if (strcasecmp(symmetry, "skew-symmetric") == 0) h->symmetry = MTX_SKEW;
+    else { mat_log(MAT_LOG_ERROR, "Unknown MatrixMarket symmetry '%s'", symmetry); return NULL; }
+
+    const char *p = next_line(buf, end);
+    while (p < end && is_blank_or_comment(p, end)) p = next_line(p, end);
+    if (p >= end) { mat_log(MAT_LOG_ERROR, "Missing size line in %s", filepath); return NULL; }
+
+    long r = 0, c = 0, nz = 0;
+    if (h->coordinate) {
+        if (sscanf(p, "%ld %ld %ld", &r, &c, &nz) != 3) r = 0;
+    } else {
+        if (sscanf(p, "%ld %ld", &r, &c) != 2) r = 0;
+        else if (h->symmetry == MTX_GENERAL) nz = r * c;
+        else if (h->symmetry == MTX_SYMMETRIC) nz = r * (r + 1) / 2;
+        else nz = r * (r - 1) / 2;
+    }
+    if (r <= 0 || c <= 0 || nz < 0 || r > 0x7fffffffL || c > 0x7fffffffL ||
+        (h->symmetry != MTX_GENERAL && r != c)) {
+        mat_log(MAT_LOG_ERROR, "Invalid MatrixMarket size line in %s", filepath);
+        return NULL;
+    }
+    h->rows = (int)r;
+    h->cols = (int)c;
+    h->entries = nz;
+    return next_line(p, end);
+}
+
+/* Step (i, j) to the next column-major array position */
+static void mtx_array_advance(const MtxHeader *h, int *i, int *j) {
+    if (++*i < h->rows) return;
+    ++*j;
+    if (h->symmetry == MTX_GENERAL) *i = 0;
+    else if (h->symmetry == MTX_SYMMETRIC) *i = *j;
+    else *i = *j + 1;
+}
+
+/* Column-major position -> (i, j) for array storage of the given symmetry */
+static void mtx_array_position(const MtxHeader *h, long idx, int *i, int *j) {
+    if (h->symmetry == MTX_GENERAL) {
+        *i = (int)(idx % h->rows);
+        *j = (int)(idx / h->rows);
+        return;
+    }
+    int skip = (h->symmetry == MTX_SKEW) ? 1 : 0;
+    int col = 0;
+    long len = h->rows - skip;
+    while (idx >= len && len > 0) {
+        idx -= len;
+        ++col;
+        len = h->rows - col - skip;
+    }
+    *j = col;
+    *i = col + skip + (int)idx;
+}
+
+/* Two-pass parallel tokenizer: pass 1 counts data lines per line-aligned
+ * chunk, pass 2 parses each chunk into its slice of the output arrays.
+ */
+static int mtx_parse_body(const char *body, const char *end, const MtxHeader *h, MtxBody *out,
+                          const char *filepath) {
+    int nchunks = 1;
+#ifdef _OPENMP
+    nchunks = omp_get_max_threads();
+#endif
+    size_t len = (size_t)(end - body);
+    if (len < (size_t)nchunks * 4096) nchunks = 1;
+
+    const char **starts = (const char **)malloc(((size_t)nchunks + 1) * sizeof(char *));
+    long *counts = (long *)calloc((size_t)nchunks + 1, sizeof(long));
+    if (!starts || !counts) { free(starts); free(counts); return 0; }
+    starts[0] = body;
+    for (int c = 1; c < nchunks; ++c) {
+        const char *p = body + len * (size_t)c / (size_t)nchunks;
+        if (p < starts[c - 1]) p = starts[c - 1];
+        if (p > body && p[-1] != '\n') p = next_line(p, end);
+        starts[c] = p;
+    }
+    starts[nchunks] = end;
+
+    #pragma omp parallel for schedule(static)
+    for (int c = 0; c < nchunks; ++c) {
+        long n = 0;
+        for (const char *p = starts[c]; p < starts[c + 1]; p = next_line(p, end)) {
+            if (!is_blank_or_comment(p, end)) ++n;
+        }
+        counts[c + 1] = n;
+    }
+    for (int c = 0; c < nchunks; ++c) counts[c + 1] += counts[c];
+
+    long total = counts[nchunks];
+    if (total != h->entries) {
+        mat_log(MAT_LOG_ERROR, "%s: expected %ld entries, found %ld", filepath, h->entries, total);
+        free(starts); free(counts);
+        return 0;
+    }
+
+    size_t alloc = (size_t)(total > 0 ? total : 1);
+    out->ti = (int *)malloc(alloc * sizeof(int));
+    out->tj = (int *)malloc(alloc * sizeof(int));
+    out->tv = (double *)malloc(alloc * sizeof(double));
+    out->count = total;
+    if (!out->ti || !out->tj || !out->tv) {
+        free(out->ti); free(out->tj); free(out->tv);
+        free(starts); free(counts);
+        return 0;
+    }
+
+    int bad = 0;
+    #pragma omp parallel for schedule(static) reduction(|:bad)
+    for (int c = 0; c < nchunks; ++c) {
+        long k = counts[c];
+        int ai = 0, aj = 0;
+        if (!h->coordinate && k < total) mtx_array_position(h, k, &ai, &aj);
+        for (const char *p = starts[c]; p < starts[c + 1] && !bad; p = next_line(p, end)) {
+            if (is_blank_or_comment(p, end)) continue;
+            char *q = (char *)p;
+            int i, j;
+            if (h->coordinate) {
+                long li = strtol(q, &q, 10);
+                long lj = strtol(q, &q, 10);
+                if (li < 1 || li > h->rows || lj < 1 || lj > h->cols) { bad = 1; break; }
+                i = (int)li - 1;
+                j = (int)lj - 1;
+            } else {
+                i = ai;
+                j = aj;
+                mtx_array_advance(h, &ai, &aj);
+            }
+            double v = 1.0;
+            if (!h->pattern) {
+                char *e = NULL;
+                v = strtod(q, &e);
+                if (e == q) { bad = 1; break; }
+            }
+            out->ti[k] = i;
+            out->tj[k] = j;
+            out->tv[k] = v;
+            ++k;
+        }
+    }
+    free(starts); free(counts);
+    if (bad) {
+        mat_log(MAT_LOG_ERROR, "Malformed entry in %s", filepath);
+        free(out->ti); free(out->tj); free(out->tv);
+        return 0;
+    }
+    return 1;
+}
+
+static int mtx_load(const char *filepath, MtxHeader *h, MtxBody *b) {
+    size_t len = 0;
+    char *buf = slurp_file(filepath, &len);
+    if (!buf) return 0;
+    memset(h, 0, sizeof(*h));
+    const char *body = mtx_parse_header(buf, buf + len, h, filepath);
+    int ok = body && mtx_parse_body(body, buf + len, h, b, filepath);
+    free(buf);
+    return ok;
+}
+
+Matrix *read_matrix_mtx(const char *filepath) {
+    if (!filepath) return NULL;
+    MtxHeader h;
+    MtxBody b;
+    if (!mtx_load(filepath, &h, &b)) return NULL;
+
+    char name[MAX_NAME_LENGTH];
+    name_from_path(filepath, name);
+    Matrix *m = create_matrix(name, h.rows, h.cols);
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        free(b.ti); free(b.tj); free(b.tv);
+        return NULL;
+    }
+
+    double sign = (h.symmetry == MTX_SKEW) ? -1.0 : 1.0;
+    int mirror = (h.symmetry != MTX_GENERAL);
+    /* Coordinate files may list duplicates (summed); atomics keep that exact */
+    #pragma omp parallel for schedule(static)
+    for (long k = 0; k < b.count; ++k) {
+        int i = b.ti[k], j = b.tj[k];
+        double v = b.tv[k];
+        #pragma omp atomic
+        m->data[i][j] += v;
+        if (mirror && i != j) {
+            #pragma omp atomic
+            m->data[j][i] += sign * v;
+        }
+    }
+
+    free(b.ti); free(b.tj); free(b.tv);
+    mat_log(MAT_LOG_INFO, "Successfully loaded matrix '%s' (%dx%d) from %s", name, h.rows, h.cols, filepath);
+    return m;
+}
+
+SparseMatrix *read_sparse_matrix_mtx(const char *filepath) {
+    if (!filepath) return NULL;
+    MtxHeader h;
+    MtxBody b;
+    if (!mtx_load(filepath, &h, &b)) return NULL;
+
+    /* Expand symmetric storage by appending the mirrored off-diagonal entries */
+    long extra = 0;
+    if (h.symmetry != MTX_GENERAL) {
+        for (long k = 0; k < b.count; ++k) if (b.ti[k] != b.tj[k]) ++extra;
+    }
+    if (extra > 0) {
+        size_t total = (size_t)(b.count + extra);
+        int *ti = (int *)realloc(b.ti, total * sizeof(int));
+        if (ti) b.ti = ti;
+        int *tj = (int *)realloc(b.tj, total * sizeof(int));
+        if (tj) b.tj = tj;
+        double *tv = (double *)realloc(b.tv, total * sizeof(double));
+        if (tv) b.tv = tv;
+        if (!ti || !tj || !tv) {
+            free(b.ti); free(b.tj); free(b.tv);
+            return NULL;
+        }
+        double sign = (h.symmetry == MTX_SKEW) ? -1.0 : 1.0;
+        long w = b.count;
+        for (long k = 0; k < b.count; ++k) {
+            if (b.ti[k] == b.tj[k]) continue;
+            b.ti[w] = b.tj[k];
+            b.tj[w] = b.ti[k];
+            b.tv[w] = sign * b.tv[k];
+            ++w;
+        }
+        b.count = w;
+    }
+
+    char name[MAX_NAME_LENGTH];
+    name_from_path(filepath, name);
+    SparseMatrix *s = sparse_from_triplets(name, h.rows, h.cols, b.count, b.ti, b.tj, b.tv);
+    free(b.ti); free(b.tj); free(b.tv);
+    if (!s) {
+        mat_log(MAT_LOG_ERROR, "Failed to build sparse matrix from %s", filepath);
+        return NULL;
+    }
+    mat_log(MAT_LOG_INFO, "Successfully loaded sparse matrix '%s' (%dx%d, %ld nonzeros) from %s",
+            name, s->rows, s->cols, s->nnz, filepath);
+    return s;
+}
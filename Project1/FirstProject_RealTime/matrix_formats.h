@@ -0,0 +1,95 @@
+#ifndef MATRIX_FORMATS_H
+#define MATRIX_FORMATS_H
+
+#include "matrix_types.h"
+#include "matrix_sparse.h"
+
+/*
+ * Interop with external matrix formats:
+ *   .npy  NumPy array files (format versions 1-3), dtypes f4/f8 in either
+ *         byte order, C or Fortran order, 1-D (n -> n x 1) or 2-D shapes;
+ *         c8/c16 files load as a ComplexMatrix.
+ *   .mtx  MatrixMarket files, coordinate or array, real/integer/pattern
+ *         fields, general/symmetric/skew-symmetric storage.
+ * The matrix name is taken from the file name without its extension.
+ */
+
+#define NPY_MAGIC "\x93NUMPY"
+#define NPY_MAGIC_LEN 6
+#define NPY_PREAMBLE_LEN 12   /* magic, version, header length (v2/v3 size) */
+#define NPY_ALIGN 64
+
+typedef struct {
+    int little_endian;
+    int itemsize;        /* 4 or 8; 8 or 16 for complex (both parts) */
+    int is_complex;
+    int fortran_order;
+    int rows, cols;
+    size_t data_offset;
+} NpyHeader;
+
+/* Read a .npy file. Native-endian f8 data is mapped straight from the file
+ * (MAP_PRIVATE, so edits never reach the file) with no copy; Fortran order
+ * loads as a MAT_COL_MAJOR matrix, C order as MAT_ROW_MAJOR. Other dtypes
+ * and byte orders are converted into a regular heap matrix.
+ * Returns: Matrix pointer or NULL on error
+ */
+Matrix *read_matrix_npy(const char *filepath);
+
+/* Write a matrix as a version 1.0 .npy file (native-endian f8, C order for
+ * row-major matrices, Fortran order for column-major ones).
+ * Returns: 1 on success, 0 on failure
+ */
+int write_matrix_npy(const Matrix *m, const char *filepath);
+
+/* 1 if filepath is a .npy file with a complex (c8/c16) dtype */
+int npy_file_is_complex(const char *filepath);
+
+/* Read a c8/c16 .npy file (either byte order, C or Fortran order) into
+ * interleaved row-major storage. Returns: ComplexMatrix pointer or NULL
+ */
+ComplexMatrix *read_complex_matrix_npy(const char *filepath);
+
+/* Write a complex matrix as a version 1.0 .npy file (native-endian c16,
+ * C order). Returns: 1 on success, 0 on failure
+ */
+int write_complex_matrix_npy(const ComplexMatrix *m, const char *filepath);
+
+/* Read a MatrixMarket file into dense storage. The body is tokenized by
+ * all OpenMP threads in parallel (one line-aligned chunk per thread).
+ * Returns: Matrix pointer or NULL on error
+ */
+Matrix *read_matrix_mtx(const char *filepath);
+
+/* Read a MatrixMarket file into CSR storage (duplicates are summed, symmetric
+ * storage is expanded). Returns: SparseMatrix pointer or NULL on error
+ */
+SparseMatrix *read_sparse_matrix_mtx(const char *filepath);
+
+/* Low-level .npy pieces shared with the stream reader (matrix_stream.h) */
+
+/* Locate the header dict from the first NPY_PREAMBLE_LEN bytes.
+ * Returns: format major version (1-3), or 0 if not a supported .npy preamble
+ */
+int npy_header_extent(const unsigned char *pre, size_t *hstart, size_t *hlen);
+
+/* Parse the NUL-terminated header dict (dtype, order, shape) into h.
+ * Returns: 1 on success, 0 for unsupported (including complex) dtypes/shapes
+ */
+int npy_parse_header(const char *hdr, NpyHeader *h);
+
+/* 1 if the payload is native-endian f8, i.e. already the block of a matrix
+ * created with npy_layout(h)
+ */
+int npy_is_native_f8(const NpyHeader *h);
+
+/* Layout matching the payload order: fortran_order loads as MAT_COL_MAJOR */
+MatrixLayout npy_layout(const NpyHeader *h);
+
+/* Convert a raw payload (any supported dtype/order) into m, in parallel */
+void npy_convert_data(const unsigned char *src, const NpyHeader *h, Matrix *m);
+
+/* 1 if filepath ends with ext (e.g. ".npy"), 0 otherwise */
+int matrix_path_has_ext(const char *filepath, const char *ext);
+
+#endif /* MATRIX_FORMATS_H */
@@ -0,0 +1,142 @@
+#include "matrix_gemm.h"
+#include <stddef.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Sub-problems with every dimension at most this size run the loop kernel */
+#define GEMM_LEAF 64
+
+/* Independent halves become tasks above this many multiply-adds */
+#define GEMM_TASK_WORK (1L << 20)
+
+/* Everything that stays fixed down the recursion */
+typedef struct {
+    double alpha, beta;
+    const GemmEpilogue *epi;
+    int parallel;
+} GemmCall;
+
+/* C tile row: first touch (beta) */
+static void scale_row(double *restrict c, int n, double beta) {
+    if (beta == 1.0) return;
+    if (beta == 0.0) {
+        for (int j = 0; j < n; j++) c[j] = 0.0;
+        return;
+    }
+    #pragma omp simd
+    for (int j = 0; j < n; j++) c[j] *= beta;
+}
+
+/* C tile row: sum complete (epilogue); row/col0 place it in the full C */
+static void finish_row(double *restrict c, int n, int row, int col0, const GemmEpilogue *e) {
+    if (e->bias && e->bias_per_row) {
+        double b = e->bias[row];
+        #pragma omp simd
+        for (int j = 0; j < n; j++) c[j] += b;
+    } else if (e->bias) {
+        const double *restrict b = e->bias + col0;
+        #pragma omp simd
+        for (int j = 0; j < n; j++) c[j] += b[j];
+    }
+    if (e->clamp) {
+        double lo = e->lo, hi = e->hi;
+        #pragma omp simd
+        for (int j = 0; j < n; j++) c[j] = c[j] < lo ? lo : (c[j] > hi ? hi : c[j]);
+    }
+    if (e->fn) {
+        for (int j = 0; j < n; j++) c[j] = e->fn(c[j], e->ctx);
+    }
+}
+
+/* first: this call is the first k-chunk into its C block; last: the final */
+static void gemm_leaf(const GemmCall *call, int m, int n, int k,
+                      const double *A, int lda, const double *B, int ldb,
+                      double *C, int ldc, int row0, int col0, int first, int last) {
+    for (int i = 0; i < m; i++) {
+        double *restrict crow = C + (size_t)i * ldc;
+        const double *arow = A + (size_t)i * lda;
+        if (first) scale_row(crow, n, call->beta);
+        for (int p = 0; p < k; p++) {
+            double s = call->alpha * arow[p];
+            if (s == 0.0) continue;
+            const double *restrict brow = B + (size_t)p * ldb;
+            #pragma omp simd
+            for (int j = 0; j < n; j++) crow[j] += s * brow[j];
+        }
+        if (last && call->epi) finish_row(crow, n, row0 + i, col0, call->epi);
+    }
+}
+
+static void gemm_node(const GemmCall *call, int m, int n, int k,
+                      const double *A, int lda, const double *B, int ldb,
+                      double *C, int ldc, int row0, int col0, int first, int last) {
+    if (m <= 0 || n <= 0) return;
+    if (m <= GEMM_LEAF && n <= GEMM_LEAF && k <= GEMM_LEAF) {
+        gemm_leaf(call, m, n, k, A, lda, B, ldb, C, ldc, row0, col0, first, last);
+        return;
+    }
+    int spawn = call->parallel && (long)m * n * (k > 0 ? k : 1) >= GEMM_TASK_WORK;
+
+    if (m >= n && m >= k) {
+        int h = m / 2;
+        #pragma omp task if (spawn)
+        gemm_node(call, h, n, k, A, lda, B, ldb, C, ldc, row0, col0, first, last);
+        gemm_node(call, m - h, n, k, A + (size_t)h * lda, lda, B, ldb,
+                  C + (size_t)h * ldc, ldc, row0 + h, col0, first, last);
+        #pragma omp taskwait
+    } else if (n >= k) {
+        int h = n / 2;
+        #pragma omp task if (spawn)
+        gemm_node(call, m, h, k, A, lda, B, ldb, C, ldc, row0, col0, first, last);
+        gemm_node(call, m, n - h, k, A, lda, B + h, ldb, C + h, ldc, row0, col0 + h, first, last);
+        #pragma omp taskwait
+    } else {
+        /* Both halves update the same C block: one after the other, beta
+         * applied by the first and the epilogue by the second
+         */
+        int h = k / 2;
+        gemm_node(call, m, n, h, A, lda, B, ldb, C, ldc, row0, col0, first, 0);
+        gemm_node(call, m, n, k - h, A + h, lda, B + (size_t)h * ldb, ldb, C, ldc, row0, col0, 0, last);
+    }
+}
+
+void gemm_recursive_task(int m, int n, int k, double alpha,
+                         const double *A, int lda, const double *B, int ldb,
+                         double *C, int ldc, int parallel) {
+    if (m <= 0 || n <= 0 || k <= 0 || alpha == 0.0) return;
+    GemmCall call = { alpha, 1.0, NULL, parallel };
+    gemm_node(&call, m, n, k, A, lda, B, ldb, C, ldc, 0, 0, 1, 1);
+}
+
+void gemm_recursive(int m, int n, int k, double alpha,
+                    const double *A, int lda, const double *B, int ldb,
+                    double *C, int ldc, int parallel) {
+#ifdef _OPENMP
+    if (parallel && !omp_in_parallel() && (long)m * n * k >= GEMM_TASK_WORK) {
+        #pragma omp parallel
+        #pragma omp single
+        gemm_recursive_task(m, n, k, alpha, A, lda, B, ldb, C, ldc, 1);
+        return;
+    }
+#endif
+    gemm_recursive_task(m, n, k, alpha, A, lda, B, ldb, C, ldc, parallel);
+}
+
+void gemm_recursive_ex(int m, int n, int k, double alpha,
+                       const double *A, int lda, const double *B, int ldb,
+                       double beta, double *C, int ldc, const GemmEpilogue *epi, int parallel) {
+    if (m <= 0 || n <= 0) return;
+    /* No product: still one pass for beta and the epilogue */
+    if (k <= 0 || alpha == 0.0) k = 0;
+    GemmCall call = { alpha, beta, epi, parallel };
+#ifdef _OPENMP
+    if (parallel && !omp_in_parallel() && (long)m * n * (k > 0 ? k : 1) >= GEMM_TASK_WORK) {
+        #pragma omp parallel
+        #pragma omp single
+        gemm_node(&call, m, n, k, A, lda, B, ldb, C, ldc, 0, 0, 1, 1);
+        return;
+    }
+#endif
+    gemm_node(&call, m, n, k, A, lda, B, ldb, C, ldc, 0, 0, 1, 1);
+}
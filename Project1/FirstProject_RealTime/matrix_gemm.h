@@ -0,0 +1,50 @@
+#ifndef MATRIX_GEMM_H
+#define MATRIX_GEMM_H
+
+/*
+ * Cache-oblivious GEMM on raw row-major buffers, the building block of the
+ * blocked factorizations (recursive LU, triangular solves).
+ *
+ * The largest of m, n, k is halved until the sub-problem fits in cache, so
+ * every cache level is used without a tuned block size. Splits along m or n
+ * produce independent halves, which run as OpenMP tasks when parallel is set
+ * and the work is large enough; splits along k run in sequence.
+ */
+
+/* Element-wise work done on each entry of C once its sum is complete, while
+ * the row segment is still in cache: bias, then clamp, then fn.
+ */
+typedef struct {
+    const double *bias;     /* NULL, or one entry per column (n) ... */
+    int bias_per_row;       /* ... or per row (m) */
+    int clamp;              /* clamp to [lo, hi] (lo = 0, hi = INFINITY: ReLU) */
+    double lo, hi;
+    double (*fn)(double x, void *ctx);  /* NULL or any other map */
+    void *ctx;
+} GemmEpilogue;
+
+/* C (m x n) += alpha * A (m x k) * B (k x n), with leading dimensions
+ * (row strides) lda, ldb, ldc. Starts its own OpenMP team when parallel is
+ * set and the caller is not already inside one.
+ */
+void gemm_recursive(int m, int n, int k, double alpha,
+                    const double *A, int lda, const double *B, int ldb,
+                    double *C, int ldc, int parallel);
+
+/* Same, for callers already running inside an OpenMP parallel region/task:
+ * only spawns tasks, never a new team.
+ */
+void gemm_recursive_task(int m, int n, int k, double alpha,
+                         const double *A, int lda, const double *B, int ldb,
+                         double *C, int ldc, int parallel);
+
+/* C = epi(alpha * A * B + beta * C). Each row segment of a leaf tile is
+ * scaled by beta when first touched and finished by the epilogue after its
+ * last k-chunk, so neither costs a separate pass over C. beta = 0 ignores
+ * the old contents of C (NaN included); epi may be NULL.
+ */
+void gemm_recursive_ex(int m, int n, int k, double alpha,
+                       const double *A, int lda, const double *B, int ldb,
+                       double beta, double *C, int ldc, const GemmEpilogue *epi, int parallel);
+
+#endif /* MATRIX_GEMM_H */
@@ -0,0 +1,283 @@
+#include "matrix_gf2.h"
+#include "matrix_log.h"
+#include <ctype.h>
+#include <errno.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Rows of B combined into one Four Russians table (256 entries) */
+#define M4RM_BITS 8
+
+/* Below this many words of work the kernels stay single-threaded */
+#define GF2_PARALLEL_WORDS 4096
+
+BitMatrix *create_bit_matrix(const char *name, int rows, int cols) {
+    if (rows <= 0 || cols <= 0) return NULL;
+    BitMatrix *b = (BitMatrix*)calloc(1, sizeof(BitMatrix));
+    if (!b) return NULL;
+    if (name) {
+        strncpy(b->name, name, MAX_NAME_LENGTH - 1);
+        b->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    b->rows = rows;
+    b->cols = cols;
+    b->words_per_row = (cols + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    b->bits = (uint64_t*)calloc((size_t)rows * b->words_per_row, sizeof(uint64_t));
+    if (!b->bits) { free(b); return NULL; }
+    return b;
+}
+
+void free_bit_matrix(BitMatrix *b) {
+    if (!b) return;
+    free(b->bits);
+    free(b);
+}
+
+BitMatrix *dense_to_bit_matrix(const Matrix *m) {
+    if (!m) return NULL;
+    BitMatrix *b = create_bit_matrix(m->name, m->rows, m->cols);
+    if (!b) return NULL;
+    int bad = 0;
+    #pragma omp parallel for schedule(static) reduction(|:bad) if ((long)m->rows * m->cols > GF2_PARALLEL_WORDS)
+    for (int i = 0; i < m->rows; i++) {
+        uint64_t *row = bit_matrix_row(b, i);
+        for (int j = 0; j < m->cols; j++) {
+            double v = mat_get(m, i, j);
+            if (v == 1.0) row[j / BITS_PER_WORD] |= (uint64_t)1 << (j % BITS_PER_WORD);
+            else if (v != 0.0) bad = 1;
+        }
+    }
+    if (bad) { free_bit_matrix(b); return NULL; }
+    return b;
+}
+
+Matrix *bit_matrix_to_dense(const BitMatrix *b) {
+    if (!b) return NULL;
+    Matrix *m = create_matrix(b->name, b->rows, b->cols);
+    if (!m) return NULL;
+    #pragma omp parallel for schedule(static) if ((long)b->rows * b->cols > GF2_PARALLEL_WORDS)
+    for (int i = 0; i < b->rows; i++) {
+        for (int j = 0; j < b->cols; j++) m->data[i][j] = bit_matrix_get(b, i, j);
+    }
+    return m;
+}
+
+/* Next whitespace-separated entry: 0 or 1 on success, -1 at EOF, -2 if the
+ * token is not a 0/1 value ("1", "0.0", "1e0" and the like are accepted).
+ */
+static int read_bit_token(FILE *f) {
+    int c;
+    do { c = getc(f); } while (c != EOF && isspace(c));
+    if (c == EOF) return -1;
+
+    char tok[64];
+    size_t len = 0;
+    while (c != EOF && !isspace(c)) {
+        if (len < sizeof(tok) - 1) tok[len++] = (char)c;
+        c = getc(f);
+    }
+    tok[len] = '\0';
+    if (len == 1 && (tok[0] == '0' || tok[0] == '1')) return tok[0] - '0';
+
+    char *end = NULL;
+    double v = strtod(tok, &end);
+    if (end == tok || *end != '\0') return -2;
+    if (v == 0.0) return 0;
+    if (v == 1.0) return 1;
+    return -2;
+}
+
+BitMatrix *read_bit_matrix_from_file(const char *filepath) {
+    FILE *f = filepath ? fopen(filepath, "r") : NULL;
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen %s: %s", filepath ? filepath : "(null)", strerror(errno));
+        return NULL;
+    }
+
+    char name[MAX_NAME_LENGTH];
+    int rows, cols;
+    if (fscanf(f, "%63s %d %d", name, &rows, &cols) != 3 || rows <= 0 || cols <= 0) {
+        mat_log(MAT_LOG_ERROR, "Invalid header in %s", filepath);
+        fclose(f);
+        return NULL;
+    }
+    BitMatrix *b = create_bit_matrix(name, rows, cols);
+    if (!b) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate %dx%d bit matrix.", rows, cols);
+        fclose(f);
+        return NULL;
+    }
+
+    for (int i = 0; i < rows; i++) {
+        uint64_t *row = bit_matrix_row(b, i);
+        for (int j = 0; j < cols; j++) {
+            int v = read_bit_token(f);
+            if (v < 0) {
+                mat_log(MAT_LOG_ERROR, v == -1 ? "Failed to read element [%d][%d] from %s"
+                                               : "Element [%d][%d] of %s is not 0 or 1", i, j, filepath);
+                free_bit_matrix(b);
+                fclose(f);
+                return NULL;
+            }
+            if (v) row[j / BITS_PER_WORD] |= (uint64_t)1 << (j % BITS_PER_WORD);
+        }
+    }
+    fclose(f);
+    mat_log(MAT_LOG_INFO, "Loaded 0/1 matrix '%s' (%dx%d, %zu bytes packed) from %s",
+            name, rows, cols, (size_t)rows * b->words_per_row * sizeof(uint64_t), filepath);
+    return b;
+}
+
+BitMatrix *bit_matrix_transpose(const BitMatrix *b, const char *name) {
+    if (!b) return NULL;
+    BitMatrix *t = create_bit_matrix(name ? name : b->name, b->cols, b->rows);
+    if (!t) return NULL;
+    /* Each output row (a column of b) is assembled one word at a time */
+    #pragma omp parallel for schedule(static) if ((long)b->rows * b->words_per_row > GF2_PARALLEL_WORDS)
+    for (int j = 0; j < b->cols; j++) {
+        uint64_t *out = bit_matrix_row(t, j);
+        int w = j / BITS_PER_WORD, shift = j % BITS_PER_WORD;
+        for (int i = 0; i < b->rows; i++) {
+            uint64_t bit = (bit_matrix_row(b, i)[w] >> shift) & 1u;
+            out[i / BITS_PER_WORD] |= bit << (i % BITS_PER_WORD);
+        }
+    }
+    return t;
+}
+
+long bit_matrix_popcount(const BitMatrix *b) {
+    if (!b) return 0;
+    long total = 0;
+    size_t words = (size_t)b->rows * b->words_per_row;
+    #pragma omp parallel for schedule(static) reduction(+:total) if (words > GF2_PARALLEL_WORDS)
+    for (size_t k = 0; k < words; k++) total += __builtin_popcountll(b->bits[k]);
+    return total;
+}
+
+/* Method of Four Russians. For every group of M4RM_BITS rows of B, table
+ * entry x holds the XOR (or OR) of the rows selected by the bits of x, built
+ * from a smaller entry plus one row. Each row of C then takes one table row
+ * per group instead of one row of B per set bit of A.
+ */
+static BitMatrix *four_russians(const BitMatrix *a, const BitMatrix *b, const char *name, int use_or) {
+    if (!a || !b || a->cols != b->rows) return NULL;
+    BitMatrix *c = create_bit_matrix(name, a->rows, b->cols);
+    if (!c) return NULL;
+    int wb = b->words_per_row;
+    uint64_t *table = (uint64_t*)malloc(((size_t)1 << M4RM_BITS) * wb * sizeof(uint64_t));
+    if (!table) { free_bit_matrix(c); return NULL; }
+
+    long work = (long)a->rows * wb * ((a->cols + M4RM_BITS - 1) / M4RM_BITS);
+    #pragma omp parallel if (work > GF2_PARALLEL_WORDS)
+    for (int k0 = 0; k0 < a->cols; k0 += M4RM_BITS) {
+        int g = a->cols - k0 < M4RM_BITS ? a->cols - k0 : M4RM_BITS;
+        int entries = 1 << g;
+
+        #pragma omp single
+        {
+            memset(table, 0, (size_t)wb * sizeof(uint64_t));
+            for (int x = 1; x < entries; x++) {
+                const uint64_t *prev = table + (size_t)(x & (x - 1)) * wb;
+                const uint64_t *brow = bit_matrix_row(b, k0 + __builtin_ctz((unsigned)x));
+                uint64_t *dst = table + (size_t)x * wb;
+                if (use_or) for (int w = 0; w < wb; w++) dst[w] = prev[w] | brow[w];
+                else        for (int w = 0; w < wb; w++) dst[w] = prev[w] ^ brow[w];
+            }
+        }
+
+        /* k0 is a multiple of 8, so the group never straddles two words */
+        int aw = k0 / BITS_PER_WORD, shift = k0 % BITS_PER_WORD;
+        unsigned mask = (unsigned)entries - 1;
+        #pragma omp for schedule(static)
+        for (int i = 0; i < a->rows; i++) {
+            unsigned x = (unsigned)(bit_matrix_row(a, i)[aw] >> shift) & mask;
+            if (!x) continue;
+            const uint64_t *src = table + (size_t)x * wb;
+            uint64_t *dst = bit_matrix_row(c, i);
+            if (use_or) for (int w = 0; w < wb; w++) dst[w] |= src[w];
+            else        for (int w = 0; w < wb; w++) dst[w] ^= src[w];
+        }
+    }
+    free(table);
+    return c;
+}
+
+BitMatrix *gf2_multiply(const BitMatrix *a, const BitMatrix *b, const char *name) {
+    return four_russians(a, b, name, 0);
+}
+
+BitMatrix *bool_multiply(const BitMatrix *a, const BitMatrix *b, const char *name) {
+    return four_russians(a, b, name, 1);
+}
+
+Matrix *bit_count_multiply(const BitMatrix *a, const BitMatrix *b, const char *name) {
+    if (!a || !b || a->cols != b->rows) return NULL;
+    /* Columns of B become rows, so each entry is popcount(row AND row) */
+    BitMatrix *bt = bit_matrix_transpose(b, NULL);
+    Matrix *c = bt ? create_matrix(name, a->rows, b->cols) : NULL;
+    if (!c) { free_bit_matrix(bt); return NULL; }
+
+    int words = a->words_per_row;
+    #pragma omp parallel for schedule(dynamic, 8) if ((long)a->rows * b->cols * words > GF2_PARALLEL_WORDS)
+    for (int i = 0; i < a->rows; i++) {
+        const uint64_t *ar = bit_matrix_row(a, i);
+        for (int j = 0; j < b->cols; j++) {
+            const uint64_t *br = bit_matrix_row(bt, j);
+            int count = 0;
+            for (int w = 0; w < words; w++) count += __builtin_popcountll(ar[w] & br[w]);
+            c->data[i][j] = count;
+        }
+    }
+    free_bit_matrix(bt);
+    return c;
+}
+
+int gf2_rank(const BitMatrix *b) {
+    if (!b) return -1;
+    int wpr = b->words_per_row;
+    size_t row_bytes = (size_t)wpr * sizeof(uint64_t);
+    uint64_t *work = (uint64_t*)malloc((size_t)b->rows * row_bytes);
+    uint64_t *tmp = (uint64_t*)malloc(row_bytes);
+    if (!work || !tmp) { free(work); free(tmp); return -1; }
+    memcpy(work, b->bits, (size_t)b->rows * row_bytes);
+
+    /* Row echelon form: rows below the pivot row are zero left of the pivot
+     * column, so eliminations only touch words from the pivot word on.
+     */
+    int rank = 0;
+    for (int col = 0; col < b->cols && rank < b->rows; col++) {
+        int w = col / BITS_PER_WORD;
+        uint64_t bit = (uint64_t)1 << (col % BITS_PER_WORD);
+        int pivot = -1;
+        for (int i = rank; i < b->rows; i++) {
+            if (work[(size_t)i * wpr + w] & bit) { pivot = i; break; }
+        }
+        if (pivot < 0) continue;
+
+        uint64_t *prow = work + (size_t)rank * wpr;
+        if (pivot != rank) {
+            memcpy(tmp, prow, row_bytes);
+            memcpy(prow, work + (size_t)pivot * wpr, row_bytes);
+            memcpy(work + (size_t)pivot * wpr, tmp, row_bytes);
+        }
+        #pragma omp parallel for schedule(static) if ((long)(b->rows - rank) * (wpr - w) > GF2_PARALLEL_WORDS)
+        for (int i = rank + 1; i < b->rows; i++) {
+            uint64_t *row = work + (size_t)i * wpr;
+            if (row[w] & bit) {
+                for (int k = w; k < wpr; k++) row[k] ^= prow[k];
+            }
+        }
+        rank++;
+    }
+    free(tmp);
+    free(work);
+    return rank;
+}
+
+int gf2_determinant(const BitMatrix *b) {
+    if (!b || b->rows != b->cols) return -1;
+    int rank = gf2_rank(b);
+    if (rank < 0) return -1;
+    return rank == b->rows ? 1 : 0;
+}
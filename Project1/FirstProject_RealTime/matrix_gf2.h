@@ -0,0 +1,83 @@
+#ifndef MATRIX_GF2_H
+#define MATRIX_GF2_H
+
+#include <stdint.h>
+#include "matrix_types.h"
+
+/*
+ * Bit-packed 0/1 matrices for adjacency and parity-check data.
+ *
+ * Each row is a run of 64-bit words, bit j of a row living in bit (j % 64)
+ * of word (j / 64); bits past the last column are always zero. That is 64x
+ * less memory than one double per entry, and every kernel works on whole
+ * words:
+ *   - GF(2) product (AND/XOR) and boolean product (AND/OR) use the Method
+ *     of Four Russians: 8 rows of B are combined into a 256-entry table,
+ *     after which each byte of a row of A selects one table row.
+ *   - Rank and determinant over GF(2) use elimination with whole-row XORs.
+ *   - Counting products (number of k with A[i][k] = B[k][j] = 1, e.g.
+ *     paths of length 2) are popcounts of ANDed rows.
+ */
+
+#define BITS_PER_WORD 64
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    int words_per_row;   /* ceil(cols / 64) */
+    uint64_t *bits;      /* rows * words_per_row words, row-major */
+} BitMatrix;
+
+/* All-zero rows x cols matrix */
+BitMatrix *create_bit_matrix(const char *name, int rows, int cols);
+void free_bit_matrix(BitMatrix *b);
+
+static inline uint64_t *bit_matrix_row(const BitMatrix *b, int i) {
+    return b->bits + (size_t)i * b->words_per_row;
+}
+
+static inline int bit_matrix_get(const BitMatrix *b, int i, int j) {
+    return (int)((bit_matrix_row(b, i)[j / BITS_PER_WORD] >> (j % BITS_PER_WORD)) & 1u);
+}
+
+static inline void bit_matrix_set(BitMatrix *b, int i, int j, int v) {
+    uint64_t mask = (uint64_t)1 << (j % BITS_PER_WORD);
+    uint64_t *w = &bit_matrix_row(b, i)[j / BITS_PER_WORD];
+    *w = v ? (*w | mask) : (*w & ~mask);
+}
+
+/* Pack a dense matrix. Returns NULL if any entry is not exactly 0 or 1 */
+BitMatrix *dense_to_bit_matrix(const Matrix *m);
+
+/* Unpack to a dense 0.0/1.0 matrix */
+Matrix *bit_matrix_to_dense(const BitMatrix *b);
+
+/* Read the text format (name, rows cols, values) straight into bits.
+ * Returns NULL if the file is unreadable or holds an entry other than 0/1.
+ */
+BitMatrix *read_bit_matrix_from_file(const char *filepath);
+
+BitMatrix *bit_matrix_transpose(const BitMatrix *b, const char *name);
+
+/* Number of ones */
+long bit_matrix_popcount(const BitMatrix *b);
+
+/* C = A * B over GF(2) (AND, XOR). Returns NULL if A->cols != B->rows */
+BitMatrix *gf2_multiply(const BitMatrix *a, const BitMatrix *b, const char *name);
+
+/* C[i][j] = OR_k (A[i][k] AND B[k][j]). Returns NULL on dimension mismatch */
+BitMatrix *bool_multiply(const BitMatrix *a, const BitMatrix *b, const char *name);
+
+/* C[i][j] = number of k with A[i][k] = B[k][j] = 1, i.e. the integer product.
+ * Returns NULL on dimension mismatch
+ */
+Matrix *bit_count_multiply(const BitMatrix *a, const BitMatrix *b, const char *name);
+
+/* Rank over GF(2) (-1 on allocation failure) */
+int gf2_rank(const BitMatrix *b);
+
+/* Determinant over GF(2): 1 if invertible, 0 if singular, -1 if not square */
+int gf2_determinant(const BitMatrix *b);
+
+#endif /* MATRIX_GF2_H */
@@ -0,0 +1,590 @@
+#include "matrix_int.h"
+#include "matrix_log.h"
+#include "matrix_file_ops.h"
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Vector kernels are compiled twice on x86-64 (AVX2 and baseline) and the
+ * loader picks the best one for the CPU, so the build flags stay portable.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__)
+#define INT_SIMD_CLONES __attribute__((target_clones("avx2", "default")))
+#else
+#define INT_SIMD_CLONES
+#endif
+
+/* Largest magnitude a double holds exactly for every integer below it */
+#define INT_EXACT_DOUBLE 9007199254740992.0   /* 2^53 */
+
+/* Below this many multiply-adds the kernels stay single-threaded */
+#define INT_PARALLEL_WORK 32768
+
+typedef unsigned __int128 u128;
+typedef __int128 i128;
+
+IntMatrix *create_int_matrix(const char *name, int rows, int cols, IntElemType type) {
+    if (rows <= 0 || cols <= 0) return NULL;
+    IntMatrix *m = (IntMatrix*)calloc(1, sizeof(IntMatrix));
+    if (!m) return NULL;
+    if (name) {
+        strncpy(m->name, name, MAX_NAME_LENGTH - 1);
+        m->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    m->rows = rows;
+    m->cols = cols;
+    m->type = type;
+    size_t elem = (type == INT_ELEM_I32) ? sizeof(int32_t) : sizeof(int64_t);
+    void *block = calloc((size_t)rows * cols, elem);
+    if (!block) { free(m); return NULL; }
+    if (type == INT_ELEM_I32) m->v.i32 = (int32_t*)block;
+    else m->v.i64 = (int64_t*)block;
+    return m;
+}
+
+void free_int_matrix(IntMatrix *m) {
+    if (!m) return;
+    free(m->type == INT_ELEM_I32 ? (void*)m->v.i32 : (void*)m->v.i64);
+    free(m);
+}
+
+static size_t elem_count(const IntMatrix *m) {
+    return (size_t)m->rows * m->cols;
+}
+
+/* ===== Conversion ===== */
+
+int int_matrix_detect(const Matrix *m, IntElemType *type) {
+    if (!m) return 0;
+    int non_integer = 0, wide = 0;
+    #pragma omp parallel for schedule(static) reduction(|:non_integer, wide) if ((long)m->rows * m->cols > INT_PARALLEL_WORK)
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            double v = mat_get(m, i, j);
+            if (!(fabs(v) <= INT_EXACT_DOUBLE) || v != trunc(v)) non_integer = 1;
+            else if (v > INT32_MAX || v < INT32_MIN) wide = 1;
+        }
+    }
+    if (non_integer) return 0;
+    if (type) *type = wide ? INT_ELEM_I64 : INT_ELEM_I32;
+    return 1;
+}
+
+IntMatrix *int_matrix_from_dense(const Matrix *m) {
+    IntElemType type;
+    if (!int_matrix_detect(m, &type)) return NULL;
+    IntMatrix *r = create_int_matrix(m->name, m->rows, m->cols, type);
+    if (!r) return NULL;
+    #pragma omp parallel for schedule(static) if ((long)m->rows * m->cols > INT_PARALLEL_WORK)
+    for (int i = 0; i < m->rows; i++) {
+        size_t base = (size_t)i * m->cols;
+        for (int j = 0; j < m->cols; j++) {
+            if (type == INT_ELEM_I32) r->v.i32[base + j] = (int32_t)mat_get(m, i, j);
+            else r->v.i64[base + j] = (int64_t)mat_get(m, i, j);
+        }
+    }
+    return r;
+}
+
+Matrix *int_matrix_to_dense(const IntMatrix *m) {
+    if (!m) return NULL;
+    Matrix *d = create_matrix(m->name, m->rows, m->cols);
+    if (!d) return NULL;
+    #pragma omp parallel for schedule(static) if ((long)m->rows * m->cols > INT_PARALLEL_WORK)
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) d->data[i][j] = (double)int_matrix_get(m, i, j);
+    }
+    return d;
+}
+
+/* int64 copy of m (the same matrix when it already is int64) */
+static IntMatrix *as_i64(const IntMatrix *m, IntMatrix **owned) {
+    *owned = NULL;
+    if (m->type == INT_ELEM_I64) return (IntMatrix*)m;
+    IntMatrix *w = create_int_matrix(m->name, m->rows, m->cols, INT_ELEM_I64);
+    if (!w) return NULL;
+    size_t n = elem_count(m);
+    for (size_t k = 0; k < n; k++) w->v.i64[k] = m->v.i32[k];
+    *owned = w;
+    return w;
+}
+
+/* Narrow an int64 result to int32. Returns NULL (and frees w) if a value does not fit */
+static IntMatrix *narrow_to_i32(IntMatrix *w, int *overflow) {
+    size_t n = elem_count(w);
+    int bad = 0;
+    for (size_t k = 0; k < n; k++) bad |= (w->v.i64[k] > INT32_MAX) | (w->v.i64[k] < INT32_MIN);
+    if (bad) {
+        if (overflow) *overflow = 1;
+        free_int_matrix(w);
+        return NULL;
+    }
+    IntMatrix *r = create_int_matrix(w->name, w->rows, w->cols, INT_ELEM_I32);
+    if (r) for (size_t k = 0; k < n; k++) r->v.i32[k] = (int32_t)w->v.i64[k];
+    free_int_matrix(w);
+    return r;
+}
+
+/* ===== Text I/O ===== */
+
+/* Next integer token. Returns 1 on success, 0 at EOF, -1 if the token is not
+ * an integer (a trailing ".0", as written by write_matrix_to_file, is allowed).
+ */
+static int read_int_token(FILE *f, int64_t *out) {
+    int c;
+    do { c = getc(f); } while (c != EOF && isspace(c));
+    if (c == EOF) return 0;
+
+    char tok[64];
+    size_t len = 0;
+    while (c != EOF && !isspace(c)) {
+        if (len < sizeof(tok) - 1) tok[len++] = (char)c;
+        c = getc(f);
+    }
+    tok[len] = '\0';
+
+    char *end = NULL;
+    errno = 0;
+    long long v = strtoll(tok, &end, 10);
+    if (end == tok || errno == ERANGE) return -1;
+    if (*end == '.') {
+        end++;
+        while (*end == '0') end++;
+    }
+    if (*end != '\0') return -1;
+    *out = (int64_t)v;
+    return 1;
+}
+
+int matrix_file_is_int(const char *filepath) {
+    char tag[16];
+    return matrix_file_tag(filepath, tag, sizeof(tag)) && strcmp(tag, "int") == 0;
+}
+
+IntMatrix *read_int_matrix_from_file(const char *filepath) {
+    FILE *f = filepath ? fopen(filepath, "r") : NULL;
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen %s: %s", filepath ? filepath : "(null)", strerror(errno));
+        return NULL;
+    }
+    char name[MAX_NAME_LENGTH];
+    int rows, cols;
+    if (fscanf(f, "%63s %d %d", name, &rows, &cols) != 3 || rows <= 0 || cols <= 0) {
+        mat_log(MAT_LOG_ERROR, "Invalid header in %s", filepath);
+        fclose(f);
+        return NULL;
+    }
+    /* Optional "int" tag; any other tag is another matrix type */
+    char tag[16];
+    if (fscanf(f, " %15[A-Za-z]", tag) == 1 && strcmp(tag, "int") != 0) {
+        mat_log(MAT_LOG_ERROR, "%s holds a %s matrix, not an integer one", filepath, tag);
+        fclose(f);
+        return NULL;
+    }
+
+    IntMatrix *w = create_int_matrix(name, rows, cols, INT_ELEM_I64);
+    if (!w) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        fclose(f);
+        return NULL;
+    }
+    size_t n = elem_count(w);
+    int fits32 = 1;
+    for (size_t k = 0; k < n; k++) {
+        int rc = read_int_token(f, &w->v.i64[k]);
+        if (rc != 1) {
+            mat_log(MAT_LOG_ERROR, rc == 0 ? "Failed to read element [%d][%d] from %s"
+                                           : "Element [%d][%d] of %s is not an integer",
+                    (int)(k / cols), (int)(k % cols), filepath);
+            free_int_matrix(w);
+            fclose(f);
+            return NULL;
+        }
+        if (w->v.i64[k] > INT32_MAX || w->v.i64[k] < INT32_MIN) fits32 = 0;
+    }
+    fclose(f);
+
+    IntMatrix *m = fits32 ? narrow_to_i32(w, NULL) : w;
+    if (m) mat_log(MAT_LOG_INFO, "Loaded integer matrix '%s' (%dx%d, int%d) from %s",
+                   name, rows, cols, fits32 ? 32 : 64, filepath);
+    return m;
+}
+
+int write_int_matrix_to_file(const IntMatrix *m, const char *filepath) {
+    if (!m || !filepath) return 0;
+    FILE *f = fopen(filepath, "w");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return 0;
+    }
+    fprintf(f, "%s\n%d %d int\n", m->name, m->rows, m->cols);
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            fprintf(f, "%lld", (long long)int_matrix_get(m, i, j));
+            if (j < m->cols - 1) fputc(' ', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    mat_log(MAT_LOG_INFO, "Matrix '%s' saved to %s", m->name, filepath);
+    return 1;
+}
+
+/* ===== Overflow bounds ===== */
+
+static uint64_t max_abs(const IntMatrix *m) {
+    size_t n = elem_count(m);
+    uint64_t best = 0;
+    if (m->type == INT_ELEM_I32) {
+        for (size_t k = 0; k < n; k++) {
+            int64_t v = m->v.i32[k];
+            uint64_t a = (uint64_t)(v < 0 ? -v : v);
+            if (a > best) best = a;
+        }
+    } else {
+        for (size_t k = 0; k < n; k++) {
+            int64_t v = m->v.i64[k];
+            uint64_t a = v < 0 ? (uint64_t)0 - (uint64_t)v : (uint64_t)v;
+            if (a > best) best = a;
+        }
+    }
+    return best;
+}
+
+/* Can terms * |a| * |b| exceed limit? Then some partial sum might overflow */
+static int product_bound_fits(uint64_t ma, uint64_t mb, long terms, uint64_t limit) {
+    if (ma == 0 || mb == 0) return 1;
+    u128 p = (u128)ma * mb;
+    return p <= (u128)limit / (u128)terms;
+}
+
+static IntElemType wider(const IntMatrix *a, const IntMatrix *b) {
+    return (a->type == INT_ELEM_I64 || b->type == INT_ELEM_I64) ? INT_ELEM_I64 : INT_ELEM_I32;
+}
+
+/* ===== Element-wise kernels ===== */
+
+INT_SIMD_CLONES
+static void addsub_i32_i32(int32_t *restrict c, const int32_t *restrict a, const int32_t *restrict b,
+                           size_t n, int sub) {
+    if (sub) {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = a[k] - b[k];
+    } else {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = a[k] + b[k];
+    }
+}
+
+INT_SIMD_CLONES
+static void addsub_i32_i64(int64_t *restrict c, const int32_t *restrict a, const int32_t *restrict b,
+                           size_t n, int sub) {
+    if (sub) {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = (int64_t)a[k] - b[k];
+    } else {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = (int64_t)a[k] + b[k];
+    }
+}
+
+INT_SIMD_CLONES
+static void addsub_i64_i64(int64_t *restrict c, const int64_t *restrict a, const int64_t *restrict b,
+                           size_t n, int sub) {
+    if (sub) {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = a[k] - b[k];
+    } else {
+        #pragma omp simd
+        for (size_t k = 0; k < n; k++) c[k] = a[k] + b[k];
+    }
+}
+
+static IntMatrix *int_addsub(const IntMatrix *a, const IntMatrix *b, const char *name,
+                             IntAccumMode mode, int *overflow, int sub) {
+    if (overflow) *overflow = 0;
+    if (!a || !b || !name) return NULL;
+    if (a->rows != b->rows || a->cols != b->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for %s", sub ? "subtraction" : "addition");
+        return NULL;
+    }
+    IntElemType target = (mode == INT_ACCUM_WIDEN) ? INT_ELEM_I64 : wider(a, b);
+    uint64_t limit = (target == INT_ELEM_I32) ? INT32_MAX : INT64_MAX;
+    uint64_t ma = max_abs(a), mb = max_abs(b);
+    int fits = ma <= limit && mb <= limit - ma;
+    size_t n = elem_count(a);
+
+    if (fits && a->type == INT_ELEM_I32 && b->type == INT_ELEM_I32) {
+        IntMatrix *c = create_int_matrix(name, a->rows, a->cols, target);
+        if (!c) return NULL;
+        if (target == INT_ELEM_I32) addsub_i32_i32(c->v.i32, a->v.i32, b->v.i32, n, sub);
+        else addsub_i32_i64(c->v.i64, a->v.i32, b->v.i32, n, sub);
+        return c;
+    }
+
+    IntMatrix *own_a = NULL, *own_b = NULL;
+    const IntMatrix *wa = as_i64(a, &own_a), *wb = wa ? as_i64(b, &own_b) : NULL;
+    IntMatrix *c = wb ? create_int_matrix(name, a->rows, a->cols, INT_ELEM_I64) : NULL;
+    if (c && fits) {
+        addsub_i64_i64(c->v.i64, wa->v.i64, wb->v.i64, n, sub);
+    } else if (c) {
+        /* Operands too large to rule out overflow: check each element */
+        int bad = 0;
+        for (size_t k = 0; k < n && !bad; k++) {
+            bad = sub ? __builtin_sub_overflow(wa->v.i64[k], wb->v.i64[k], &c->v.i64[k])
+                      : __builtin_add_overflow(wa->v.i64[k], wb->v.i64[k], &c->v.i64[k]);
+        }
+        if (bad) {
+            if (overflow) *overflow = 1;
+            free_int_matrix(c);
+            c = NULL;
+        }
+    }
+    free_int_matrix(own_a);
+    free_int_matrix(own_b);
+    if (c && target == INT_ELEM_I32) c = narrow_to_i32(c, overflow);
+    return c;
+}
+
+IntMatrix *int_add(const IntMatrix *a, const IntMatrix *b, const char *name,
+                   IntAccumMode mode, int *overflow) {
+    return int_addsub(a, b, name, mode, overflow, 0);
+}
+
+IntMatrix *int_subtract(const IntMatrix *a, const IntMatrix *b, const char *name,
+                        IntAccumMode mode, int *overflow) {
+    return int_addsub(a, b, name, mode, overflow, 1);
+}
+
+/* ===== GEMM kernels =====
+ * Row i of C accumulates a[i][k] * (row k of B) over one kc x nc tile of B;
+ * the inner loop runs over contiguous columns and vectorizes. The caller has
+ * already proven that no partial sum can overflow the accumulator type.
+ */
+
+/* Tile sizes: a KC x NC tile of B (128 KiB of int32) stays in L2 while
+ * MC rows of A sweep over it.
+ */
+#define GEMM_MC 64
+#define GEMM_KC 128
+#define GEMM_NC 256
+
+INT_SIMD_CLONES
+static void gemm_row_i32_i32(int32_t *restrict c, const int32_t *restrict a, const int32_t *restrict b,
+                             int kc, int nc, int ldb) {
+    for (int k = 0; k < kc; k++) {
+        int32_t s = a[k];
+        if (s == 0) continue;
+        const int32_t *restrict brow = b + (size_t)k * ldb;
+        #pragma omp simd
+        for (int j = 0; j < nc; j++) c[j] += s * brow[j];
+    }
+}
+
+INT_SIMD_CLONES
+static void gemm_row_i32_i64(int64_t *restrict c, const int32_t *restrict a, const int32_t *restrict b,
+                             int kc, int nc, int ldb) {
+    for (int k = 0; k < kc; k++) {
+        int64_t s = a[k];
+        if (s == 0) continue;
+        const int32_t *restrict brow = b + (size_t)k * ldb;
+        #pragma omp simd
+        for (int j = 0; j < nc; j++) c[j] += s * (int64_t)brow[j];
+    }
+}
+
+INT_SIMD_CLONES
+static void gemm_row_i64_i64(int64_t *restrict c, const int64_t *restrict a, const int64_t *restrict b,
+                             int kc, int nc, int ldb) {
+    for (int k = 0; k < kc; k++) {
+        int64_t s = a[k];
+        if (s == 0) continue;
+        const int64_t *restrict brow = b + (size_t)k * ldb;
+        #pragma omp simd
+        for (int j = 0; j < nc; j++) c[j] += s * brow[j];
+    }
+}
+
+typedef enum { GEMM_I32_I32, GEMM_I32_I64, GEMM_I64_I64 } GemmKind;
+
+/* C (M x N, zeroed) += A (M x K) * B (K x N), all row-major, blocks of MC
+ * rows of C handed out to threads.
+ */
+static void gemm_blocked(GemmKind kind, void *c, const void *a, const void *b, int M, int K, int N) {
+    #pragma omp parallel for schedule(dynamic, 1) if ((long)M * K * N > INT_PARALLEL_WORK)
+    for (int i0 = 0; i0 < M; i0 += GEMM_MC) {
+        int i1 = M - i0 < GEMM_MC ? M : i0 + GEMM_MC;
+        for (int k0 = 0; k0 < K; k0 += GEMM_KC) {
+            int kc = K - k0 < GEMM_KC ? K - k0 : GEMM_KC;
+            for (int j0 = 0; j0 < N; j0 += GEMM_NC) {
+                int nc = N - j0 < GEMM_NC ? N - j0 : GEMM_NC;
+                size_t boff = (size_t)k0 * N + j0;
+                for (int i = i0; i < i1; i++) {
+                    size_t coff = (size_t)i * N + j0, aoff = (size_t)i * K + k0;
+                    switch (kind) {
+                        case GEMM_I32_I32:
+                            gemm_row_i32_i32((int32_t*)c + coff, (const int32_t*)a + aoff,
+                                             (const int32_t*)b + boff, kc, nc, N);
+                            break;
+                        case GEMM_I32_I64:
+                            gemm_row_i32_i64((int64_t*)c + coff, (const int32_t*)a + aoff,
+                                             (const int32_t*)b + boff, kc, nc, N);
+                            break;
+                        case GEMM_I64_I64:
+                            gemm_row_i64_i64((int64_t*)c + coff, (const int64_t*)a + aoff,
+                                             (const int64_t*)b + boff, kc, nc, N);
+                            break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* 128-bit accumulation with an overflow check on every step.
+ * Returns 0 if a result does not fit in int64.
+ */
+static int gemm_checked(int64_t *c, const IntMatrix *a, const IntMatrix *b) {
+    int M = a->rows, K = a->cols, N = b->cols, bad = 0;
+    #pragma omp parallel reduction(|:bad) if ((long)M * K * N > INT_PARALLEL_WORK)
+    {
+        i128 *acc = (i128*)malloc((size_t)N * sizeof(i128));
+        if (!acc) bad = 1;
+        #pragma omp for schedule(dynamic, 4)
+        for (int i = 0; i < M; i++) {
+            if (!acc || bad) continue;
+            memset(acc, 0, (size_t)N * sizeof(i128));
+            for (int k = 0; k < K && !bad; k++) {
+                i128 s = int_matrix_get(a, i, k);
+                if (s == 0) continue;
+                for (int j = 0; j < N; j++) {
+                    if (__builtin_add_overflow(acc[j], s * int_matrix_get(b, k, j), &acc[j])) bad = 1;
+                }
+            }
+            for (int j = 0; j < N && !bad; j++) {
+                if (acc[j] > INT64_MAX || acc[j] < INT64_MIN) bad = 1;
+                else c[(size_t)i * N + j] = (int64_t)acc[j];
+            }
+        }
+        free(acc);
+    }
+    return !bad;
+}
+
+IntMatrix *int_multiply(const IntMatrix *a, const IntMatrix *b, const char *name,
+                        IntAccumMode mode, int *overflow) {
+    if (overflow) *overflow = 0;
+    if (!a || !b || !name) return NULL;
+    if (a->cols != b->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return NULL;
+    }
+    int M = a->rows, K = a->cols, N = b->cols;
+    IntElemType target = (mode == INT_ACCUM_WIDEN) ? INT_ELEM_I64 : wider(a, b);
+    uint64_t ma = max_abs(a), mb = max_abs(b);
+    int both32 = (a->type == INT_ELEM_I32 && b->type == INT_ELEM_I32);
+
+    /* Exact int32 accumulation is possible */
+    if (both32 && target == INT_ELEM_I32 && product_bound_fits(ma, mb, K, INT32_MAX)) {
+        IntMatrix *c = create_int_matrix(name, M, N, INT_ELEM_I32);
+        if (!c) return NULL;
+        gemm_blocked(GEMM_I32_I32, c->v.i32, a->v.i32, b->v.i32, M, K, N);
+        return c;
+    }
+
+    IntMatrix *c = create_int_matrix(name, M, N, INT_ELEM_I64);
+    if (!c) return NULL;
+    if (product_bound_fits(ma, mb, K, INT64_MAX)) {
+        if (both32) {
+            gemm_blocked(GEMM_I32_I64, c->v.i64, a->v.i32, b->v.i32, M, K, N);
+        } else {
+            IntMatrix *own_a = NULL, *own_b = NULL;
+            const IntMatrix *wa = as_i64(a, &own_a), *wb = wa ? as_i64(b, &own_b) : NULL;
+            if (!wb) { free_int_matrix(own_a); free_int_matrix(c); return NULL; }
+            gemm_blocked(GEMM_I64_I64, c->v.i64, wa->v.i64, wb->v.i64, M, K, N);
+            free_int_matrix(own_a);
+            free_int_matrix(own_b);
+        }
+    } else if (!gemm_checked(c->v.i64, a, b)) {
+        if (overflow) *overflow = 1;
+        free_int_matrix(c);
+        return NULL;
+    }
+    return target == INT_ELEM_I32 ? narrow_to_i32(c, overflow) : c;
+}
+
+/* ===== Mixed int/double ===== */
+
+Matrix *int_dense_multiply(const IntMatrix *a, const Matrix *b, const char *name) {
+    if (!a || !b || !name || a->cols != b->rows) return NULL;
+    /* The row sweep below needs b's rows contiguous */
+    Matrix *own_b = NULL;
+    if (b->layout != MAT_ROW_MAJOR) {
+        b = own_b = copy_matrix_layout(b, NULL, MAT_ROW_MAJOR);
+        if (!b) return NULL;
+    }
+    Matrix *c = create_matrix(name, a->rows, b->cols);
+    if (!c) { free_matrix(own_b); return NULL; }
+    int K = a->cols, N = b->cols;
+    #pragma omp parallel for schedule(static) if ((long)a->rows * K * N > INT_PARALLEL_WORK)
+    for (int i = 0; i < a->rows; i++) {
+        double *crow = c->data[i];
+        for (int k = 0; k < K; k++) {
+            double s = (double)int_matrix_get(a, i, k);
+            if (s == 0.0) continue;
+            const double *brow = b->data[k];
+            for (int j = 0; j < N; j++) crow[j] += s * brow[j];
+        }
+    }
+    free_matrix(own_b);
+    return c;
+}
+
+Matrix *dense_int_multiply(const Matrix *a, const IntMatrix *b, const char *name) {
+    if (!a || !b || !name || a->cols != b->rows) return NULL;
+    Matrix *c = create_matrix(name, a->rows, b->cols);
+    if (!c) return NULL;
+    int K = a->cols, N = b->cols;
+    #pragma omp parallel for schedule(static) if ((long)a->rows * K * N > INT_PARALLEL_WORK)
+    for (int i = 0; i < a->rows; i++) {
+        double *crow = c->data[i];
+        for (int k = 0; k < K; k++) {
+            double s = mat_get(a, i, k);
+            if (s == 0.0) continue;
+            if (b->type == INT_ELEM_I32) {
+                const int32_t *brow = b->v.i32 + (size_t)k * N;
+                for (int j = 0; j < N; j++) crow[j] += s * (double)brow[j];
+            } else {
+                const int64_t *brow = b->v.i64 + (size_t)k * N;
+                for (int j = 0; j < N; j++) crow[j] += s * (double)brow[j];
+            }
+        }
+    }
+    return c;
+}
+
+static Matrix *int_dense_addsub(const IntMatrix *a, const Matrix *b, const char *name, int sub) {
+    if (!a || !b || !name || a->rows != b->rows || a->cols != b->cols) return NULL;
+    Matrix *c = create_matrix(name, a->rows, a->cols);
+    if (!c) return NULL;
+    #pragma omp parallel for schedule(static) if ((long)a->rows * a->cols > INT_PARALLEL_WORK)
+    for (int i = 0; i < a->rows; i++) {
+        for (int j = 0; j < a->cols; j++) {
+            double x = (double)int_matrix_get(a, i, j);
+            c->data[i][j] = sub ? x - mat_get(b, i, j) : x + mat_get(b, i, j);
+        }
+    }
+    return c;
+}
+
+Matrix *int_dense_add(const IntMatrix *a, const Matrix *b, const char *name) {
+    return int_dense_addsub(a, b, name, 0);
+}
+
+Matrix *int_dense_subtract(const IntMatrix *a, const Matrix *b, const char *name) {
+    return int_dense_addsub(a, b, name, 1);
+}
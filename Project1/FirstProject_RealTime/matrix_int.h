@@ -0,0 +1,83 @@
+#ifndef MATRIX_INT_H
+#define MATRIX_INT_H
+
+#include <stdint.h>
+#include "matrix_types.h"
+
+/*
+ * Integer matrices (IntMatrix in matrix_types.h, int32 or int64 elements)
+ * with exact arithmetic.
+ *
+ * Elements are stored row-major in one contiguous block. Add/subtract/
+ * multiply run vectorized loops (AVX2 clones are selected at run time on
+ * x86-64) whenever a bound on the operands proves that no intermediate can
+ * overflow the accumulator; otherwise they fall back to per-element checked
+ * arithmetic with 128-bit accumulation, so a result is either exact or
+ * reported as an overflow, never silently wrapped.
+ *
+ * Mixed int/double operations promote lazily: the integer operand is never
+ * copied to a double matrix, its elements are converted as the kernel
+ * reads them.
+ */
+
+/* Result type policy for int/int operations */
+typedef enum {
+    INT_ACCUM_CHECKED,   /* keep the wider input type, fail if a value does not fit */
+    INT_ACCUM_WIDEN      /* always produce int64 (exact for any int32 inputs) */
+} IntAccumMode;
+
+/* Element (i, j) widened to int64 */
+static inline int64_t int_matrix_get(const IntMatrix *m, int i, int j) {
+    size_t k = (size_t)i * m->cols + j;
+    return m->type == INT_ELEM_I32 ? (int64_t)m->v.i32[k] : m->v.i64[k];
+}
+
+/* Narrowest element type that holds every entry of m exactly.
+ * Returns: 1 and sets *type if all entries are integers, 0 otherwise
+ * (entries beyond +-2^53 are rejected: the double may already be rounded)
+ */
+int int_matrix_detect(const Matrix *m, IntElemType *type);
+
+/* Convert an integer-valued dense matrix. Returns NULL if m is not integral */
+IntMatrix *int_matrix_from_dense(const Matrix *m);
+
+/* Promote to double (values beyond 2^53 are rounded) */
+Matrix *int_matrix_to_dense(const IntMatrix *m);
+
+/* Text format: like the real one with "int" after the dimensions,
+ *     name
+ *     rows cols int
+ *     v v v ...              (one row per line)
+ */
+
+/* 1 if filepath is a text file tagged "int" */
+int matrix_file_is_int(const char *filepath);
+
+/* Read the text format with exact integer parsing (no double round trip),
+ * choosing int32 when every value fits. Untagged real text files are read
+ * too. Returns NULL on parse error or a non-integer entry.
+ */
+IntMatrix *read_int_matrix_from_file(const char *filepath);
+
+/* Write in the tagged text format. Returns: 1 on success, 0 on failure */
+int write_int_matrix_to_file(const IntMatrix *m, const char *filepath);
+
+/* C = A op B. Returns NULL on dimension mismatch, allocation failure or
+ * overflow; *overflow (optional) is set to 1 only in the overflow case.
+ */
+IntMatrix *int_add(const IntMatrix *a, const IntMatrix *b, const char *name,
+                   IntAccumMode mode, int *overflow);
+IntMatrix *int_subtract(const IntMatrix *a, const IntMatrix *b, const char *name,
+                        IntAccumMode mode, int *overflow);
+IntMatrix *int_multiply(const IntMatrix *a, const IntMatrix *b, const char *name,
+                        IntAccumMode mode, int *overflow);
+
+/* Mixed products with lazy promotion; the result is double */
+Matrix *int_dense_multiply(const IntMatrix *a, const Matrix *b, const char *name);
+Matrix *dense_int_multiply(const Matrix *a, const IntMatrix *b, const char *name);
+
+/* a + b and a - b for an integer a and a double b */
+Matrix *int_dense_add(const IntMatrix *a, const Matrix *b, const char *name);
+Matrix *int_dense_subtract(const IntMatrix *a, const Matrix *b, const char *name);
+
+#endif /* MATRIX_INT_H */
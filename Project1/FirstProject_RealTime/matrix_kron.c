@@ -0,0 +1,305 @@
+#include "matrix_kron.h"
+#include "matrix_gemm.h"
+#include "matrix_trsm.h"
+#include "lu_recursive.h"
+#include "matrix_log.h"
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include <sys/time.h>
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* Row-major copy of m (transposed if trans is set) */
+static double *gather(const Matrix *m, int trans) {
+    double *buf = (double *)malloc((size_t)m->rows * m->cols * sizeof(double));
+    if (!buf) return NULL;
+    for (int i = 0; i < m->rows; i++)
+        for (int j = 0; j < m->cols; j++) {
+            if (trans) buf[(size_t)j * m->rows + i] = mat_get(m, i, j);
+            else buf[(size_t)i * m->cols + j] = mat_get(m, i, j);
+        }
+    return buf;
+}
+
+/* Column r of x (length rows * cols) as a rows x cols row-major block */
+static void unvec(const Matrix *x, int r, int rows, int cols, double *out) {
+    for (int t = 0; t < rows * cols; t++) out[t] = mat_get(x, t, r);
+}
+
+/* ===== Products ===== */
+
+/* y = vec(A X B^T): T = A X (m x q), then y = T B^T (m x n) */
+static int multiply_column(const KronOperator *op, const double *A, const double *Bt,
+                           const Matrix *x, int r, double *y, int parallel) {
+    int m = op->a->rows, p = op->a->cols, n = op->b->rows, q = op->b->cols;
+    double *X = (double *)malloc((size_t)p * q * sizeof(double));
+    double *T = (double *)calloc((size_t)m * q, sizeof(double));
+    if (!X || !T) {
+        free(X); free(T);
+        return 0;
+    }
+    unvec(x, r, p, q, X);
+    gemm_recursive_task(m, q, p, 1.0, A, p, X, q, T, q, parallel);
+    memset(y, 0, (size_t)m * n * sizeof(double));
+    gemm_recursive_task(m, n, q, 1.0, T, q, Bt, n, y, n, parallel);
+    free(X); free(T);
+    return 1;
+}
+
+static Matrix *kron_multiply(const KronOperator *op, const Matrix *x, const char *result_name,
+                             int parallel, double *exec_time) {
+    double start = get_time();
+    if (!op || !op->a || !op->b || !x || !result_name) return NULL;
+    if (x->rows != kron_cols(op) || kron_rows(op) > INT_MAX) {
+        mat_log(MAT_LOG_ERROR, "Kronecker product: operand must have %ld rows", kron_cols(op));
+        return NULL;
+    }
+    int k = x->cols;
+    double *A = gather(op->a, 0), *Bt = gather(op->b, 1);
+    Matrix *y = create_matrix_layout(result_name, (int)kron_rows(op), k, MAT_COL_MAJOR);
+    int ok = A && Bt && y;
+
+    if (ok && parallel) {
+        #pragma omp parallel
+        #pragma omp single
+        for (int r = 0; r < k; r++) {
+            #pragma omp task shared(ok)
+            if (!multiply_column(op, A, Bt, x, r, y->data[r], 1)) {
+                #pragma omp atomic write
+                ok = 0;
+            }
+        }
+    } else if (ok) {
+        for (int r = 0; r < k && ok; r++) ok = multiply_column(op, A, Bt, x, r, y->data[r], 0);
+    }
+    free(A); free(Bt);
+    if (!ok) {
+        if (y) free_matrix(y);
+        return NULL;
+    }
+    if (exec_time) *exec_time = get_time() - start;
+    return y;
+}
+
+Matrix *kron_multiply_single(const KronOperator *op, const Matrix *x, const char *result_name,
+                             double *exec_time) {
+    return kron_multiply(op, x, result_name, 0, exec_time);
+}
+
+Matrix *kron_multiply_openmp(const KronOperator *op, const Matrix *x, const char *result_name,
+                             double *exec_time) {
+    return kron_multiply(op, x, result_name, 1, exec_time);
+}
+
+/* ===== Solve ===== */
+
+/* W (n x ncols, row-major) := inv(L U) P W */
+static void lu_solve_block(const LUFactor *f, double *W, int ncols, int parallel) {
+    for (int i = 0; i < f->n; i++) {
+        if (f->piv[i] == i) continue;
+        double *r1 = W + (size_t)i * ncols, *r2 = W + (size_t)f->piv[i] * ncols;
+        for (int j = 0; j < ncols; j++) {
+            double t = r1[j];
+            r1[j] = r2[j];
+            r2[j] = t;
+        }
+    }
+    trsm_left_raw(TRI_LOWER, TRI_UNIT, f->n, ncols, f->lu, f->n, W, ncols, parallel);
+    trsm_left_raw(TRI_UPPER, TRI_NON_UNIT, f->n, ncols, f->lu, f->n, W, ncols, parallel);
+}
+
+/* y = vec(inv(A) C inv(B)^T): W = inv(A) C, then y^T = inv(B) W^T */
+static int solve_column(const LUFactor *fa, const LUFactor *fb, const Matrix *c, int r,
+                        double *y, int parallel) {
+    int m = fa->n, n = fb->n;
+    double *W = (double *)malloc((size_t)m * n * sizeof(double));
+    double *Wt = (double *)malloc((size_t)m * n * sizeof(double));
+    if (!W || !Wt) {
+        free(W); free(Wt);
+        return 0;
+    }
+    unvec(c, r, m, n, W);
+    lu_solve_block(fa, W, n, parallel);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++) Wt[(size_t)j * m + i] = W[(size_t)i * n + j];
+    lu_solve_block(fb, Wt, m, parallel);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < n; j++) y[(size_t)i * n + j] = Wt[(size_t)j * m + i];
+    free(W); free(Wt);
+    return 1;
+}
+
+static Matrix *kron_solve(const KronOperator *op, const Matrix *c, const char *result_name,
+                          int parallel, double *exec_time) {
+    double start = get_time();
+    if (!op || !op->a || !op->b || !c || !result_name) return NULL;
+    if (op->a->rows != op->a->cols || op->b->rows != op->b->cols ||
+        c->rows != kron_rows(op) || kron_rows(op) > INT_MAX) {
+        mat_log(MAT_LOG_ERROR, "Kronecker solve: factors must be square and the right-hand side %ld rows",
+                kron_rows(op));
+        return NULL;
+    }
+    LUFactor *fa = lu_factor_recursive(op->a, parallel, NULL);
+    LUFactor *fb = lu_factor_recursive(op->b, parallel, NULL);
+    Matrix *y = NULL;
+    int ok = fa && fb;
+    if (ok && (fa->singular || fb->singular)) {
+        mat_log(MAT_LOG_ERROR, "Kronecker solve: factor %s is singular",
+                fa->singular ? op->a->name : op->b->name);
+        ok = 0;
+    }
+    if (ok) {
+        y = create_matrix_layout(result_name, (int)kron_rows(op), c->cols, MAT_COL_MAJOR);
+        ok = y != NULL;
+    }
+
+    if (ok && parallel) {
+        #pragma omp parallel
+        #pragma omp single
+        for (int r = 0; r < c->cols; r++) {
+            #pragma omp task shared(ok)
+            if (!solve_column(fa, fb, c, r, y->data[r], 1)) {
+                #pragma omp atomic write
+                ok = 0;
+            }
+        }
+    } else if (ok) {
+        for (int r = 0; r < c->cols && ok; r++) ok = solve_column(fa, fb, c, r, y->data[r], 0);
+    }
+    free_lu_factor(fa);
+    free_lu_factor(fb);
+    if (!ok) {
+        if (y) free_matrix(y);
+        return NULL;
+    }
+    if (exec_time) *exec_time = get_time() - start;
+    return y;
+}
+
+Matrix *kron_solve_single(const KronOperator *op, const Matrix *c, const char *result_name,
+                          double *exec_time) {
+    return kron_solve(op, c, result_name, 0, exec_time);
+}
+
+Matrix *kron_solve_openmp(const KronOperator *op, const Matrix *c, const char *result_name,
+                          double *exec_time) {
+    return kron_solve(op, c, result_name, 1, exec_time);
+}
+
+/* ===== Determinant and eigenpairs ===== */
+
+/* log|det| and sign of an LU factorization; returns 0 if singular */
+static int lu_log_det(const LUFactor *f, double *log_abs, int *sign) {
+    if (f->singular) return 0;
+    double s = 0.0;
+    int sg = f->sign;
+    for (int i = 0; i < f->n; i++) {
+        double d = f->lu[(size_t)i * f->n + i];
+        if (d == 0.0) return 0;
+        if (d < 0.0) sg = -sg;
+        s += log(fabs(d));
+    }
+    *log_abs = s;
+    *sign = sg;
+    return 1;
+}
+
+int kron_determinant(const KronOperator *op, int parallel, double *out_det, double *exec_time) {
+    double start = get_time();
+    if (!op || !op->a || !op->b || !out_det) return 0;
+    if (op->a->rows != op->a->cols || op->b->rows != op->b->cols) return 0;
+    int m = op->a->rows, n = op->b->rows;
+
+    LUFactor *fa = lu_factor_recursive(op->a, parallel, NULL);
+    LUFactor *fb = lu_factor_recursive(op->b, parallel, NULL);
+    if (!fa || !fb) {
+        free_lu_factor(fa);
+        free_lu_factor(fb);
+        return 0;
+    }
+    double la, lb;
+    int sa, sb;
+    if (!lu_log_det(fa, &la, &sa) || !lu_log_det(fb, &lb, &sb)) {
+        *out_det = 0.0;
+    } else {
+        /* det(A)^n det(B)^m: the sign of a power is negative only for odd exponents */
+        int sign = ((sa < 0 && (n & 1)) ? -1 : 1) * ((sb < 0 && (m & 1)) ? -1 : 1);
+        *out_det = sign * exp((double)n * la + (double)m * lb);
+    }
+    free_lu_factor(fa);
+    free_lu_factor(fb);
+    if (exec_time) *exec_time = get_time() - start;
+    return 1;
+}
+
+KronEigenResult *kron_eigen(const KronOperator *op, int max_iter, double tol, int parallel,
+                            double *exec_time) {
+    double start = get_time();
+    if (!op || !op->a || !op->b) return NULL;
+    if (op->a->rows != op->a->cols || op->b->rows != op->b->cols) return NULL;
+
+    KronEigenResult *res = (KronEigenResult *)calloc(1, sizeof(KronEigenResult));
+    if (!res) return NULL;
+    res->m = op->a->rows;
+    res->n = op->b->rows;
+    res->a = parallel ? eigen_qr_openmp(op->a, max_iter, tol, NULL) : eigen_qr_single(op->a, max_iter, tol, NULL);
+    res->b = parallel ? eigen_qr_openmp(op->b, max_iter, tol, NULL) : eigen_qr_single(op->b, max_iter, tol, NULL);
+    res->eigenvalues = (double *)malloc((size_t)res->m * res->n * sizeof(double));
+    if (!res->a || !res->b || !res->eigenvalues) {
+        free_kron_eigen_result(res);
+        return NULL;
+    }
+    for (int i = 0; i < res->m; i++)
+        for (int j = 0; j < res->n; j++)
+            res->eigenvalues[(size_t)i * res->n + j] = res->a->eigenvalues[i] * res->b->eigenvalues[j];
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+void kron_eigenvector(const KronEigenResult *res, int idx, double *out) {
+    int i = idx / res->n, j = idx % res->n;
+    for (int s = 0; s < res->m; s++) {
+        double u = mat_get(res->a->eigenvectors, s, i);
+        for (int t = 0; t < res->n; t++) out[(size_t)s * res->n + t] = u * mat_get(res->b->eigenvectors, t, j);
+    }
+}
+
+void free_kron_eigen_result(KronEigenResult *res) {
+    if (!res) return;
+    free_eigen_result(res->a);
+    free_eigen_result(res->b);
+    free(res->eigenvalues);
+    free(res);
+}
+
+/* ===== Explicit product ===== */
+
+Matrix *kron_materialize(const KronOperator *op, const char *result_name, int parallel) {
+    if (!op || !op->a || !op->b || !result_name) return NULL;
+    if (kron_rows(op) > INT_MAX || kron_cols(op) > INT_MAX) {
+        mat_log(MAT_LOG_ERROR, "Kronecker product %ld x %ld is too large to form",
+                kron_rows(op), kron_cols(op));
+        return NULL;
+    }
+    const Matrix *a = op->a, *b = op->b;
+    int n = b->rows, q = b->cols;
+    Matrix *k = create_matrix(result_name, (int)kron_rows(op), (int)kron_cols(op));
+    if (!k) return NULL;
+
+    /* Row (i, r) is the row r of B scaled by each A[i][j] in turn */
+    #pragma omp parallel for collapse(2) schedule(static) if (parallel)
+    for (int i = 0; i < a->rows; i++)
+        for (int r = 0; r < n; r++) {
+            double *row = k->data[i * n + r];
+            for (int j = 0; j < a->cols; j++) {
+                double aij = mat_get(a, i, j);
+                for (int l = 0; l < q; l++) row[j * q + l] = aij * mat_get(b, r, l);
+            }
+        }
+    return k;
+}
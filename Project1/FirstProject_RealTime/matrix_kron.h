@@ -0,0 +1,84 @@
+#ifndef MATRIX_KRON_H
+#define MATRIX_KRON_H
+
+#include "matrix_types.h"
+#include "eigen_qr.h"
+
+/*
+ * Kronecker product A (x) B as an implicit operator: only the factors are
+ * stored, never the (mn) x (pq) product.
+ *
+ * For A m x p and B n x q, entry ((i, k), (j, l)) of A (x) B is
+ * A[i][j] * B[k][l], with the row index (i, k) flattened to i * n + k and
+ * the column index (j, l) to j * q + l. A vector x of length pq is read as
+ * the p x q row-major matrix X, and the "vec trick"
+ *
+ *     (A (x) B) x  =  vec(A X B^T)
+ *
+ * turns one product into two small GEMMs: O(mq(p + n)) flops instead of
+ * O(mnpq), and memory linear in the factor sizes. Solves, determinants and
+ * eigenpairs follow from the factors in the same way:
+ *
+ *     inv(A (x) B) = inv(A) (x) inv(B)
+ *     det(A (x) B) = det(A)^n * det(B)^m           (A m x m, B n x n)
+ *     eig(A (x) B) = { lambda_i * mu_j },  vectors u_i (x) v_j
+ */
+
+typedef struct {
+    const Matrix *a;    /* not owned; either layout */
+    const Matrix *b;
+} KronOperator;
+
+/* Dimensions of the (never formed) product */
+static inline long kron_rows(const KronOperator *op) {
+    return (long)op->a->rows * op->b->rows;
+}
+
+static inline long kron_cols(const KronOperator *op) {
+    return (long)op->a->cols * op->b->cols;
+}
+
+/* Y = (A (x) B) X for every column of x (pq x k, either layout). The result
+ * is mn x k and column-major, so each product lands in one contiguous line.
+ * Returns NULL on a dimension mismatch or allocation failure.
+ */
+Matrix *kron_multiply_single(const KronOperator *op, const Matrix *x, const char *result_name,
+                             double *exec_time);
+Matrix *kron_multiply_openmp(const KronOperator *op, const Matrix *x, const char *result_name,
+                             double *exec_time);
+
+/* X = inv(A (x) B) C for square A, B (recursive LU of each factor, see
+ * lu_recursive.h). Returns NULL on a dimension mismatch, a singular factor
+ * or allocation failure.
+ */
+Matrix *kron_solve_single(const KronOperator *op, const Matrix *c, const char *result_name,
+                          double *exec_time);
+Matrix *kron_solve_openmp(const KronOperator *op, const Matrix *c, const char *result_name,
+                          double *exec_time);
+
+/* det(A)^n * det(B)^m, combined in log space so that the powers do not
+ * overflow before the result does. Returns 0 if a factor is not square.
+ */
+int kron_determinant(const KronOperator *op, int parallel, double *out_det, double *exec_time);
+
+typedef struct {
+    int m, n;               /* orders of A and B */
+    double *eigenvalues;    /* m * n values, lambda_i * mu_j at i * n + j */
+    EigenResult *a, *b;     /* eigenpairs of the factors */
+} KronEigenResult;
+
+/* Eigenpairs of square A, B by QR iteration (eigen_qr.h); parallel selects
+ * the OpenMP engine. Returns NULL if a factor is not square or QR fails.
+ */
+KronEigenResult *kron_eigen(const KronOperator *op, int max_iter, double tol, int parallel,
+                            double *exec_time);
+/* Fill out (m * n entries) with eigenvector idx = i * n + j, u_i (x) v_j */
+void kron_eigenvector(const KronEigenResult *res, int idx, double *out);
+void free_kron_eigen_result(KronEigenResult *res);
+
+/* Form A (x) B explicitly (mn x pq, row-major), for when it is really
+ * needed. Returns NULL if the product does not fit in a Matrix.
+ */
+Matrix *kron_materialize(const KronOperator *op, const char *result_name, int parallel);
+
+#endif /* MATRIX_KRON_H */
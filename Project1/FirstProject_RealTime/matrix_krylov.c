@@ -0,0 +1,929 @@
+#include "matrix_krylov.h"
+#include "matrix_gemm.h"
+#include "matrix_log.h"
+#include <math.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Below this many block entries (n * nrhs) vector operations run on one thread */
+#define KRYLOV_PARALLEL_LEN 20000
+/* Times a method is rerun on columns whose true residual misses the tolerance */
+#define KRYLOV_MAX_RESTARTS 4
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+KrylovOptions krylov_default_options(void) {
+    KrylovOptions o;
+    o.method = KRYLOV_CG;
+    o.precond = PRECOND_NONE;
+    o.tol = 1e-8;
+    o.max_iter = 1000;
+    o.restart = 30;
+    o.block_size = 32;
+    return o;
+}
+
+/* ===== Block vectors =====
+ * A block is n x k, row-major: entry (i, r) is v[i * k + r], so the k
+ * right-hand sides of one row sit next to each other.
+ */
+
+static void blk_dots(const double *a, const double *b, int n, int k, double *out) {
+    for (int r = 0; r < k; r++) out[r] = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:out[:k]) if ((long)n * k > KRYLOV_PARALLEL_LEN)
+    for (int i = 0; i < n; i++) {
+        const double *ai = a + (size_t)i * k, *bi = b + (size_t)i * k;
+        for (int r = 0; r < k; r++) out[r] += ai[r] * bi[r];
+    }
+}
+
+/* y[:, r] += alpha[r] * x[:, r] */
+static void blk_axpy(double *y, const double *alpha, const double *x, int n, int k) {
+    #pragma omp parallel for schedule(static) if ((long)n * k > KRYLOV_PARALLEL_LEN)
+    for (int i = 0; i < n; i++) {
+        double *yi = y + (size_t)i * k;
+        const double *xi = x + (size_t)i * k;
+        #pragma omp simd
+        for (int r = 0; r < k; r++) yi[r] += alpha[r] * xi[r];
+    }
+}
+
+/* y[:, r] = x[:, r] + beta[r] * y[:, r] */
+static void blk_xpby(double *y, const double *x, const double *beta, int n, int k) {
+    #pragma omp parallel for schedule(static) if ((long)n * k > KRYLOV_PARALLEL_LEN)
+    for (int i = 0; i < n; i++) {
+        double *yi = y + (size_t)i * k;
+        const double *xi = x + (size_t)i * k;
+        #pragma omp simd
+        for (int r = 0; r < k; r++) yi[r] = xi[r] + beta[r] * yi[r];
+    }
+}
+
+/* y[:, r] *= s[r] */
+static void blk_scale(double *y, const double *s, int n, int k) {
+    #pragma omp parallel for schedule(static) if ((long)n * k > KRYLOV_PARALLEL_LEN)
+    for (int i = 0; i < n; i++) {
+        double *yi = y + (size_t)i * k;
+        #pragma omp simd
+        for (int r = 0; r < k; r++) yi[r] *= s[r];
+    }
+}
+
+static void blk_norms(const double *a, int n, int k, double *out) {
+    blk_dots(a, a, n, k, out);
+    for (int r = 0; r < k; r++) out[r] = sqrt(out[r]);
+}
+
+/* ===== Operator ===== */
+
+typedef struct {
+    int n;
+    const SparseMatrix *sparse;
+    const double *dense;        /* row-major, leading dimension ld */
+    int ld;
+    Matrix *dense_copy;         /* owned when the input was not usable as is */
+} Op;
+
+static int op_init(Op *op, const KrylovOperator *k) {
+    memset(op, 0, sizeof(*op));
+    if (k->sparse) {
+        if (k->sparse->rows != k->sparse->cols) return 0;
+        op->n = k->sparse->rows;
+        op->sparse = k->sparse;
+        return 1;
+    }
+    const Matrix *a = k->dense;
+    if (!a || a->rows != a->cols) return 0;
+    op->n = a->rows;
+    if (a->layout != MAT_ROW_MAJOR) {
+        op->dense_copy = copy_matrix_layout(a, a->name, MAT_ROW_MAJOR);
+        if (!op->dense_copy) return 0;
+        a = op->dense_copy;
+    }
+    op->dense = a->data[0];
+    op->ld = (int)a->row_stride;
+    return 1;
+}
+
+static void op_free(Op *op) {
+    if (op->dense_copy) free_matrix(op->dense_copy);
+}
+
+/* Y = A X for an n x k block */
+static void op_apply(const Op *op, const double *X, double *Y, int k) {
+    if (op->sparse) {
+        sparse_spmm(op->sparse, X, k, Y);
+        return;
+    }
+    memset(Y, 0, (size_t)op->n * k * sizeof(double));
+    gemm_recursive(op->n, k, op->n, 1.0, op->dense, op->ld, X, k, Y, k, 1);
+}
+
+/* CSR view of the operator for the incomplete factorizations */
+static SparseMatrix *op_csr(const Op *op) {
+    if (op->sparse) {
+        const SparseMatrix *s = op->sparse;
+        SparseMatrix *c = create_sparse_matrix(s->name, s->rows, s->cols, s->nnz);
+        if (!c) return NULL;
+        memcpy(c->row_ptr, s->row_ptr, (size_t)(s->rows + 1) * sizeof(long));
+        memcpy(c->col_idx, s->col_idx, (size_t)s->nnz * sizeof(int));
+        memcpy(c->values, s->values, (size_t)s->nnz * sizeof(double));
+        return c;
+    }
+    Matrix view = {0};
+    const double *line0 = op->dense;
+    double **lines = (double **)malloc((size_t)op->n * sizeof(double *));
+    if (!lines) return NULL;
+    for (int i = 0; i < op->n; i++) lines[i] = (double *)line0 + (size_t)i * op->ld;
+    strcpy(view.name, "A");
+    view.rows = view.cols = op->n;
+    view.data = lines;
+    view.layout = MAT_ROW_MAJOR;
+    view.row_stride = (size_t)op->ld;
+    view.col_stride = 1;
+    SparseMatrix *c = dense_to_sparse(&view);
+    free(lines);
+    return c;
+}
+
+static double op_entry(const Op *op, int i, int j) {
+    if (op->sparse) return sparse_get(op->sparse, i, j);
+    return op->dense[(size_t)i * op->ld + j];
+}
+
+/* ===== Preconditioners ===== */
+
+typedef struct {
+    PrecondType type;
+    int n;
+    double *inv_diag;           /* Jacobi */
+    int bs, nblocks;            /* block-Jacobi: LU of each diagonal block */
+    double *blu;
+    int *bpiv;
+    SparseMatrix *f;            /* ILU(0): L (unit) and U in A's pattern; IC(0): L */
+    long *diag_pos;
+} Precond;
+
+static void precond_free(Precond *p) {
+    free(p->inv_diag);
+    free(p->blu);
+    free(p->bpiv);
+    if (p->f) free_sparse_matrix(p->f);
+    free(p->diag_pos);
+}
+
+static int build_jacobi(Precond *p, const Op *op) {
+    p->inv_diag = (double *)malloc((size_t)p->n * sizeof(double));
+    if (!p->inv_diag) return 0;
+    for (int i = 0; i < p->n; i++) {
+        double d = op_entry(op, i, i);
+        if (d == 0.0) {
+            mat_log(MAT_LOG_ERROR, "Jacobi preconditioner: zero diagonal at row %d", i);
+            return 0;
+        }
+        p->inv_diag[i] = 1.0 / d;
+    }
+    return 1;
+}
+
+static int build_block_jacobi(Precond *p, const Op *op, int bs) {
+    if (bs < 1) bs = 1;
+    if (bs > p->n) bs = p->n;
+    p->bs = bs;
+    p->nblocks = (p->n + bs - 1) / bs;
+    p->blu = (double *)malloc((size_t)p->nblocks * bs * bs * sizeof(double));
+    p->bpiv = (int *)malloc((size_t)p->nblocks * bs * sizeof(int));
+    if (!p->blu || !p->bpiv) return 0;
+
+    int failed = -1;
+    #pragma omp parallel for schedule(dynamic) if (p->nblocks > 1)
+    for (int b = 0; b < p->nblocks; b++) {
+        int i0 = b * bs, m = (i0 + bs <= p->n) ? bs : p->n - i0;
+        double *lu = p->blu + (size_t)b * bs * bs;
+        int *piv = p->bpiv + (size_t)b * bs;
+        for (int i = 0; i < m; i++)
+            for (int j = 0; j < m; j++) lu[i * bs + j] = op_entry(op, i0 + i, i0 + j);
+
+        /* Partial pivoting; piv[c] is the row swapped into position c */
+        for (int c = 0; c < m; c++) {
+            int best = c;
+            for (int i = c + 1; i < m; i++)
+                if (fabs(lu[i * bs + c]) > fabs(lu[best * bs + c])) best = i;
+            piv[c] = best;
+            if (lu[best * bs + c] == 0.0) {
+                #pragma omp critical
+                failed = b;
+                break;
+            }
+            if (best != c)
+                for (int j = 0; j < m; j++) {
+                    double t = lu[c * bs + j];
+                    lu[c * bs + j] = lu[best * bs + j];
+                    lu[best * bs + j] = t;
+                }
+            for (int i = c + 1; i < m; i++) {
+                double l = lu[i * bs + c] / lu[c * bs + c];
+                lu[i * bs + c] = l;
+                for (int j = c + 1; j < m; j++) lu[i * bs + j] -= l * lu[c * bs + j];
+            }
+        }
+    }
+    if (failed >= 0) {
+        mat_log(MAT_LOG_ERROR, "Block-Jacobi preconditioner: diagonal block %d is singular", failed);
+        return 0;
+    }
+    return 1;
+}
+
+/* Position of the diagonal entry in every row of f, or 0 if one is missing */
+static int find_diagonals(Precond *p) {
+    SparseMatrix *f = p->f;
+    p->diag_pos = (long *)malloc((size_t)p->n * sizeof(long));
+    if (!p->diag_pos) return 0;
+    for (int i = 0; i < p->n; i++) {
+        p->diag_pos[i] = -1;
+        for (long q = f->row_ptr[i]; q < f->row_ptr[i + 1]; q++)
+            if (f->col_idx[q] == i) { p->diag_pos[i] = q; break; }
+        if (p->diag_pos[i] < 0) {
+            mat_log(MAT_LOG_ERROR, "Incomplete factorization: no diagonal entry in row %d", i);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* ILU(0), IKJ order: fill outside the pattern of A is dropped */
+static int build_ilu0(Precond *p, const Op *op) {
+    p->f = op_csr(op);
+    if (!p->f || !find_diagonals(p)) return 0;
+    SparseMatrix *f = p->f;
+    long *pos = (long *)malloc((size_t)p->n * sizeof(long));
+    if (!pos) return 0;
+    for (int j = 0; j < p->n; j++) pos[j] = -1;
+
+    int ok = 1;
+    for (int i = 0; i < p->n && ok; i++) {
+        for (long q = f->row_ptr[i]; q < f->row_ptr[i + 1]; q++) pos[f->col_idx[q]] = q;
+        for (long q = f->row_ptr[i]; q < f->row_ptr[i + 1] && f->col_idx[q] < i; q++) {
+            int k = f->col_idx[q];
+            double l = f->values[q] / f->values[p->diag_pos[k]];
+            f->values[q] = l;
+            for (long t = p->diag_pos[k] + 1; t < f->row_ptr[k + 1]; t++)
+                if (pos[f->col_idx[t]] >= 0) f->values[pos[f->col_idx[t]]] -= l * f->values[t];
+        }
+        if (f->values[p->diag_pos[i]] == 0.0) {
+            mat_log(MAT_LOG_ERROR, "ILU(0) preconditioner: zero pivot at row %d", i);
+            ok = 0;
+        }
+        for (long q = f->row_ptr[i]; q < f->row_ptr[i + 1]; q++) pos[f->col_idx[q]] = -1;
+    }
+    free(pos);
+    return ok;
+}
+
+/* IC(0): A ~ L L^T with L on the lower-triangle pattern of A */
+static int build_ic0(Precond *p, const Op *op) {
+    SparseMatrix *full = op_csr(op);
+    if (!full) return 0;
+    long nnz = 0;
+    for (int i = 0; i < p->n; i++)
+        for (long q = full->row_ptr[i]; q < full->row_ptr[i + 1]; q++)
+            if (full->col_idx[q] <= i) nnz++;
+    p->f = create_sparse_matrix(full->name, p->n, p->n, nnz);
+    if (!p->f) {
+        free_sparse_matrix(full);
+        return 0;
+    }
+    SparseMatrix *f = p->f;
+    nnz = 0;
+    for (int i = 0; i < p->n; i++) {
+        for (long q = full->row_ptr[i]; q < full->row_ptr[i + 1]; q++)
+            if (full->col_idx[q] <= i) {
+                f->col_idx[nnz] = full->col_idx[q];
+                f->values[nnz++] = full->values[q];
+            }
+        f->row_ptr[i + 1] = nnz;
+    }
+    free_sparse_matrix(full);
+    if (!find_diagonals(p)) return 0;
+
+    for (int i = 0; i < p->n; i++) {
+        for (long q = f->row_ptr[i]; q <= p->diag_pos[i]; q++) {
+            int k = f->col_idx[q];
+            /* s = a_ik - sum_{j < k} l_ij l_kj, merging rows i and k */
+            double s = f->values[q];
+            long a = f->row_ptr[i], b = f->row_ptr[k];
+            while (a < q && b < p->diag_pos[k]) {
+                if (f->col_idx[a] == f->col_idx[b]) s -= f->values[a++] * f->values[b++];
+                else if (f->col_idx[a] < f->col_idx[b]) a++;
+                else b++;
+            }
+            if (k < i) {
+                f->values[q] = s / f->values[p->diag_pos[k]];
+            } else if (s <= 0.0) {
+                mat_log(MAT_LOG_ERROR, "IC(0) preconditioner: non-positive pivot at row %d "
+                        "(matrix not symmetric positive definite?)", i);
+                return 0;
+            } else {
+                f->values[q] = sqrt(s);
+            }
+        }
+    }
+    return 1;
+}
+
+static int precond_init(Precond *p, const Op *op, const KrylovOptions *opt) {
+    memset(p, 0, sizeof(*p));
+    p->type = opt->precond;
+    p->n = op->n;
+    switch (opt->precond) {
+        case PRECOND_NONE:         return 1;
+        case PRECOND_JACOBI:       return build_jacobi(p, op);
+        case PRECOND_BLOCK_JACOBI: return build_block_jacobi(p, op, opt->block_size);
+        case PRECOND_ILU0:         return build_ilu0(p, op);
+        case PRECOND_IC0:          return build_ic0(p, op);
+    }
+    return 0;
+}
+
+/* Z = M^-1 R for an n x k block (Z may not alias R) */
+static void precond_apply(const Precond *p, const double *R, double *Z, int k) {
+    int n = p->n;
+    size_t len = (size_t)n * k;
+    switch (p->type) {
+        case PRECOND_NONE:
+            memcpy(Z, R, len * sizeof(double));
+            return;
+
+        case PRECOND_JACOBI:
+            #pragma omp parallel for schedule(static) if ((long)len > KRYLOV_PARALLEL_LEN)
+            for (int i = 0; i < n; i++)
+                for (int r = 0; r < k; r++) Z[(size_t)i * k + r] = p->inv_diag[i] * R[(size_t)i * k + r];
+            return;
+
+        case PRECOND_BLOCK_JACOBI: {
+            int bs = p->bs;
+            #pragma omp parallel for schedule(static) if ((long)len > KRYLOV_PARALLEL_LEN)
+            for (int b = 0; b < p->nblocks; b++) {
+                int i0 = b * bs, m = (i0 + bs <= n) ? bs : n - i0;
+                const double *lu = p->blu + (size_t)b * bs * bs;
+                const int *piv = p->bpiv + (size_t)b * bs;
+                double *z = Z + (size_t)i0 * k;
+                memcpy(z, R + (size_t)i0 * k, (size_t)m * k * sizeof(double));
+                for (int c = 0; c < m; c++)
+                    if (piv[c] != c)
+                        for (int r = 0; r < k; r++) {
+                            double t = z[(size_t)c * k + r];
+                            z[(size_t)c * k + r] = z[(size_t)piv[c] * k + r];
+                            z[(size_t)piv[c] * k + r] = t;
+                        }
+                for (int i = 1; i < m; i++)
+                    for (int j = 0; j < i; j++)
+                        for (int r = 0; r < k; r++) z[(size_t)i * k + r] -= lu[i * bs + j] * z[(size_t)j * k + r];
+                for (int i = m - 1; i >= 0; i--) {
+                    for (int j = i + 1; j < m; j++)
+                        for (int r = 0; r < k; r++) z[(size_t)i * k + r] -= lu[i * bs + j] * z[(size_t)j * k + r];
+                    for (int r = 0; r < k; r++) z[(size_t)i * k + r] /= lu[i * bs + i];
+                }
+            }
+            return;
+        }
+
+        case PRECOND_ILU0: {
+            const SparseMatrix *f = p->f;
+            /* L y = r (unit diagonal), then U z = y */
+            for (int i = 0; i < n; i++) {
+                double *zi = Z + (size_t)i * k;
+                memcpy(zi, R + (size_t)i * k, (size_t)k * sizeof(double));
+                for (long q = f->row_ptr[i]; q < p->diag_pos[i]; q++) {
+                    const double *zj = Z + (size_t)f->col_idx[q] * k;
+                    double l = f->values[q];
+                    #pragma omp simd
+                    for (int r = 0; r < k; r++) zi[r] -= l * zj[r];
+                }
+            }
+            for (int i = n - 1; i >= 0; i--) {
+                double *zi = Z + (size_t)i * k;
+                for (long q = p->diag_pos[i] + 1; q < f->row_ptr[i + 1]; q++) {
+                    const double *zj = Z + (size_t)f->col_idx[q] * k;
+                    double u = f->values[q];
+                    #pragma omp simd
+                    for (int r = 0; r < k; r++) zi[r] -= u * zj[r];
+                }
+                double d = 1.0 / f->values[p->diag_pos[i]];
+                for (int r = 0; r < k; r++) zi[r] *= d;
+            }
+            return;
+        }
+
+        case PRECOND_IC0: {
+            const SparseMatrix *f = p->f;
+            /* L y = r, then L^T z = y (columns of L^T are the rows of L) */
+            for (int i = 0; i < n; i++) {
+                double *zi = Z + (size_t)i * k;
+                memcpy(zi, R + (size_t)i * k, (size_t)k * sizeof(double));
+                for (long q = f->row_ptr[i]; q < p->diag_pos[i]; q++) {
+                    const double *zj = Z + (size_t)f->col_idx[q] * k;
+                    double l = f->values[q];
+                    #pragma omp simd
+                    for (int r = 0; r < k; r++) zi[r] -= l * zj[r];
+                }
+                double d = 1.0 / f->values[p->diag_pos[i]];
+                for (int r = 0; r < k; r++) zi[r] *= d;
+            }
+            for (int i = n - 1; i >= 0; i--) {
+                double *zi = Z + (size_t)i * k;
+                double d = 1.0 / f->values[p->diag_pos[i]];
+                for (int r = 0; r < k; r++) zi[r] *= d;
+                for (long q = f->row_ptr[i]; q < p->diag_pos[i]; q++) {
+                    double *zj = Z + (size_t)f->col_idx[q] * k;
+                    double l = f->values[q];
+                    #pragma omp simd
+                    for (int r = 0; r < k; r++) zj[r] -= l * zi[r];
+                }
+            }
+            return;
+        }
+    }
+}
+
+/* ===== Solver state ===== */
+
+typedef struct {
+    const Op *op;
+    const Precond *pc;
+    const KrylovOptions *opt;
+    int n, k;
+    int budget;                 /* iterations left for this run of a method */
+    double *X, *B;              /* n x k blocks */
+    double *bnorm;
+    int *active;                /* still iterating */
+    KrylovResult *res;
+} Solve;
+
+/* Record the relative residual of every active column after one iteration */
+static void record(Solve *s, const double *rel) {
+    for (int r = 0; r < s->k; r++) {
+        if (!s->active[r]) continue;
+        s->res->iterations[r]++;
+        s->res->history[r][s->res->history_len[r]++] = rel[r];
+    }
+}
+
+static int any_active(const Solve *s) {
+    for (int r = 0; r < s->k; r++)
+        if (s->active[r]) return 1;
+    return 0;
+}
+
+/* R = B - A X; rel[r] = ||R[:, r]|| / ||b_r|| */
+static void true_residual(Solve *s, double *R, double *rel) {
+    op_apply(s->op, s->X, R, s->k);
+    size_t len = (size_t)s->n * s->k;
+    #pragma omp parallel for schedule(static) if ((long)len > KRYLOV_PARALLEL_LEN)
+    for (size_t t = 0; t < len; t++) R[t] = s->B[t] - R[t];
+    blk_norms(R, s->n, s->k, rel);
+    for (int r = 0; r < s->k; r++) rel[r] /= s->bnorm[r];
+}
+
+static void stop_column(Solve *s, int r, int converged, const char *why) {
+    s->active[r] = 0;
+    s->res->converged[r] = converged;
+    if (why) mat_log(MAT_LOG_WARN, "Krylov solve, right-hand side %d: %s after %d iterations",
+                     r, why, s->res->iterations[r]);
+}
+
+static int solve_cg(Solve *s) {
+    int n = s->n, k = s->k;
+    size_t len = (size_t)n * k;
+    double *R = (double *)malloc(len * sizeof(double));
+    double *Z = (double *)malloc(len * sizeof(double));
+    double *P = (double *)malloc(len * sizeof(double));
+    double *Q = (double *)malloc(len * sizeof(double));
+    double *sc = (double *)malloc((size_t)4 * k * sizeof(double));
+    if (!R || !Z || !P || !Q || !sc) {
+        free(R); free(Z); free(P); free(Q); free(sc);
+        return 0;
+    }
+    double *rz = sc, *pq = sc + k, *alpha = sc + 2 * k, *rel = sc + 3 * k;
+
+    true_residual(s, R, rel);
+    for (int r = 0; r < k; r++)
+        if (s->active[r] && rel[r] <= s->opt->tol) stop_column(s, r, 1, NULL);
+    precond_apply(s->pc, R, Z, k);
+    memcpy(P, Z, len * sizeof(double));
+    blk_dots(R, Z, n, k, rz);
+
+    for (int it = 0; it < s->budget && any_active(s); it++) {
+        op_apply(s->op, P, Q, k);
+        blk_dots(P, Q, n, k, pq);
+        for (int r = 0; r < k; r++) {
+            alpha[r] = 0.0;
+            if (!s->active[r]) continue;
+            if (pq[r] <= 0.0) stop_column(s, r, 0, "p'Ap <= 0 (matrix not positive definite?)");
+            else alpha[r] = rz[r] / pq[r];
+        }
+        blk_axpy(s->X, alpha, P, n, k);
+        for (int r = 0; r < k; r++) alpha[r] = -alpha[r];
+        blk_axpy(R, alpha, Q, n, k);
+
+        blk_norms(R, n, k, rel);
+        for (int r = 0; r < k; r++) rel[r] /= s->bnorm[r];
+        record(s, rel);
+        for (int r = 0; r < k; r++)
+            if (s->active[r] && rel[r] <= s->opt->tol) stop_column(s, r, 1, NULL);
+
+        /* beta = (r'z)_new / (r'z)_old; P = Z + beta P */
+        precond_apply(s->pc, R, Z, k);
+        blk_dots(R, Z, n, k, pq);
+        for (int r = 0; r < k; r++) {
+            alpha[r] = (s->active[r] && rz[r] != 0.0) ? pq[r] / rz[r] : 0.0;
+            rz[r] = pq[r];
+        }
+        blk_xpby(P, Z, alpha, n, k);
+    }
+    free(R); free(Z); free(P); free(Q); free(sc);
+    return 1;
+}
+
+static int solve_bicgstab(Solve *s) {
+    int n = s->n, k = s->k;
+    size_t len = (size_t)n * k;
+    double *blk = (double *)malloc(8 * len * sizeof(double));
+    double *sc = (double *)malloc((size_t)10 * k * sizeof(double));
+    if (!blk || !sc) {
+        free(blk); free(sc);
+        return 0;
+    }
+    double *R = blk, *Rh = blk + len, *P = blk + 2 * len, *V = blk + 3 * len;
+    double *Ph = blk + 4 * len, *S = blk + 5 * len, *Sh = blk + 6 * len, *T = blk + 7 * len;
+    double *rho = sc, *alpha = sc + k, *omega = sc + 2 * k, *rho_new = sc + 3 * k;
+    double *tmp = sc + 4 * k, *tmp2 = sc + 5 * k, *rel = sc + 6 * k;
+    double *cx1 = sc + 7 * k, *cx2 = sc + 8 * k, *beta = sc + 9 * k;
+
+    true_residual(s, R, rel);
+    for (int r = 0; r < k; r++) {
+        if (s->active[r] && rel[r] <= s->opt->tol) stop_column(s, r, 1, NULL);
+        rho[r] = alpha[r] = omega[r] = 1.0;
+    }
+    memcpy(Rh, R, len * sizeof(double));
+    memset(P, 0, len * sizeof(double));
+    memset(V, 0, len * sizeof(double));
+
+    for (int it = 0; it < s->budget && any_active(s); it++) {
+        blk_dots(Rh, R, n, k, rho_new);
+        for (int r = 0; r < k; r++) {
+            beta[r] = 0.0;
+            tmp[r] = 0.0;
+            if (!s->active[r]) continue;
+            if (rho_new[r] == 0.0) {
+                stop_column(s, r, 0, "breakdown (rho = 0)");
+                continue;
+            }
+            beta[r] = (rho_new[r] / rho[r]) * (alpha[r] / omega[r]);
+            tmp[r] = -omega[r];
+        }
+        /* P = R + beta (P - omega V) */
+        blk_axpy(P, tmp, V, n, k);
+        blk_xpby(P, R, beta, n, k);
+
+        precond_apply(s->pc, P, Ph, k);
+        op_apply(s->op, Ph, V, k);
+        blk_dots(Rh, V, n, k, tmp);
+        for (int r = 0; r < k; r++) {
+            cx1[r] = cx2[r] = 0.0;
+            if (!s->active[r]) {
+                alpha[r] = 0.0;
+                continue;
+            }
+            if (tmp[r] == 0.0) {
+                alpha[r] = 0.0;
+                stop_column(s, r, 0, "breakdown (r'v = 0)");
+                continue;
+            }
+            alpha[r] = rho_new[r] / tmp[r];
+            cx1[r] = alpha[r];
+        }
+
+        /* S = R - alpha V; a column may already be done at this half step */
+        memcpy(S, R, len * sizeof(double));
+        for (int r = 0; r < k; r++) tmp[r] = -alpha[r];
+        blk_axpy(S, tmp, V, n, k);
+        blk_norms(S, n, k, rel);
+        int half_done = 0;
+        for (int r = 0; r < k; r++) {
+            rel[r] /= s->bnorm[r];
+            tmp2[r] = 0.0;      /* 1 marks a column that converged at the half step */
+            if (s->active[r] && rel[r] <= s->opt->tol) {
+                tmp2[r] = 1.0;
+                half_done = 1;
+            }
+        }
+
+        precond_apply(s->pc, S, Sh, k);
+        op_apply(s->op, Sh, T, k);
+        blk_dots(T, S, n, k, tmp);
+        blk_dots(T, T, n, k, omega);
+        for (int r = 0; r < k; r++) {
+            double ts = tmp[r], tt = omega[r];
+            omega[r] = (s->active[r] && !tmp2[r] && tt > 0.0) ? ts / tt : 0.0;
+            cx2[r] = omega[r];
+        }
+
+        blk_axpy(s->X, cx1, Ph, n, k);
+        blk_axpy(s->X, cx2, Sh, n, k);
+        memcpy(R, S, len * sizeof(double));
+        for (int r = 0; r < k; r++) tmp[r] = -omega[r];
+        blk_axpy(R, tmp, T, n, k);
+
+        if (!half_done) {
+            blk_norms(R, n, k, rel);
+            for (int r = 0; r < k; r++) rel[r] /= s->bnorm[r];
+        } else {
+            blk_norms(R, n, k, tmp);
+            for (int r = 0; r < k; r++)
+                if (!tmp2[r]) rel[r] = tmp[r] / s->bnorm[r];
+        }
+        record(s, rel);
+        for (int r = 0; r < k; r++) {
+            if (!s->active[r]) continue;
+            if (tmp2[r] || rel[r] <= s->opt->tol) stop_column(s, r, 1, NULL);
+            else if (omega[r] == 0.0) stop_column(s, r, 0, "breakdown (omega = 0)");
+        }
+        memcpy(rho, rho_new, (size_t)k * sizeof(double));
+    }
+    free(blk); free(sc);
+    return 1;
+}
+
+/* Restarted, right-preconditioned GMRES(m): each cycle builds an Arnoldi
+ * basis of A M^-1 per column (modified Gram-Schmidt), reduces the Hessenberg
+ * matrix with Givens rotations to read the residual off |g[j + 1]|, and
+ * finishes with X += M^-1 V y. Every restart recomputes the true residual.
+ */
+static int solve_gmres(Solve *s) {
+    int n = s->n, k = s->k, m = s->opt->restart;
+    if (m < 1) m = 1;
+    if (m > n) m = n;
+    size_t len = (size_t)n * k;
+    double *V = (double *)malloc((size_t)(m + 1) * len * sizeof(double));
+    double *Z = (double *)malloc(len * sizeof(double));
+    double *W = (double *)malloc(len * sizeof(double));
+    double *H = (double *)calloc((size_t)k * (m + 1) * m, sizeof(double));
+    double *g = (double *)malloc((size_t)k * (m + 1) * sizeof(double));
+    double *cs = (double *)malloc((size_t)k * m * sizeof(double));
+    double *sn = (double *)malloc((size_t)k * m * sizeof(double));
+    double *y = (double *)malloc((size_t)k * m * sizeof(double));
+    double *sc = (double *)malloc((size_t)3 * k * sizeof(double));
+    int *steps = (int *)malloc((size_t)2 * k * sizeof(int));
+    if (!V || !Z || !W || !H || !g || !cs || !sn || !y || !sc || !steps) {
+        free(V); free(Z); free(W); free(H); free(g); free(cs); free(sn); free(y); free(sc); free(steps);
+        return 0;
+    }
+    double *rel = sc, *h = sc + k, *coef = sc + 2 * k;
+    int *cyc = steps + k;       /* column still extending the basis this cycle */
+    int total = 0;
+
+    for (;;) {
+        /* V_0 = R / ||R|| */
+        true_residual(s, V, rel);
+        for (int r = 0; r < k; r++) {
+            if (s->active[r] && rel[r] <= s->opt->tol) stop_column(s, r, 1, NULL);
+            double beta = rel[r] * s->bnorm[r];
+            coef[r] = (s->active[r] && beta > 0.0) ? 1.0 / beta : 0.0;
+            for (int i = 0; i <= m; i++) g[r * (m + 1) + i] = 0.0;
+            g[r * (m + 1)] = beta;
+            steps[r] = 0;
+            cyc[r] = s->active[r];
+        }
+        if (!any_active(s) || total >= s->budget) break;
+        blk_scale(V, coef, n, k);
+
+        for (int j = 0; j < m && total < s->budget; j++) {
+            int any = 0;
+            for (int r = 0; r < k; r++) any |= cyc[r];
+            if (!any) break;
+
+            double *Vj = V + (size_t)j * len, *Vn = V + (size_t)(j + 1) * len;
+            precond_apply(s->pc, Vj, Z, k);
+            op_apply(s->op, Z, W, k);
+            for (int i = 0; i <= j; i++) {
+                const double *Vi = V + (size_t)i * len;
+                blk_dots(W, Vi, n, k, h);
+                for (int r = 0; r < k; r++) {
+                    H[((size_t)r * (m + 1) + i) * m + j] = h[r];
+                    coef[r] = cyc[r] ? -h[r] : 0.0;
+                }
+                blk_axpy(W, coef, Vi, n, k);
+            }
+            blk_norms(W, n, k, h);
+            for (int r = 0; r < k; r++) coef[r] = (cyc[r] && h[r] > 0.0) ? 1.0 / h[r] : 0.0;
+            memcpy(Vn, W, len * sizeof(double));
+            blk_scale(Vn, coef, n, k);
+
+            for (int r = 0; r < k; r++) {
+                rel[r] = 0.0;
+                if (!cyc[r]) continue;
+                double *Hr = H + (size_t)r * (m + 1) * m;
+                double *gr = g + (size_t)r * (m + 1);
+                double *c = cs + (size_t)r * m, *sv = sn + (size_t)r * m;
+                Hr[(j + 1) * m + j] = h[r];
+                for (int i = 0; i < j; i++) {
+                    double a = Hr[i * m + j], b = Hr[(i + 1) * m + j];
+                    Hr[i * m + j] = c[i] * a + sv[i] * b;
+                    Hr[(i + 1) * m + j] = -sv[i] * a + c[i] * b;
+                }
+                double a = Hr[j * m + j], b = Hr[(j + 1) * m + j];
+                double d = hypot(a, b);
+                c[j] = d > 0.0 ? a / d : 1.0;
+                sv[j] = d > 0.0 ? b / d : 0.0;
+                Hr[j * m + j] = d;
+                Hr[(j + 1) * m + j] = 0.0;
+                gr[j + 1] = -sv[j] * gr[j];
+                gr[j] = c[j] * gr[j];
+                rel[r] = fabs(gr[j + 1]) / s->bnorm[r];
+                steps[r] = j + 1;
+            }
+            record(s, rel);
+            for (int r = 0; r < k; r++)
+                if (cyc[r] && (rel[r] <= s->opt->tol || h[r] == 0.0)) cyc[r] = 0;
+            total++;
+        }
+
+        /* y = H^-1 g (upper triangular), then X += M^-1 (V y) */
+        memset(W, 0, len * sizeof(double));
+        int maxs = 0;
+        for (int r = 0; r < k; r++) {
+            const double *Hr = H + (size_t)r * (m + 1) * m;
+            const double *gr = g + (size_t)r * (m + 1);
+            double *yr = y + (size_t)r * m;
+            for (int i = steps[r] - 1; i >= 0; i--) {
+                double t = gr[i];
+                for (int l = i + 1; l < steps[r]; l++) t -= Hr[i * m + l] * yr[l];
+                yr[i] = Hr[i * m + i] != 0.0 ? t / Hr[i * m + i] : 0.0;
+            }
+            if (steps[r] > maxs) maxs = steps[r];
+        }
+        for (int i = 0; i < maxs; i++) {
+            for (int r = 0; r < k; r++) coef[r] = i < steps[r] ? y[(size_t)r * m + i] : 0.0;
+            blk_axpy(W, coef, V + (size_t)i * len, n, k);
+        }
+        precond_apply(s->pc, W, Z, k);
+        for (int r = 0; r < k; r++) coef[r] = steps[r] > 0 ? 1.0 : 0.0;
+        blk_axpy(s->X, coef, Z, n, k);
+    }
+    free(V); free(Z); free(W); free(H); free(g); free(cs); free(sn); free(y); free(sc); free(steps);
+    return 1;
+}
+
+/* ===== Driver ===== */
+
+void free_krylov_result(KrylovResult *res) {
+    if (!res) return;
+    if (res->x) free_matrix(res->x);
+    if (res->history)
+        for (int r = 0; r < res->nrhs; r++) free(res->history[r]);
+    free(res->history);
+    free(res->history_len);
+    free(res->iterations);
+    free(res->converged);
+    free(res->residual);
+    free(res);
+}
+
+static KrylovResult *alloc_result(int n, int k, int max_iter) {
+    KrylovResult *res = (KrylovResult *)calloc(1, sizeof(KrylovResult));
+    if (!res) return NULL;
+    res->nrhs = k;
+    res->x = create_matrix("x", n, k);
+    res->iterations = (int *)calloc((size_t)k, sizeof(int));
+    res->converged = (int *)calloc((size_t)k, sizeof(int));
+    res->residual = (double *)calloc((size_t)k, sizeof(double));
+    res->history = (double **)calloc((size_t)k, sizeof(double *));
+    res->history_len = (int *)calloc((size_t)k, sizeof(int));
+    int ok = res->x && res->iterations && res->converged && res->residual && res->history && res->history_len;
+    for (int r = 0; ok && r < k; r++) {
+        res->history[r] = (double *)malloc((size_t)(max_iter + 1) * sizeof(double));
+        ok = res->history[r] != NULL;
+    }
+    if (!ok) {
+        free_krylov_result(res);
+        return NULL;
+    }
+    return res;
+}
+
+KrylovResult *krylov_solve(const KrylovOperator *kop, const Matrix *b, const Matrix *x0,
+                           const KrylovOptions *opt, double *exec_time) {
+    double start = get_time();
+    KrylovOptions dflt = krylov_default_options();
+    if (!opt) opt = &dflt;
+    if (!kop || !b || opt->max_iter < 0 || !(opt->tol >= 0.0)) return NULL;
+
+    Op op;
+    if (!op_init(&op, kop)) {
+        mat_log(MAT_LOG_ERROR, "Krylov solve: operator must be a square matrix");
+        return NULL;
+    }
+    int n = op.n, k = b->cols;
+    if (b->rows != n || k < 1 || (x0 && (x0->rows != n || x0->cols != k))) {
+        mat_log(MAT_LOG_ERROR, "Krylov solve: right-hand side must be %d x k", n);
+        op_free(&op);
+        return NULL;
+    }
+
+    Precond pc;
+    if (!precond_init(&pc, &op, opt)) {
+        precond_free(&pc);
+        op_free(&op);
+        return NULL;
+    }
+
+    size_t len = (size_t)n * k;
+    Solve s = { &op, &pc, opt, n, k, opt->max_iter, NULL, NULL, NULL, NULL, NULL };
+    s.X = (double *)malloc(len * sizeof(double));
+    s.B = (double *)malloc(len * sizeof(double));
+    s.bnorm = (double *)malloc((size_t)k * sizeof(double));
+    s.active = (int *)malloc((size_t)k * sizeof(int));
+    s.res = alloc_result(n, k, opt->max_iter);
+    int ok = s.X && s.B && s.bnorm && s.active && s.res;
+
+    if (ok) {
+        for (int i = 0; i < n; i++)
+            for (int r = 0; r < k; r++) {
+                s.B[(size_t)i * k + r] = mat_get(b, i, r);
+                s.X[(size_t)i * k + r] = x0 ? mat_get(x0, i, r) : 0.0;
+            }
+        blk_norms(s.B, n, k, s.bnorm);
+        for (int r = 0; r < k; r++) {
+            s.active[r] = 1;
+            if (s.bnorm[r] == 0.0) {
+                /* b = 0: x = 0 solves it exactly */
+                for (int i = 0; i < n; i++) s.X[(size_t)i * k + r] = 0.0;
+                s.bnorm[r] = 1.0;
+                s.active[r] = 0;
+                s.res->converged[r] = 1;
+            }
+        }
+
+        /* Initial residuals open every history */
+        double *R = (double *)malloc(len * sizeof(double));
+        ok = R != NULL;
+        if (ok) {
+            true_residual(&s, R, s.res->residual);
+            for (int r = 0; r < k; r++) s.res->history[r][s.res->history_len[r]++] = s.res->residual[r];
+            free(R);
+        }
+    }
+
+    /* CG and BiCGSTAB stop on an updated residual that can drift from
+     * b - A x; a column whose true residual misses the tolerance is restarted
+     * from its current x with the iterations it has left.
+     */
+    double *R = ok ? (double *)malloc(len * sizeof(double)) : NULL;
+    ok = ok && R != NULL;
+    for (int round = 0; ok && round < KRYLOV_MAX_RESTARTS; round++) {
+        switch (opt->method) {
+            case KRYLOV_CG:       ok = solve_cg(&s); break;
+            case KRYLOV_GMRES:    ok = solve_gmres(&s); break;
+            case KRYLOV_BICGSTAB: ok = solve_bicgstab(&s); break;
+            default:              ok = 0; break;
+        }
+        if (!ok) break;
+        true_residual(&s, R, s.res->residual);
+        int used = 0, again = 0;
+        for (int r = 0; r < k; r++) {
+            if (!s.res->converged[r] || s.res->residual[r] <= opt->tol) continue;
+            s.res->converged[r] = 0;
+            if (s.res->iterations[r] >= opt->max_iter) continue;
+            s.active[r] = again = 1;
+            if (s.res->iterations[r] > used) used = s.res->iterations[r];
+        }
+        if (!again) break;
+        s.budget = opt->max_iter - used;
+    }
+    free(R);
+
+    if (ok) {
+        for (int i = 0; i < n; i++)
+            for (int r = 0; r < k; r++) *mat_at(s.res->x, i, r) = s.X[(size_t)i * k + r];
+    }
+    KrylovResult *res = s.res;
+    if (!ok) {
+        free_krylov_result(res);
+        res = NULL;
+    } else {
+        int done = 0;
+        for (int r = 0; r < k; r++) done += res->converged[r];
+        mat_log(MAT_LOG_INFO, "Krylov solve: %d/%d right-hand sides converged", done, k);
+    }
+    free(s.X); free(s.B); free(s.bnorm); free(s.active);
+    precond_free(&pc);
+    op_free(&op);
+    if (exec_time) *exec_time = get_time() - start;
+    return res;
+}
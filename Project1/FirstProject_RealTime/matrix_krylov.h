@@ -0,0 +1,76 @@
+#ifndef MATRIX_KRYLOV_H
+#define MATRIX_KRYLOV_H
+
+#include "matrix_types.h"
+#include "matrix_sparse.h"
+
+/*
+ * Preconditioned Krylov solvers for A X = B: conjugate gradients (A
+ * symmetric positive definite), restarted GMRES(m) and BiCGSTAB (general A).
+ *
+ * A is applied as an SpMV on a CSR matrix or as a GEMV on a dense one (the
+ * recursive GEMM of matrix_gemm.h), so one iteration costs O(nnz) or O(n^2).
+ * All right-hand sides are iterated in lockstep on n x nrhs blocks: each
+ * iteration reads A once for every system, and columns that have converged
+ * stop changing. Products, dot products and vector updates are split across
+ * OpenMP threads by rows; the ILU(0)/IC(0) triangular sweeps run row by row
+ * but vectorize across the right-hand sides.
+ *
+ * GMRES and BiCGSTAB are right-preconditioned, so the residual they track
+ * is the true residual of the original system.
+ */
+
+typedef enum {
+    KRYLOV_CG = 0,
+    KRYLOV_GMRES,
+    KRYLOV_BICGSTAB
+} KrylovMethod;
+
+typedef enum {
+    PRECOND_NONE = 0,
+    PRECOND_JACOBI,         /* inverse of the diagonal */
+    PRECOND_BLOCK_JACOBI,   /* LU of each diagonal block of block_size */
+    PRECOND_ILU0,           /* incomplete LU on the sparsity pattern of A */
+    PRECOND_IC0             /* incomplete Cholesky (A symmetric positive definite) */
+} PrecondType;
+
+typedef struct {
+    KrylovMethod method;
+    PrecondType precond;
+    double tol;             /* stop when ||b - A x|| <= tol * ||b|| */
+    int max_iter;           /* per right-hand side */
+    int restart;            /* GMRES(m) basis size */
+    int block_size;         /* block-Jacobi block size */
+} KrylovOptions;
+
+/* CG, no preconditioner, tol 1e-8, 1000 iterations, restart 30, blocks of 32 */
+KrylovOptions krylov_default_options(void);
+
+/* Exactly one of dense / sparse is set; A must be square */
+typedef struct {
+    const Matrix *dense;
+    const SparseMatrix *sparse;
+} KrylovOperator;
+
+typedef struct {
+    Matrix *x;              /* n x nrhs solution */
+    int nrhs;
+    int *iterations;        /* per right-hand side */
+    int *converged;         /* 1 if the tolerance was met */
+    double *residual;       /* final ||b - A x|| / ||b|| (recomputed, not estimated) */
+    double **history;       /* history[j][0..history_len[j]): relative residual after
+                               each iteration, starting with the initial guess */
+    int *history_len;
+} KrylovResult;
+
+/* Solve A X = B for every column of b (n x nrhs, either layout). x0 is an
+ * optional starting guess of the same shape. Returns NULL on a shape
+ * mismatch, a preconditioner that cannot be built (zero pivot, IC(0)
+ * breakdown) or allocation failure; a solve that runs out of iterations
+ * still returns a result with converged[j] = 0.
+ */
+KrylovResult *krylov_solve(const KrylovOperator *op, const Matrix *b, const Matrix *x0,
+                           const KrylovOptions *opt, double *exec_time);
+void free_krylov_result(KrylovResult *res);
+
+#endif /* MATRIX_KRYLOV_H */
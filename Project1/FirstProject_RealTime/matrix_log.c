@@ -0,0 +1,54 @@
+#include "matrix_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+
+/* Longer messages are formatted into a heap buffer */
+#define MAT_LOG_LINE 512
+
+static MatLogFn g_log_fn = NULL;
+static void *g_log_ctx = NULL;
+static MatLogLevel g_log_min = MAT_LOG_INFO;
+
+void mat_set_logger(MatLogFn fn, void *ctx, MatLogLevel min_level) {
+    g_log_fn = fn;
+    g_log_ctx = ctx;
+    g_log_min = min_level;
+}
+
+void mat_console_logger(MatLogLevel level, const char *msg, void *ctx) {
+    (void)ctx;
+    FILE *out = (level >= MAT_LOG_WARN) ? stderr : stdout;
+    fputs(msg, out);
+    fputc('\n', out);
+}
+
+int mat_log_enabled(MatLogLevel level) {
+    return g_log_fn != NULL && level >= g_log_min;
+}
+
+void mat_log(MatLogLevel level, const char *fmt, ...) {
+    if (!mat_log_enabled(level)) return;
+
+    char line[MAT_LOG_LINE];
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (len < 0) return;
+    if ((size_t)len < sizeof(line)) {
+        g_log_fn(level, line, g_log_ctx);
+        return;
+    }
+
+    char *big = (char *)malloc((size_t)len + 1);
+    if (!big) {
+        g_log_fn(level, line, g_log_ctx);   /* truncated beats nothing */
+        return;
+    }
+    va_start(ap, fmt);
+    vsnprintf(big, (size_t)len + 1, fmt, ap);
+    va_end(ap);
+    g_log_fn(level, big, g_log_ctx);
+    free(big);
+}
@@ -0,0 +1,36 @@
+#ifndef MATRIX_LOG_H
+#define MATRIX_LOG_H
+
+/*
+ * Library diagnostics. Kernels never write to the console themselves: every
+ * message, including the performance comparison reports, goes through
+ * mat_log() to an optional callback. With no logger installed (the default)
+ * messages are dropped before they are even formatted.
+ */
+
+typedef enum {
+    MAT_LOG_DEBUG = 0,
+    MAT_LOG_INFO,
+    MAT_LOG_WARN,
+    MAT_LOG_ERROR
+} MatLogLevel;
+
+/* msg is one line without a trailing newline. The callback may be invoked
+ * from several threads at once (OpenMP regions, the stream reader).
+ */
+typedef void (*MatLogFn)(MatLogLevel level, const char *msg, void *ctx);
+
+/* Install (or with fn == NULL remove) the logger; messages below min_level
+ * are dropped
+ */
+void mat_set_logger(MatLogFn fn, void *ctx, MatLogLevel min_level);
+
+/* Ready-made logger: INFO/DEBUG to stdout, WARN/ERROR to stderr */
+void mat_console_logger(MatLogLevel level, const char *msg, void *ctx);
+
+/* 1 if a message at level would reach the logger */
+int mat_log_enabled(MatLogLevel level);
+
+void mat_log(MatLogLevel level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#endif /* MATRIX_LOG_H */
@@ -0,0 +1,198 @@
+#include "matrix_morton.h"
+#include <sys/time.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Recursion levels with at least this many tiles per side spawn tasks */
+#define MORTON_TASK_TILES 4
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static int next_pow2(int v) {
+    int p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+TiledMatrix *create_tiled_matrix(const char *name, int rows, int cols, int tile) {
+    if (rows <= 0 || cols <= 0) return NULL;
+    if (tile <= 0) tile = MORTON_DEFAULT_TILE;
+    if (tile & (tile - 1)) return NULL;
+
+    TiledMatrix *m = (TiledMatrix*)calloc(1, sizeof(TiledMatrix));
+    if (!m) return NULL;
+    if (name) {
+        strncpy(m->name, name, MAX_NAME_LENGTH - 1);
+        m->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    m->rows = rows;
+    m->cols = cols;
+    m->tile = tile;
+    while ((1 << m->tile_shift) < tile) m->tile_shift++;
+    m->tile_rows = (rows + tile - 1) / tile;
+    m->tile_cols = (cols + tile - 1) / tile;
+    /* Morton index grows with both coordinates, so the last tile is the highest */
+    m->tile_count = (size_t)morton_index(m->tile_rows - 1, m->tile_cols - 1) + 1;
+    m->data = (double*)calloc(m->tile_count * tile * tile, sizeof(double));
+    if (!m->data) { free(m); return NULL; }
+    return m;
+}
+
+void free_tiled_matrix(TiledMatrix *m) {
+    if (!m) return;
+    free(m->data);
+    free(m);
+}
+
+TiledMatrix *tiled_from_dense(const Matrix *m, int tile) {
+    if (!m) return NULL;
+    TiledMatrix *t = create_tiled_matrix(m->name, m->rows, m->cols, tile);
+    if (!t) return NULL;
+    int T = t->tile;
+    #pragma omp parallel for collapse(2) schedule(static) if ((long)m->rows * m->cols > 65536)
+    for (int ti = 0; ti < t->tile_rows; ti++) {
+        for (int tj = 0; tj < t->tile_cols; tj++) {
+            double *dst = tiled_tile(t, ti, tj);
+            int i1 = (ti + 1) * T < m->rows ? (ti + 1) * T : m->rows;
+            int j0 = tj * T, j1 = (tj + 1) * T < m->cols ? (tj + 1) * T : m->cols;
+            for (int i = ti * T; i < i1; i++) {
+                double *drow = dst + (size_t)(i - ti * T) * T;
+                if (m->layout == MAT_ROW_MAJOR) {
+                    memcpy(drow, m->data[i] + j0, (size_t)(j1 - j0) * sizeof(double));
+                } else {
+                    for (int j = j0; j < j1; j++) drow[j - j0] = m->data[j][i];
+                }
+            }
+        }
+    }
+    return t;
+}
+
+Matrix *tiled_to_dense(const TiledMatrix *t) {
+    if (!t) return NULL;
+    Matrix *m = create_matrix(t->name, t->rows, t->cols);
+    if (!m) return NULL;
+    int T = t->tile;
+    #pragma omp parallel for collapse(2) schedule(static) if ((long)t->rows * t->cols > 65536)
+    for (int ti = 0; ti < t->tile_rows; ti++) {
+        for (int tj = 0; tj < t->tile_cols; tj++) {
+            const double *src = tiled_tile(t, ti, tj);
+            int i1 = (ti + 1) * T < t->rows ? (ti + 1) * T : t->rows;
+            int j0 = tj * T, j1 = (tj + 1) * T < t->cols ? (tj + 1) * T : t->cols;
+            for (int i = ti * T; i < i1; i++) {
+                memcpy(m->data[i] + j0, src + (size_t)(i - ti * T) * T, (size_t)(j1 - j0) * sizeof(double));
+            }
+        }
+    }
+    return m;
+}
+
+/* ===== Transpose ===== */
+
+static void transpose_rec(const TiledMatrix *a, TiledMatrix *t, int ti, int tj, int s) {
+    if (ti >= a->tile_rows || tj >= a->tile_cols) return;
+    if (s == 1) {
+        int T = a->tile;
+        const double *src = tiled_tile(a, ti, tj);
+        double *dst = tiled_tile(t, tj, ti);
+        for (int i = 0; i < T; i++) {
+            for (int j = 0; j < T; j++) dst[(size_t)j * T + i] = src[(size_t)i * T + j];
+        }
+        return;
+    }
+    int h = s / 2;
+    #pragma omp task if (s >= MORTON_TASK_TILES)
+    transpose_rec(a, t, ti, tj, h);
+    #pragma omp task if (s >= MORTON_TASK_TILES)
+    transpose_rec(a, t, ti, tj + h, h);
+    #pragma omp task if (s >= MORTON_TASK_TILES)
+    transpose_rec(a, t, ti + h, tj, h);
+    transpose_rec(a, t, ti + h, tj + h, h);
+    #pragma omp taskwait
+}
+
+TiledMatrix *tiled_transpose(const TiledMatrix *a, const char *name) {
+    if (!a) return NULL;
+    TiledMatrix *t = create_tiled_matrix(name ? name : a->name, a->cols, a->rows, a->tile);
+    if (!t) return NULL;
+    int side = next_pow2(a->tile_rows > a->tile_cols ? a->tile_rows : a->tile_cols);
+    #pragma omp parallel
+    #pragma omp single
+    transpose_rec(a, t, 0, 0, side);
+    return t;
+}
+
+/* ===== Multiply ===== */
+
+/* C tile += A tile * B tile; zero padding makes full-tile loops safe */
+static void tile_multiply_add(double *restrict c, const double *restrict a, const double *restrict b, int T) {
+    for (int i = 0; i < T; i++) {
+        double *crow = c + (size_t)i * T;
+        const double *arow = a + (size_t)i * T;
+        for (int k = 0; k < T; k++) {
+            double s = arow[k];
+            if (s == 0.0) continue;
+            const double *brow = b + (size_t)k * T;
+            #pragma omp simd
+            for (int j = 0; j < T; j++) crow[j] += s * brow[j];
+        }
+    }
+}
+
+/* C[ti.., tj..] += A[ti.., tk..] * B[tk.., tj..] over s x s tiles. The four
+ * C quadrants are independent; the two halves of the k range run one after
+ * the other so no C tile is written concurrently.
+ */
+static void multiply_rec(const TiledMatrix *a, const TiledMatrix *b, TiledMatrix *c,
+                         int ti, int tj, int tk, int s) {
+    if (ti >= a->tile_rows || tj >= b->tile_cols || tk >= a->tile_cols) return;
+    if (s == 1) {
+        tile_multiply_add(tiled_tile(c, ti, tj), tiled_tile(a, ti, tk), tiled_tile(b, tk, tj), a->tile);
+        return;
+    }
+    int h = s / 2;
+    for (int kk = tk; kk <= tk + h; kk += h) {
+        #pragma omp task if (s >= MORTON_TASK_TILES)
+        multiply_rec(a, b, c, ti, tj, kk, h);
+        #pragma omp task if (s >= MORTON_TASK_TILES)
+        multiply_rec(a, b, c, ti, tj + h, kk, h);
+        #pragma omp task if (s >= MORTON_TASK_TILES)
+        multiply_rec(a, b, c, ti + h, tj, kk, h);
+        multiply_rec(a, b, c, ti + h, tj + h, kk, h);
+        #pragma omp taskwait
+    }
+}
+
+TiledMatrix *tiled_multiply(const TiledMatrix *a, const TiledMatrix *b, const char *name) {
+    if (!a || !b || a->cols != b->rows || a->tile != b->tile) return NULL;
+    TiledMatrix *c = create_tiled_matrix(name, a->rows, b->cols, a->tile);
+    if (!c) return NULL;
+    int side = a->tile_rows;
+    if (a->tile_cols > side) side = a->tile_cols;
+    if (b->tile_cols > side) side = b->tile_cols;
+    side = next_pow2(side);
+    #pragma omp parallel
+    #pragma omp single
+    multiply_rec(a, b, c, 0, 0, 0, side);
+    return c;
+}
+
+Matrix *multiply_matrices_morton(const Matrix *a, const Matrix *b, const char *name, int tile,
+                                 double *exec_time) {
+    if (!a || !b || a->cols != b->rows) return NULL;
+    double start = get_time();
+    TiledMatrix *ta = tiled_from_dense(a, tile);
+    TiledMatrix *tb = ta ? tiled_from_dense(b, tile) : NULL;
+    TiledMatrix *tc = tb ? tiled_multiply(ta, tb, name) : NULL;
+    Matrix *c = tc ? tiled_to_dense(tc) : NULL;
+    free_tiled_matrix(ta);
+    free_tiled_matrix(tb);
+    free_tiled_matrix(tc);
+    if (exec_time) *exec_time = get_time() - start;
+    return c;
+}
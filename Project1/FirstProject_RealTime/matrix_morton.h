@@ -0,0 +1,92 @@
+#ifndef MATRIX_MORTON_H
+#define MATRIX_MORTON_H
+
+#include <stdint.h>
+#include "matrix_types.h"
+
+/*
+ * Tiled Z-order (Morton) layout for recursive algorithms.
+ *
+ * The matrix is cut into tile x tile blocks, each stored contiguously
+ * (row-major inside the tile). Tiles are laid out in Morton order: the tile
+ * index interleaves the bits of the tile row and column, so every quadrant
+ * of every recursion level is one contiguous range of memory. Recursive
+ * kernels therefore touch contiguous data at each level and get good cache
+ * behaviour at all cache sizes without per-host block-size tuning.
+ *
+ * Edge tiles are zero-padded. The tile grid is addressed as if it were
+ * square with a power-of-two side, so strongly rectangular matrices carry
+ * extra padding; the layout is meant for square-ish operands.
+ */
+
+#define MORTON_DEFAULT_TILE 32
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    int tile;            /* tile edge, a power of two */
+    int tile_shift;      /* log2(tile) */
+    int tile_rows;       /* ceil(rows / tile) */
+    int tile_cols;       /* ceil(cols / tile) */
+    size_t tile_count;   /* tiles allocated: morton(tile_rows-1, tile_cols-1) + 1 */
+    double *data;        /* tile_count * tile * tile values */
+} TiledMatrix;
+
+/* Spread the low 32 bits of x to the even bit positions */
+static inline uint64_t morton_spread(uint32_t x) {
+    uint64_t v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v << 8))  & 0x00FF00FF00FF00FFULL;
+    v = (v | (v << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v << 2))  & 0x3333333333333333ULL;
+    v = (v | (v << 1))  & 0x5555555555555555ULL;
+    return v;
+}
+
+/* Morton index of tile (ti, tj): row bits odd, column bits even, so the
+ * four quadrants come in the order top-left, top-right, bottom-left,
+ * bottom-right.
+ */
+static inline uint64_t morton_index(int ti, int tj) {
+    return (morton_spread((uint32_t)ti) << 1) | morton_spread((uint32_t)tj);
+}
+
+/* First value of tile (ti, tj) */
+static inline double *tiled_tile(const TiledMatrix *m, int ti, int tj) {
+    return m->data + (size_t)morton_index(ti, tj) * ((size_t)m->tile * m->tile);
+}
+
+/* Address of element (i, j) */
+static inline double *tiled_at(const TiledMatrix *m, int i, int j) {
+    int mask = m->tile - 1;
+    return tiled_tile(m, i >> m->tile_shift, j >> m->tile_shift) + (size_t)(i & mask) * m->tile + (j & mask);
+}
+
+/* All-zero matrix; tile must be a power of two (0 selects MORTON_DEFAULT_TILE) */
+TiledMatrix *create_tiled_matrix(const char *name, int rows, int cols, int tile);
+void free_tiled_matrix(TiledMatrix *m);
+
+/* Conversion from and to the row-major Matrix (parallel over tiles) */
+TiledMatrix *tiled_from_dense(const Matrix *m, int tile);
+Matrix *tiled_to_dense(const TiledMatrix *t);
+
+/* Recursive out-of-place transpose */
+TiledMatrix *tiled_transpose(const TiledMatrix *a, const char *name);
+
+/* C = A * B by recursive quadrant splitting down to single tiles; the
+ * upper recursion levels run as OpenMP tasks. A and B must share a tile size.
+ * Returns NULL on dimension or tile-size mismatch.
+ */
+TiledMatrix *tiled_multiply(const TiledMatrix *a, const TiledMatrix *b, const char *name);
+
+/* a * b for row- or column-major operands through the tiled layout:
+ * convert both, tiled_multiply(), convert back. tile 0 selects
+ * MORTON_DEFAULT_TILE. *exec_time (optional) includes the conversions.
+ * Returns NULL on dimension mismatch, a tile that is not a power of two,
+ * or allocation failure.
+ */
+Matrix *multiply_matrices_morton(const Matrix *a, const Matrix *b, const char *name, int tile,
+                                 double *exec_time);
+
+#endif /* MATRIX_MORTON_H */
@@ -0,0 +1,513 @@
+#include "matrix_ordering.h"
+#include "matrix_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/* Adjacency lists without self loops, CSR-style */
+typedef struct {
+    int n;
+    long *ptr;
+    int *adj;
+} Graph;
+
+static void free_graph(Graph *g) {
+    free(g->ptr);
+    free(g->adj);
+}
+
+const char *ordering_name(OrderingMethod method) {
+    switch (method) {
+        case ORDER_RCM: return "RCM";
+        case ORDER_AMD: return "AMD";
+        default:        return "natural";
+    }
+}
+
+/* Drop duplicate neighbours in place; mark[] is scratch of n entries */
+static void compact_graph(Graph *g, long *fill, int *mark) {
+    long out = 0;
+    for (int i = 0; i < g->n; i++) mark[i] = -1;
+    for (int i = 0; i < g->n; i++) {
+        long start = out;
+        for (long p = g->ptr[i]; p < fill[i]; p++) {
+            int j = g->adj[p];
+            if (mark[j] == i) continue;
+            mark[j] = i;
+            g->adj[out++] = j;
+        }
+        g->ptr[i] = start;
+    }
+    g->ptr[g->n] = out;
+}
+
+/* Pattern of A + A^T without the diagonal */
+static int symmetric_graph(const SparseMatrix *s, Graph *g) {
+    int n = s->rows;
+    g->n = n;
+    g->ptr = (long *)calloc((size_t)n + 1, sizeof(long));
+    long *fill = (long *)malloc((size_t)n * sizeof(long));
+    int *mark = (int *)malloc((size_t)n * sizeof(int));
+    if (!g->ptr || !fill || !mark) goto fail;
+
+    for (int i = 0; i < n; i++) {
+        for (long p = s->row_ptr[i]; p < s->row_ptr[i + 1]; p++) {
+            int j = s->col_idx[p];
+            if (j == i) continue;
+            g->ptr[i + 1]++;
+            g->ptr[j + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++) g->ptr[i + 1] += g->ptr[i];
+    g->adj = (int *)malloc((size_t)(g->ptr[n] > 0 ? g->ptr[n] : 1) * sizeof(int));
+    if (!g->adj) goto fail;
+    memcpy(fill, g->ptr, (size_t)n * sizeof(long));
+    for (int i = 0; i < n; i++) {
+        for (long p = s->row_ptr[i]; p < s->row_ptr[i + 1]; p++) {
+            int j = s->col_idx[p];
+            if (j == i) continue;
+            g->adj[fill[i]++] = j;
+            g->adj[fill[j]++] = i;
+        }
+    }
+    compact_graph(g, fill, mark);
+    free(fill);
+    free(mark);
+    return 1;
+
+fail:
+    free(fill);
+    free(mark);
+    free_graph(g);
+    return 0;
+}
+
+/* Pattern of A^T A without the diagonal: columns sharing a row are
+ * neighbours. Dense rows would make everything adjacent and are skipped.
+ */
+static int column_graph(const SparseMatrix *s, Graph *g) {
+    int n = s->cols, m = s->rows;
+    long dense = (long)(ORDER_DENSE_ROW * sqrt((double)n));
+    if (dense < 16) dense = 16;
+    g->n = n;
+    g->ptr = (long *)calloc((size_t)n + 1, sizeof(long));
+    long *cptr = (long *)calloc((size_t)n + 1, sizeof(long));
+    int *crow = (int *)malloc((size_t)(s->nnz > 0 ? s->nnz : 1) * sizeof(int));
+    long *fill = (long *)malloc((size_t)n * sizeof(long));
+    int *mark = (int *)malloc((size_t)n * sizeof(int));
+    if (!g->ptr || !cptr || !crow || !fill || !mark) goto fail;
+
+    /* rows of each column (the transpose pattern) */
+    for (long p = 0; p < s->nnz; p++) cptr[s->col_idx[p] + 1]++;
+    for (int j = 0; j < n; j++) cptr[j + 1] += cptr[j];
+    memcpy(fill, cptr, (size_t)n * sizeof(long));
+    for (int i = 0; i < m; i++) {
+        for (long p = s->row_ptr[i]; p < s->row_ptr[i + 1]; p++) crow[fill[s->col_idx[p]]++] = i;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int j = 0; j < n; j++) mark[j] = -1;
+        for (int j = 0; j < n; j++) {
+            mark[j] = j;
+            for (long q = cptr[j]; q < cptr[j + 1]; q++) {
+                int r = crow[q];
+                if (s->row_ptr[r + 1] - s->row_ptr[r] > dense) continue;
+                for (long p = s->row_ptr[r]; p < s->row_ptr[r + 1]; p++) {
+                    int c = s->col_idx[p];
+                    if (mark[c] == j) continue;
+                    mark[c] = j;
+                    if (pass == 0) g->ptr[j + 1]++;
+                    else g->adj[fill[j]++] = c;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int j = 0; j < n; j++) g->ptr[j + 1] += g->ptr[j];
+            g->adj = (int *)malloc((size_t)(g->ptr[n] > 0 ? g->ptr[n] : 1) * sizeof(int));
+            if (!g->adj) goto fail;
+            memcpy(fill, g->ptr, (size_t)n * sizeof(long));
+        }
+    }
+    free(cptr); free(crow); free(fill); free(mark);
+    return 1;
+
+fail:
+    free(cptr); free(crow); free(fill); free(mark);
+    free_graph(g);
+    return 0;
+}
+
+/* ===== Reverse Cuthill-McKee ===== */
+
+static int cmp_key(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/* Breadth-first search from root; queue receives the component in level
+ * order. Returns the number of levels, *last = start of the last level.
+ */
+static int bfs_levels(const Graph *g, int root, int *queue, int *mark, int stamp, int *count, int *last) {
+    int head = 0, tail = 0, levels = 0;
+    queue[tail++] = root;
+    mark[root] = stamp;
+    while (head < tail) {
+        int level_end = tail;
+        *last = head;
+        levels++;
+        for (; head < level_end; head++) {
+            int u = queue[head];
+            for (long p = g->ptr[u]; p < g->ptr[u + 1]; p++) {
+                int v = g->adj[p];
+                if (mark[v] != stamp) { mark[v] = stamp; queue[tail++] = v; }
+            }
+        }
+    }
+    *count = tail;
+    return levels;
+}
+
+/* George-Liu: move to a least-degree node of the last level while the
+ * eccentricity keeps growing
+ */
+static int pseudo_peripheral(const Graph *g, int root, int *queue, int *mark, int *stamp) {
+    int count, last;
+    int levels = bfs_levels(g, root, queue, mark, ++*stamp, &count, &last);
+    for (int iter = 0; iter < 8; iter++) {
+        int best = queue[last];
+        for (int t = last; t < count; t++) {
+            int v = queue[t];
+            if (g->ptr[v + 1] - g->ptr[v] < g->ptr[best + 1] - g->ptr[best]) best = v;
+        }
+        int more = bfs_levels(g, best, queue, mark, ++*stamp, &count, &last);
+        if (more <= levels) break;
+        root = best;
+        levels = more;
+    }
+    return root;
+}
+
+static int rcm(const Graph *g, int *perm) {
+    int n = g->n;
+    if (n <= 0) return 1;
+    int *queue = (int *)malloc((size_t)n * sizeof(int));
+    int *mark = (int *)malloc((size_t)n * sizeof(int));
+    int *by_degree = (int *)malloc((size_t)n * sizeof(int));
+    long *bucket = (long *)calloc((size_t)n + 1, sizeof(long));
+    char *visited = (char *)calloc((size_t)n, 1);
+    long max_deg = 0;
+    for (int i = 0; i < n; i++) {
+        long d = g->ptr[i + 1] - g->ptr[i];
+        if (d > max_deg) max_deg = d;
+    }
+    long long *keys = (long long *)malloc((size_t)(max_deg > 0 ? max_deg : 1) * sizeof(long long));
+    if (!queue || !mark || !by_degree || !bucket || !visited || !keys) {
+        free(queue); free(mark); free(by_degree); free(bucket); free(visited); free(keys);
+        return 0;
+    }
+    for (int i = 0; i < n; i++) mark[i] = 0;
+
+    /* nodes by increasing degree, so each component starts near its rim */
+    for (int i = 0; i < n; i++) bucket[g->ptr[i + 1] - g->ptr[i]]++;
+    for (long d = 0, run = 0; d < n; d++) { long c = bucket[d]; bucket[d] = run; run += c; }
+    for (int i = 0; i < n; i++) by_degree[bucket[g->ptr[i + 1] - g->ptr[i]]++] = i;
+
+    int stamp = 0, k = 0, cursor = 0;
+    while (k < n) {
+        while (visited[by_degree[cursor]]) cursor++;
+        int start = pseudo_peripheral(g, by_degree[cursor], queue, mark, &stamp);
+        int head = k;
+        perm[k++] = start;
+        visited[start] = 1;
+        while (head < k) {
+            int u = perm[head++];
+            int found = 0;
+            for (long p = g->ptr[u]; p < g->ptr[u + 1]; p++) {
+                int v = g->adj[p];
+                if (visited[v]) continue;
+                visited[v] = 1;
+                keys[found++] = ((long long)(g->ptr[v + 1] - g->ptr[v]) << 32) | (long long)v;
+            }
+            qsort(keys, (size_t)found, sizeof(long long), cmp_key);
+            for (int t = 0; t < found; t++) perm[k++] = (int)(keys[t] & 0xffffffffLL);
+        }
+    }
+    for (int i = 0, j = n - 1; i < j; i++, j--) { int t = perm[i]; perm[i] = perm[j]; perm[j] = t; }
+
+    free(queue); free(mark); free(by_degree); free(bucket); free(visited); free(keys);
+    return 1;
+}
+
+/* ===== Approximate minimum degree ===== */
+
+typedef struct {
+    int *v;
+    int n, cap;
+} IntList;
+
+static int list_push(IntList *l, int x) {
+    if (l->n == l->cap) {
+        int cap = l->cap ? 2 * l->cap : 4;
+        int *v = (int *)realloc(l->v, (size_t)cap * sizeof(int));
+        if (!v) return 0;
+        l->v = v;
+        l->cap = cap;
+    }
+    l->v[l->n++] = x;
+    return 1;
+}
+
+static void list_free(IntList *l) {
+    free(l->v);
+    l->v = NULL;
+    l->n = l->cap = 0;
+}
+
+enum { NODE_VARIABLE = 0, NODE_ELEMENT, NODE_ABSORBED };
+
+/* Degree lists: head[d] -> next -> ... */
+typedef struct {
+    int *head, *next, *prev;
+} Buckets;
+
+static void bucket_insert(Buckets *b, int i, int d) {
+    b->prev[i] = -1;
+    b->next[i] = b->head[d];
+    if (b->head[d] >= 0) b->prev[b->head[d]] = i;
+    b->head[d] = i;
+}
+
+static void bucket_remove(Buckets *b, int i, int d) {
+    if (b->prev[i] >= 0) b->next[b->prev[i]] = b->next[i];
+    else b->head[d] = b->next[i];
+    if (b->next[i] >= 0) b->prev[b->next[i]] = b->prev[i];
+}
+
+/* Quotient-graph minimum degree. For a variable i, var[i] holds the
+ * variable neighbours not yet covered by an element and elem[i] the
+ * adjacent elements; for an element e, var[e] holds its variables L_e.
+ * Eliminating p turns it into the element L_p = var[p] + the L_e of its
+ * elements, which are absorbed. For i in L_p the degree becomes
+ *     min(d_i + |L_p| - 1, |var[i]| + |L_p| - 1 + sum_e |L_e \ L_p|),
+ * where |L_e \ L_p| comes from one scan of the elements around L_p.
+ */
+static int amd(const Graph *g, int *perm) {
+    int n = g->n, ok = 1;
+    IntList *var = (IntList *)calloc((size_t)n, sizeof(IntList));
+    IntList *elem = (IntList *)calloc((size_t)n, sizeof(IntList));
+    char *status = (char *)calloc((size_t)n, 1);
+    int *deg = (int *)malloc((size_t)n * sizeof(int));
+    int *mark = (int *)calloc((size_t)n, sizeof(int));
+    int *wmark = (int *)calloc((size_t)n, sizeof(int));
+    int *w = (int *)malloc((size_t)n * sizeof(int));
+    Buckets b;
+    b.head = (int *)malloc((size_t)n * sizeof(int));
+    b.next = (int *)malloc((size_t)n * sizeof(int));
+    b.prev = (int *)malloc((size_t)n * sizeof(int));
+    if (!var || !elem || !status || !deg || !mark || !wmark || !w || !b.head || !b.next || !b.prev) {
+        ok = 0;
+        goto done;
+    }
+
+    for (int i = 0; i < n; i++) b.head[i] = -1;
+    for (int i = 0; i < n && ok; i++) {
+        for (long p = g->ptr[i]; p < g->ptr[i + 1] && ok; p++) ok = list_push(&var[i], g->adj[p]);
+        deg[i] = var[i].n;
+        bucket_insert(&b, i, deg[i]);
+    }
+
+    int mindeg = 0, stamp = 0, wstamp = 0;
+    for (int k = 0; k < n && ok; k++) {
+        while (b.head[mindeg] < 0) mindeg++;
+        int p = b.head[mindeg];
+        bucket_remove(&b, p, mindeg);
+        perm[k] = p;
+        status[p] = NODE_ELEMENT;
+
+        /* L_p: the uncovered neighbours plus the variables of p's elements */
+        IntList lp = { NULL, 0, 0 };
+        mark[p] = ++stamp;
+        for (int t = 0; t < var[p].n && ok; t++) {
+            int v = var[p].v[t];
+            if (status[v] == NODE_VARIABLE && mark[v] != stamp) { mark[v] = stamp; ok = list_push(&lp, v); }
+        }
+        for (int t = 0; t < elem[p].n && ok; t++) {
+            int e = elem[p].v[t];
+            if (status[e] != NODE_ELEMENT) continue;
+            for (int u = 0; u < var[e].n && ok; u++) {
+                int v = var[e].v[u];
+                if (status[v] == NODE_VARIABLE && mark[v] != stamp) { mark[v] = stamp; ok = list_push(&lp, v); }
+            }
+            status[e] = NODE_ABSORBED;
+            list_free(&var[e]);
+        }
+        list_free(&var[p]);
+        list_free(&elem[p]);
+        var[p] = lp;
+        if (!ok) break;
+
+        /* w[e] = |L_e \ L_p| for every element next to L_p */
+        ++wstamp;
+        for (int t = 0; t < lp.n; t++) {
+            int i = lp.v[t];
+            bucket_remove(&b, i, deg[i]);
+            for (int u = 0; u < elem[i].n; u++) {
+                int e = elem[i].v[u];
+                if (status[e] != NODE_ELEMENT) continue;
+                if (wmark[e] != wstamp) { wmark[e] = wstamp; w[e] = var[e].n; }
+                w[e]--;
+            }
+        }
+
+        int remaining = n - k - 1;
+        for (int t = 0; t < lp.n && ok; t++) {
+            int i = lp.v[t];
+            long esum = 0;
+            int out = 0;
+            for (int u = 0; u < elem[i].n; u++) {
+                int e = elem[i].v[u];
+                if (status[e] != NODE_ELEMENT) continue;
+                elem[i].v[out++] = e;
+                esum += w[e];
+            }
+            elem[i].n = out;
+            ok = list_push(&elem[i], p);
+
+            /* neighbours inside L_p are now reached through p */
+            out = 0;
+            for (int u = 0; u < var[i].n; u++) {
+                int v = var[i].v[u];
+                if (status[v] == NODE_VARIABLE && mark[v] != stamp && v != i) var[i].v[out++] = v;
+            }
+            var[i].n = out;
+
+            long d = (long)var[i].n + lp.n - 1 + esum;
+            long bound = (long)deg[i] + lp.n - 1;
+            if (bound < d) d = bound;
+            if (d > remaining - 1) d = remaining - 1;
+            if (d < 0) d = 0;
+            deg[i] = (int)d;
+            bucket_insert(&b, i, deg[i]);
+            if (deg[i] < mindeg) mindeg = deg[i];
+        }
+    }
+
+done:
+    if (var) for (int i = 0; i < n; i++) list_free(&var[i]);
+    if (elem) for (int i = 0; i < n; i++) list_free(&elem[i]);
+    free(var); free(elem); free(status); free(deg); free(mark); free(wmark); free(w);
+    free(b.head); free(b.next); free(b.prev);
+    return ok;
+}
+
+/* ===== Public API ===== */
+
+static int *order_graph(Graph *g, OrderingMethod method) {
+    int *perm = (int *)malloc((size_t)(g->n > 0 ? g->n : 1) * sizeof(int));
+    int ok = perm != NULL;
+    if (ok && method == ORDER_RCM) ok = rcm(g, perm);
+    else if (ok && method == ORDER_AMD) ok = amd(g, perm);
+    else if (ok) for (int i = 0; i < g->n; i++) perm[i] = i;
+    free_graph(g);
+    if (!ok) { free(perm); return NULL; }
+    return perm;
+}
+
+int *sparse_ordering(const SparseMatrix *s, OrderingMethod method) {
+    if (!s) return NULL;
+    if (s->rows != s->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: symmetric ordering needs a square matrix ('%s' is %dx%d)",
+                s->name, s->rows, s->cols);
+        return NULL;
+    }
+    Graph g = { 0, NULL, NULL };
+    if (!symmetric_graph(s, &g)) return NULL;
+    return order_graph(&g, method);
+}
+
+int *sparse_column_ordering(const SparseMatrix *s, OrderingMethod method) {
+    if (!s) return NULL;
+    Graph g = { 0, NULL, NULL };
+    if (!column_graph(s, &g)) return NULL;
+    return order_graph(&g, method);
+}
+
+typedef struct {
+    int col;
+    double val;
+} Entry;
+
+static int cmp_entry(const void *a, const void *b) {
+    int x = ((const Entry *)a)->col, y = ((const Entry *)b)->col;
+    return (x > y) - (x < y);
+}
+
+SparseMatrix *sparse_permute(const SparseMatrix *s, const int *p, const int *q, const char *name) {
+    if (!s || !name) return NULL;
+    int *qinv = (int *)malloc((size_t)(s->cols > 0 ? s->cols : 1) * sizeof(int));
+    SparseMatrix *c = create_sparse_matrix(name, s->rows, s->cols, s->nnz);
+    long max_row = 0;
+    for (int i = 0; i < s->rows; i++) {
+        long len = s->row_ptr[i + 1] - s->row_ptr[i];
+        if (len > max_row) max_row = len;
+    }
+    Entry *row = (Entry *)malloc((size_t)(max_row > 0 ? max_row : 1) * sizeof(Entry));
+    if (!qinv || !c || !row) { free(qinv); free(row); free_sparse_matrix(c); return NULL; }
+
+    for (int k = 0; k < s->cols; k++) qinv[q ? q[k] : k] = k;
+    long out = 0;
+    for (int k = 0; k < s->rows; k++) {
+        int i = p ? p[k] : k;
+        int len = 0;
+        for (long t = s->row_ptr[i]; t < s->row_ptr[i + 1]; t++) {
+            row[len].col = qinv[s->col_idx[t]];
+            row[len].val = s->values[t];
+            len++;
+        }
+        if (q) qsort(row, (size_t)len, sizeof(Entry), cmp_entry);
+        for (int t = 0; t < len; t++) {
+            c->col_idx[out] = row[t].col;
+            c->values[out] = row[t].val;
+            out++;
+        }
+        c->row_ptr[k + 1] = out;
+    }
+    c->nnz = out;
+    free(qinv);
+    free(row);
+    return c;
+}
+
+int sparse_bandwidth(const SparseMatrix *s, int *lower, int *upper) {
+    int lo = 0, up = 0;
+    if (s) {
+        for (int i = 0; i < s->rows; i++) {
+            for (long p = s->row_ptr[i]; p < s->row_ptr[i + 1]; p++) {
+                int d = s->col_idx[p] - i;
+                if (d > up) up = d;
+                if (-d > lo) lo = -d;
+            }
+        }
+    }
+    if (lower) *lower = lo;
+    if (upper) *upper = up;
+    return lo > up ? lo : up;
+}
+
+int permutation_sign(const int *perm, int n) {
+    char *seen = (char *)calloc((size_t)(n > 0 ? n : 1), 1);
+    if (!seen) return 0;
+    int sign = 1;
+    for (int i = 0; i < n; i++) {
+        if (seen[i]) continue;
+        int len = 0;
+        for (int j = i; !seen[j]; j = perm[j]) {
+            if (perm[j] < 0 || perm[j] >= n) { free(seen); return 0; }
+            seen[j] = 1;
+            len++;
+        }
+        if (len % 2 == 0) sign = -sign;
+    }
+    free(seen);
+    return sign;
+}
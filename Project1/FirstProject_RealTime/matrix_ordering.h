@@ -0,0 +1,65 @@
+#ifndef MATRIX_ORDERING_H
+#define MATRIX_ORDERING_H
+
+#include "matrix_sparse.h"
+
+/*
+ * Reorderings of sparse matrices. Eliminating in a good order keeps the
+ * factors sparse; on a mesh-derived matrix it is the difference between
+ * O(n^2) and near-linear fill.
+ *
+ * - Reverse Cuthill-McKee: breadth-first search from a pseudo-peripheral
+ *   node of each connected component, neighbours visited by increasing
+ *   degree, then reversed. Small bandwidth and profile; the ordering for
+ *   banded storage (matrix_band.h).
+ * - Approximate minimum degree: eliminates a node of (approximately)
+ *   least degree at every step. The elimination graph is kept in quotient
+ *   form (eliminated nodes become elements that stand for the cliques they
+ *   create), so memory never exceeds that of A, and degrees are the AMD
+ *   upper bounds computed from the element sizes. Least fill; the ordering
+ *   for sparse LU and Cholesky (matrix_sparse_factor.h).
+ *
+ * The symmetric orderings work on the pattern of A + A^T and are applied
+ * as P A P^T. The column ordering works on the pattern of A^T A, with
+ * rows denser than ORDER_DENSE_ROW * sqrt(n) ignored, and is applied as
+ * A Q for LU with row pivoting.
+ *
+ * A permutation perm lists old indices in their new order: new index k is
+ * old index perm[k].
+ */
+
+#define ORDER_DENSE_ROW 10
+
+typedef enum {
+    ORDER_NATURAL = 0,
+    ORDER_RCM,
+    ORDER_AMD
+} OrderingMethod;
+
+/* Name for reports ("natural", "RCM", "AMD") */
+const char *ordering_name(OrderingMethod method);
+
+/* Symmetric ordering of square s; returns a malloc'd permutation of
+ * s->rows entries or NULL (not square, allocation failure)
+ */
+int *sparse_ordering(const SparseMatrix *s, OrderingMethod method);
+
+/* Column ordering of s from the pattern of A^T A (s->cols entries) */
+int *sparse_column_ordering(const SparseMatrix *s, OrderingMethod method);
+
+/* A(p, q) as a new CSR matrix: row k is row p[k] of A, column k is column
+ * q[k]. p or q NULL means the identity.
+ */
+SparseMatrix *sparse_permute(const SparseMatrix *s, const int *p, const int *q, const char *name);
+
+/* Largest distance of a stored entry below (*lower) and above (*upper) the
+ * diagonal; returns the larger of the two
+ */
+int sparse_bandwidth(const SparseMatrix *s, int *lower, int *upper);
+
+/* +1 or -1: the sign of permutation perm of n entries (0 if perm is not a
+ * permutation)
+ */
+int permutation_sign(const int *perm, int n);
+
+#endif /* MATRIX_ORDERING_H */
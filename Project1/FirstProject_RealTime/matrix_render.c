@@ -0,0 +1,325 @@
+#include "matrix_render.h"
+#include <stdarg.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Rows formatted per parallel batch in a full dump */
+#define RENDER_DUMP_BLOCK 256
+
+/* ===== Output buffer ===== */
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    int failed;
+} RenderBuffer;
+
+static int rb_reserve(RenderBuffer *b, size_t extra) {
+    if (b->failed) return 0;
+    if (b->len + extra + 1 <= b->cap) return 1;
+    size_t newcap = b->cap ? b->cap : 4096;
+    while (newcap < b->len + extra + 1) newcap *= 2;
+    char *tmp = (char *)realloc(b->data, newcap);
+    if (!tmp) { b->failed = 1; return 0; }
+    b->data = tmp;
+    b->cap = newcap;
+    return 1;
+}
+
+static void rb_puts(RenderBuffer *b, const char *s) {
+    size_t n = strlen(s);
+    if (!rb_reserve(b, n)) return;
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+static void rb_printf(RenderBuffer *b, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+static void rb_printf(RenderBuffer *b, const char *fmt, ...) {
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(NULL, 0, fmt, ap);
+    va_end(ap);
+    if (n < 0 || !rb_reserve(b, (size_t)n)) return;
+    va_start(ap, fmt);
+    vsnprintf(b->data + b->len, (size_t)n + 1, fmt, ap);
+    va_end(ap);
+    b->len += (size_t)n;
+}
+
+static void rb_flush(RenderBuffer *b, FILE *out) {
+    if (b->len > 0) fwrite(b->data, 1, b->len, out);
+    fflush(out);
+    b->len = 0;
+}
+
+static void rb_free(RenderBuffer *b) {
+    free(b->data);
+    b->data = NULL;
+    b->len = b->cap = 0;
+}
+
+/* ===== Row formatting ===== */
+
+/* Matrix style: "%10.4f " per value. Eigenvector style: "  [ % .6f ... ]" */
+typedef enum { ROW_PLAIN, ROW_BRACKETED } RowStyle;
+
+static void rb_value(RenderBuffer *b, double v, const RenderOptions *o, RowStyle style) {
+    if (style == ROW_BRACKETED) rb_printf(b, " % .*f", o->precision, v);
+    else rb_printf(b, "%*.*f ", o->width, o->precision, v);
+}
+
+static void rb_gap(RenderBuffer *b, const RenderOptions *o, RowStyle style) {
+    if (style == ROW_BRACKETED) rb_puts(b, " ...");
+    else rb_printf(b, "%*s ", o->width, "...");
+}
+
+/* Row i, all columns or, when wider than two edges, the head and tail edges.
+ * Elements are read through the strides so either layout renders the same.
+ */
+static void rb_row(RenderBuffer *b, const Matrix *m, int i, int edge, const RenderOptions *o,
+                   RowStyle style) {
+    int cols = m->cols;
+    if (style == ROW_BRACKETED) rb_puts(b, "  [");
+    if (edge <= 0 || cols <= 2 * edge) {
+        for (int j = 0; j < cols; j++) rb_value(b, mat_get(m, i, j), o, style);
+    } else {
+        for (int j = 0; j < edge; j++) rb_value(b, mat_get(m, i, j), o, style);
+        rb_gap(b, o, style);
+        for (int j = cols - edge; j < cols; j++) rb_value(b, mat_get(m, i, j), o, style);
+    }
+    rb_puts(b, style == ROW_BRACKETED ? " ]\n" : "\n");
+}
+
+/* "..." line standing in for the skipped rows */
+static void rb_row_gap(RenderBuffer *b, int skipped, int cols, int edge, const RenderOptions *o,
+                       RowStyle style) {
+    int shown = (edge <= 0 || cols <= 2 * edge) ? cols : 2 * edge + 1;
+    if (style == ROW_BRACKETED) rb_puts(b, "  [");
+    for (int j = 0; j < shown; j++) rb_gap(b, o, style);
+    rb_printf(b, "%s  (%d rows omitted)\n", style == ROW_BRACKETED ? " ]" : "", skipped);
+}
+
+static void rb_rows_summary(RenderBuffer *b, const Matrix *m, const RenderOptions *o, RowStyle style) {
+    int rows = m->rows, er = o->edge_rows, ec = o->edge_cols;
+    if (er <= 0 || rows <= 2 * er) {
+        for (int i = 0; i < rows; i++) rb_row(b, m, i, ec, o, style);
+        return;
+    }
+    for (int i = 0; i < er; i++) rb_row(b, m, i, ec, o, style);
+    rb_row_gap(b, rows - 2 * er, m->cols, ec, o, style);
+    for (int i = rows - er; i < rows; i++) rb_row(b, m, i, ec, o, style);
+}
+
+static const RenderOptions *resolve(const RenderOptions *opt, RenderOptions *storage) {
+    if (opt) return opt;
+    *storage = render_default_options();
+    return storage;
+}
+
+/* ===== Public API ===== */
+
+RenderOptions render_default_options(void) {
+    RenderOptions o;
+    o.edge_rows = RENDER_DEFAULT_EDGE;
+    o.edge_cols = RENDER_DEFAULT_EDGE;
+    o.width = 10;
+    o.precision = 4;
+    return o;
+}
+
+void render_matrix_summary(FILE *out, const Matrix *m, const RenderOptions *opt) {
+    if (!out || !m) return;
+    RenderOptions storage;
+    const RenderOptions *o = resolve(opt, &storage);
+    RenderBuffer b = {0};
+
+    rb_puts(&b, "\n========================================\n");
+    rb_printf(&b, "Matrix: %s\n", m->name);
+    int clipped = (o->edge_rows > 0 && m->rows > 2 * o->edge_rows) ||
+                  (o->edge_cols > 0 && m->cols > 2 * o->edge_cols);
+    rb_printf(&b, "Dimensions: %d x %d", m->rows, m->cols);
+    if (m->layout == MAT_COL_MAJOR) rb_puts(&b, " (column-major)");
+    if (clipped) rb_printf(&b, " (summary: first/last %d rows and columns)", o->edge_rows);
+    rb_puts(&b, "\n");
+    rb_puts(&b, "========================================\n");
+    rb_rows_summary(&b, m, o, ROW_PLAIN);
+    rb_puts(&b, "========================================\n\n");
+
+    rb_flush(&b, out);
+    rb_free(&b);
+}
+
+/* re in the value width, then +imi: "    1.0000-0.5000i" */
+static void rb_complex_value(RenderBuffer *b, const ComplexMatrix *m, int i, int j, const RenderOptions *o) {
+    const double *z = m->v + 2 * ((size_t)i * m->cols + j);
+    rb_printf(b, "%*.*f%+.*fi ", o->width, o->precision, z[0], o->precision, z[1]);
+}
+
+static void rb_complex_row(RenderBuffer *b, const ComplexMatrix *m, int i, const RenderOptions *o) {
+    int cols = m->cols, edge = o->edge_cols;
+    if (edge <= 0 || cols <= 2 * edge) {
+        for (int j = 0; j < cols; j++) rb_complex_value(b, m, i, j, o);
+    } else {
+        for (int j = 0; j < edge; j++) rb_complex_value(b, m, i, j, o);
+        rb_gap(b, o, ROW_PLAIN);
+        for (int j = cols - edge; j < cols; j++) rb_complex_value(b, m, i, j, o);
+    }
+    rb_puts(b, "\n");
+}
+
+void render_complex_summary(FILE *out, const ComplexMatrix *m, const RenderOptions *opt) {
+    if (!out || !m) return;
+    RenderOptions storage;
+    const RenderOptions *o = resolve(opt, &storage);
+    RenderBuffer b = {0};
+
+    rb_puts(&b, "\n========================================\n");
+    rb_printf(&b, "Matrix: %s\n", m->name);
+    int er = o->edge_rows;
+    int clipped = (er > 0 && m->rows > 2 * er) ||
+                  (o->edge_cols > 0 && m->cols > 2 * o->edge_cols);
+    rb_printf(&b, "Dimensions: %d x %d complex", m->rows, m->cols);
+    if (clipped) rb_printf(&b, " (summary: first/last %d rows and columns)", er);
+    rb_puts(&b, "\n");
+    rb_puts(&b, "========================================\n");
+    if (er <= 0 || m->rows <= 2 * er) {
+        for (int i = 0; i < m->rows; i++) rb_complex_row(&b, m, i, o);
+    } else {
+        for (int i = 0; i < er; i++) rb_complex_row(&b, m, i, o);
+        rb_printf(&b, "%*s  (%d rows omitted)\n", o->width, "...", m->rows - 2 * er);
+        for (int i = m->rows - er; i < m->rows; i++) rb_complex_row(&b, m, i, o);
+    }
+    rb_puts(&b, "========================================\n\n");
+
+    rb_flush(&b, out);
+    rb_free(&b);
+}
+
+int render_matrix_window(FILE *out, const Matrix *m, int row0, int nrows, int col0, int ncols,
+                         const RenderOptions *opt) {
+    if (!out || !m || nrows <= 0 || ncols <= 0) return 0;
+    if (row0 < 0) row0 = 0;
+    if (col0 < 0) col0 = 0;
+    if (row0 >= m->rows || col0 >= m->cols) return 0;
+    int row1 = (nrows > m->rows - row0) ? m->rows : row0 + nrows;
+    int col1 = (ncols > m->cols - col0) ? m->cols : col0 + ncols;
+
+    RenderOptions storage;
+    const RenderOptions *o = resolve(opt, &storage);
+    RenderBuffer b = {0};
+
+    rb_printf(&b, "\n%s: rows %d-%d, columns %d-%d of %d x %d\n",
+              m->name, row0, row1 - 1, col0, col1 - 1, m->rows, m->cols);
+    rb_printf(&b, "%8s", "");
+    for (int j = col0; j < col1; j++) rb_printf(&b, "%*d ", o->width, j);
+    rb_puts(&b, "\n");
+    for (int i = row0; i < row1; i++) {
+        rb_printf(&b, "[%5d] ", i);
+        for (int j = col0; j < col1; j++) rb_value(&b, mat_get(m, i, j), o, ROW_PLAIN);
+        rb_puts(&b, "\n");
+    }
+
+    rb_flush(&b, out);
+    rb_free(&b);
+    return 1;
+}
+
+/* Write the rows of m to f. Batches of rows are formatted concurrently into
+ * per-row buffers, then written out in order.
+ */
+static int dump_rows(FILE *f, const Matrix *m, const RenderOptions *o, RowStyle style) {
+    int rows = m->rows, cols = m->cols;
+    RenderBuffer *bufs = (RenderBuffer *)calloc(RENDER_DUMP_BLOCK, sizeof(RenderBuffer));
+    if (!bufs) return 0;
+    int ok = 1;
+    for (int start = 0; start < rows && ok; start += RENDER_DUMP_BLOCK) {
+        int count = rows - start < RENDER_DUMP_BLOCK ? rows - start : RENDER_DUMP_BLOCK;
+        #pragma omp parallel for schedule(dynamic, 8) if ((long)count * cols > 4096)
+        for (int k = 0; k < count; k++) {
+            bufs[k].len = 0;
+            rb_row(&bufs[k], m, start + k, 0, o, style);
+        }
+        for (int k = 0; k < count; k++) {
+            if (bufs[k].failed || fwrite(bufs[k].data, 1, bufs[k].len, f) != bufs[k].len) ok = 0;
+        }
+    }
+    for (int k = 0; k < RENDER_DUMP_BLOCK; k++) rb_free(&bufs[k]);
+    free(bufs);
+    return ok;
+}
+
+int render_matrix_to_file(const Matrix *m, const char *path, const RenderOptions *opt) {
+    if (!m || !path) return 0;
+    RenderOptions storage;
+    const RenderOptions *o = resolve(opt, &storage);
+    FILE *f = fopen(path, "w");
+    if (!f) return 0;
+
+    fprintf(f, "Matrix: %s\nDimensions: %d x %d\n", m->name, m->rows, m->cols);
+    int ok = dump_rows(f, m, o, ROW_PLAIN);
+    if (fclose(f) != 0) ok = 0;
+    return ok;
+}
+
+static void rb_eigenvalue(RenderBuffer *b, const EigenResult *res, int i) {
+    rb_printf(b, "  λ[%d] = %.10g\n", i, res->eigenvalues[i]);
+}
+
+void render_eigen_summary(FILE *out, const char *matrix_name, const EigenResult *res,
+                          const RenderOptions *opt) {
+    if (!out || !res) return;
+    RenderOptions storage;
+    if (!opt) {
+        storage = render_default_options();
+        storage.precision = 6;
+        opt = &storage;
+    }
+    RenderBuffer b = {0};
+    int n = res->n, er = opt->edge_rows;
+
+    rb_puts(&b, "\n========================================\n");
+    rb_puts(&b, "EIGENVALUE & EIGENVECTOR RESULTS\n");
+    rb_puts(&b, "========================================\n");
+    rb_printf(&b, "Matrix: %s (%dx%d)\n", matrix_name ? matrix_name : "?", n, n);
+    rb_printf(&b, "Converged in %d iterations\n\n", res->iterations);
+
+    rb_printf(&b, "Eigenvalues (%d):\n", n);
+    if (er <= 0 || n <= 2 * er) {
+        for (int i = 0; i < n; ++i) rb_eigenvalue(&b, res, i);
+    } else {
+        for (int i = 0; i < er; ++i) rb_eigenvalue(&b, res, i);
+        rb_printf(&b, "  ...  (%d eigenvalues omitted)\n", n - 2 * er);
+        for (int i = n - er; i < n; ++i) rb_eigenvalue(&b, res, i);
+    }
+
+    if (res->eigenvectors) {
+        rb_printf(&b, "\nEigenvectors matrix [%dx%d] (columns are eigenvectors):\n", n, n);
+        rb_rows_summary(&b, res->eigenvectors, opt, ROW_BRACKETED);
+    }
+    rb_puts(&b, "========================================\n\n");
+
+    rb_flush(&b, out);
+    rb_free(&b);
+}
+
+int render_eigen_to_file(const char *matrix_name, const EigenResult *res, const char *path) {
+    if (!res || !path) return 0;
+    FILE *f = fopen(path, "w");
+    if (!f) return 0;
+
+    RenderOptions o = render_default_options();
+    o.precision = 6;
+    fprintf(f, "Matrix: %s (%dx%d)\nConverged in %d iterations\n\nEigenvalues (%d):\n",
+            matrix_name ? matrix_name : "?", res->n, res->n, res->iterations, res->n);
+    for (int i = 0; i < res->n; ++i) fprintf(f, "  λ[%d] = %.10g\n", i, res->eigenvalues[i]);
+
+    int ok = 1;
+    if (res->eigenvectors) {
+        fprintf(f, "\nEigenvectors matrix [%dx%d] (columns are eigenvectors):\n", res->n, res->n);
+        ok = dump_rows(f, res->eigenvectors, &o, ROW_BRACKETED);
+    }
+    if (fclose(f) != 0) ok = 0;
+    return ok;
+}
@@ -0,0 +1,52 @@
+#ifndef MATRIX_RENDER_H
+#define MATRIX_RENDER_H
+
+#include "matrix_types.h"
+#include "eigen_qr.h"
+
+/*
+ * Text rendering for matrices and eigen results that stays fast for large
+ * sizes. Output is built in a memory buffer and written with one fwrite, so
+ * the cost no longer scales with the number of elements:
+ *   - summaries show the first/last edge rows and columns with "..." between,
+ *   - windows show an explicit row/column range with indices (for paging),
+ *   - full dumps go to a file only, with rows formatted in parallel.
+ * Matrices no larger than the summary edges render exactly as before.
+ */
+
+#define RENDER_DEFAULT_EDGE 4
+
+typedef struct {
+    int edge_rows;    /* rows shown at the top and at the bottom of a summary */
+    int edge_cols;    /* columns shown at the left and at the right */
+    int width;        /* field width of one value */
+    int precision;    /* digits after the decimal point */
+} RenderOptions;
+
+/* Defaults used when a NULL RenderOptions is passed (edges 4, "%10.4f") */
+RenderOptions render_default_options(void);
+
+/* Header plus head/tail/ellipsis view of m */
+void render_matrix_summary(FILE *out, const Matrix *m, const RenderOptions *opt);
+
+/* Same view of a complex matrix, each value as re+imi */
+void render_complex_summary(FILE *out, const ComplexMatrix *m, const RenderOptions *opt);
+
+/* Rows [row0, row0+nrows) x columns [col0, col0+ncols), clipped to m,
+ * with row and column indices.
+ * Returns: 1 if anything was shown, 0 if the window is outside m
+ */
+int render_matrix_window(FILE *out, const Matrix *m, int row0, int nrows, int col0, int ncols,
+                         const RenderOptions *opt);
+
+/* Every element of m, written to path. Returns: 1 on success, 0 on failure */
+int render_matrix_to_file(const Matrix *m, const char *path, const RenderOptions *opt);
+
+/* Eigenvalues (head/tail of the list) and a summary of the eigenvector matrix */
+void render_eigen_summary(FILE *out, const char *matrix_name, const EigenResult *res,
+                          const RenderOptions *opt);
+
+/* Every eigenvalue and eigenvector, written to path. Returns: 1 on success */
+int render_eigen_to_file(const char *matrix_name, const EigenResult *res, const char *path);
+
+#endif /* MATRIX_RENDER_H */
@@ -0,0 +1,417 @@
+#define _GNU_SOURCE
+#include "matrix_resources.h"
+#include "matrix_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define CG_PATH_MAX 1024
+
+/* ===== cgroup discovery ===== */
+
+/* Mount of one hierarchy: files for cgroup path p live under
+ * mountpoint + (p minus root)
+ */
+typedef struct {
+    char root[CG_PATH_MAX];
+    char mountpoint[CG_PATH_MAX];
+    char path[CG_PATH_MAX];     /* this process's cgroup in the hierarchy */
+    int found;
+} CgroupMount;
+
+/* 1 if name is one of the comma-separated words of list */
+static int has_word(const char *list, const char *name) {
+    size_t len = strlen(name);
+    for (const char *p = list; p && *p; ) {
+        const char *end = strchr(p, ',');
+        size_t n = end ? (size_t)(end - p) : strlen(p);
+        if (n == len && strncmp(p, name, len) == 0) return 1;
+        p = end ? end + 1 : NULL;
+    }
+    return 0;
+}
+
+/* Find the cgroup2 mount (controller == NULL) or the v1 mount carrying
+ * controller in /proc/self/mountinfo
+ */
+static int find_mount(const char *controller, CgroupMount *m) {
+    FILE *f = fopen("/proc/self/mountinfo", "r");
+    if (!f) return 0;
+    char line[4 * CG_PATH_MAX];
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), f)) {
+        char root[CG_PATH_MAX], mountpoint[CG_PATH_MAX];
+        if (sscanf(line, "%*d %*d %*s %1023s %1023s", root, mountpoint) != 2) continue;
+        const char *sep = strstr(line, " - ");
+        if (!sep) continue;
+        char fstype[64], source[256], options[1024];
+        if (sscanf(sep + 3, "%63s %255s %1023s", fstype, source, options) != 3) continue;
+        if (controller ? (strcmp(fstype, "cgroup") == 0 && has_word(options, controller))
+                       : strcmp(fstype, "cgroup2") == 0) {
+            strcpy(m->root, root);
+            strcpy(m->mountpoint, mountpoint);
+            found = 1;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+/* Path of this process in the hierarchy, from /proc/self/cgroup lines
+ * "id:controllers:path" (v2: "0::path")
+ */
+static int find_path(const char *controller, CgroupMount *m) {
+    FILE *f = fopen("/proc/self/cgroup", "r");
+    if (!f) return 0;
+    char line[CG_PATH_MAX + 256];
+    int found = 0;
+    while (!found && fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\n")] = '\0';
+        char *c1 = strchr(line, ':');
+        char *c2 = c1 ? strchr(c1 + 1, ':') : NULL;
+        if (!c2) continue;
+        *c2 = '\0';
+        const char *controllers = c1 + 1;
+        if (controller ? has_word(controllers, controller) : (strncmp(line, "0", 1) == 0 && *controllers == '\0')) {
+            snprintf(m->path, sizeof(m->path), "%s", c2 + 1);
+            found = 1;
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+static int open_hierarchy(const char *controller, CgroupMount *m) {
+    memset(m, 0, sizeof(*m));
+    m->found = find_mount(controller, m) && find_path(controller, m);
+    return m->found;
+}
+
+/* Directory of this process's group. In a cgroup namespace the mount root
+ * is the group itself, so the path is cut down to what lies below it; a
+ * path outside the mounted subtree falls back to the mount point. Returns 0
+ * if the path does not fit in len.
+ */
+static int leaf_dir(const CgroupMount *m, char *dir, size_t len) {
+    const char *rel = m->path;
+    size_t rlen = strlen(m->root);
+    if (strcmp(m->root, "/") != 0) {
+        if (strncmp(rel, m->root, rlen) == 0 && (rel[rlen] == '/' || rel[rlen] == '\0')) rel += rlen;
+        else rel = "";
+    }
+    if (strcmp(rel, "/") == 0) rel = "";
+    return snprintf(dir, len, "%s%s", m->mountpoint, rel) < (int)len;
+}
+
+/* Drop the last component of dir; 0 once dir is the mount point */
+static int parent_dir(const CgroupMount *m, char *dir) {
+    if (strlen(dir) <= strlen(m->mountpoint)) return 0;
+    char *slash = strrchr(dir, '/');
+    if (!slash) return 0;
+    *slash = '\0';
+    return strlen(dir) >= strlen(m->mountpoint);
+}
+
+static int read_line(const char *dir, const char *file, char *buf, size_t len) {
+    char path[2 * CG_PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", dir, file);
+    FILE *f = fopen(path, "r");
+    if (!f) return 0;
+    int ok = fgets(buf, (int)len, f) != NULL;
+    fclose(f);
+    if (ok) buf[strcspn(buf, "\n")] = '\0';
+    return ok;
+}
+
+/* CPUs in a list such as "0-3,8,10-11" */
+static int count_cpu_list(const char *list) {
+    int count = 0;
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long a = strtol(p, &end, 10);
+        if (end == p) break;
+        long b = a;
+        if (*end == '-') {
+            p = end + 1;
+            b = strtol(p, &end, 10);
+            if (end == p) break;
+        }
+        if (b >= a) count += (int)(b - a + 1);
+        p = end;
+        if (*p == ',') p++;
+        else break;
+    }
+    return count;
+}
+
+/* ===== Limits along the hierarchy ===== */
+
+/* A hybrid system may mount an empty cgroup2 tree next to the v1
+ * controllers; it only counts if it carries cpu, cpuset or memory
+ */
+static int v2_has_controllers(const CgroupMount *m) {
+    char buf[512];
+    if (!read_line(m->mountpoint, "cgroup.controllers", buf, sizeof(buf))) return 0;
+    for (char *p = buf; *p; p++) if (*p == ' ') *p = ',';
+    return has_word(buf, "cpu") || has_word(buf, "cpuset") || has_word(buf, "memory");
+}
+
+static void probe_v2(ResourceBudget *b, const CgroupMount *m) {
+    char dir[CG_PATH_MAX], buf[256];
+    if (!leaf_dir(m, dir, sizeof(dir))) return;
+    int have_cpuset = 0;
+    do {
+        long long quota, period;
+        char word[32];
+        if (read_line(dir, "cpu.max", buf, sizeof(buf)) && sscanf(buf, "%31s %lld", word, &period) == 2 &&
+            strcmp(word, "max") != 0 && (quota = atoll(word)) > 0 && period > 0) {
+            double q = (double)quota / (double)period;
+            if (b->quota_cpus == 0.0 || q < b->quota_cpus) b->quota_cpus = q;
+        }
+        unsigned long long mem;
+        if (read_line(dir, "memory.max", buf, sizeof(buf)) && strcmp(buf, "max") != 0 &&
+            sscanf(buf, "%llu", &mem) == 1 && mem > 0) {
+            if (b->memory_limit == 0 || mem < b->memory_limit) b->memory_limit = mem;
+        }
+        /* the innermost effective set already reflects the ancestors */
+        if (!have_cpuset && read_line(dir, "cpuset.cpus.effective", buf, sizeof(buf)) && buf[0]) {
+            b->cpuset_cpus = count_cpu_list(buf);
+            have_cpuset = 1;
+        }
+    } while (parent_dir(m, dir));
+}
+
+static void probe_v1_cpu(ResourceBudget *b, const CgroupMount *m) {
+    char dir[CG_PATH_MAX], buf[64];
+    if (!leaf_dir(m, dir, sizeof(dir))) return;
+    do {
+        long long quota = -1, period = 0;
+        if (read_line(dir, "cpu.cfs_quota_us", buf, sizeof(buf))) quota = atoll(buf);
+        if (read_line(dir, "cpu.cfs_period_us", buf, sizeof(buf))) period = atoll(buf);
+        if (quota > 0 && period > 0) {
+            double q = (double)quota / (double)period;
+            if (b->quota_cpus == 0.0 || q < b->quota_cpus) b->quota_cpus = q;
+        }
+    } while (parent_dir(m, dir));
+}
+
+static void probe_v1_cpuset(ResourceBudget *b, const CgroupMount *m) {
+    char dir[CG_PATH_MAX], buf[1024];
+    if (!leaf_dir(m, dir, sizeof(dir))) return;
+    do {
+        if (read_line(dir, "cpuset.cpus", buf, sizeof(buf)) && buf[0]) {
+            b->cpuset_cpus = count_cpu_list(buf);
+            return;
+        }
+    } while (parent_dir(m, dir));
+}
+
+static void probe_v1_memory(ResourceBudget *b, const CgroupMount *m) {
+    char dir[CG_PATH_MAX], buf[64];
+    if (!leaf_dir(m, dir, sizeof(dir))) return;
+    do {
+        unsigned long long mem;
+        /* "unlimited" is a huge page-aligned value; the clamp below drops it */
+        if (read_line(dir, "memory.limit_in_bytes", buf, sizeof(buf)) && sscanf(buf, "%llu", &mem) == 1 &&
+            mem > 0 && (b->memory_limit == 0 || mem < b->memory_limit)) {
+            b->memory_limit = mem;
+        }
+    } while (parent_dir(m, dir));
+}
+
+/* ===== Probe ===== */
+
+void resource_probe(ResourceBudget *out) {
+    ResourceBudget b;
+    memset(&b, 0, sizeof(b));
+
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    b.online_cpus = online > 0 ? (int)online : 1;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) b.affinity_cpus = CPU_COUNT(&set);
+
+    CgroupMount m;
+    if (open_hierarchy(NULL, &m) && v2_has_controllers(&m)) {
+        b.cgroup_version = 2;
+        probe_v2(&b, &m);
+    } else {
+        if (open_hierarchy("cpu", &m)) { b.cgroup_version = 1; probe_v1_cpu(&b, &m); }
+        if (open_hierarchy("cpuset", &m)) { b.cgroup_version = 1; probe_v1_cpuset(&b, &m); }
+        if (open_hierarchy("memory", &m)) { b.cgroup_version = 1; probe_v1_memory(&b, &m); }
+    }
+
+    long pages = sysconf(_SC_PHYS_PAGES), page_size = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && page_size > 0) b.memory_total = (unsigned long long)pages * (unsigned long long)page_size;
+    if (b.memory_total && b.memory_limit >= b.memory_total) b.memory_limit = 0;
+    b.memory_budget = b.memory_limit ? b.memory_limit : b.memory_total;
+
+    struct rlimit rl;
+    b.nproc_limit = -1;
+    if (getrlimit(RLIMIT_NPROC, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) b.nproc_limit = (long)rl.rlim_cur;
+
+    int cpus = b.online_cpus;
+    if (b.affinity_cpus > 0 && b.affinity_cpus < cpus) cpus = b.affinity_cpus;
+    if (b.cpuset_cpus > 0 && b.cpuset_cpus < cpus) cpus = b.cpuset_cpus;
+    if (b.quota_cpus > 0.0 && (int)ceil(b.quota_cpus) < cpus) cpus = (int)ceil(b.quota_cpus);
+    b.cpus = cpus < 1 ? 1 : cpus;
+
+    /* RLIMIT_NPROC counts every process of the user, so leave half of it to
+     * the rest of the session
+     */
+    b.max_workers = b.cpus;
+    if (b.nproc_limit >= 0 && b.nproc_limit / 2 < b.max_workers) b.max_workers = (int)(b.nproc_limit / 2);
+    if (b.max_workers < 1) b.max_workers = 1;
+
+    *out = b;
+}
+
+static ResourceBudget g_budget;
+static pthread_once_t g_budget_once = PTHREAD_ONCE_INIT;
+
+static void probe_once(void) {
+    resource_probe(&g_budget);
+}
+
+const ResourceBudget *resource_budget(void) {
+    pthread_once(&g_budget_once, probe_once);
+    return &g_budget;
+}
+
+int resource_apply_openmp(void) {
+#ifdef _OPENMP
+    const char *env = getenv("OMP_NUM_THREADS");
+    if (!env || !*env) omp_set_num_threads(resource_budget()->cpus);
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+void resource_describe(const ResourceBudget *b, char *buf, size_t len) {
+    char cpus[160], mem[96];
+    int n = snprintf(cpus, sizeof(cpus), "%d CPU%s (online %d", b->cpus, b->cpus == 1 ? "" : "s", b->online_cpus);
+    if (b->affinity_cpus > 0 && b->affinity_cpus != b->online_cpus)
+        n += snprintf(cpus + n, sizeof(cpus) - (size_t)n, ", affinity %d", b->affinity_cpus);
+    if (b->cpuset_cpus > 0)
+        n += snprintf(cpus + n, sizeof(cpus) - (size_t)n, ", cpuset %d", b->cpuset_cpus);
+    if (b->quota_cpus > 0.0)
+        n += snprintf(cpus + n, sizeof(cpus) - (size_t)n, ", quota %.2f", b->quota_cpus);
+    snprintf(cpus + n, sizeof(cpus) - (size_t)n, ")");
+
+    double gib = (double)b->memory_budget / (1024.0 * 1024.0 * 1024.0);
+    if (b->memory_limit) snprintf(mem, sizeof(mem), "%.1f GiB memory limit", gib);
+    else snprintf(mem, sizeof(mem), "%.1f GiB memory", gib);
+
+    char cg[24] = "no cgroup";
+    if (b->cgroup_version) snprintf(cg, sizeof(cg), "cgroup v%d", b->cgroup_version);
+    snprintf(buf, len, "%s, %s (%s), %d worker%s", cpus, mem, cg, b->max_workers, b->max_workers == 1 ? "" : "s");
+}
+
+void resource_log_budget(void) {
+    if (!mat_log_enabled(MAT_LOG_INFO)) return;
+    char line[320];
+    resource_describe(resource_budget(), line, sizeof(line));
+    mat_log(MAT_LOG_INFO, "Resources: %s", line);
+}
+
+/* ===== Worker waves ===== */
+
+static int write_all(int fd, const void *buf, size_t len) {
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t w = write(fd, p, len);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return 0;
+        p += w;
+        len -= (size_t)w;
+    }
+    return 1;
+}
+
+static int read_all(int fd, void *buf, size_t len) {
+    char *p = (char *)buf;
+    while (len > 0) {
+        ssize_t r = read(fd, p, len);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return 0;
+        p += r;
+        len -= (size_t)r;
+    }
+    return 1;
+}
+
+int resource_fork_waves(int count, int width, WorkerTask fn, void *ctx, double *out) {
+    if (count <= 0) return 1;
+    int wave = resource_budget()->max_workers;
+    if (wave > count) wave = count;
+    int (*pipes)[2] = malloc((size_t)wave * sizeof(int[2]));
+    pid_t *pids = (pid_t *)malloc((size_t)wave * sizeof(pid_t));
+    if (!pipes || !pids) { free(pipes); free(pids); return 0; }
+
+    size_t bytes = (size_t)width * sizeof(double);
+    int ok = 1;
+    for (int base = 0; ok && base < count; ) {
+        int todo = count - base < wave ? count - base : wave;
+        int started = 0;
+        for (; started < todo; started++) {
+            if (pipe(pipes[started]) == -1) {
+                mat_log(MAT_LOG_ERROR, "pipe: %s", strerror(errno));
+                ok = 0;
+                break;
+            }
+            pid_t pid = fork();
+            if (pid == -1) {
+                int err = errno;
+                close(pipes[started][0]);
+                close(pipes[started][1]);
+                if (err == EAGAIN && started > 0) {
+                    wave = started;     /* out of processes: smaller waves */
+                } else {
+                    mat_log(MAT_LOG_ERROR, "fork: %s", strerror(err));
+                    ok = 0;
+                }
+                break;
+            }
+            if (pid == 0) {
+                close(pipes[started][0]);
+                double *buf = (double *)malloc(bytes ? bytes : sizeof(double));
+                if (!buf) _exit(1);
+                fn(ctx, base + started, buf);
+                int sent = write_all(pipes[started][1], buf, bytes);
+                close(pipes[started][1]);
+                _exit(sent ? 0 : 1);
+            }
+            pids[started] = pid;
+            close(pipes[started][1]);
+        }
+
+        /* Collect the wave even after a failure so no child is left behind */
+        for (int c = 0; c < started; c++) {
+            if (ok && !read_all(pipes[c][0], out + (size_t)(base + c) * width, bytes)) {
+                mat_log(MAT_LOG_ERROR, "Worker %d sent no result", base + c);
+                ok = 0;
+            }
+            close(pipes[c][0]);
+            int status = 0;
+            if (waitpid(pids[c], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = 0;
+        }
+        base += started;
+    }
+
+    free(pipes);
+    free(pids);
+    return ok;
+}
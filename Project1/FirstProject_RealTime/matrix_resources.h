@@ -0,0 +1,71 @@
+#ifndef MATRIX_RESOURCES_H
+#define MATRIX_RESOURCES_H
+
+#include <stddef.h>
+
+/*
+ * What this process may actually use, as opposed to what the machine has.
+ *
+ * Inside a container sysconf(_SC_NPROCESSORS_ONLN) and the physical memory
+ * size describe the host. The probe also reads
+ *
+ *   - the affinity mask (sched_getaffinity),
+ *   - the cgroup CPU quota (v2 cpu.max, v1 cpu.cfs_quota_us / cfs_period_us)
+ *     and cpuset (cpuset.cpus[.effective]),
+ *   - the cgroup memory limit (v2 memory.max, v1 memory.limit_in_bytes),
+ *   - the RLIMIT_NPROC soft limit,
+ *
+ * walking from the process's own cgroup up to the mount point so that a
+ * limit set on a parent group counts too. The CPU budget is the smallest of
+ * the CPU counts; a fractional quota rounds up (1.5 CPUs -> 2 threads).
+ *
+ * The budget sizes the OpenMP thread count (resource_apply_openmp), the
+ * number of worker processes alive at once in the multiprocess engines and
+ * the TSQR row blocks.
+ */
+
+typedef struct {
+    int online_cpus;            /* sysconf(_SC_NPROCESSORS_ONLN) */
+    int affinity_cpus;          /* CPUs in the affinity mask, 0 if unknown */
+    int cpuset_cpus;            /* CPUs in the cgroup cpuset, 0 if none */
+    double quota_cpus;          /* cgroup quota / period, 0 if unlimited */
+    int cpus;                   /* effective CPU budget, at least 1 */
+    int cgroup_version;         /* 1 or 2, 0 if no cgroup was found */
+    unsigned long long memory_total;   /* physical memory in bytes */
+    unsigned long long memory_limit;   /* cgroup limit in bytes, 0 if unlimited */
+    unsigned long long memory_budget;  /* the smaller of the two */
+    long nproc_limit;           /* RLIMIT_NPROC soft limit, -1 if unlimited */
+    int max_workers;            /* worker processes alive at once, at least 1 */
+} ResourceBudget;
+
+/* Probe into out (reads /proc and /sys every time) */
+void resource_probe(ResourceBudget *out);
+
+/* The budget of this process, probed on first use and cached */
+const ResourceBudget *resource_budget(void);
+
+/* Make cpus the default OpenMP team size, unless OMP_NUM_THREADS is set.
+ * Returns the thread count now in effect.
+ */
+int resource_apply_openmp(void);
+
+/* One-line summary for reports, e.g.
+ * "2 CPUs (online 8, cpuset 4, quota 1.50), 1.0 GiB memory (cgroup v2), 2 workers"
+ */
+void resource_describe(const ResourceBudget *b, char *buf, size_t len);
+
+/* Log the summary at MAT_LOG_INFO, prefixed with "Resources: " */
+void resource_log_budget(void);
+
+/* Body of one forked worker: compute task into out (width doubles) */
+typedef void (*WorkerTask)(void *ctx, int task, double *out);
+
+/* Run tasks 0..count-1, one forked child each, with at most max_workers
+ * children alive at once; the width doubles of task t land in
+ * out[t * width ...]. A fork that fails with EAGAIN after part of a wave
+ * has started shrinks the waves instead of failing. Returns 0 (logged) if
+ * a pipe or fork fails otherwise or a child dies.
+ */
+int resource_fork_waves(int count, int width, WorkerTask fn, void *ctx, double *out);
+
+#endif /* MATRIX_RESOURCES_H */
@@ -0,0 +1,182 @@
+#include "matrix_sparse.h"
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+SparseMatrix *create_sparse_matrix(const char *name, int rows, int cols, long nnz) {
+    if (rows <= 0 || cols <= 0 || nnz < 0) return NULL;
+    SparseMatrix *s = (SparseMatrix*)calloc(1, sizeof(SparseMatrix));
+    if (!s) return NULL;
+    if (name) {
+        strncpy(s->name, name, MAX_NAME_LENGTH - 1);
+        s->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    s->rows = rows;
+    s->cols = cols;
+    s->nnz = nnz;
+    s->row_ptr = (long*)calloc((size_t)rows + 1, sizeof(long));
+    s->col_idx = (int*)malloc((size_t)(nnz > 0 ? nnz : 1) * sizeof(int));
+    s->values = (double*)malloc((size_t)(nnz > 0 ? nnz : 1) * sizeof(double));
+    if (!s->row_ptr || !s->col_idx || !s->values) {
+        free_sparse_matrix(s);
+        return NULL;
+    }
+    return s;
+}
+
+void free_sparse_matrix(SparseMatrix *s) {
+    if (!s) return;
+    free(s->row_ptr);
+    free(s->col_idx);
+    free(s->values);
+    free(s);
+}
+
+/* Insertion sort of one row by column; rows are short in practice */
+static void sort_row(int *cols, double *vals, long len) {
+    for (long a = 1; a < len; ++a) {
+        int c = cols[a]; double v = vals[a];
+        long b = a - 1;
+        while (b >= 0 && cols[b] > c) { cols[b + 1] = cols[b]; vals[b + 1] = vals[b]; --b; }
+        cols[b + 1] = c; vals[b + 1] = v;
+    }
+}
+
+SparseMatrix *sparse_from_triplets(const char *name, int rows, int cols, long count,
+                                   const int *ti, const int *tj, const double *tv) {
+    if (rows <= 0 || cols <= 0 || count < 0 || (count > 0 && (!ti || !tj || !tv))) return NULL;
+    for (long k = 0; k < count; ++k) {
+        if (ti[k] < 0 || ti[k] >= rows || tj[k] < 0 || tj[k] >= cols) return NULL;
+    }
+
+    SparseMatrix *s = create_sparse_matrix(name, rows, cols, count);
+    if (!s) return NULL;
+
+    /* Counting sort by row */
+    for (long k = 0; k < count; ++k) s->row_ptr[ti[k] + 1]++;
+    for (int i = 0; i < rows; ++i) s->row_ptr[i + 1] += s->row_ptr[i];
+    long *next = (long*)malloc((size_t)rows * sizeof(long));
+    if (!next) { free_sparse_matrix(s); return NULL; }
+    memcpy(next, s->row_ptr, (size_t)rows * sizeof(long));
+    for (long k = 0; k < count; ++k) {
+        long pos = next[ti[k]]++;
+        s->col_idx[pos] = tj[k];
+        s->values[pos] = tv[k];
+    }
+    free(next);
+
+    /* Sort each row and merge duplicates in place (rows are independent) */
+    long *row_len = (long*)malloc((size_t)rows * sizeof(long));
+    if (!row_len) { free_sparse_matrix(s); return NULL; }
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < rows; ++i) {
+        long b = s->row_ptr[i], e = s->row_ptr[i + 1];
+        sort_row(s->col_idx + b, s->values + b, e - b);
+        long w = b;
+        for (long r = b; r < e; ++r) {
+            if (w > b && s->col_idx[w - 1] == s->col_idx[r]) {
+                s->values[w - 1] += s->values[r];
+            } else {
+                s->col_idx[w] = s->col_idx[r];
+                s->values[w] = s->values[r];
+                ++w;
+            }
+        }
+        row_len[i] = w - b;
+    }
+
+    /* Compact rows after duplicate removal */
+    long w = 0;
+    for (int i = 0; i < rows; ++i) {
+        long b = s->row_ptr[i];
+        if (w != b) {
+            memmove(s->col_idx + w, s->col_idx + b, (size_t)row_len[i] * sizeof(int));
+            memmove(s->values + w, s->values + b, (size_t)row_len[i] * sizeof(double));
+        }
+        s->row_ptr[i] = w;
+        w += row_len[i];
+    }
+    s->row_ptr[rows] = w;
+    s->nnz = w;
+    free(row_len);
+    return s;
+}
+
+/* Below this many stored entries a product runs on one thread */
+#define SPARSE_PARALLEL_NNZ 20000
+
+void sparse_spmv(const SparseMatrix *s, const double *x, double *y) {
+    if (!s || !x || !y) return;
+    #pragma omp parallel for schedule(static) if (s->nnz > SPARSE_PARALLEL_NNZ)
+    for (int i = 0; i < s->rows; ++i) {
+        double sum = 0.0;
+        for (long k = s->row_ptr[i]; k < s->row_ptr[i + 1]; ++k) sum += s->values[k] * x[s->col_idx[k]];
+        y[i] = sum;
+    }
+}
+
+void sparse_spmm(const SparseMatrix *s, const double *X, int nrhs, double *Y) {
+    if (!s || !X || !Y || nrhs <= 0) return;
+    #pragma omp parallel for schedule(static) if (s->nnz * (long)nrhs > SPARSE_PARALLEL_NNZ)
+    for (int i = 0; i < s->rows; ++i) {
+        double *yi = Y + (size_t)i * nrhs;
+        for (int r = 0; r < nrhs; ++r) yi[r] = 0.0;
+        for (long k = s->row_ptr[i]; k < s->row_ptr[i + 1]; ++k) {
+            double v = s->values[k];
+            const double *xk = X + (size_t)s->col_idx[k] * nrhs;
+            #pragma omp simd
+            for (int r = 0; r < nrhs; ++r) yi[r] += v * xk[r];
+        }
+    }
+}
+
+double sparse_get(const SparseMatrix *s, int i, int j) {
+    long lo = s->row_ptr[i], hi = s->row_ptr[i + 1] - 1;
+    while (lo <= hi) {
+        long mid = (lo + hi) / 2;
+        if (s->col_idx[mid] == j) return s->values[mid];
+        if (s->col_idx[mid] < j) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return 0.0;
+}
+
+Matrix *sparse_to_dense(const SparseMatrix *s) {
+    if (!s) return NULL;
+    Matrix *m = create_matrix(s->name, s->rows, s->cols);
+    if (!m) return NULL;
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < s->rows; ++i) {
+        for (long k = s->row_ptr[i]; k < s->row_ptr[i + 1]; ++k) {
+            m->data[i][s->col_idx[k]] = s->values[k];
+        }
+    }
+    return m;
+}
+
+SparseMatrix *dense_to_sparse(const Matrix *m) {
+    if (!m) return NULL;
+    long nnz = 0;
+    for (int i = 0; i < m->rows; ++i)
+        for (int j = 0; j < m->cols; ++j)
+            if (mat_get(m, i, j) != 0.0) ++nnz;
+
+    SparseMatrix *s = create_sparse_matrix(m->name, m->rows, m->cols, nnz);
+    if (!s) return NULL;
+    long k = 0;
+    for (int i = 0; i < m->rows; ++i) {
+        s->row_ptr[i] = k;
+        for (int j = 0; j < m->cols; ++j) {
+            double v = mat_get(m, i, j);
+            if (v != 0.0) {
+                s->col_idx[k] = j;
+                s->values[k] = v;
+                ++k;
+            }
+        }
+    }
+    s->row_ptr[m->rows] = k;
+    return s;
+}
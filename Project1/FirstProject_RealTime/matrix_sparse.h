@@ -0,0 +1,48 @@
+#ifndef MATRIX_SPARSE_H
+#define MATRIX_SPARSE_H
+
+#include "matrix_types.h"
+
+/* Compressed sparse row (CSR) matrix.
+ * Row i holds entries col_idx[row_ptr[i] .. row_ptr[i+1]) with matching values,
+ * column indices sorted ascending and unique within a row.
+ */
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    long nnz;
+    long *row_ptr;   /* rows + 1 entries */
+    int *col_idx;    /* nnz entries */
+    double *values;  /* nnz entries */
+} SparseMatrix;
+
+/* Allocate an empty CSR matrix with room for nnz entries (row_ptr zeroed) */
+SparseMatrix *create_sparse_matrix(const char *name, int rows, int cols, long nnz);
+void free_sparse_matrix(SparseMatrix *s);
+
+/* Build CSR from coordinate triplets (0-based). Duplicate (i, j) entries are
+ * summed. Returns NULL on allocation failure or out-of-range indices.
+ */
+SparseMatrix *sparse_from_triplets(const char *name, int rows, int cols, long count,
+                                   const int *ti, const int *tj, const double *tv);
+
+/* y = A x (x has s->cols entries, y has s->rows). Rows are split across
+ * OpenMP threads once the matrix is large enough to pay for it.
+ */
+void sparse_spmv(const SparseMatrix *s, const double *x, double *y);
+
+/* Y = A X for nrhs right-hand sides at once; X (cols x nrhs) and Y
+ * (rows x nrhs) are row-major, so every stored entry is read once per call
+ * rather than once per right-hand side.
+ */
+void sparse_spmm(const SparseMatrix *s, const double *X, int nrhs, double *Y);
+
+/* Value of entry (i, j), 0.0 if it is not stored (binary search in row i) */
+double sparse_get(const SparseMatrix *s, int i, int j);
+
+/* Dense <-> sparse conversion; dense_to_sparse drops exact zeros */
+Matrix *sparse_to_dense(const SparseMatrix *s);
+SparseMatrix *dense_to_sparse(const Matrix *m);
+
+#endif /* MATRIX_SPARSE_H */
@@ -0,0 +1,360 @@
+#include "matrix_sparse_factor.h"
+#include "matrix_log.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* A^T in CSR, which is also A in compressed-column form */
+static SparseMatrix *csr_transpose(const SparseMatrix *s) {
+    SparseMatrix *t = create_sparse_matrix(s->name, s->cols, s->rows, s->nnz);
+    long *next = (long *)malloc((size_t)s->cols * sizeof(long));
+    if (!t || !next) { free(next); free_sparse_matrix(t); return NULL; }
+
+    for (long p = 0; p < s->nnz; p++) t->row_ptr[s->col_idx[p] + 1]++;
+    for (int j = 0; j < s->cols; j++) t->row_ptr[j + 1] += t->row_ptr[j];
+    memcpy(next, t->row_ptr, (size_t)s->cols * sizeof(long));
+    for (int i = 0; i < s->rows; i++) {
+        for (long p = s->row_ptr[i]; p < s->row_ptr[i + 1]; p++) {
+            long q = next[s->col_idx[p]]++;
+            t->col_idx[q] = i;
+            t->values[q] = s->values[p];
+        }
+    }
+    free(next);
+    return t;
+}
+
+/* ===== Cholesky ===== */
+
+/* Pattern of row k of L: the nodes reached from the entries of row k of
+ * the lower triangle when walking up the elimination tree, in s[top..n)
+ * in topological order
+ */
+static int ereach(const SparseMatrix *c, int k, const int *parent, int *s, int *w) {
+    int top = c->rows;
+    w[k] = k;
+    for (long p = c->row_ptr[k]; p < c->row_ptr[k + 1]; p++) {
+        int i = c->col_idx[p];
+        if (i > k) continue;
+        int len = 0;
+        for (; w[i] != k; i = parent[i]) {
+            s[len++] = i;
+            w[i] = k;
+        }
+        while (len > 0) s[--top] = s[--len];
+    }
+    return top;
+}
+
+/* Up-looking Cholesky of symmetric c. Returns 0 on allocation failure;
+ * *posdef = 0 if a pivot was not positive.
+ */
+static int cholesky_logdet(const SparseMatrix *c, double *logdet, long *lnz, int *posdef) {
+    int n = c->rows, ok = 0;
+    int *parent = (int *)malloc((size_t)n * sizeof(int));
+    int *anc = (int *)malloc((size_t)n * sizeof(int));
+    int *w = (int *)malloc((size_t)n * sizeof(int));
+    int *s = (int *)malloc((size_t)n * sizeof(int));
+    long *Lp = (long *)calloc((size_t)n + 1, sizeof(long));
+    long *next = (long *)malloc((size_t)n * sizeof(long));
+    double *x = (double *)calloc((size_t)n, sizeof(double));
+    int *Li = NULL;
+    double *Lx = NULL;
+    if (!parent || !anc || !w || !s || !Lp || !next || !x) goto done;
+
+    /* elimination tree with path compression */
+    for (int k = 0; k < n; k++) {
+        parent[k] = -1;
+        anc[k] = -1;
+        for (long p = c->row_ptr[k]; p < c->row_ptr[k + 1]; p++) {
+            int i = c->col_idx[p], inext;
+            for (; i != -1 && i < k; i = inext) {
+                inext = anc[i];
+                anc[i] = k;
+                if (inext == -1) parent[i] = k;
+            }
+        }
+    }
+
+    /* column counts, one row subtree at a time */
+    for (int k = 0; k < n; k++) w[k] = -1;
+    for (int k = 0; k < n; k++) Lp[k + 1] = 1;
+    for (int k = 0; k < n; k++) {
+        int top = ereach(c, k, parent, s, w);
+        for (int t = top; t < n; t++) Lp[s[t] + 1]++;
+    }
+    for (int k = 0; k < n; k++) Lp[k + 1] += Lp[k];
+    Li = (int *)malloc((size_t)Lp[n] * sizeof(int));
+    Lx = (double *)malloc((size_t)Lp[n] * sizeof(double));
+    if (!Li || !Lx) goto done;
+    memcpy(next, Lp, (size_t)n * sizeof(long));
+
+    *posdef = 1;
+    *logdet = 0.0;
+    for (int k = 0; k < n; k++) w[k] = -1;
+    for (int k = 0; k < n && *posdef; k++) {
+        int top = ereach(c, k, parent, s, w);
+        for (long p = c->row_ptr[k]; p < c->row_ptr[k + 1]; p++) {
+            if (c->col_idx[p] <= k) x[c->col_idx[p]] = c->values[p];
+        }
+        double d = x[k];
+        x[k] = 0.0;
+        for (int t = top; t < n; t++) {
+            int j = s[t];
+            double lkj = x[j] / Lx[Lp[j]];
+            x[j] = 0.0;
+            for (long p = Lp[j] + 1; p < next[j]; p++) x[Li[p]] -= Lx[p] * lkj;
+            d -= lkj * lkj;
+            long q = next[j]++;
+            Li[q] = k;
+            Lx[q] = lkj;
+        }
+        if (!(d > 0.0)) { *posdef = 0; break; }
+        long q = next[k]++;
+        Li[q] = k;
+        Lx[q] = sqrt(d);
+        *logdet += log(d);
+    }
+    *lnz = Lp[n];
+    ok = 1;
+
+done:
+    free(parent); free(anc); free(w); free(s); free(Lp); free(next); free(x); free(Li); free(Lx);
+    return ok;
+}
+
+/* ===== LU ===== */
+
+/* Depth-first search from row j in the graph of L (column pinv[j] of L
+ * holds the rows that row j updates); finished nodes go to xi[--top]
+ */
+static int lu_dfs(int j, int k, const long *Lp, const int *Li, const int *pinv,
+                  int *xi, long *pstack, int *w, int top) {
+    int head = 0;
+    xi[0] = j;
+    while (head >= 0) {
+        j = xi[head];
+        int J = pinv[j];
+        if (w[j] != k) {
+            w[j] = k;
+            pstack[head] = J < 0 ? 0 : Lp[J] + 1;
+        }
+        int done = 1;
+        long end = J < 0 ? 0 : Lp[J + 1];
+        for (long p = pstack[head]; p < end; p++) {
+            int i = Li[p];
+            if (w[i] == k) continue;
+            pstack[head] = p + 1;
+            xi[++head] = i;
+            done = 0;
+            break;
+        }
+        if (done) {
+            head--;
+            xi[--top] = j;
+        }
+    }
+    return top;
+}
+
+/* Gilbert-Peierls LU of the n x n matrix with columns (Cp, Ci, Cx).
+ * L is kept (with original row indices, unit diagonal first) because later
+ * columns are solved with it; U only contributes its pivot and its count.
+ */
+static int lu_logdet(int n, const long *Cp, const int *Ci, const double *Cx, int prefer_diag,
+                     double *logabs, int *sign, long *factor_nnz) {
+    int ok = 0;
+    long lcap = 4 * Cp[n] + n, lnz = 0, unz = 0;
+    int *pinv = (int *)malloc((size_t)n * sizeof(int));
+    int *w = (int *)malloc((size_t)n * sizeof(int));
+    int *xi = (int *)malloc((size_t)n * sizeof(int));
+    long *pstack = (long *)malloc((size_t)n * sizeof(long));
+    long *Lp = (long *)malloc(((size_t)n + 1) * sizeof(long));
+    double *x = (double *)calloc((size_t)n, sizeof(double));
+    int *Li = (int *)malloc((size_t)lcap * sizeof(int));
+    double *Lx = (double *)malloc((size_t)lcap * sizeof(double));
+    if (!pinv || !w || !xi || !pstack || !Lp || !x || !Li || !Lx) goto done;
+
+    for (int i = 0; i < n; i++) { pinv[i] = -1; w[i] = -1; }
+    *logabs = 0.0;
+    *sign = 1;
+    for (int k = 0; k < n; k++) {
+        if (lnz + n > lcap) {
+            long cap = 2 * lcap + n;
+            int *ni = (int *)realloc(Li, (size_t)cap * sizeof(int));
+            if (ni) Li = ni;
+            double *nx = (double *)realloc(Lx, (size_t)cap * sizeof(double));
+            if (nx) Lx = nx;
+            if (!ni || !nx) goto done;
+            lcap = cap;
+        }
+        Lp[k] = lnz;
+
+        /* x = L \ C(:, k) on the reach of C(:, k) */
+        int top = n;
+        for (long p = Cp[k]; p < Cp[k + 1]; p++) {
+            if (w[Ci[p]] != k) top = lu_dfs(Ci[p], k, Lp, Li, pinv, xi, pstack, w, top);
+        }
+        for (long p = Cp[k]; p < Cp[k + 1]; p++) x[Ci[p]] = Cx[p];
+        for (int t = top; t < n; t++) {
+            int j = xi[t], J = pinv[j];
+            if (J < 0) continue;
+            double xj = x[j];
+            for (long p = Lp[J] + 1; p < Lp[J + 1]; p++) x[Li[p]] -= Lx[p] * xj;
+        }
+
+        /* pivot among the rows not yet used; the others are U(:, k) */
+        int ipiv = -1;
+        double a = -1.0;
+        for (int t = top; t < n; t++) {
+            int i = xi[t];
+            if (pinv[i] >= 0) { unz++; continue; }
+            if (fabs(x[i]) > a) { a = fabs(x[i]); ipiv = i; }
+        }
+        if (ipiv < 0 || a <= 0.0) {
+            *sign = 0;
+            *logabs = -INFINITY;
+            for (int t = top; t < n; t++) x[xi[t]] = 0.0;
+            break;
+        }
+        if (prefer_diag && pinv[k] < 0 && w[k] == k && fabs(x[k]) >= SPARSE_PIVOT_TOL * a) ipiv = k;
+
+        double pivot = x[ipiv];
+        unz++;
+        *logabs += log(fabs(pivot));
+        if (pivot < 0.0) *sign = -*sign;
+        pinv[ipiv] = k;
+        Li[lnz] = ipiv;
+        Lx[lnz++] = 1.0;
+        for (int t = top; t < n; t++) {
+            int i = xi[t];
+            if (pinv[i] < 0) {
+                Li[lnz] = i;
+                Lx[lnz++] = x[i] / pivot;
+            }
+            x[i] = 0.0;
+        }
+        Lp[k + 1] = lnz;
+    }
+    if (*sign != 0) *sign *= permutation_sign(pinv, n);
+    *factor_nnz = lnz + unz - n;
+    ok = 1;
+
+done:
+    free(pinv); free(w); free(xi); free(pstack); free(Lp); free(x); free(Li); free(Lx);
+    return ok;
+}
+
+/* ===== Driver ===== */
+
+int sparse_determinant(const SparseMatrix *s, OrderingMethod ordering, double *out_det,
+                       SparseFactorStats *stats, double *exec_time) {
+    if (!s || !out_det) return 0;
+    if (s->rows != s->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: determinant needs a square matrix ('%s' is %dx%d)",
+                s->name, s->rows, s->cols);
+        return 0;
+    }
+    double start = get_time();
+    int n = s->rows, ok = 0;
+    SparseFactorStats st;
+    memset(&st, 0, sizeof(st));
+    st.ordering = ordering;
+    st.nnz_a = s->nnz;
+    st.bandwidth_before = sparse_bandwidth(s, NULL, NULL);
+
+    SparseMatrix *t = csr_transpose(s);
+    SparseMatrix *c = NULL, *ct = NULL;
+    int *perm = NULL;
+    if (!t) goto done;
+
+    /* same pattern as A^T (columns are sorted, so the arrays must match) */
+    int sym_pattern = memcmp(t->row_ptr, s->row_ptr, ((size_t)n + 1) * sizeof(long)) == 0 &&
+                      memcmp(t->col_idx, s->col_idx, (size_t)s->nnz * sizeof(int)) == 0;
+    int spd_candidate = sym_pattern;
+    for (long p = 0; p < s->nnz && spd_candidate; p++) {
+        if (s->values[p] != t->values[p]) spd_candidate = 0;
+    }
+    for (int i = 0; i < n && spd_candidate; i++) {
+        if (!(sparse_get(s, i, i) > 0.0)) spd_candidate = 0;
+    }
+    free_sparse_matrix(t);
+    t = NULL;
+
+    double t0 = get_time();
+    int sign_q = 1;
+    if (ordering != ORDER_NATURAL) {
+        perm = sym_pattern ? sparse_ordering(s, ordering) : sparse_column_ordering(s, ordering);
+        if (!perm) goto done;
+        c = sym_pattern ? sparse_permute(s, perm, perm, s->name) : sparse_permute(s, NULL, perm, s->name);
+        if (!c) goto done;
+        if (!sym_pattern) sign_q = permutation_sign(perm, n);
+    }
+    const SparseMatrix *a = c ? c : s;
+    st.order_time = get_time() - t0;
+    st.bandwidth_after = sparse_bandwidth(a, NULL, NULL);
+
+    t0 = get_time();
+    int factored = 0;
+    if (spd_candidate) {
+        long lnz = 0;
+        int posdef = 0;
+        if (!cholesky_logdet(a, &st.log_abs_det, &lnz, &posdef)) goto done;
+        if (posdef) {
+            st.method = SPARSE_FACTOR_CHOLESKY;
+            st.sign = 1;
+            st.factor_nnz = 2 * lnz - n;
+            factored = 1;
+        }
+    }
+    if (!factored) {
+        ct = csr_transpose(a);
+        if (!ct) goto done;
+        st.method = SPARSE_FACTOR_LU;
+        if (!lu_logdet(n, ct->row_ptr, ct->col_idx, ct->values, sym_pattern,
+                       &st.log_abs_det, &st.sign, &st.factor_nnz)) goto done;
+        st.sign *= sign_q;
+    }
+    st.factor_time = get_time() - t0;
+    st.fill_ratio = st.nnz_a > 0 ? (double)st.factor_nnz / (double)st.nnz_a : 0.0;
+
+    *out_det = st.sign == 0 ? 0.0 : st.sign * exp(st.log_abs_det);
+    if (stats) *stats = st;
+    ok = 1;
+
+done:
+    free(perm);
+    free_sparse_matrix(t);
+    free_sparse_matrix(c);
+    free_sparse_matrix(ct);
+    if (exec_time) *exec_time = get_time() - start;
+    return ok;
+}
+
+int determinant_sparse(const Matrix *m, double *out_det, double *exec_time) {
+    if (!m || !out_det) return 0;
+    double start = get_time();
+    SparseMatrix *s = dense_to_sparse(m);
+    if (!s) return 0;
+    int ok = sparse_determinant(s, SPARSE_DEFAULT_ORDERING, out_det, NULL, NULL);
+    free_sparse_matrix(s);
+    if (exec_time) *exec_time = get_time() - start;
+    return ok;
+}
+
+void sparse_log_fill(const SparseFactorStats *stats) {
+    if (!stats) return;
+    mat_log(MAT_LOG_INFO, "   %s with %s ordering: nnz(A) %ld -> factors %ld (fill %.2fx), bandwidth %d -> %d",
+            stats->method == SPARSE_FACTOR_CHOLESKY ? "Cholesky" : "LU", ordering_name(stats->ordering),
+            stats->nnz_a, stats->factor_nnz, stats->fill_ratio, stats->bandwidth_before,
+            stats->bandwidth_after);
+    mat_log(MAT_LOG_INFO, "   ordering %.6f s, factorization %.6f s, log|det| = %.6g",
+            stats->order_time, stats->factor_time, stats->log_abs_det);
+}
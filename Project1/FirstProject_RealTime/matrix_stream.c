@@ -0,0 +1,549 @@
+#include "matrix_stream.h"
+#include "matrix_formats.h"
+#include "matrix_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Bytes requested per read(); pipes typically hand back 64 KiB at a time */
+#define STREAM_CHUNK (1 << 20)
+
+/* Chunks the reader may run ahead of the parser (bounds memory use) */
+#define STREAM_QUEUE_DEPTH 4
+
+/* Regions smaller than this are tokenized by a single thread */
+#define STREAM_PAR_MIN (64 * 1024)
+#define STREAM_MAX_PIECES 256
+
+/* Upper bound on a .npy header dict; real headers are a few hundred bytes */
+#define STREAM_NPY_MAX_HEADER (1 << 20)
+
+typedef struct {
+    char *data;
+    size_t len;
+} StreamChunk;
+
+struct MatrixStream {
+    int fd;
+    char label[MAX_NAME_LENGTH];
+
+    /* Reader thread -> consumer queue (guarded by lock) */
+    pthread_t reader;
+    pthread_mutex_t lock;
+    pthread_cond_t not_empty, not_full;
+    StreamChunk queue[STREAM_QUEUE_DEPTH];
+    int head, count;
+    int eof;            /* reader saw end of input or an error */
+    int read_errno;     /* errno of the failed read(), 0 on clean EOF */
+    int stop;           /* consumer is shutting the reader down */
+
+    /* Consumer window: unconsumed bytes are buf[pos..len), NUL-terminated */
+    char *buf;
+    size_t pos, len, cap;
+    int drained;        /* no more bytes will ever arrive */
+    int failed;
+    int index;          /* matrices returned so far */
+};
+
+/* ===== Reader thread ===== */
+
+static void *stream_reader_main(void *arg) {
+    MatrixStream *s = (MatrixStream *)arg;
+    /* Only the blocking read() may be cancelled, so the queue never sees a
+     * half-finished update.
+     */
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+
+    for (;;) {
+        char *chunk = (char *)malloc(STREAM_CHUNK);
+        ssize_t n;
+        int err = 0;
+        if (!chunk) {
+            n = -1;
+            err = ENOMEM;
+        } else {
+            pthread_cleanup_push(free, chunk);
+            pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+            do {
+                n = read(s->fd, chunk, STREAM_CHUNK);
+            } while (n < 0 && errno == EINTR);
+            if (n < 0) err = errno;
+            pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+            pthread_cleanup_pop(0);
+        }
+
+        pthread_mutex_lock(&s->lock);
+        if (n <= 0 || s->stop) {
+            free(chunk);
+            s->eof = 1;
+            s->read_errno = err;
+            pthread_cond_signal(&s->not_empty);
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        while (s->count == STREAM_QUEUE_DEPTH && !s->stop) {
+            pthread_cond_wait(&s->not_full, &s->lock);
+        }
+        if (s->stop) {
+            free(chunk);
+            pthread_mutex_unlock(&s->lock);
+            break;
+        }
+        StreamChunk *slot = &s->queue[(s->head + s->count) % STREAM_QUEUE_DEPTH];
+        slot->data = chunk;
+        slot->len = (size_t)n;
+        s->count++;
+        pthread_cond_signal(&s->not_empty);
+        pthread_mutex_unlock(&s->lock);
+    }
+    return NULL;
+}
+
+/* Take the next chunk off the queue, blocking until one arrives.
+ * Returns: 1 with *c filled in, 0 once the input is exhausted
+ */
+static int stream_dequeue(MatrixStream *s, StreamChunk *c) {
+    if (s->drained) return 0;
+    pthread_mutex_lock(&s->lock);
+    while (s->count == 0 && !s->eof) {
+        pthread_cond_wait(&s->not_empty, &s->lock);
+    }
+    if (s->count == 0) {
+        s->drained = 1;
+        if (s->read_errno) {
+            mat_log(MAT_LOG_ERROR, "Read error on %s: %s", s->label, strerror(s->read_errno));
+            s->failed = 1;
+        }
+        pthread_mutex_unlock(&s->lock);
+        return 0;
+    }
+    *c = s->queue[s->head];
+    s->head = (s->head + 1) % STREAM_QUEUE_DEPTH;
+    s->count--;
+    pthread_cond_signal(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+    return 1;
+}
+
+/* ===== Consumer window ===== */
+
+/* Append the next chunk to the window. Returns: 0 once the input is exhausted */
+static int stream_pull(MatrixStream *s) {
+    StreamChunk c;
+    if (!stream_dequeue(s, &c)) return 0;
+
+    size_t keep = s->len - s->pos;
+    if (s->pos > 0) {
+        memmove(s->buf, s->buf + s->pos, keep);
+        s->pos = 0;
+        s->len = keep;
+    }
+    if (keep + c.len + 1 > s->cap) {
+        size_t newcap = s->cap ? s->cap : STREAM_CHUNK;
+        while (newcap < keep + c.len + 1) newcap *= 2;
+        char *tmp = (char *)realloc(s->buf, newcap);
+        if (!tmp) {
+            free(c.data);
+            mat_log(MAT_LOG_ERROR, "Out of memory while reading %s", s->label);
+            s->failed = 1;
+            s->drained = 1;
+            return 0;
+        }
+        s->buf = tmp;
+        s->cap = newcap;
+    }
+    memcpy(s->buf + s->len, c.data, c.len);
+    s->len += c.len;
+    s->buf[s->len] = '\0';
+    free(c.data);
+    return 1;
+}
+
+/* Make at least n unconsumed bytes available. Returns: 0 if the input ends first */
+static int stream_require(MatrixStream *s, size_t n) {
+    while (s->len - s->pos < n) {
+        if (!stream_pull(s)) return 0;
+    }
+    return 1;
+}
+
+/* Skip whitespace. Returns: 0 at end of input */
+static int stream_skip_space(MatrixStream *s) {
+    for (;;) {
+        while (s->pos < s->len && isspace((unsigned char)s->buf[s->pos])) s->pos++;
+        if (s->pos < s->len) return 1;
+        if (!stream_pull(s)) return 0;
+    }
+}
+
+/* Read one whitespace-delimited token. Returns: 1 on success, 0 on failure */
+static int stream_token(MatrixStream *s, char *out, size_t n) {
+    if (!stream_skip_space(s)) return 0;
+    size_t scan = s->pos;
+    for (;;) {
+        while (scan < s->len && !isspace((unsigned char)s->buf[scan])) scan++;
+        if (scan < s->len || s->drained) break;
+        size_t off = scan - s->pos;
+        if (!stream_pull(s)) break;
+        scan = s->pos + off;
+    }
+    size_t tlen = scan - s->pos;
+    if (tlen == 0 || tlen >= n) return 0;
+    memcpy(out, s->buf + s->pos, tlen);
+    out[tlen] = '\0';
+    s->pos = scan;
+    return 1;
+}
+
+/* Copy exactly n raw bytes to dst. Once the window is empty whole chunks are
+ * copied straight from the queue, so large binary payloads are moved once.
+ * Returns: 0 if the input ends first
+ */
+static int stream_read_bytes(MatrixStream *s, unsigned char *dst, size_t n) {
+    size_t done = s->len - s->pos;
+    if (done > n) done = n;
+    memcpy(dst, s->buf + s->pos, done);
+    s->pos += done;
+
+    while (done < n) {
+        StreamChunk c;
+        if (!stream_dequeue(s, &c)) return 0;
+        size_t take = c.len < n - done ? c.len : n - done;
+        memcpy(dst + done, c.data, take);
+        done += take;
+        if (take < c.len) {
+            /* Leftover belongs to the next matrix: it becomes the window */
+            free(s->buf);
+            s->buf = c.data;
+            s->cap = STREAM_CHUNK;
+            memmove(s->buf, s->buf + take, c.len - take);
+            s->pos = 0;
+            s->len = c.len - take;
+            s->buf[s->len] = '\0';
+        } else {
+            free(c.data);
+        }
+    }
+    return 1;
+}
+
+/* ===== Parallel tokenizer ===== */
+
+static long count_tokens(const char *p, const char *end) {
+    long n = 0;
+    while (p < end) {
+        while (p < end && isspace((unsigned char)*p)) ++p;
+        if (p >= end) break;
+        ++n;
+        while (p < end && !isspace((unsigned char)*p)) ++p;
+    }
+    return n;
+}
+
+/* Parse up to max values from base[0..len), which ends on a token boundary.
+ * The region is split at whitespace into one piece per thread; pass 1 counts
+ * tokens per piece, pass 2 parses each piece straight into its slots.
+ * Returns: values stored (-1 on a malformed token); *used = bytes consumed
+ */
+static long parse_region(const char *base, size_t len, double *dst, long max, size_t *used) {
+    int pieces = 1;
+#ifdef _OPENMP
+    if (len >= STREAM_PAR_MIN) pieces = omp_get_max_threads();
+#endif
+    if (pieces > STREAM_MAX_PIECES) pieces = STREAM_MAX_PIECES;
+
+    size_t bounds[STREAM_MAX_PIECES + 1];
+    long offset[STREAM_MAX_PIECES + 1];
+    size_t stop_at[STREAM_MAX_PIECES];
+    bounds[0] = 0;
+    bounds[pieces] = len;
+    for (int t = 1; t < pieces; ++t) {
+        size_t b = len / pieces * t;
+        if (b < bounds[t - 1]) b = bounds[t - 1];
+        while (b < len && !isspace((unsigned char)base[b])) ++b;
+        bounds[t] = b;
+    }
+
+    #pragma omp parallel for num_threads(pieces) schedule(static, 1) if (pieces > 1)
+    for (int t = 0; t < pieces; ++t) {
+        offset[t + 1] = count_tokens(base + bounds[t], base + bounds[t + 1]);
+    }
+    offset[0] = 0;
+    for (int t = 0; t < pieces; ++t) offset[t + 1] += offset[t];
+    long total = offset[pieces];
+
+    int bad = 0;
+    #pragma omp parallel for num_threads(pieces) schedule(static, 1) reduction(|:bad) if (pieces > 1)
+    for (int t = 0; t < pieces; ++t) {
+        stop_at[t] = bounds[t + 1];
+        long idx = offset[t];
+        const char *p = base + bounds[t];
+        const char *end = base + bounds[t + 1];
+        while (idx < max && p < end) {
+            while (p < end && isspace((unsigned char)*p)) ++p;
+            if (p >= end) break;
+            const char *q = p;
+            while (q < end && !isspace((unsigned char)*q)) ++q;
+            char *e = NULL;
+            double v = strtod(p, &e);
+            if (e != q) { bad = 1; break; }
+            dst[idx++] = v;
+            p = q;
+        }
+        if (idx == max && offset[t] < max) stop_at[t] = (size_t)(p - base);
+    }
+    if (bad) return -1;
+
+    if (total <= max) {
+        *used = len;
+        return total;
+    }
+    for (int t = 0; t < pieces; ++t) {
+        if (offset[t] < max && offset[t + 1] >= max) { *used = stop_at[t]; break; }
+    }
+    return max;
+}
+
+/* Fill need values from the stream, tokenizing each received region in parallel */
+static int stream_parse_values(MatrixStream *s, double *dst, long need) {
+    long filled = 0;
+    while (filled < need) {
+        const char *base = s->buf + s->pos;
+        size_t avail = s->len - s->pos;
+        size_t cut = avail;
+        /* A token cut by the chunk boundary waits for the next chunk */
+        if (!s->drained) {
+            while (cut > 0 && !isspace((unsigned char)base[cut - 1])) --cut;
+        }
+        if (cut == 0) {
+            if (s->drained) {
+                mat_log(MAT_LOG_ERROR, "Unexpected end of %s after %ld of %ld values", s->label, filled, need);
+                return 0;
+            }
+            stream_pull(s);
+            continue;
+        }
+        size_t used = 0;
+        long got = parse_region(base, cut, dst + filled, need - filled, &used);
+        if (got < 0) {
+            mat_log(MAT_LOG_ERROR, "Invalid value near element %ld in %s", filled, s->label);
+            return 0;
+        }
+        filled += got;
+        s->pos += used;
+    }
+    return 1;
+}
+
+/* ===== Matrix readers ===== */
+
+static Matrix *stream_read_text(MatrixStream *s) {
+    char name[MAX_NAME_LENGTH], tok[32];
+    if (!stream_token(s, name, sizeof(name))) {
+        mat_log(MAT_LOG_ERROR, "Failed to read matrix name from %s", s->label);
+        return NULL;
+    }
+    long dims[2];
+    for (int k = 0; k < 2; ++k) {
+        char *end = NULL;
+        if (!stream_token(s, tok, sizeof(tok)) ||
+            (dims[k] = strtol(tok, &end, 10), *end != '\0') || dims[k] <= 0 || dims[k] > 0x7fffffffL) {
+            mat_log(MAT_LOG_ERROR, "Invalid dimensions for '%s' in %s", name, s->label);
+            return NULL;
+        }
+    }
+
+    Matrix *m = create_matrix(name, (int)dims[0], (int)dims[1]);
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        return NULL;
+    }
+    if (!stream_parse_values(s, m->data[0], dims[0] * dims[1])) {
+        free_matrix(m);
+        return NULL;
+    }
+    return m;
+}
+
+static Matrix *stream_read_npy(MatrixStream *s) {
+    size_t hstart, hlen;
+    if (!stream_require(s, NPY_PREAMBLE_LEN) ||
+        !npy_header_extent((const unsigned char *)s->buf + s->pos, &hstart, &hlen) ||
+        hlen > STREAM_NPY_MAX_HEADER || !stream_require(s, hstart + hlen)) {
+        mat_log(MAT_LOG_ERROR, "Invalid .npy preamble in %s", s->label);
+        return NULL;
+    }
+
+    char *hdr = (char *)malloc(hlen + 1);
+    if (!hdr) return NULL;
+    memcpy(hdr, s->buf + s->pos + hstart, hlen);
+    hdr[hlen] = '\0';
+    s->pos += hstart + hlen;
+
+    NpyHeader h;
+    memset(&h, 0, sizeof(h));
+    int ok = npy_parse_header(hdr, &h);
+    free(hdr);
+    if (!ok) {
+        mat_log(MAT_LOG_ERROR, "Unsupported .npy dtype/shape in %s (need 1-D/2-D f4 or f8)", s->label);
+        return NULL;
+    }
+
+    char name[MAX_NAME_LENGTH];
+    snprintf(name, sizeof(name), "%.48s_%d", s->label, s->index + 1);
+    Matrix *m = create_matrix_layout(name, h.rows, h.cols, npy_layout(&h));
+    if (!m) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        return NULL;
+    }
+
+    size_t bytes = (size_t)h.rows * (size_t)h.cols * (size_t)h.itemsize;
+    if (npy_is_native_f8(&h)) {
+        /* Already our layout: payload lands directly in the matrix block */
+        if (!stream_read_bytes(s, (unsigned char *)m->data[0], bytes)) goto truncated;
+    } else {
+        unsigned char *raw = (unsigned char *)malloc(bytes);
+        if (!raw) {
+            mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+            free_matrix(m);
+            return NULL;
+        }
+        if (!stream_read_bytes(s, raw, bytes)) { free(raw); goto truncated; }
+        npy_convert_data(raw, &h, m);
+        free(raw);
+    }
+    return m;
+
+truncated:
+    mat_log(MAT_LOG_ERROR, "Truncated .npy data for '%s' in %s", name, s->label);
+    free_matrix(m);
+    return NULL;
+}
+
+/* ===== Public API ===== */
+
+MatrixStream *matrix_stream_open(int fd, const char *label) {
+    if (fd < 0) return NULL;
+    MatrixStream *s = (MatrixStream *)calloc(1, sizeof(MatrixStream));
+    if (!s) return NULL;
+    s->fd = fd;
+    strncpy(s->label, label ? label : "stream", MAX_NAME_LENGTH - 1);
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->not_empty, NULL);
+    pthread_cond_init(&s->not_full, NULL);
+    if (pthread_create(&s->reader, NULL, stream_reader_main, s) != 0) {
+        mat_log(MAT_LOG_ERROR, "Failed to start reader thread for %s", s->label);
+        pthread_mutex_destroy(&s->lock);
+        pthread_cond_destroy(&s->not_empty);
+        pthread_cond_destroy(&s->not_full);
+        free(s);
+        return NULL;
+    }
+    return s;
+}
+
+Matrix *matrix_stream_next(MatrixStream *s) {
+    if (!s || s->failed) return NULL;
+    if (!stream_skip_space(s)) return NULL;
+
+    Matrix *m = ((unsigned char)s->buf[s->pos] == (unsigned char)NPY_MAGIC[0])
+                    ? stream_read_npy(s)
+                    : stream_read_text(s);
+    if (!m) {
+        s->failed = 1;
+        return NULL;
+    }
+    s->index++;
+    mat_log(MAT_LOG_INFO, "Successfully loaded matrix '%s' (%dx%d) from %s", m->name, m->rows, m->cols, s->label);
+    return m;
+}
+
+int matrix_stream_failed(const MatrixStream *s) {
+    return !s || s->failed;
+}
+
+static int has_data(const char *p, size_t n) {
+    for (size_t k = 0; k < n; ++k) {
+        if (!isspace((unsigned char)p[k])) return 1;
+    }
+    return 0;
+}
+
+int matrix_stream_pending(MatrixStream *s) {
+    if (!s) return 0;
+    if (s->buf && has_data(s->buf + s->pos, s->len - s->pos)) return 1;
+    pthread_mutex_lock(&s->lock);
+    int found = 0;
+    for (int k = 0; k < s->count && !found; ++k) {
+        const StreamChunk *c = &s->queue[(s->head + k) % STREAM_QUEUE_DEPTH];
+        found = has_data(c->data, c->len);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return found;
+}
+
+void matrix_stream_close(MatrixStream *s) {
+    if (!s) return;
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    int finished = s->eof;
+    pthread_cond_broadcast(&s->not_full);
+    pthread_mutex_unlock(&s->lock);
+    /* The reader may be blocked in read() on an idle pipe */
+    if (!finished) pthread_cancel(s->reader);
+    pthread_join(s->reader, NULL);
+
+    for (int k = 0; k < s->count; ++k) {
+        free(s->queue[(s->head + k) % STREAM_QUEUE_DEPTH].data);
+    }
+    pthread_mutex_destroy(&s->lock);
+    pthread_cond_destroy(&s->not_empty);
+    pthread_cond_destroy(&s->not_full);
+    free(s->buf);
+    free(s);
+}
+
+int read_matrices_from_stream(int fd, const char *label, MatrixCollection *col) {
+    if (!col) return -1;
+    MatrixStream *s = matrix_stream_open(fd, label);
+    if (!s) return -1;
+
+    int added = 0;
+    Matrix *m;
+    while ((m = matrix_stream_next(s)) != NULL) {
+        if (add_matrix(col, m)) {
+            added++;
+        } else {
+            mat_log(MAT_LOG_INFO, "Matrix '%s' already exists or failed to add.", m->name);
+            free_matrix(m);
+        }
+    }
+    int failed = matrix_stream_failed(s);
+    matrix_stream_close(s);
+    mat_log(MAT_LOG_INFO, "Loaded %d matrices from %s", added, label ? label : "stream");
+    return failed ? -1 : added;
+}
+
+int read_matrices_from_stream_path(const char *path, MatrixCollection *col) {
+    if (!path || !col) return -1;
+    if (strcmp(path, "-") == 0) return read_matrices_from_stream(STDIN_FILENO, "stdin", col);
+
+    /* Blocks until a writer opens the other end when path is a FIFO */
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        mat_log(MAT_LOG_ERROR, "Cannot open '%s': %s", path, strerror(errno));
+        return -1;
+    }
+    const char *base = strrchr(path, '/');
+    int rc = read_matrices_from_stream(fd, base ? base + 1 : path, col);
+    close(fd);
+    return rc;
+}
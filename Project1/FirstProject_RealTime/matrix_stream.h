@@ -0,0 +1,58 @@
+#ifndef MATRIX_STREAM_H
+#define MATRIX_STREAM_H
+
+#include "matrix_types.h"
+
+/*
+ * Streaming ingestion from any readable fd: stdin, pipes, FIFOs, sockets,
+ * character devices or regular files. Nothing is seeked, so the data can
+ * come straight from an upstream generator.
+ *
+ * A stream holds any number of concatenated matrices, each one either
+ *   - text: name, rows cols, then rows*cols values (the .txt format), or
+ *   - a complete .npy file (detected by its magic bytes); these are named
+ *     <label>_<k>, where k is the position of the matrix in the stream.
+ * Whitespace between matrices is ignored.
+ *
+ * Work is pipelined: a reader thread pulls fixed-size chunks off the fd into
+ * a bounded queue while the consumer tokenizes the chunks already received
+ * with all OpenMP threads and fills rows in place.
+ */
+
+typedef struct MatrixStream MatrixStream;
+
+/* Start reading fd (not closed by the stream). label names the source in
+ * messages and in generated matrix names (e.g. "stdin").
+ * Returns: stream handle or NULL on error
+ */
+MatrixStream *matrix_stream_open(int fd, const char *label);
+
+/* Next matrix from the stream.
+ * Returns: Matrix pointer, or NULL at end of stream or on a parse/read error
+ *          (tell the two apart with matrix_stream_failed)
+ */
+Matrix *matrix_stream_next(MatrixStream *s);
+
+/* 1 if the stream stopped because of an error, 0 on a clean end of stream */
+int matrix_stream_failed(const MatrixStream *s);
+
+/* 1 if non-whitespace bytes have already been received but not parsed,
+ * i.e. another matrix has at least started. Never waits for input.
+ */
+int matrix_stream_pending(MatrixStream *s);
+
+/* Stop the reader thread and release the stream */
+void matrix_stream_close(MatrixStream *s);
+
+/* Read every matrix in fd into the collection (duplicates are skipped).
+ * Returns: number of matrices added, or -1 if the stream was malformed
+ *          (matrices read before the error are kept)
+ */
+int read_matrices_from_stream(int fd, const char *label, MatrixCollection *col);
+
+/* Same as read_matrices_from_stream for a path: "-" is stdin, anything else
+ * (FIFO, device, regular file) is opened read-only.
+ */
+int read_matrices_from_stream_path(const char *path, MatrixCollection *col);
+
+#endif /* MATRIX_STREAM_H */
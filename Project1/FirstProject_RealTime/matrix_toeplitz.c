@@ -0,0 +1,681 @@
+#include "matrix_toeplitz.h"
+#include "matrix_fft.h"
+#include "matrix_file_ops.h"
+#include "matrix_arithmetic_parallel.h"
+#include "matrix_resources.h"
+#include "lu_recursive.h"
+#include "matrix_log.h"
+#include <complex.h>
+#include <math.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/time.h>
+
+/* Below this many diagonals (rows + cols - 1) the direct sum is faster */
+#define TOEPLITZ_FFT_MIN 64
+
+/* A Levinson denominator or a circulant eigenvalue (relative to the
+ * largest) below this counts as zero (as PIVOT_EPS for LU)
+ */
+#define TOEPLITZ_EPS 1e-12
+
+/* Direct products with fewer multiply-adds than this stay on one thread */
+#define TOEPLITZ_PAR_MIN 65536L
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+static void stop_clock(double start, double *exec_time) {
+    if (exec_time) *exec_time = get_time() - start;
+}
+
+/* ===== Construction / conversion ===== */
+
+/* C(0, j) = c[(n - j) mod n] */
+static void circulant_fill_row(ToeplitzMatrix *t) {
+    t->row[0] = t->col[0];
+    for (int j = 1; j < t->cols; j++) t->row[j] = t->col[t->rows - j];
+}
+
+ToeplitzMatrix *toeplitz_from_vectors(const char *name, const double *col, int rows,
+                                      const double *row, int cols) {
+    if (!name || !col || !row) return NULL;
+    if (rows > 0 && cols > 0 && col[0] != row[0]) {
+        mat_log(MAT_LOG_ERROR, "Error: first column starts with %g but first row with %g", col[0], row[0]);
+        return NULL;
+    }
+    ToeplitzMatrix *t = create_toeplitz_matrix(name, rows, cols, STRUCTURE_TOEPLITZ);
+    if (!t) return NULL;
+    memcpy(t->col, col, (size_t)rows * sizeof(double));
+    memcpy(t->row, row, (size_t)cols * sizeof(double));
+    return t;
+}
+
+ToeplitzMatrix *circulant_from_vector(const char *name, const double *c, int n) {
+    if (!name || !c) return NULL;
+    ToeplitzMatrix *t = create_toeplitz_matrix(name, n, n, STRUCTURE_CIRCULANT);
+    if (!t) return NULL;
+    memcpy(t->col, c, (size_t)n * sizeof(double));
+    circulant_fill_row(t);
+    return t;
+}
+
+ToeplitzMatrix *toeplitz_detect(const Matrix *m, const char *name) {
+    if (!m || !name) return NULL;
+    for (int i = 1; i < m->rows; i++) {
+        for (int j = 1; j < m->cols; j++) {
+            if (mat_get(m, i, j) != mat_get(m, i - 1, j - 1)) return NULL;
+        }
+    }
+
+    int circulant = m->rows == m->cols;
+    for (int i = 1; circulant && i < m->rows; i++) {
+        circulant = mat_get(m, i, 0) == mat_get(m, i - 1, m->cols - 1);
+    }
+
+    ToeplitzMatrix *t = create_toeplitz_matrix(name, m->rows, m->cols,
+                                               circulant ? STRUCTURE_CIRCULANT : STRUCTURE_TOEPLITZ);
+    if (!t) return NULL;
+    for (int i = 0; i < m->rows; i++) t->col[i] = mat_get(m, i, 0);
+    for (int j = 0; j < m->cols; j++) t->row[j] = mat_get(m, 0, j);
+    return t;
+}
+
+Matrix *toeplitz_to_dense(const ToeplitzMatrix *t, const char *name) {
+    if (!t || !name) return NULL;
+    Matrix *m = create_matrix(name, t->rows, t->cols);
+    if (!m) return NULL;
+    for (int i = 0; i < t->rows; i++) {
+        double *dst = m->data[i];
+        for (int j = 0; j < t->cols; j++) dst[j] = toeplitz_get(t, i, j);
+    }
+    return m;
+}
+
+/* ===== Products ===== */
+
+/* Explicit product: no NaN/Inf recovery (__muldc3) in the inner loops */
+static inline double complex cmul(double complex a, double complex b) {
+    return CMPLX(creal(a) * creal(b) - cimag(a) * cimag(b),
+                 creal(a) * cimag(b) + cimag(a) * creal(b));
+}
+
+static int use_fft(const ToeplitzMatrix *t) {
+    return t->rows + t->cols - 1 >= TOEPLITZ_FFT_MIN;
+}
+
+/* Transform of the first column of the length-L circulant embedding t */
+static double complex *embedding_spectrum(const ToeplitzMatrix *t, const FftPlan *plan, int len) {
+    double complex *c = (double complex *)calloc((size_t)len, sizeof(double complex));
+    if (!c) return NULL;
+    for (int k = 0; k < t->rows; k++) c[k] = t->col[k];
+    for (int k = 1; k < t->cols; k++) c[len - k] = t->row[k];
+    fft_execute(plan, c, 0);
+    return c;
+}
+
+/* One cyclic convolution (divide = 0) or deconvolution (divide = 1) of
+ * the columns x0 + i x1 (n_in values each, stride xs; x1 may be NULL)
+ * with spec, keeping the first n_out values in y0 and y1 (stride ys).
+ * Returns 0 if a Bluestein transform cannot get its scratch buffer
+ */
+static int cyclic_pair(const FftPlan *plan, const double complex *spec, int len, int divide,
+                       double complex *buf, int n_in, const double *x0, const double *x1, size_t xs,
+                       int n_out, double *y0, double *y1, size_t ys) {
+    for (int j = 0; j < n_in; j++) buf[j] = CMPLX(x0[j * xs], x1 ? x1[j * xs] : 0.0);
+    for (int j = n_in; j < len; j++) buf[j] = 0.0;
+    if (!fft_execute(plan, buf, 0)) return 0;
+    if (divide) {
+        for (int k = 0; k < len; k++) {
+            double complex s = spec[k];
+            buf[k] = cmul(buf[k], conj(s)) / (creal(s) * creal(s) + cimag(s) * cimag(s));
+        }
+    } else {
+        for (int k = 0; k < len; k++) buf[k] = cmul(buf[k], spec[k]);
+    }
+    if (!fft_execute(plan, buf, 1)) return 0;
+    for (int i = 0; i < n_out; i++) {
+        y0[i * ys] = creal(buf[i]);
+        if (y1) y1[i * ys] = cimag(buf[i]);
+    }
+    return 1;
+}
+
+/* y = T x, row by row over the stored diagonals */
+static void direct_product(const ToeplitzMatrix *t, const Matrix *x, Matrix *y, int parallel) {
+    int p = x->cols;
+    #pragma omp parallel for schedule(static) if (parallel && (long)t->rows * t->cols * p >= TOEPLITZ_PAR_MIN)
+    for (int i = 0; i < t->rows; i++) {
+        double *restrict dst = y->data[i];
+        for (int j = 0; j < t->cols; j++) {
+            double a = toeplitz_get(t, i, j);
+            if (a == 0.0) continue;
+            for (int c = 0; c < p; c++) dst[c] += a * mat_get(x, j, c);
+        }
+    }
+}
+
+int toeplitz_matvec(const ToeplitzMatrix *t, const double *x, double *y) {
+    if (!t || !x || !y) return 0;
+    if (!use_fft(t)) {
+        for (int i = 0; i < t->rows; i++) {
+            double sum = 0.0;
+            for (int j = 0; j < t->cols; j++) sum += toeplitz_get(t, i, j) * x[j];
+            y[i] = sum;
+        }
+        return 1;
+    }
+
+    int len = fft_next_pow2(t->rows + t->cols - 1);
+    FftPlan *plan = fft_plan_create(len);
+    double complex *spec = plan ? embedding_spectrum(t, plan, len) : NULL;
+    double complex *buf = (double complex *)malloc((size_t)len * sizeof(double complex));
+    int ok = spec && buf && cyclic_pair(plan, spec, len, 0, buf, t->cols, x, NULL, 1, t->rows, y, NULL, 1);
+    free(buf);
+    free(spec);
+    fft_plan_free(plan);
+    return ok;
+}
+
+static Matrix *toeplitz_multiply(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                 int parallel, double *exec_time) {
+    if (!t || !x || !name) return NULL;
+    if (t->cols != x->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for multiplication");
+        return NULL;
+    }
+
+    double start = get_time();
+    Matrix *y = create_matrix(name, t->rows, x->cols);
+    if (!y) return NULL;
+    if (!use_fft(t)) {
+        direct_product(t, x, y, parallel);
+        stop_clock(start, exec_time);
+        return y;
+    }
+
+    int len = fft_next_pow2(t->rows + t->cols - 1);
+    FftPlan *plan = fft_plan_create(len);
+    double complex *spec = plan ? embedding_spectrum(t, plan, len) : NULL;
+    int ok = spec != NULL;
+    int pairs = (x->cols + 1) / 2;
+
+    #pragma omp parallel if (parallel && ok && pairs > 1)
+    {
+        double complex *buf = ok ? (double complex *)malloc((size_t)len * sizeof(double complex)) : NULL;
+        if (!buf) {
+            #pragma omp atomic write
+            ok = 0;
+        }
+        #pragma omp for schedule(dynamic)
+        for (int q = 0; q < pairs; q++) {
+            if (!buf) continue;
+            int c0 = 2 * q, second = c0 + 1 < x->cols;
+            cyclic_pair(plan, spec, len, 0, buf,
+                        t->cols, mat_at(x, 0, c0), second ? mat_at(x, 0, c0 + 1) : NULL, x->row_stride,
+                        t->rows, mat_at(y, 0, c0), second ? mat_at(y, 0, c0 + 1) : NULL, y->row_stride);
+        }
+        free(buf);
+    }
+
+    free(spec);
+    fft_plan_free(plan);
+    if (!ok) {
+        free_matrix(y);
+        return NULL;
+    }
+    stop_clock(start, exec_time);
+    return y;
+}
+
+Matrix *toeplitz_multiply_single(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                 double *exec_time) {
+    return toeplitz_multiply(t, x, name, 0, exec_time);
+}
+
+Matrix *toeplitz_multiply_openmp(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                 double *exec_time) {
+    return toeplitz_multiply(t, x, name, 1, exec_time);
+}
+
+/* ===== Levinson recursion ===== */
+
+/* Grows f and b, the first and last columns of the inverse of the leading
+ * k x k minor, from k = 1 to n:
+ *     ef = T(k, 0:k) f,  eb = T(0, 1:k+1) b,  den = 1 - ef eb
+ *     f' = ([f; 0] - ef [0; b]) / den,  b' = ([0; b] - eb [f; 0]) / den
+ * For symmetric T, b is f reversed. Since b'[k] = det T_k / det T_{k+1},
+ * the determinant comes for free. With p > 0 it also extends the solution
+ * of T_k X = B(0:k, :) by (B(k, :) - T(k, 0:k) X) b'.
+ * Returns 1, 0 on breakdown (den or t0 numerically zero), -1 on
+ * allocation failure.
+ */
+static int levinson(const ToeplitzMatrix *t, const Matrix *rhs, double *x, int p,
+                    double *logabs, int *sign) {
+    int n = t->rows;
+    const double *col = t->col, *row = t->row;
+
+    double scale = 0.0;
+    for (int k = 0; k < n; k++) {
+        if (fabs(col[k]) > scale) scale = fabs(col[k]);
+        if (fabs(row[k]) > scale) scale = fabs(row[k]);
+    }
+    if (!(fabs(col[0]) > TOEPLITZ_EPS * scale)) return 0;
+
+    int symmetric = memcmp(col, row, (size_t)n * sizeof(double)) == 0;
+    double *work = (double *)malloc(((size_t)4 * n + 2 * (size_t)p) * sizeof(double));
+    if (!work) return -1;
+    double *f = work, *b = f + n, *fn = b + n, *bn = fn + n;
+    double *ex = bn + n, *r = ex + p;
+
+    f[0] = b[0] = 1.0 / col[0];
+    *logabs = log(fabs(col[0]));
+    *sign = col[0] < 0.0 ? -1 : 1;
+    for (int c = 0; c < p; c++) x[c] = mat_get(rhs, 0, c) / col[0];
+
+    for (int k = 1; k < n; k++) {
+        double ef = 0.0, eb = 0.0;
+        for (int j = 0; j < k; j++) ef += col[k - j] * f[j];
+        if (symmetric) {
+            eb = ef;
+        } else {
+            for (int j = 0; j < k; j++) eb += row[j + 1] * b[j];
+        }
+        double den = 1.0 - ef * eb;
+        if (!(fabs(den) >= TOEPLITZ_EPS)) {
+            free(work);
+            return 0;
+        }
+
+        for (int j = 0; j <= k; j++) {
+            double fj = j < k ? f[j] : 0.0;
+            double bj = j > 0 ? b[j - 1] : 0.0;
+            fn[j] = (fj - ef * bj) / den;
+            if (!symmetric) bn[j] = (bj - eb * fj) / den;
+        }
+        if (symmetric) {
+            for (int j = 0; j <= k; j++) bn[j] = fn[k - j];
+        }
+        double *tmp = f; f = fn; fn = tmp;
+        tmp = b; b = bn; bn = tmp;
+
+        *logabs -= log(fabs(b[k]));
+        if (b[k] < 0.0) *sign = -*sign;
+
+        if (p > 0) {
+            for (int c = 0; c < p; c++) ex[c] = 0.0;
+            for (int j = 0; j < k; j++) {
+                double a = col[k - j];
+                const double *xj = x + (size_t)j * p;
+                for (int c = 0; c < p; c++) ex[c] += a * xj[c];
+            }
+            for (int c = 0; c < p; c++) r[c] = mat_get(rhs, k, c) - ex[c];
+            for (int j = 0; j <= k; j++) {
+                double bj = b[j];
+                double *xj = x + (size_t)j * p;
+                for (int c = 0; c < p; c++) xj[c] += r[c] * bj;
+            }
+        }
+    }
+
+    free(work);
+    return 1;
+}
+
+/* ===== Circulants ===== */
+
+/* Eigenvalues FFT_n(col) and the largest and smallest modulus */
+static double complex *circulant_eigenvalues(const ToeplitzMatrix *t, const FftPlan *plan,
+                                             double *max_abs, double *min_abs) {
+    int n = t->rows;
+    double complex *lam = (double complex *)malloc((size_t)n * sizeof(double complex));
+    if (!lam) return NULL;
+    for (int k = 0; k < n; k++) lam[k] = t->col[k];
+    if (!fft_execute(plan, lam, 0)) {
+        free(lam);
+        return NULL;
+    }
+    *max_abs = 0.0;
+    *min_abs = INFINITY;
+    for (int k = 0; k < n; k++) {
+        double a = cabs(lam[k]);
+        if (a > *max_abs) *max_abs = a;
+        if (a < *min_abs) *min_abs = a;
+    }
+    return lam;
+}
+
+static int circulant_determinant(const ToeplitzMatrix *t, double *logabs, int *sign) {
+    int n = t->rows;
+    FftPlan *plan = fft_plan_create(n);
+    double max_abs = 0.0, min_abs = 0.0;
+    double complex *lam = plan ? circulant_eigenvalues(t, plan, &max_abs, &min_abs) : NULL;
+    fft_plan_free(plan);
+    if (!lam) return -1;
+
+    if (!(min_abs > TOEPLITZ_EPS * max_abs)) {
+        *logabs = -INFINITY;
+        *sign = 0;
+        free(lam);
+        return 1;
+    }
+    /* log|det| = sum log|lam|; the phase as a running unit product */
+    double complex phase = 1.0;
+    *logabs = 0.0;
+    for (int k = 0; k < n; k++) {
+        double a = cabs(lam[k]);
+        *logabs += log(a);
+        phase = cmul(phase, lam[k] / a);
+        phase /= cabs(phase);
+    }
+    /* det of a real matrix is real: the phase is +-1 up to rounding */
+    *sign = creal(phase) < 0.0 ? -1 : 1;
+    free(lam);
+    return 1;
+}
+
+static Matrix *circulant_solve(const ToeplitzMatrix *t, const Matrix *b, const char *name) {
+    int n = t->rows;
+    FftPlan *plan = fft_plan_create(n);
+    double max_abs = 0.0, min_abs = 0.0;
+    double complex *lam = plan ? circulant_eigenvalues(t, plan, &max_abs, &min_abs) : NULL;
+    double complex *buf = (double complex *)malloc((size_t)n * sizeof(double complex));
+    Matrix *x = NULL;
+    if (lam && buf && !(min_abs > TOEPLITZ_EPS * max_abs)) {
+        mat_log(MAT_LOG_ERROR, "Error: circulant '%s' is singular (smallest eigenvalue %.3e)", t->name, min_abs);
+    } else if (lam && buf && (x = create_matrix(name, n, b->cols)) != NULL) {
+        for (int c = 0; c < b->cols; c += 2) {
+            int second = c + 1 < b->cols;
+            if (!cyclic_pair(plan, lam, n, 1, buf,
+                             n, mat_at(b, 0, c), second ? mat_at(b, 0, c + 1) : NULL, b->row_stride,
+                             n, mat_at(x, 0, c), second ? mat_at(x, 0, c + 1) : NULL, x->row_stride)) {
+                free_matrix(x);
+                x = NULL;
+                break;
+            }
+        }
+    }
+    free(buf);
+    free(lam);
+    fft_plan_free(plan);
+    return x;
+}
+
+/* ===== Solve / determinant ===== */
+
+/* Levinson needs every leading minor to be nonsingular; when one is not,
+ * the dense matrix is factored with the recursive LU instead. NULL if the
+ * matrix itself is singular or on allocation failure
+ */
+static LUFactor *dense_fallback_factor(const ToeplitzMatrix *t) {
+    mat_log(MAT_LOG_WARN, "WARNING: Levinson breakdown on '%s' (singular leading minor); "
+            "using dense LU", t->name);
+    Matrix *d = toeplitz_to_dense(t, t->name);
+    LUFactor *f = d ? lu_factor_recursive(d, 1, NULL) : NULL;
+    free_matrix(d);
+    return f;
+}
+
+/* X with P*A = L*U, column by column: forward then back substitution */
+static Matrix *lu_solve_dense(const LUFactor *f, const Matrix *b, const char *name) {
+    int n = f->n;
+    Matrix *x = create_matrix(name, n, b->cols);
+    double *y = (double *)malloc((size_t)n * sizeof(double));
+    if (!x || !y) { free_matrix(x); free(y); return NULL; }
+    for (int c = 0; c < b->cols; c++) {
+        for (int i = 0; i < n; i++) y[i] = mat_get(b, i, c);
+        for (int i = 0; i < n; i++) {
+            double tmp = y[i]; y[i] = y[f->piv[i]]; y[f->piv[i]] = tmp;
+        }
+        for (int i = 0; i < n; i++) {
+            const double *row = f->lu + (size_t)i * n;
+            double sum = y[i];
+            for (int k = 0; k < i; k++) sum -= row[k] * y[k];
+            y[i] = sum;
+        }
+        for (int i = n - 1; i >= 0; i--) {
+            const double *row = f->lu + (size_t)i * n;
+            double sum = y[i];
+            for (int k = i + 1; k < n; k++) sum -= row[k] * y[k];
+            y[i] = sum / row[i];
+        }
+        for (int i = 0; i < n; i++) x->data[i][c] = y[i];
+    }
+    free(y);
+    return x;
+}
+
+Matrix *toeplitz_solve(const ToeplitzMatrix *t, const Matrix *b, const char *name, double *exec_time) {
+    if (!t || !b || !name) return NULL;
+    if (t->rows != t->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: Toeplitz matrix '%s' is not square", t->name);
+        return NULL;
+    }
+    if (b->rows != t->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: right-hand side has %d rows, expected %d", b->rows, t->rows);
+        return NULL;
+    }
+
+    double start = get_time();
+    if (t->kind == STRUCTURE_CIRCULANT) {
+        Matrix *x = circulant_solve(t, b, name);
+        if (x) stop_clock(start, exec_time);
+        return x;
+    }
+
+    Matrix *x = create_matrix(name, t->rows, b->cols);
+    if (!x) return NULL;
+    double logabs;
+    int sign;
+    int rc = levinson(t, b, x->data[0], b->cols, &logabs, &sign);
+    if (rc == 0) {
+        free_matrix(x);
+        LUFactor *f = dense_fallback_factor(t);
+        if (!f) return NULL;
+        x = NULL;
+        if (f->singular) mat_log(MAT_LOG_ERROR, "Error: Toeplitz matrix '%s' is singular", t->name);
+        else x = lu_solve_dense(f, b, name);
+        free_lu_factor(f);
+        if (x) stop_clock(start, exec_time);
+        return x;
+    }
+    if (rc != 1) {
+        free_matrix(x);
+        return NULL;
+    }
+    stop_clock(start, exec_time);
+    return x;
+}
+
+int toeplitz_determinant(const ToeplitzMatrix *t, double *out_det, double *out_logabs, double *exec_time) {
+    if (!t || !out_det) return 0;
+    if (t->rows != t->cols) {
+        mat_log(MAT_LOG_ERROR, "Error: Toeplitz matrix '%s' is not square", t->name);
+        return 0;
+    }
+
+    double start = get_time();
+    double logabs = 0.0;
+    int sign = 1;
+    int rc = t->kind == STRUCTURE_CIRCULANT ? circulant_determinant(t, &logabs, &sign)
+                                            : levinson(t, NULL, NULL, 0, &logabs, &sign);
+    if (rc == 0) {
+        LUFactor *f = dense_fallback_factor(t);
+        if (!f) return 0;
+        /* log|det| from the diagonal of U, so it stays finite like Levinson's */
+        sign = f->sign;
+        logabs = 0.0;
+        for (int i = 0; i < f->n && sign != 0; i++) {
+            double u = f->lu[(size_t)i * f->n + i];
+            if (u == 0.0) { sign = 0; logabs = -INFINITY; break; }
+            if (u < 0.0) sign = -sign;
+            logabs += log(fabs(u));
+        }
+        free_lu_factor(f);
+        rc = 1;
+    }
+    if (rc != 1) return 0;
+
+    *out_det = sign == 0 ? 0.0 : sign * exp(logabs);
+    if (out_logabs) *out_logabs = logabs;
+    stop_clock(start, exec_time);
+    return 1;
+}
+
+/* ===== Comparison ===== */
+
+static double max_difference(const Matrix *x, const Matrix *y) {
+    if (!x || !y) return NAN;
+    double worst = 0.0;
+    for (int i = 0; i < x->rows; i++) {
+        for (int j = 0; j < x->cols; j++) {
+            double d = fabs(mat_get(x, i, j) - mat_get(y, i, j));
+            if (d > worst) worst = d;
+        }
+    }
+    return worst;
+}
+
+Matrix *run_toeplitz_multiply_comparison(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                         ToeplitzMultiplyMetrics *metrics) {
+    if (!t || !x || !name || !metrics) return NULL;
+
+    mat_log(MAT_LOG_INFO, "\n========================================");
+    mat_log(MAT_LOG_INFO, "Performance Comparison: Toeplitz Multiplication");
+    mat_log(MAT_LOG_INFO, "Matrix 1: %s (%dx%d %s), Matrix 2: %s (%dx%d)",
+            t->name, t->rows, t->cols, t->kind == STRUCTURE_CIRCULANT ? "circulant" : "toeplitz",
+            x->name, x->rows, x->cols);
+    resource_log_budget();
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    char temp_name[128];
+    snprintf(temp_name, sizeof(temp_name), "%s_dense", name);
+    mat_log(MAT_LOG_INFO, "[1/2] Running dense product of the expanded matrix...");
+    Matrix *dense_t = toeplitz_to_dense(t, temp_name);
+    Matrix *dense = dense_t ? multiply_matrices_openmp(dense_t, x, temp_name, &metrics->dense_time) : NULL;
+    free_matrix(dense_t);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds\n", metrics->dense_time);
+
+    mat_log(MAT_LOG_INFO, "[2/2] Running FFT product...");
+    Matrix *fast = toeplitz_multiply_openmp(t, x, name, &metrics->fft_time);
+    mat_log(MAT_LOG_INFO, "   ✓ Completed in %.6f seconds", metrics->fft_time);
+    mat_log(MAT_LOG_INFO, "   Speedup: %.2fx\n", metrics->dense_time / metrics->fft_time);
+
+    size_t dense_bytes = (size_t)t->rows * t->cols * sizeof(double);
+    size_t packed_bytes = ((size_t)t->rows + t->cols) * sizeof(double);
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "PERFORMANCE SUMMARY");
+    mat_log(MAT_LOG_INFO, "========================================");
+    mat_log(MAT_LOG_INFO, "Dense product:     %.6f s (baseline)", metrics->dense_time);
+    mat_log(MAT_LOG_INFO, "FFT product:       %.6f s (%.2fx %s)", metrics->fft_time,
+            metrics->dense_time / metrics->fft_time,
+            metrics->fft_time < metrics->dense_time ? "faster" : "slower");
+    mat_log(MAT_LOG_INFO, "Storage of T:      %zu bytes dense, %zu bytes structured", dense_bytes, packed_bytes);
+    mat_log(MAT_LOG_INFO, "Max |difference|:  %.3e", max_difference(dense, fast));
+    mat_log(MAT_LOG_INFO, "========================================\n");
+
+    free_matrix(dense);
+    return fast;
+}
+
+/* ===== File I/O ===== */
+
+int matrix_file_is_toeplitz(const char *filepath) {
+    char tag[16];
+    if (!matrix_file_tag(filepath, tag, sizeof(tag))) return 0;
+    return strcmp(tag, "toeplitz") == 0 || strcmp(tag, "circulant") == 0;
+}
+
+static int read_values(FILE *f, double *v, int n) {
+    for (int k = 0; k < n; k++) {
+        if (fscanf(f, "%lf", &v[k]) != 1) return 0;
+    }
+    return 1;
+}
+
+ToeplitzMatrix *read_toeplitz_matrix_from_file(const char *filepath) {
+    if (!filepath) return NULL;
+    FILE *f = fopen(filepath, "r");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return NULL;
+    }
+
+    char name[MAX_NAME_LENGTH], tag[16];
+    int rows, cols;
+    if (fscanf(f, "%63s", name) != 1 || fscanf(f, "%d %d", &rows, &cols) != 2 || rows <= 0 || cols <= 0 ||
+        fscanf(f, " %15[A-Za-z]", tag) != 1) {
+        mat_log(MAT_LOG_ERROR, "Invalid header in %s", filepath);
+        fclose(f);
+        return NULL;
+    }
+
+    StructureKind kind;
+    if (strcmp(tag, "toeplitz") == 0) {
+        kind = STRUCTURE_TOEPLITZ;
+    } else if (strcmp(tag, "circulant") == 0) {
+        kind = STRUCTURE_CIRCULANT;
+    } else {
+        mat_log(MAT_LOG_ERROR, "%s is not a Toeplitz matrix file (expected \"rows cols toeplitz\")", filepath);
+        fclose(f);
+        return NULL;
+    }
+    if (kind == STRUCTURE_CIRCULANT && rows != cols) {
+        mat_log(MAT_LOG_ERROR, "Circulant in %s must be square, got %dx%d", filepath, rows, cols);
+        fclose(f);
+        return NULL;
+    }
+
+    ToeplitzMatrix *t = create_toeplitz_matrix(name, rows, cols, kind);
+    if (!t) {
+        mat_log(MAT_LOG_ERROR, "Failed to allocate matrix.");
+        fclose(f);
+        return NULL;
+    }
+    int ok = read_values(f, t->col, rows);
+    if (ok && kind == STRUCTURE_CIRCULANT) {
+        circulant_fill_row(t);
+    } else if (ok) {
+        ok = read_values(f, t->row, cols);
+        if (ok && t->row[0] != t->col[0]) {
+            mat_log(MAT_LOG_ERROR, "First row and column in %s disagree on the diagonal", filepath);
+            ok = -1;
+        }
+    }
+    fclose(f);
+    if (ok != 1) {
+        if (ok == 0) mat_log(MAT_LOG_ERROR, "Failed to read the diagonals from %s", filepath);
+        free_toeplitz_matrix(t);
+        return NULL;
+    }
+
+    mat_log(MAT_LOG_INFO, "Successfully loaded %s matrix '%s' (%dx%d) from %s", tag, name, rows, cols, filepath);
+    return t;
+}
+
+static void write_values(FILE *f, const double *v, int n) {
+    for (int k = 0; k < n; k++) fprintf(f, k ? " %.10f" : "%.10f", v[k]);
+    fprintf(f, "\n");
+}
+
+int write_toeplitz_matrix_to_file(const ToeplitzMatrix *t, const char *filepath) {
+    if (!t || !filepath) return 0;
+    FILE *f = fopen(filepath, "w");
+    if (!f) {
+        mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno));
+        return 0;
+    }
+
+    int circulant = t->kind == STRUCTURE_CIRCULANT;
+    fprintf(f, "%s\n", t->name);
+    fprintf(f, "%d %d %s\n", t->rows, t->cols, circulant ? "circulant" : "toeplitz");
+    write_values(f, t->col, t->rows);
+    if (!circulant) write_values(f, t->row, t->cols);
+
+    fclose(f);
+    mat_log(MAT_LOG_INFO, "Toeplitz matrix '%s' saved to %s", t->name, filepath);
+    return 1;
+}
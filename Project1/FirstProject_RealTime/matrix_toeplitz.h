@@ -0,0 +1,120 @@
+#ifndef MATRIX_TOEPLITZ_H
+#define MATRIX_TOEPLITZ_H
+
+#include "matrix_types.h"
+
+/*
+ * Toeplitz and circulant matrices (ToeplitzMatrix in matrix_types.h),
+ * stored as their first column and first row: rows + cols values instead
+ * of rows * cols.
+ *
+ * Products go through the FFT (matrix_fft.h). An m x n Toeplitz matrix is
+ * the top-left block of a circulant of any length L >= m + n - 1 whose
+ * first column is
+ *
+ *     c = [col[0] .. col[m-1], 0 .. 0, row[n-1] .. row[1]],
+ *
+ * and a circulant times a vector is a cyclic convolution:
+ * C x = IFFT(FFT(c) .* FFT(x)). So T x costs O(L log L) instead of O(mn).
+ * FFT(c) is computed once per product. Since T is real, two real columns
+ * x1, x2 go through one complex transform as x1 + i x2: the real part of
+ * the result is T x1 and the imaginary part T x2.
+ *
+ * Solves and determinants of square Toeplitz matrices use the Levinson
+ * recursion, O(n^2): it grows the inverses' first and last columns one
+ * leading minor at a time (Levinson-Durbin, with half the work, when the
+ * matrix is symmetric). It needs every leading minor to be nonsingular.
+ * When one is not, the solve and the determinant fall back to the
+ * recursive LU of the expanded matrix (lu_recursive.h, O(n^3)) and log a
+ * warning. Circulants are diagonalised by the DFT, so their eigenvalues
+ * FFT(col) give the determinant and the solve in O(n log n) with no such
+ * restriction.
+ */
+
+/* Times of the two methods in run_toeplitz_multiply_comparison() */
+typedef struct {
+    double dense_time;      /* expanded T through multiply_matrices_openmp() */
+    double fft_time;        /* toeplitz_multiply_openmp() */
+} ToeplitzMultiplyMetrics;
+
+static inline double toeplitz_get(const ToeplitzMatrix *t, int i, int j) {
+    return i >= j ? t->col[i - j] : t->row[j - i];
+}
+
+/* ===== Construction / conversion ===== */
+
+/* Toeplitz matrix from its first column (rows values) and first row (cols
+ * values). NULL if col[0] != row[0] or on allocation failure
+ */
+ToeplitzMatrix *toeplitz_from_vectors(const char *name, const double *col, int rows,
+                                      const double *row, int cols);
+
+/* n x n circulant with first column c */
+ToeplitzMatrix *circulant_from_vector(const char *name, const double *c, int n);
+
+/* Compressed copy of m if it is exactly Toeplitz (each diagonal constant),
+ * as a circulant if it is square and its diagonals also wrap around.
+ * NULL if it is not Toeplitz
+ */
+ToeplitzMatrix *toeplitz_detect(const Matrix *m, const char *name);
+
+/* Dense row-major rows x cols copy */
+Matrix *toeplitz_to_dense(const ToeplitzMatrix *t, const char *name);
+
+/* ===== Products ===== */
+
+/* y = T x for one vector (x has t->cols values, y t->rows).
+ * Returns 1, or 0 on allocation failure
+ */
+int toeplitz_matvec(const ToeplitzMatrix *t, const double *x, double *y);
+
+/* T * x for a dense x with t->cols rows. Small matrices use the direct
+ * O(mn) sum, which beats the transforms there. The OpenMP version runs
+ * the column pairs in parallel. Returns NULL on dimension mismatch or
+ * allocation failure
+ */
+Matrix *toeplitz_multiply_single(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                 double *exec_time);
+Matrix *toeplitz_multiply_openmp(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                 double *exec_time);
+
+/* ===== Solve / determinant ===== */
+
+/* X with T X = B (Levinson, dense LU after a Levinson breakdown, or the
+ * DFT for a circulant). Returns NULL if t is not square, B has the wrong
+ * number of rows, T is singular, or on allocation failure
+ */
+Matrix *toeplitz_solve(const ToeplitzMatrix *t, const Matrix *b, const char *name, double *exec_time);
+
+/* det(T). *out_logabs gets log|det|, which stays finite when det itself
+ * overflows (may be NULL). A singular matrix gives det 0. Returns 1 on
+ * success, 0 if t is not square or on allocation failure
+ */
+int toeplitz_determinant(const ToeplitzMatrix *t, double *out_det, double *out_logabs, double *exec_time);
+
+/* Run the dense product of the expanded T and the FFT product (both
+ * OpenMP) and log the times, storage and largest deviation. Returns the
+ * FFT result
+ */
+Matrix *run_toeplitz_multiply_comparison(const ToeplitzMatrix *t, const Matrix *x, const char *name,
+                                         ToeplitzMultiplyMetrics *metrics);
+
+/* ===== File I/O ===== */
+
+/* Text format: the first column, then the first row, each on one line
+ *     name                      name
+ *     rows cols toeplitz        n n circulant
+ *     col[0] .. col[rows-1]     c[0] .. c[n-1]
+ *     row[0] .. row[cols-1]
+ */
+
+/* 1 if filepath is a Toeplitz or circulant text file */
+int matrix_file_is_toeplitz(const char *filepath);
+
+/* Returns: ToeplitzMatrix pointer or NULL on error */
+ToeplitzMatrix *read_toeplitz_matrix_from_file(const char *filepath);
+
+/* Returns: 1 on success, 0 on failure */
+int write_toeplitz_matrix_to_file(const ToeplitzMatrix *t, const char *filepath);
+
+#endif /* MATRIX_TOEPLITZ_H */
@@ -0,0 +1,325 @@
+#include "matrix_trsm.h"
+#include "matrix_gemm.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
+#include <errno.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Triangles at most this large are handled by substitution */
+#define TRI_LEAF 64
+
+/* Right-hand sides are split into tasks above this width and work */
+#define TRI_TASK_COLS 256
+#define TRI_TASK_WORK (1L << 20)
+
+/* Fewest right-hand-side columns worth a worker process */
+#define TRI_MP_MIN_COLS 16
+
+typedef enum { TRI_SOLVE, TRI_MULTIPLY } TriKind;
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* ===== Raw kernels ===== */
+
+static void trsm_leaf(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                      const double *T, int ldt, double *W, int ldw) {
+    for (int s = 0; s < n; s++) {
+        int i = uplo == TRI_LOWER ? s : n - 1 - s;
+        int p0 = uplo == TRI_LOWER ? 0 : i + 1;
+        int p1 = uplo == TRI_LOWER ? i : n;
+        double *wi = W + (size_t)i * ldw;
+        for (int p = p0; p < p1; p++) {
+            double t = T[(size_t)i * ldt + p];
+            if (t == 0.0) continue;
+            const double *wp = W + (size_t)p * ldw;
+            #pragma omp simd
+            for (int j = 0; j < nrhs; j++) wi[j] -= t * wp[j];
+        }
+        if (diag == TRI_NON_UNIT) {
+            double d = T[(size_t)i * ldt + i];
+            #pragma omp simd
+            for (int j = 0; j < nrhs; j++) wi[j] /= d;
+        }
+    }
+}
+
+void trsm_left_raw(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                   const double *T, int ldt, double *W, int ldw, int parallel) {
+    if (n <= 0 || nrhs <= 0) return;
+    if (parallel && nrhs > TRI_TASK_COLS && (long)n * n * nrhs > TRI_TASK_WORK) {
+        int h = nrhs / 2;
+        #pragma omp task
+        trsm_left_raw(uplo, diag, n, h, T, ldt, W, ldw, parallel);
+        trsm_left_raw(uplo, diag, n, nrhs - h, T, ldt, W + h, ldw, parallel);
+        #pragma omp taskwait
+        return;
+    }
+    if (n <= TRI_LEAF) {
+        trsm_leaf(uplo, diag, n, nrhs, T, ldt, W, ldw);
+        return;
+    }
+    int h = n / 2;
+    const double *T22 = T + (size_t)h * ldt + h;
+    double *W2 = W + (size_t)h * ldw;
+    if (uplo == TRI_LOWER) {
+        trsm_left_raw(uplo, diag, h, nrhs, T, ldt, W, ldw, parallel);
+        gemm_recursive_task(n - h, nrhs, h, -1.0, T + (size_t)h * ldt, ldt, W, ldw, W2, ldw, parallel);
+        trsm_left_raw(uplo, diag, n - h, nrhs, T22, ldt, W2, ldw, parallel);
+    } else {
+        trsm_left_raw(uplo, diag, n - h, nrhs, T22, ldt, W2, ldw, parallel);
+        gemm_recursive_task(h, nrhs, n - h, -1.0, T + h, ldt, W2, ldw, W, ldw, parallel);
+        trsm_left_raw(uplo, diag, h, nrhs, T, ldt, W, ldw, parallel);
+    }
+}
+
+/* In place: each row is overwritten only after every row that still needs
+ * its old value (later rows for lower, earlier rows for upper) is done.
+ */
+static void trmm_leaf(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                      const double *T, int ldt, double *W, int ldw) {
+    for (int s = 0; s < n; s++) {
+        int i = uplo == TRI_LOWER ? n - 1 - s : s;
+        int p0 = uplo == TRI_LOWER ? 0 : i + 1;
+        int p1 = uplo == TRI_LOWER ? i : n;
+        double *wi = W + (size_t)i * ldw;
+        if (diag == TRI_NON_UNIT) {
+            double d = T[(size_t)i * ldt + i];
+            #pragma omp simd
+            for (int j = 0; j < nrhs; j++) wi[j] *= d;
+        }
+        for (int p = p0; p < p1; p++) {
+            double t = T[(size_t)i * ldt + p];
+            if (t == 0.0) continue;
+            const double *wp = W + (size_t)p * ldw;
+            #pragma omp simd
+            for (int j = 0; j < nrhs; j++) wi[j] += t * wp[j];
+        }
+    }
+}
+
+void trmm_left_raw(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                   const double *T, int ldt, double *W, int ldw, int parallel) {
+    if (n <= 0 || nrhs <= 0) return;
+    if (parallel && nrhs > TRI_TASK_COLS && (long)n * n * nrhs > TRI_TASK_WORK) {
+        int h = nrhs / 2;
+        #pragma omp task
+        trmm_left_raw(uplo, diag, n, h, T, ldt, W, ldw, parallel);
+        trmm_left_raw(uplo, diag, n, nrhs - h, T, ldt, W + h, ldw, parallel);
+        #pragma omp taskwait
+        return;
+    }
+    if (n <= TRI_LEAF) {
+        trmm_leaf(uplo, diag, n, nrhs, T, ldt, W, ldw);
+        return;
+    }
+    int h = n / 2;
+    const double *T22 = T + (size_t)h * ldt + h;
+    double *W2 = W + (size_t)h * ldw;
+    if (uplo == TRI_LOWER) {
+        /* W2 = T22*W2 + T21*W1 needs the old W1, so it goes first */
+        trmm_left_raw(uplo, diag, n - h, nrhs, T22, ldt, W2, ldw, parallel);
+        gemm_recursive_task(n - h, nrhs, h, 1.0, T + (size_t)h * ldt, ldt, W, ldw, W2, ldw, parallel);
+        trmm_left_raw(uplo, diag, h, nrhs, T, ldt, W, ldw, parallel);
+    } else {
+        trmm_left_raw(uplo, diag, h, nrhs, T, ldt, W, ldw, parallel);
+        gemm_recursive_task(h, nrhs, n - h, 1.0, T + h, ldt, W2, ldw, W, ldw, parallel);
+        trmm_left_raw(uplo, diag, n - h, nrhs, T22, ldt, W2, ldw, parallel);
+    }
+}
+
+static void run_raw(TriKind kind, TriUplo uplo, TriDiag diag, int n, int nrhs,
+                    const double *T, double *W, int ldw, int parallel) {
+    if (kind == TRI_SOLVE) trsm_left_raw(uplo, diag, n, nrhs, T, n, W, ldw, parallel);
+    else trmm_left_raw(uplo, diag, n, nrhs, T, n, W, ldw, parallel);
+}
+
+/* ===== Worker processes ===== */
+
+static int write_full(int fd, const void *buf, size_t len) {
+    const char *p = (const char *)buf;
+    while (len > 0) {
+        ssize_t w = write(fd, p, len);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return 0;
+        p += w;
+        len -= (size_t)w;
+    }
+    return 1;
+}
+
+static int read_full(int fd, void *buf, size_t len) {
+    char *p = (char *)buf;
+    while (len > 0) {
+        ssize_t r = read(fd, p, len);
+        if (r < 0 && errno == EINTR) continue;
+        if (r <= 0) return 0;
+        p += r;
+        len -= (size_t)r;
+    }
+    return 1;
+}
+
+/* Each worker solves a contiguous block of right-hand-side columns in its
+ * copy-on-write image of W and sends the block back through a pipe.
+ */
+static int run_workers(TriKind kind, TriUplo uplo, TriDiag diag, int n, int nrhs,
+                       const double *T, double *W, int ldw) {
+    int workers = (nrhs + TRI_MP_MIN_COLS - 1) / TRI_MP_MIN_COLS;
+    if (workers > resource_budget()->max_workers) workers = resource_budget()->max_workers;
+    if (workers < 1) workers = 1;
+
+    int (*pipes)[2] = malloc((size_t)workers * sizeof(int[2]));
+    pid_t *pids = (pid_t *)malloc((size_t)workers * sizeof(pid_t));
+    double *block = (double *)malloc((size_t)n * ((nrhs + workers - 1) / workers) * sizeof(double));
+    if (!pipes || !pids || !block) { free(pipes); free(pids); free(block); return 0; }
+
+    int started = 0, ok = 1;
+    for (int w = 0; w < workers; w++) {
+        int c0 = (int)((long)nrhs * w / workers), c1 = (int)((long)nrhs * (w + 1) / workers);
+        if (pipe(pipes[w]) == -1) { mat_log(MAT_LOG_ERROR, "pipe: %s", strerror(errno)); ok = 0; break; }
+        pid_t pid = fork();
+        if (pid == -1) {
+            mat_log(MAT_LOG_ERROR, "fork: %s", strerror(errno));
+            close(pipes[w][0]); close(pipes[w][1]);
+            ok = 0;
+            break;
+        }
+        if (pid == 0) {
+            close(pipes[w][0]);
+            int width = c1 - c0;
+            run_raw(kind, uplo, diag, n, width, T, W + c0, ldw, 0);
+            for (int i = 0; i < n; i++) {
+                memcpy(block + (size_t)i * width, W + (size_t)i * ldw + c0, (size_t)width * sizeof(double));
+            }
+            int sent = write_full(pipes[w][1], block, (size_t)n * width * sizeof(double));
+            close(pipes[w][1]);
+            _exit(sent ? 0 : 1);
+        }
+        pids[w] = pid;
+        close(pipes[w][1]);
+        started++;
+    }
+
+    for (int w = 0; w < started; w++) {
+        int c0 = (int)((long)nrhs * w / workers), c1 = (int)((long)nrhs * (w + 1) / workers);
+        int width = c1 - c0;
+        if (ok && read_full(pipes[w][0], block, (size_t)n * width * sizeof(double))) {
+            for (int i = 0; i < n; i++) {
+                memcpy(W + (size_t)i * ldw + c0, block + (size_t)i * width, (size_t)width * sizeof(double));
+            }
+        } else {
+            ok = 0;
+        }
+        close(pipes[w][0]);
+        waitpid(pids[w], NULL, 0);
+    }
+    free(pipes);
+    free(pids);
+    free(block);
+    return ok;
+}
+
+/* ===== Matrix-level driver ===== */
+
+enum { ENGINE_SINGLE, ENGINE_OPENMP, ENGINE_MULTIPROCESS };
+
+static Matrix *tri_run(TriKind kind, const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                       const char *result_name, double *exec_time, int engine) {
+    if (!a || !b || !result_name) return NULL;
+    int n = a->rows;
+    int inner = op.side == TRI_LEFT ? b->rows : b->cols;
+    if (a->rows != a->cols || inner != n) {
+        mat_log(MAT_LOG_ERROR, "Error: Matrix dimensions incompatible for triangular %s",
+                kind == TRI_SOLVE ? "solve" : "multiply");
+        return NULL;
+    }
+
+    double start = get_time();
+
+    /* X*op(A) = B is op(A)^T * X^T = B^T: the right side flips the transpose */
+    int trans = (op.trans == TRI_TRANS) != (op.side == TRI_RIGHT);
+    TriUplo uplo = trans ? (op.uplo == TRI_LOWER ? TRI_UPPER : TRI_LOWER) : op.uplo;
+
+    double *T = (double *)malloc((size_t)n * n * sizeof(double));
+    if (!T) return NULL;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) T[(size_t)i * n + j] = trans ? mat_get(a, j, i) : mat_get(a, i, j);
+    }
+    if (kind == TRI_SOLVE && op.diag == TRI_NON_UNIT) {
+        for (int i = 0; i < n; i++) {
+            if (T[(size_t)i * n + i] == 0.0) {
+                mat_log(MAT_LOG_ERROR, "Error: Triangular matrix '%s' is singular (zero at [%d][%d])",
+                        a->name, i, i);
+                free(T);
+                return NULL;
+            }
+        }
+    }
+
+    /* Left: X is the row-major n x nrhs work block. Right: X stored
+     * column-major is X^T row-major, the block the transposed problem needs.
+     */
+    Matrix *result = copy_matrix_layout(b, result_name, op.side == TRI_LEFT ? MAT_ROW_MAJOR : MAT_COL_MAJOR);
+    if (!result) { free(T); return NULL; }
+    int nrhs = mat_minor_count(result);
+    double *W = result->data[0];
+    if (alpha != 1.0) {
+        size_t total = (size_t)n * nrhs;
+        for (size_t k = 0; k < total; k++) W[k] *= alpha;
+    }
+
+    int ok = 1;
+    if (engine == ENGINE_MULTIPROCESS) {
+        ok = run_workers(kind, uplo, op.diag, n, nrhs, T, W, nrhs);
+    } else if (engine == ENGINE_OPENMP) {
+        #pragma omp parallel
+        #pragma omp single
+        run_raw(kind, uplo, op.diag, n, nrhs, T, W, nrhs, 1);
+    } else {
+        run_raw(kind, uplo, op.diag, n, nrhs, T, W, nrhs, 0);
+    }
+    free(T);
+    if (!ok) { free_matrix(result); return NULL; }
+
+    if (exec_time) *exec_time = get_time() - start;
+    return result;
+}
+
+Matrix *trsm_single(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time) {
+    return tri_run(TRI_SOLVE, a, b, op, alpha, result_name, exec_time, ENGINE_SINGLE);
+}
+
+Matrix *trsm_openmp(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time) {
+    return tri_run(TRI_SOLVE, a, b, op, alpha, result_name, exec_time, ENGINE_OPENMP);
+}
+
+Matrix *trsm_multiprocess(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                          const char *result_name, double *exec_time) {
+    return tri_run(TRI_SOLVE, a, b, op, alpha, result_name, exec_time, ENGINE_MULTIPROCESS);
+}
+
+Matrix *trmm_single(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time) {
+    return tri_run(TRI_MULTIPLY, a, b, op, alpha, result_name, exec_time, ENGINE_SINGLE);
+}
+
+Matrix *trmm_openmp(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time) {
+    return tri_run(TRI_MULTIPLY, a, b, op, alpha, result_name, exec_time, ENGINE_OPENMP);
+}
+
+Matrix *trmm_multiprocess(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                          const char *result_name, double *exec_time) {
+    return tri_run(TRI_MULTIPLY, a, b, op, alpha, result_name, exec_time, ENGINE_MULTIPROCESS);
+}
@@ -0,0 +1,66 @@
+#ifndef MATRIX_TRSM_H
+#define MATRIX_TRSM_H
+
+#include "matrix_types.h"
+
+/*
+ * Triangular solve (TRSM) and triangular multiply (TRMM) with many
+ * right-hand sides:
+ *
+ *   TRSM  left:  X = alpha * inv(op(A)) * B     right:  X = alpha * B * inv(op(A))
+ *   TRMM  left:  X = alpha * op(A) * B          right:  X = alpha * B * op(A)
+ *
+ * where A is square and triangular and op(A) is A or A^T. Only the triangle
+ * named by uplo is read; with TRI_UNIT the diagonal is taken as 1.
+ *
+ * Every variant is reduced to a left-side, non-transposed problem on a
+ * row-major work block (a right-side problem is the left one on B^T, which
+ * the column-major result layout provides for free). The triangle is split
+ * recursively; the off-diagonal blocks are applied with the recursive GEMM
+ * of matrix_gemm.h, so nearly all flops run in cache-friendly GEMM calls.
+ * The right-hand-side columns are independent: the OpenMP variants split
+ * them into tasks and the multiprocess variants give each worker process a
+ * block of columns.
+ */
+
+typedef enum { TRI_LEFT = 0, TRI_RIGHT } TriSide;
+typedef enum { TRI_LOWER = 0, TRI_UPPER } TriUplo;
+typedef enum { TRI_NO_TRANS = 0, TRI_TRANS } TriTrans;
+typedef enum { TRI_NON_UNIT = 0, TRI_UNIT } TriDiag;
+
+typedef struct {
+    TriSide side;
+    TriUplo uplo;
+    TriTrans trans;
+    TriDiag diag;
+} TriOptions;
+
+/* Raw kernels on row-major buffers: W (n x nrhs) := inv(T) * W or T * W for
+ * the uplo triangle of T (n x n). Callers inside an OpenMP region pass
+ * parallel = 1 to split the work into tasks.
+ */
+void trsm_left_raw(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                   const double *T, int ldt, double *W, int ldw, int parallel);
+void trmm_left_raw(TriUplo uplo, TriDiag diag, int n, int nrhs,
+                   const double *T, int ldt, double *W, int ldw, int parallel);
+
+/* Matrix-level kernels; a and b may use either layout. Return a new matrix
+ * named result_name, or NULL on a dimension mismatch, a zero diagonal
+ * element (TRSM with TRI_NON_UNIT) or resource failure. Right-side results
+ * are column-major.
+ */
+Matrix *trsm_single(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time);
+Matrix *trsm_openmp(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time);
+Matrix *trsm_multiprocess(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                          const char *result_name, double *exec_time);
+
+Matrix *trmm_single(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time);
+Matrix *trmm_openmp(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                    const char *result_name, double *exec_time);
+Matrix *trmm_multiprocess(const Matrix *a, const Matrix *b, TriOptions op, double alpha,
+                          const char *result_name, double *exec_time);
+
+#endif /* MATRIX_TRSM_H */
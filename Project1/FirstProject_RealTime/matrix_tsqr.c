@@ -0,0 +1,459 @@
+#include "matrix_tsqr.h"
+#include "matrix_formats.h"
+#include "matrix_file_ops.h"
+#include "matrix_trsm.h"
+#include "matrix_log.h"
+#include "matrix_resources.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* |R[i][i]| below this fraction of the largest diagonal entry counts as zero */
+#define TSQR_RANK_EPS 1e-12
+
+static double get_time(void) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/* ===== Row sources ===== */
+
+typedef enum { SRC_MEMORY, SRC_NPY, SRC_TEXT } SourceKind;
+
+typedef struct {
+    SourceKind kind;
+    long rows;
+    int w;                      /* columns of [A | B] */
+    const Matrix *a, *b;        /* SRC_MEMORY */
+    int fd;                     /* SRC_NPY */
+    NpyHeader h;
+    FILE *f;                    /* SRC_TEXT, read strictly in order */
+    const char *path;
+    int block;                  /* rows folded in per step, see block_rows() */
+} RowSource;
+
+/* Fill dst (count x w, row-major) with rows [r0, r0 + count) of [A | B] */
+static int source_rows(const RowSource *src, long r0, int count, double *dst) {
+    int w = src->w;
+    if (src->kind == SRC_MEMORY) {
+        int n = src->a->cols;
+        for (int i = 0; i < count; i++) {
+            double *row = dst + (size_t)i * w;
+            for (int j = 0; j < n; j++) row[j] = mat_get(src->a, (int)(r0 + i), j);
+            for (int j = n; j < w; j++) row[j] = mat_get(src->b, (int)(r0 + i), j - n);
+        }
+        return 1;
+    }
+    if (src->kind == SRC_TEXT) {
+        for (size_t k = 0; k < (size_t)count * w; k++) {
+            if (fscanf(src->f, "%lf", &dst[k]) != 1) {
+                mat_log(MAT_LOG_ERROR, "Failed to read row %ld from %s", r0 + (long)(k / w), src->path);
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    /* .npy: read the raw bytes of the block, then convert dtype/byte order */
+    int isz = src->h.itemsize;
+    size_t row_bytes = (size_t)w * isz;
+    unsigned char *raw = (unsigned char *)malloc((size_t)count * row_bytes);
+    if (!raw) return 0;
+    int ok = 1;
+    if (!src->h.fortran_order) {
+        off_t off = (off_t)(src->h.data_offset + (size_t)r0 * row_bytes);
+        ok = pread(src->fd, raw, (size_t)count * row_bytes, off) == (ssize_t)((size_t)count * row_bytes);
+    } else {
+        /* Column j of the block is a contiguous run inside column j of the file */
+        for (int j = 0; ok && j < w; j++) {
+            off_t off = (off_t)(src->h.data_offset + ((size_t)j * src->rows + (size_t)r0) * isz);
+            size_t len = (size_t)count * isz;
+            ok = pread(src->fd, raw + (size_t)j * len, len, off) == (ssize_t)len;
+        }
+    }
+    if (ok) {
+        Matrix block = {0};
+        double *line[1] = { dst };
+        block.rows = count;
+        block.cols = w;
+        block.data = line;
+        block.row_stride = (size_t)w;
+        block.col_stride = 1;
+        NpyHeader bh = src->h;
+        bh.rows = count;
+        npy_convert_data(raw, &bh, &block);
+    } else {
+        mat_log(MAT_LOG_ERROR, "Failed to read rows %ld-%ld from %s", r0, r0 + count - 1, src->path);
+    }
+    free(raw);
+    return ok;
+}
+
+/* ===== Householder reduction ===== */
+
+/* Reduce the m x w row-major block S to R (top min(m, w) rows, zeros below
+ * the diagonal). Q is not kept. Columns are updated row by row so every
+ * pass streams S in storage order.
+ */
+static void householder_r(double *S, int m, int w, double *dots) {
+    int steps = m < w ? m : w;
+    for (int j = 0; j < steps; j++) {
+        double norm2 = 0.0;
+        for (int i = j; i < m; i++) norm2 += S[(size_t)i * w + j] * S[(size_t)i * w + j];
+        if (norm2 == 0.0) continue;
+        double alpha = S[(size_t)j * w + j];
+        double beta = alpha >= 0.0 ? -sqrt(norm2) : sqrt(norm2);
+        double tau = (beta - alpha) / beta;
+        double scale = 1.0 / (alpha - beta);
+
+        /* v = (1, x[j+1..] * scale) is kept in column j while it is needed */
+        for (int i = j + 1; i < m; i++) S[(size_t)i * w + j] *= scale;
+
+        for (int c = j + 1; c < w; c++) dots[c] = S[(size_t)j * w + c];
+        for (int i = j + 1; i < m; i++) {
+            const double *row = S + (size_t)i * w;
+            double v = row[j];
+            #pragma omp simd
+            for (int c = j + 1; c < w; c++) dots[c] += v * row[c];
+        }
+        for (int c = j + 1; c < w; c++) dots[c] *= tau;
+
+        for (int c = j + 1; c < w; c++) S[(size_t)j * w + c] -= dots[c];
+        for (int i = j + 1; i < m; i++) {
+            double *row = S + (size_t)i * w;
+            double v = row[j];
+            #pragma omp simd
+            for (int c = j + 1; c < w; c++) row[c] -= v * dots[c];
+            row[j] = 0.0;
+        }
+        S[(size_t)j * w + j] = beta;
+    }
+}
+
+/* Copy the leading w x w upper triangle of S (m rows) into R */
+static void extract_r(const double *S, int m, int w, double *R) {
+    memset(R, 0, (size_t)w * w * sizeof(double));
+    int top = m < w ? m : w;
+    for (int i = 0; i < top; i++) {
+        memcpy(R + (size_t)i * w + i, S + (size_t)i * w + i, (size_t)(w - i) * sizeof(double));
+    }
+}
+
+/* R of rows [r0, r1), folding src->block rows at a time into a running R */
+static int tsqr_leaf(const RowSource *src, long r0, long r1, double *R) {
+    int w = src->w, block = src->block;
+    double *S = (double *)malloc((size_t)(w + block) * w * sizeof(double));
+    double *dots = (double *)malloc((size_t)w * sizeof(double));
+    if (!S || !dots) { free(S); free(dots); return 0; }
+
+    int have = 0, ok = 1;
+    memset(R, 0, (size_t)w * w * sizeof(double));
+    for (long r = r0; r < r1 && ok; r += block) {
+        int count = (r1 - r < block) ? (int)(r1 - r) : block;
+        int top = have ? w : 0;
+        if (have) memcpy(S, R, (size_t)w * w * sizeof(double));
+        ok = source_rows(src, r, count, S + (size_t)top * w);
+        if (!ok) break;
+        householder_r(S, top + count, w, dots);
+        extract_r(S, top + count, w, R);
+        have = 1;
+    }
+    free(S);
+    free(dots);
+    return ok;
+}
+
+/* R1 := R of [R1; R2] */
+static int tsqr_combine(double *R1, const double *R2, int w) {
+    double *S = (double *)malloc((size_t)2 * w * w * sizeof(double));
+    double *dots = (double *)malloc((size_t)w * sizeof(double));
+    if (!S || !dots) { free(S); free(dots); return 0; }
+    memcpy(S, R1, (size_t)w * w * sizeof(double));
+    memcpy(S + (size_t)w * w, R2, (size_t)w * w * sizeof(double));
+    householder_r(S, 2 * w, w, dots);
+    extract_r(S, 2 * w, w, R1);
+    free(S);
+    free(dots);
+    return 1;
+}
+
+/* ===== Drivers ===== */
+
+static int range_count(long rows, int workers) {
+    long blocks = (rows + TSQR_BLOCK_ROWS - 1) / TSQR_BLOCK_ROWS;
+    if (workers <= 0) workers = resource_budget()->max_workers;
+    if (workers > blocks) workers = (int)blocks;
+    return workers < 1 ? 1 : workers;
+}
+
+static long range_start(long rows, int parts, int p) {
+    return (long)((double)rows * p / parts);
+}
+
+/* R of the whole source into R (w x w) using threads (parallel) or not */
+static int reduce_in_process(const RowSource *src, int parts, int parallel, double *R) {
+    int w = src->w;
+    double *slots = (double *)malloc((size_t)parts * w * w * sizeof(double));
+    if (!slots) return 0;
+    int ok = 1;
+    #pragma omp parallel for schedule(dynamic, 1) reduction(&&:ok) if (parallel)
+    for (int p = 0; p < parts; p++) {
+        ok = tsqr_leaf(src, range_start(src->rows, parts, p), range_start(src->rows, parts, p + 1),
+                       slots + (size_t)p * w * w) && ok;
+    }
+    for (int step = 1; ok && step < parts; step *= 2) {
+        #pragma omp parallel for schedule(dynamic, 1) reduction(&&:ok) if (parallel)
+        for (int p = 0; p < parts - step; p += 2 * step) {
+            ok = tsqr_combine(slots + (size_t)p * w * w, slots + (size_t)(p + step) * w * w, w) && ok;
+        }
+    }
+    if (ok) memcpy(R, slots, (size_t)w * w * sizeof(double));
+    free(slots);
+    return ok;
+}
+
+/* Wait for count children; 1 if every one exited with status 0 */
+static int wait_children(const pid_t *pids, int count) {
+    int ok = 1;
+    for (int i = 0; i < count; i++) {
+        int status = 0;
+        if (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = 0;
+    }
+    return ok;
+}
+
+/* Same reduction with a forked process per range and per tree node. The
+ * slots are a shared anonymous mapping, so children write their R's in
+ * place and the parent (and later tree levels) read them directly.
+ */
+static int reduce_multiprocess(const RowSource *src, int parts, double *R) {
+    int w = src->w;
+    size_t bytes = (size_t)parts * w * w * sizeof(double);
+    double *slots = (double *)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (slots == MAP_FAILED) { mat_log(MAT_LOG_ERROR, "mmap: %s", strerror(errno)); return 0; }
+    pid_t *pids = (pid_t *)malloc((size_t)parts * sizeof(pid_t));
+    if (!pids) { munmap(slots, bytes); return 0; }
+
+    int started = 0;
+    for (int p = 0; p < parts; p++) {
+        pid_t pid = fork();
+        if (pid == -1) { mat_log(MAT_LOG_ERROR, "fork: %s", strerror(errno)); break; }
+        if (pid == 0) {
+            int leaf_ok = tsqr_leaf(src, range_start(src->rows, parts, p), range_start(src->rows, parts, p + 1),
+                                    slots + (size_t)p * w * w);
+            _exit(leaf_ok ? 0 : 1);
+        }
+        pids[started++] = pid;
+    }
+    int ok = wait_children(pids, started) && started == parts;
+
+    for (int step = 1; ok && step < parts; step *= 2) {
+        started = 0;
+        for (int p = 0; p < parts - step; p += 2 * step) {
+            pid_t pid = fork();
+            if (pid == -1) { mat_log(MAT_LOG_ERROR, "fork: %s", strerror(errno)); ok = 0; break; }
+            if (pid == 0) {
+                int node_ok = tsqr_combine(slots + (size_t)p * w * w, slots + (size_t)(p + step) * w * w, w);
+                _exit(node_ok ? 0 : 1);
+            }
+            pids[started++] = pid;
+        }
+        ok = wait_children(pids, started) && ok;
+    }
+
+    if (ok) memcpy(R, slots, (size_t)w * w * sizeof(double));
+    free(pids);
+    munmap(slots, bytes);
+    return ok;
+}
+
+/* Solution, factor and residuals from the R of [A | B] */
+static LstsqResult *finish(const double *R, int n, int nrhs, long rows) {
+    int w = n + nrhs;
+    LstsqResult *res = (LstsqResult *)calloc(1, sizeof(LstsqResult));
+    if (!res) return NULL;
+    res->n = n;
+    res->nrhs = nrhs;
+    res->rows = rows;
+    res->r = create_matrix("R", n, n);
+    res->residual_norm = (double *)calloc((size_t)nrhs, sizeof(double));
+    if (!res->r || !res->residual_norm) { free_lstsq_result(res); return NULL; }
+
+    double dmax = 0.0;
+    for (int i = 0; i < n; i++) {
+        memcpy(res->r->data[i] + i, R + (size_t)i * w + i, (size_t)(n - i) * sizeof(double));
+        if (fabs(R[(size_t)i * w + i]) > dmax) dmax = fabs(R[(size_t)i * w + i]);
+    }
+    for (int i = 0; i < n; i++) {
+        if (!(fabs(R[(size_t)i * w + i]) > TSQR_RANK_EPS * dmax)) res->rank_deficient = 1;
+    }
+
+    /* Rows n..w-1 of the B columns are Q^T B below R: the residual part */
+    for (int j = 0; j < nrhs; j++) {
+        double s = 0.0;
+        for (int i = n; i <= n + j; i++) s += R[(size_t)i * w + n + j] * R[(size_t)i * w + n + j];
+        res->residual_norm[j] = sqrt(s);
+    }
+
+    if (res->rank_deficient) {
+        mat_log(MAT_LOG_WARN, "Least squares: A is rank deficient, no unique solution");
+        return res;
+    }
+    res->x = create_matrix("X", n, nrhs);
+    if (!res->x) { free_lstsq_result(res); return NULL; }
+    for (int i = 0; i < n; i++) memcpy(res->x->data[i], R + (size_t)i * w + n, (size_t)nrhs * sizeof(double));
+    trsm_left_raw(TRI_UPPER, TRI_NON_UNIT, n, nrhs, R, w, res->x->data[0], nrhs, 0);
+    return res;
+}
+
+enum { ENGINE_SINGLE, ENGINE_OPENMP, ENGINE_MULTIPROCESS };
+
+/* Rows per leaf block: TSQR_BLOCK_ROWS, or fewer when the parts' block
+ * buffers ((w + block) x w each) would take more than a quarter of the
+ * memory budget (matrix_resources.h)
+ */
+static int block_rows(int w, int parts) {
+    unsigned long long share = resource_budget()->memory_budget / 4 / (unsigned long long)parts;
+    unsigned long long fit = share / ((unsigned long long)w * sizeof(double));
+    long block = fit > (unsigned long long)w ? (long)(fit - (unsigned long long)w) : 0;
+    if (block > TSQR_BLOCK_ROWS) block = TSQR_BLOCK_ROWS;
+    if (block < TSQR_MIN_BLOCK_ROWS) block = TSQR_MIN_BLOCK_ROWS;
+    return (int)block;
+}
+
+static LstsqResult *solve_source(RowSource *src, int n, int engine, int workers, double *exec_time) {
+    double start = get_time();
+    int w = src->w;
+    double *R = (double *)malloc((size_t)w * w * sizeof(double));
+    if (!R) return NULL;
+
+    int parts = engine == ENGINE_SINGLE ? 1 : range_count(src->rows, workers);
+    src->block = block_rows(w, parts);
+    int ok;
+    if (engine == ENGINE_MULTIPROCESS) {
+        ok = reduce_multiprocess(src, parts, R);
+    } else {
+        ok = reduce_in_process(src, parts, engine == ENGINE_OPENMP, R);
+    }
+    LstsqResult *res = ok ? finish(R, n, w - n, src->rows) : NULL;
+    free(R);
+    if (res && exec_time) *exec_time = get_time() - start;
+    return res;
+}
+
+static int check_shapes(long rows, int n, int nrhs) {
+    if (n <= 0 || nrhs <= 0) {
+        mat_log(MAT_LOG_ERROR, "Error: least squares needs at least one unknown and one right-hand side");
+        return 0;
+    }
+    if (rows < n) {
+        mat_log(MAT_LOG_ERROR, "Error: least squares needs at least as many rows (%ld) as unknowns (%d)", rows, n);
+        return 0;
+    }
+    return 1;
+}
+
+static LstsqResult *solve_memory(const Matrix *a, const Matrix *b, int engine, int workers, double *exec_time) {
+    if (!a || !b) return NULL;
+    if (a->rows != b->rows) {
+        mat_log(MAT_LOG_ERROR, "Error: A and B must have the same number of rows");
+        return NULL;
+    }
+    if (!check_shapes(a->rows, a->cols, b->cols)) return NULL;
+    RowSource src = {0};
+    src.kind = SRC_MEMORY;
+    src.rows = a->rows;
+    src.w = a->cols + b->cols;
+    src.a = a;
+    src.b = b;
+    return solve_source(&src, a->cols, engine, workers, exec_time);
+}
+
+LstsqResult *lstsq_tsqr_single(const Matrix *a, const Matrix *b, double *exec_time) {
+    return solve_memory(a, b, ENGINE_SINGLE, 1, exec_time);
+}
+
+LstsqResult *lstsq_tsqr_openmp(const Matrix *a, const Matrix *b, double *exec_time) {
+    return solve_memory(a, b, ENGINE_OPENMP, 0, exec_time);
+}
+
+LstsqResult *lstsq_tsqr_multiprocess(const Matrix *a, const Matrix *b, int workers, double *exec_time) {
+    return solve_memory(a, b, ENGINE_MULTIPROCESS, workers, exec_time);
+}
+
+/* Open a .npy source: header parsed, rows read later with pread */
+static int open_npy_source(const char *filepath, RowSource *src) {
+    src->fd = open(filepath, O_RDONLY);
+    if (src->fd < 0) { mat_log(MAT_LOG_ERROR, "open: %s", strerror(errno)); return 0; }
+    unsigned char pre[NPY_PREAMBLE_LEN];
+    size_t hstart, hlen;
+    if (pread(src->fd, pre, sizeof(pre), 0) != (ssize_t)sizeof(pre) ||
+        memcmp(pre, NPY_MAGIC, NPY_MAGIC_LEN) != 0 || !npy_header_extent(pre, &hstart, &hlen)) {
+        mat_log(MAT_LOG_ERROR, "'%s' is not a supported .npy file", filepath);
+        return 0;
+    }
+    char *hdr = (char *)malloc(hlen + 1);
+    if (!hdr || pread(src->fd, hdr, hlen, (off_t)hstart) != (ssize_t)hlen) {
+        mat_log(MAT_LOG_ERROR, "Truncated .npy header in %s", filepath);
+        free(hdr);
+        return 0;
+    }
+    hdr[hlen] = '\0';
+    int ok = npy_parse_header(hdr, &src->h);
+    free(hdr);
+    if (!ok) {
+        mat_log(MAT_LOG_ERROR, "Unsupported .npy dtype/shape in %s (need 1-D/2-D f4 or f8)", filepath);
+        return 0;
+    }
+    src->h.data_offset = hstart + hlen;
+    src->rows = src->h.rows;
+    src->w = src->h.cols;
+    return 1;
+}
+
+static int open_text_source(const char *filepath, RowSource *src) {
+    src->f = fopen(filepath, "r");
+    if (!src->f) { mat_log(MAT_LOG_ERROR, "fopen: %s", strerror(errno)); return 0; }
+    char name[MAX_NAME_LENGTH];
+    int rows, cols;
+    if (fscanf(src->f, "%63s", name) != 1 || fscanf(src->f, "%d %d", &rows, &cols) != 2 ||
+        rows <= 0 || cols <= 0) {
+        mat_log(MAT_LOG_ERROR, "Invalid matrix header in %s", filepath);
+        return 0;
+    }
+    src->rows = rows;
+    src->w = cols;
+    return 1;
+}
+
+LstsqResult *lstsq_tsqr_file(const char *filepath, int nrhs, int workers, double *exec_time) {
+    if (!filepath) return NULL;
+    RowSource src = {0};
+    src.fd = -1;
+    src.path = filepath;
+    int is_npy = matrix_path_has_ext(filepath, ".npy");
+    src.kind = is_npy ? SRC_NPY : SRC_TEXT;
+
+    LstsqResult *res = NULL;
+    int opened = is_npy ? open_npy_source(filepath, &src) : open_text_source(filepath, &src);
+    if (opened && check_shapes(src.rows, src.w - nrhs, nrhs)) {
+        res = is_npy ? solve_source(&src, src.w - nrhs, ENGINE_MULTIPROCESS, workers, exec_time)
+                     : solve_source(&src, src.w - nrhs, ENGINE_SINGLE, 1, exec_time);
+    }
+    if (src.fd >= 0) close(src.fd);
+    if (src.f) fclose(src.f);
+    return res;
+}
+
+void free_lstsq_result(LstsqResult *res) {
+    if (!res) return;
+    free_matrix(res->x);
+    free_matrix(res->r);
+    free(res->residual_norm);
+    free(res);
+}
@@ -0,0 +1,53 @@
+#ifndef MATRIX_TSQR_H
+#define MATRIX_TSQR_H
+
+#include "matrix_types.h"
+
+/*
+ * Least squares min ||A X - B|| for tall matrices by TSQR (tall-skinny QR).
+ *
+ * The rows of [A | B] are cut into ranges. Each range is reduced to the
+ * (n + nrhs) x (n + nrhs) triangular R of its QR factorization, reading the
+ * rows in blocks of at most TSQR_BLOCK_ROWS (fewer if the memory budget of
+ * matrix_resources.h is tight) so that only one block plus one R is in
+ * memory at a time. The range results are then combined pairwise in a
+ * binary reduction tree (QR of two stacked R's). Q is never formed: the
+ * R of the augmented matrix holds R_A, Q^T B and the residual norms, and
+ * X follows from one triangular solve.
+ *
+ * The multiprocess variant runs each range in a forked worker and each tree
+ * node in a forked child; the R's live in a shared anonymous mapping, so
+ * only w*w doubles per worker ever cross process boundaries.
+ */
+
+#define TSQR_BLOCK_ROWS 1024
+#define TSQR_MIN_BLOCK_ROWS 64
+
+typedef struct {
+    int n;                  /* unknowns (columns of A) */
+    int nrhs;               /* right-hand sides (columns of B) */
+    long rows;              /* rows of A that were reduced */
+    Matrix *x;              /* n x nrhs solution, NULL if rank_deficient */
+    Matrix *r;              /* n x n upper-triangular factor of A */
+    double *residual_norm;  /* ||A x_j - b_j|| for each right-hand side */
+    int rank_deficient;     /* some |R[i][i]| is negligible; no solution returned */
+} LstsqResult;
+
+void free_lstsq_result(LstsqResult *res);
+
+/* In-memory problems; a is m x n with m >= n, b is m x nrhs, either layout.
+ * Return NULL on a shape mismatch or resource failure.
+ */
+LstsqResult *lstsq_tsqr_single(const Matrix *a, const Matrix *b, double *exec_time);
+LstsqResult *lstsq_tsqr_openmp(const Matrix *a, const Matrix *b, double *exec_time);
+/* workers <= 0 uses resource_budget()->max_workers (matrix_resources.h) */
+LstsqResult *lstsq_tsqr_multiprocess(const Matrix *a, const Matrix *b, int workers, double *exec_time);
+
+/* Streamed from a file holding [A | B] (the last nrhs columns are B) in the
+ * text format of matrix_file_ops.h or as .npy. A .npy file is split among
+ * worker processes that each read their own row range; a text file can only
+ * be read front to back and is folded block by block in this process.
+ */
+LstsqResult *lstsq_tsqr_file(const char *filepath, int nrhs, int workers, double *exec_time);
+
+#endif /* MATRIX_TSQR_H */
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 /* Shared header for matrix data structures and operations
  * Used by both menu_demo.c and matrix_file_ops.c to stay synchronized
@@ -11,24 +12,147 @@
 
 #define MAX_NAME_LENGTH 64
 
-/* Matrix structure */
+/* Storage order of the contiguous block */
+typedef enum {
+    MAT_ROW_MAJOR = 0,
+    MAT_COL_MAJOR
+} MatrixLayout;
+
+/* Matrix structure
+ * All elements live in one contiguous block starting at data[0]; element
+ * (i, j) is at data[0][i * row_stride + j * col_stride]. data[k] points at
+ * the k-th major line: row k for MAT_ROW_MAJOR (so data[i][j] is element
+ * (i, j)), column k for MAT_COL_MAJOR (data[j][i]). Code that does not
+ * check the layout must go through mat_at()/mat_get().
+ * The block is heap-allocated, or an mmapped file region when mapping != NULL
+ * (zero-copy .npy loads, see matrix_formats.c).
+ */
 typedef struct {
     char name[MAX_NAME_LENGTH];
     int rows;
     int cols;
     double **data;
+    void *mapping;
+    size_t mapping_len;
+    MatrixLayout layout;
+    size_t row_stride;      /* distance from (i, j) to (i + 1, j) */
+    size_t col_stride;      /* distance from (i, j) to (i, j + 1) */
 } Matrix;
 
-/* Collection of matrices */
+static inline double *mat_at(const Matrix *m, int i, int j) {
+    return m->data[0] + (size_t)i * m->row_stride + (size_t)j * m->col_stride;
+}
+
+static inline double mat_get(const Matrix *m, int i, int j) {
+    return *mat_at(m, i, j);
+}
+
+/* Number of data[] lines and their length */
+static inline int mat_major_count(const Matrix *m) {
+    return m->layout == MAT_COL_MAJOR ? m->cols : m->rows;
+}
+
+static inline int mat_minor_count(const Matrix *m) {
+    return m->layout == MAT_COL_MAJOR ? m->rows : m->cols;
+}
+
+/* Complex (complex128) matrix
+ * Row-major, each element an interleaved (re, im) pair of doubles: the
+ * layout of a C99 double complex array and of NumPy complex128. Element
+ * (i, j) is v[2 * (i * cols + j)] (real) and the next double (imaginary).
+ * Kernels and file I/O are in matrix_complex.h.
+ */
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    double *v;              /* 2 * rows * cols doubles */
+} ComplexMatrix;
+
+/* Toeplitz matrix: T(i, j) = col[i - j] for i >= j, row[j - i] for j > i,
+ * so the first column and the first row describe all rows x cols entries
+ * (row[0] == col[0]). A circulant is the square Toeplitz matrix with
+ * C(i, j) = col[(i - j) mod n]; its row is filled in from col. Kernels and
+ * file I/O are in matrix_toeplitz.h.
+ */
+typedef enum {
+    STRUCTURE_TOEPLITZ = 0,
+    STRUCTURE_CIRCULANT
+} StructureKind;
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    StructureKind kind;
+    double *col;            /* first column, rows values */
+    double *row;            /* first row, cols values */
+} ToeplitzMatrix;
+
+/* Integer matrix: int32 or int64 elements, row-major in one contiguous
+ * block. Exact kernels and file I/O are in matrix_int.h.
+ */
+typedef enum {
+    INT_ELEM_I32,
+    INT_ELEM_I64
+} IntElemType;
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    int rows;
+    int cols;
+    IntElemType type;
+    union {
+        int32_t *i32;
+        int64_t *i64;
+    } v;                 /* rows * cols elements, row-major */
+} IntMatrix;
+
+/* Collection of matrices
+ * Complex, Toeplitz and integer matrices are kept in their own lists; a
+ * name is used at most once across all lists.
+ */
 typedef struct {
     Matrix **items;
     int count;
     int capacity;
+    ComplexMatrix **complex_items;
+    int complex_count;
+    int complex_capacity;
+    ToeplitzMatrix **toeplitz_items;
+    int toeplitz_count;
+    int toeplitz_capacity;
+    IntMatrix **int_items;
+    int int_count;
+    int int_capacity;
 } MatrixCollection;
 
 /* ===== Matrix lifecycle functions ===== */
 Matrix *create_matrix(const char *name, int rows, int cols);
+Matrix *create_matrix_layout(const char *name, int rows, int cols, MatrixLayout layout);
+/* Wrap rows*cols doubles at base (inside an mmapped region) without copying;
+ * free_matrix() unmaps the region.
+ */
+Matrix *create_matrix_mapped(const char *name, int rows, int cols, MatrixLayout layout,
+                             double *base, void *mapping, size_t mapping_len);
 void free_matrix(Matrix *m);
+/* All-zero rows x cols complex matrix */
+ComplexMatrix *create_complex_matrix(const char *name, int rows, int cols);
+void free_complex_matrix(ComplexMatrix *m);
+/* rows x cols Toeplitz (or n x n circulant) matrix with zero col and row */
+ToeplitzMatrix *create_toeplitz_matrix(const char *name, int rows, int cols, StructureKind kind);
+void free_toeplitz_matrix(ToeplitzMatrix *t);
+/* All-zero rows x cols integer matrix (defined in matrix_int.c) */
+IntMatrix *create_int_matrix(const char *name, int rows, int cols, IntElemType type);
+void free_int_matrix(IntMatrix *m);
+
+/* ===== Layout ===== */
+/* Transpose in place in O(1): swaps the dimensions and strides and flips the
+ * layout flag; no element moves.
+ */
+void transpose_matrix(Matrix *m);
+/* New matrix with m's elements stored in the given layout (O(rows*cols)) */
+Matrix *copy_matrix_layout(const Matrix *m, const char *name, MatrixLayout layout);
 
 /* ===== Collection management ===== */
 MatrixCollection *create_collection(void);
@@ -36,6 +160,23 @@ void free_collection(MatrixCollection *c);
 Matrix *find_matrix(MatrixCollection *c, const char *name);
 int add_matrix(MatrixCollection *c, Matrix *m);
 int remove_matrix(MatrixCollection *c, const char *name);
+/* Add m, or if a matrix with the same name exists, move m's contents into it
+ * (so pointers to the existing Matrix stay valid) and free m.
+ * Returns: 1 if added, 2 if replaced, 0 on failure
+ */
+int replace_matrix(MatrixCollection *c, Matrix *m);
+ComplexMatrix *find_complex_matrix(MatrixCollection *c, const char *name);
+/* Returns: 1 if added, 0 if the name is taken (in any list) or on failure */
+int add_complex_matrix(MatrixCollection *c, ComplexMatrix *m);
+int remove_complex_matrix(MatrixCollection *c, const char *name);
+ToeplitzMatrix *find_toeplitz_matrix(MatrixCollection *c, const char *name);
+/* Returns: 1 if added, 0 if the name is taken (in any list) or on failure */
+int add_toeplitz_matrix(MatrixCollection *c, ToeplitzMatrix *t);
+int remove_toeplitz_matrix(MatrixCollection *c, const char *name);
+IntMatrix *find_int_matrix(MatrixCollection *c, const char *name);
+/* Returns: 1 if added, 0 if the name is taken (in any list) or on failure */
+int add_int_matrix(MatrixCollection *c, IntMatrix *m);
+int remove_int_matrix(MatrixCollection *c, const char *name);
 
 /* ===== Display functions ===== */
 void display_matrix(const Matrix *m);
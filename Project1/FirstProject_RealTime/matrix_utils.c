@@ -1,12 +1,14 @@
 #include "matrix_types.h"
+#include "matrix_render.h"
 #include <ctype.h>
+#include <sys/mman.h>
 
 /* 
  * Implementation of shared matrix functions
  * Used by both menu_demo.c and matrix_file_ops.c
  */
 
-Matrix *create_matrix(const char *name, int rows, int cols) {
+static Matrix *alloc_matrix_header(const char *name, int rows, int cols, MatrixLayout layout) {
     if (rows <= 0 || cols <= 0) return NULL;
     Matrix *m = (Matrix*)calloc(1, sizeof(Matrix));
     if (!m) return NULL;
@@ -16,27 +18,132 @@ Matrix *create_matrix(const char *name, int rows, int cols) {
     }
     m->rows = rows;
     m->cols = cols;
-    m->data = (double**)calloc(rows, sizeof(double*));
+    m->layout = layout;
+    m->row_stride = layout == MAT_COL_MAJOR ? 1 : (size_t)cols;
+    m->col_stride = layout == MAT_COL_MAJOR ? (size_t)rows : 1;
+    m->data = (double**)calloc(mat_major_count(m), sizeof(double*));
     if (!m->data) { free(m); return NULL; }
-    for (int i = 0; i < rows; i++) {
-        m->data[i] = (double*)calloc(cols, sizeof(double));
-        if (!m->data[i]) {
-            for (int k = 0; k < i; k++) free(m->data[k]);
-            free(m->data); free(m); return NULL;
+    return m;
+}
+
+static void point_major_lines(Matrix *m, double *base) {
+    int major = mat_major_count(m), minor = mat_minor_count(m);
+    for (int k = 0; k < major; k++) m->data[k] = base + (size_t)k * minor;
+}
+
+Matrix *create_matrix_layout(const char *name, int rows, int cols, MatrixLayout layout) {
+    Matrix *m = alloc_matrix_header(name, rows, cols, layout);
+    if (!m) return NULL;
+    double *block = (double*)calloc((size_t)rows * (size_t)cols, sizeof(double));
+    if (!block) { free(m->data); free(m); return NULL; }
+    point_major_lines(m, block);
+    return m;
+}
+
+Matrix *create_matrix(const char *name, int rows, int cols) {
+    return create_matrix_layout(name, rows, cols, MAT_ROW_MAJOR);
+}
+
+Matrix *create_matrix_mapped(const char *name, int rows, int cols, MatrixLayout layout,
+                             double *base, void *mapping, size_t mapping_len) {
+    if (!base || !mapping) return NULL;
+    Matrix *m = alloc_matrix_header(name, rows, cols, layout);
+    if (!m) return NULL;
+    point_major_lines(m, base);
+    m->mapping = mapping;
+    m->mapping_len = mapping_len;
+    return m;
+}
+
+void transpose_matrix(Matrix *m) {
+    if (!m) return;
+    /* data[k] was line k of m and stays line k of the transpose: rows become columns */
+    int t = m->rows; m->rows = m->cols; m->cols = t;
+    size_t s = m->row_stride; m->row_stride = m->col_stride; m->col_stride = s;
+    m->layout = m->layout == MAT_COL_MAJOR ? MAT_ROW_MAJOR : MAT_COL_MAJOR;
+}
+
+Matrix *copy_matrix_layout(const Matrix *m, const char *name, MatrixLayout layout) {
+    if (!m) return NULL;
+    Matrix *r = create_matrix_layout(name ? name : m->name, m->rows, m->cols, layout);
+    if (!r) return NULL;
+    if (m->layout == layout) {
+        memcpy(r->data[0], m->data[0], (size_t)m->rows * m->cols * sizeof(double));
+        return r;
+    }
+    /* Blocked so that both the reads and the writes stay within a few lines */
+    const int B = 32;
+    int major = mat_major_count(r), minor = mat_minor_count(r);
+    #pragma omp parallel for schedule(static) if ((long)m->rows * m->cols > 65536)
+    for (int k0 = 0; k0 < major; k0 += B) {
+        int k1 = k0 + B < major ? k0 + B : major;
+        for (int l0 = 0; l0 < minor; l0 += B) {
+            int l1 = l0 + B < minor ? l0 + B : minor;
+            for (int k = k0; k < k1; k++) {
+                for (int l = l0; l < l1; l++) r->data[k][l] = m->data[l][k];
+            }
         }
     }
-    return m;
+    return r;
 }
 
 void free_matrix(Matrix *m) {
     if (!m) return;
-    if (m->data) {
-        for (int i = 0; i < m->rows; i++) free(m->data[i]);
-        free(m->data);
+    if (m->mapping) {
+        munmap(m->mapping, m->mapping_len);
+    } else if (m->data) {
+        free(m->data[0]);
     }
+    free(m->data);
     free(m);
 }
 
+ComplexMatrix *create_complex_matrix(const char *name, int rows, int cols) {
+    if (rows <= 0 || cols <= 0) return NULL;
+    ComplexMatrix *m = (ComplexMatrix*)calloc(1, sizeof(ComplexMatrix));
+    if (!m) return NULL;
+    if (name) {
+        strncpy(m->name, name, MAX_NAME_LENGTH - 1);
+        m->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    m->rows = rows;
+    m->cols = cols;
+    m->v = (double*)calloc(2 * (size_t)rows * (size_t)cols, sizeof(double));
+    if (!m->v) { free(m); return NULL; }
+    return m;
+}
+
+void free_complex_matrix(ComplexMatrix *m) {
+    if (!m) return;
+    free(m->v);
+    free(m);
+}
+
+ToeplitzMatrix *create_toeplitz_matrix(const char *name, int rows, int cols, StructureKind kind) {
+    if (rows <= 0 || cols <= 0) return NULL;
+    if (kind == STRUCTURE_CIRCULANT && rows != cols) return NULL;
+    ToeplitzMatrix *t = (ToeplitzMatrix*)calloc(1, sizeof(ToeplitzMatrix));
+    if (!t) return NULL;
+    if (name) {
+        strncpy(t->name, name, MAX_NAME_LENGTH - 1);
+        t->name[MAX_NAME_LENGTH - 1] = '\0';
+    }
+    t->rows = rows;
+    t->cols = cols;
+    t->kind = kind;
+    t->col = (double*)calloc((size_t)rows, sizeof(double));
+    t->row = (double*)calloc((size_t)cols, sizeof(double));
+    if (!t->col || !t->row) { free_toeplitz_matrix(t); return NULL; }
+    return t;
+}
+
+void free_toeplitz_matrix(ToeplitzMatrix *t) {
+    if (!t) return;
+    free(t->col);
+    free(t->row);
+    free(t);
+}
+
 MatrixCollection *create_collection(void) {
     MatrixCollection *c = (MatrixCollection*)calloc(1, sizeof(MatrixCollection));
     if (!c) return NULL;
@@ -50,9 +157,21 @@ void free_collection(MatrixCollection *c) {
     if (!c) return;
     for (int i = 0; i < c->count; i++) free_matrix(c->items[i]);
     free(c->items);
+    for (int i = 0; i < c->complex_count; i++) free_complex_matrix(c->complex_items[i]);
+    free(c->complex_items);
+    for (int i = 0; i < c->toeplitz_count; i++) free_toeplitz_matrix(c->toeplitz_items[i]);
+    free(c->toeplitz_items);
+    for (int i = 0; i < c->int_count; i++) free_int_matrix(c->int_items[i]);
+    free(c->int_items);
     free(c);
 }
 
+/* Names are unique across the dense, complex, Toeplitz and integer lists */
+static int name_taken(MatrixCollection *c, const char *name) {
+    return find_matrix(c, name) || find_complex_matrix(c, name) || find_toeplitz_matrix(c, name) ||
+           find_int_matrix(c, name);
+}
+
 Matrix *find_matrix(MatrixCollection *c, const char *name) {
     if (!c || !name) return NULL;
     for (int i = 0; i < c->count; i++) {
@@ -63,7 +182,7 @@ Matrix *find_matrix(MatrixCollection *c, const char *name) {
 
 int add_matrix(MatrixCollection *c, Matrix *m) {
     if (!c || !m) return 0;
-    if (find_matrix(c, m->name)) return 0; // duplicate
+    if (name_taken(c, m->name)) return 0; // duplicate
     if (c->count >= c->capacity) {
         int newcap = c->capacity * 2;
         Matrix **tmp = (Matrix**)realloc(c->items, newcap * sizeof(Matrix*));
@@ -75,6 +194,33 @@ int add_matrix(MatrixCollection *c, Matrix *m) {
     return 1;
 }
 
+int replace_matrix(MatrixCollection *c, Matrix *m) {
+    if (!c || !m) return 0;
+    Matrix *old = find_matrix(c, m->name);
+    if (!old) return add_matrix(c, m);
+
+    /* Swap storage so free_matrix(m) releases the old contents */
+    Matrix tmp = *old;
+    old->rows = m->rows;
+    old->cols = m->cols;
+    old->data = m->data;
+    old->mapping = m->mapping;
+    old->mapping_len = m->mapping_len;
+    old->layout = m->layout;
+    old->row_stride = m->row_stride;
+    old->col_stride = m->col_stride;
+    m->rows = tmp.rows;
+    m->cols = tmp.cols;
+    m->data = tmp.data;
+    m->mapping = tmp.mapping;
+    m->mapping_len = tmp.mapping_len;
+    m->layout = tmp.layout;
+    m->row_stride = tmp.row_stride;
+    m->col_stride = tmp.col_stride;
+    free_matrix(m);
+    return 2;
+}
+
 int remove_matrix(MatrixCollection *c, const char *name) {
     if (!c || !name) return 0;
     for (int i = 0; i < c->count; i++) {
@@ -88,17 +234,112 @@ int remove_matrix(MatrixCollection *c, const char *name) {
     return 0;
 }
 
-void display_matrix(const Matrix *m) {
-    if (!m) { puts("Matrix not found."); return; }
-    printf("\n========================================\n");
-    printf("Matrix: %s\n", m->name);
-    printf("Dimensions: %d x %d\n", m->rows, m->cols);
-    printf("========================================\n");
-    for (int i = 0; i < m->rows; i++) {
-        for (int j = 0; j < m->cols; j++) {
-            printf("%10.4f ", m->data[i][j]);
+ComplexMatrix *find_complex_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return NULL;
+    for (int i = 0; i < c->complex_count; i++) {
+        if (strcmp(c->complex_items[i]->name, name) == 0) return c->complex_items[i];
+    }
+    return NULL;
+}
+
+int add_complex_matrix(MatrixCollection *c, ComplexMatrix *m) {
+    if (!c || !m) return 0;
+    if (name_taken(c, m->name)) return 0; // duplicate
+    if (c->complex_count >= c->complex_capacity) {
+        int newcap = c->complex_capacity ? c->complex_capacity * 2 : 8;
+        ComplexMatrix **tmp = (ComplexMatrix**)realloc(c->complex_items, newcap * sizeof(ComplexMatrix*));
+        if (!tmp) return 0;
+        c->complex_items = tmp;
+        c->complex_capacity = newcap;
+    }
+    c->complex_items[c->complex_count++] = m;
+    return 1;
+}
+
+int remove_complex_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return 0;
+    for (int i = 0; i < c->complex_count; i++) {
+        if (strcmp(c->complex_items[i]->name, name) == 0) {
+            free_complex_matrix(c->complex_items[i]);
+            for (int j = i + 1; j < c->complex_count; j++) c->complex_items[j-1] = c->complex_items[j];
+            c->complex_count--;
+            return 1;
         }
-        printf("\n");
     }
-    printf("========================================\n\n");
+    return 0;
+}
+
+ToeplitzMatrix *find_toeplitz_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return NULL;
+    for (int i = 0; i < c->toeplitz_count; i++) {
+        if (strcmp(c->toeplitz_items[i]->name, name) == 0) return c->toeplitz_items[i];
+    }
+    return NULL;
+}
+
+int add_toeplitz_matrix(MatrixCollection *c, ToeplitzMatrix *t) {
+    if (!c || !t) return 0;
+    if (name_taken(c, t->name)) return 0; // duplicate
+    if (c->toeplitz_count >= c->toeplitz_capacity) {
+        int newcap = c->toeplitz_capacity ? c->toeplitz_capacity * 2 : 8;
+        ToeplitzMatrix **tmp = (ToeplitzMatrix**)realloc(c->toeplitz_items, newcap * sizeof(ToeplitzMatrix*));
+        if (!tmp) return 0;
+        c->toeplitz_items = tmp;
+        c->toeplitz_capacity = newcap;
+    }
+    c->toeplitz_items[c->toeplitz_count++] = t;
+    return 1;
+}
+
+int remove_toeplitz_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return 0;
+    for (int i = 0; i < c->toeplitz_count; i++) {
+        if (strcmp(c->toeplitz_items[i]->name, name) == 0) {
+            free_toeplitz_matrix(c->toeplitz_items[i]);
+            for (int j = i + 1; j < c->toeplitz_count; j++) c->toeplitz_items[j-1] = c->toeplitz_items[j];
+            c->toeplitz_count--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+IntMatrix *find_int_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return NULL;
+    for (int i = 0; i < c->int_count; i++) {
+        if (strcmp(c->int_items[i]->name, name) == 0) return c->int_items[i];
+    }
+    return NULL;
+}
+
+int add_int_matrix(MatrixCollection *c, IntMatrix *m) {
+    if (!c || !m) return 0;
+    if (name_taken(c, m->name)) return 0; // duplicate
+    if (c->int_count >= c->int_capacity) {
+        int newcap = c->int_capacity ? c->int_capacity * 2 : 8;
+        IntMatrix **tmp = (IntMatrix**)realloc(c->int_items, newcap * sizeof(IntMatrix*));
+        if (!tmp) return 0;
+        c->int_items = tmp;
+        c->int_capacity = newcap;
+    }
+    c->int_items[c->int_count++] = m;
+    return 1;
+}
+
+int remove_int_matrix(MatrixCollection *c, const char *name) {
+    if (!c || !name) return 0;
+    for (int i = 0; i < c->int_count; i++) {
+        if (strcmp(c->int_items[i]->name, name) == 0) {
+            free_int_matrix(c->int_items[i]);
+            for (int j = i + 1; j < c->int_count; j++) c->int_items[j-1] = c->int_items[j];
+            c->int_count--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void display_matrix(const Matrix *m) {
+    if (!m) { puts("Matrix not found."); return; }
+    render_matrix_summary(stdout, m, NULL);
 }
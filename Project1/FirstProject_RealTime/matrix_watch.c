@@ -0,0 +1,336 @@
+#include "matrix_watch.h"
+#include "matrix_file_ops.h"
+#include "matrix_formats.h"
+#include "matrix_complex.h"
+#include "matrix_toeplitz.h"
+#include "matrix_int.h"
+#include "matrix_log.h"
+#include <errno.h>
+#include <limits.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <string.h>
+
+#define WATCH_EVENTS (IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | \
+                      IN_DELETE_SELF | IN_MOVE_SELF)
+
+/* Folder path plus one entry name */
+#define WATCH_PATH_LEN (PATH_MAX + NAME_MAX + 2)
+
+/* File in the folder and the matrix it provides */
+typedef struct {
+    char file[NAME_MAX + 1];
+    char name[MAX_NAME_LENGTH];
+} WatchedFile;
+
+/* Collection list a file's matrix belongs to, from its text tag */
+typedef enum {
+    WATCH_DENSE,
+    WATCH_COMPLEX,
+    WATCH_TOEPLITZ,
+    WATCH_INT
+} WatchKind;
+
+/* File named by one or more events since the last poll */
+typedef struct {
+    char file[NAME_MAX + 1];
+    int deleted;
+    WatchKind kind;
+    void *loaded;        /* Matrix, ComplexMatrix, ToeplitzMatrix or IntMatrix */
+    char name[MAX_NAME_LENGTH];
+} PendingFile;
+
+struct FolderWatch {
+    int fd;
+    int wd;
+    char folder[PATH_MAX];
+    WatchedFile *files;
+    int count;
+    int capacity;
+};
+
+static int is_matrix_file(const char *file) {
+    return matrix_path_has_ext(file, ".txt") || matrix_path_has_ext(file, ".npy") ||
+           matrix_path_has_ext(file, ".mtx");
+}
+
+static WatchedFile *find_file(FolderWatch *w, const char *file) {
+    for (int i = 0; i < w->count; i++) {
+        if (strcmp(w->files[i].file, file) == 0) return &w->files[i];
+    }
+    return NULL;
+}
+
+static void set_file(FolderWatch *w, const char *file, const char *name) {
+    WatchedFile *f = find_file(w, file);
+    if (!f) {
+        if (w->count >= w->capacity) {
+            int newcap = w->capacity ? w->capacity * 2 : 16;
+            WatchedFile *tmp = (WatchedFile*)realloc(w->files, newcap * sizeof(WatchedFile));
+            if (!tmp) return;
+            w->files = tmp;
+            w->capacity = newcap;
+        }
+        f = &w->files[w->count++];
+        strncpy(f->file, file, NAME_MAX);
+        f->file[NAME_MAX] = '\0';
+    }
+    strncpy(f->name, name, MAX_NAME_LENGTH - 1);
+    f->name[MAX_NAME_LENGTH - 1] = '\0';
+}
+
+static void drop_file(FolderWatch *w, const char *file) {
+    WatchedFile *f = find_file(w, file);
+    if (f) *f = w->files[--w->count];
+}
+
+/* Name of the matrix a file provides, without parsing its data: the first
+ * token of a text file, the file name otherwise (as matrix_formats does).
+ */
+static int peek_matrix_name(const char *path, const char *file, char *name) {
+    if (matrix_path_has_ext(file, ".txt")) {
+        FILE *f = fopen(path, "r");
+        if (!f) return 0;
+        int ok = (fscanf(f, "%63s", name) == 1);
+        fclose(f);
+        return ok;
+    }
+    snprintf(name, MAX_NAME_LENGTH, "%.*s", MAX_NAME_LENGTH - 1, file);
+    char *dot = strrchr(name, '.');
+    if (dot && dot != name) *dot = '\0';
+    return 1;
+}
+
+/* Parse a file into the type its tag names (as read_matrices_from_folder).
+ * Returns: the matrix, with *kind and name set, or NULL
+ */
+static void *load_file(const char *path, WatchKind *kind, char *name) {
+    void *loaded;
+    const char *src;
+    if (matrix_file_is_complex(path)) {
+        ComplexMatrix *z = read_complex_matrix_from_file(path);
+        *kind = WATCH_COMPLEX; loaded = z; src = z ? z->name : NULL;
+    } else if (matrix_file_is_toeplitz(path)) {
+        ToeplitzMatrix *t = read_toeplitz_matrix_from_file(path);
+        *kind = WATCH_TOEPLITZ; loaded = t; src = t ? t->name : NULL;
+    } else if (matrix_file_is_int(path)) {
+        IntMatrix *im = read_int_matrix_from_file(path);
+        *kind = WATCH_INT; loaded = im; src = im ? im->name : NULL;
+    } else {
+        Matrix *m = read_matrix_from_file(path);
+        *kind = WATCH_DENSE; loaded = m; src = m ? m->name : NULL;
+    }
+    if (src) snprintf(name, MAX_NAME_LENGTH, "%s", src);
+    return loaded;
+}
+
+static void free_loaded(void *loaded, WatchKind kind) {
+    switch (kind) {
+        case WATCH_COMPLEX:  free_complex_matrix((ComplexMatrix*)loaded); break;
+        case WATCH_TOEPLITZ: free_toeplitz_matrix((ToeplitzMatrix*)loaded); break;
+        case WATCH_INT:      free_int_matrix((IntMatrix*)loaded); break;
+        default:             free_matrix((Matrix*)loaded); break;
+    }
+}
+
+static int in_collection(MatrixCollection *col, const char *name) {
+    return find_matrix(col, name) || find_complex_matrix(col, name) ||
+           find_toeplitz_matrix(col, name) || find_int_matrix(col, name);
+}
+
+/* Drop name from whichever list holds it. Returns: 1 if it was found */
+static int remove_any(MatrixCollection *col, const char *name) {
+    return remove_matrix(col, name) || remove_complex_matrix(col, name) ||
+           remove_toeplitz_matrix(col, name) || remove_int_matrix(col, name);
+}
+
+/* Put a loaded matrix on its list, replacing one of the same name on any
+ * list. A dense matrix that stays dense is swapped in place.
+ * Returns: 1 if stored (the collection owns it), 0 otherwise
+ */
+static int store_loaded(MatrixCollection *col, void *loaded, WatchKind kind, const char *name) {
+    if (kind == WATCH_DENSE) {
+        if (!find_matrix(col, name)) remove_any(col, name);
+        return replace_matrix(col, (Matrix*)loaded);
+    }
+    remove_any(col, name);
+    switch (kind) {
+        case WATCH_COMPLEX:  return add_complex_matrix(col, (ComplexMatrix*)loaded);
+        case WATCH_TOEPLITZ: return add_toeplitz_matrix(col, (ToeplitzMatrix*)loaded);
+        default:             return add_int_matrix(col, (IntMatrix*)loaded);
+    }
+}
+
+static void add_pending(PendingFile **list, int *count, int *cap, const char *file, int deleted) {
+    for (int i = 0; i < *count; i++) {
+        if (strcmp((*list)[i].file, file) == 0) {
+            (*list)[i].deleted = deleted;   /* last event wins */
+            return;
+        }
+    }
+    if (*count >= *cap) {
+        int newcap = *cap ? *cap * 2 : 16;
+        PendingFile *tmp = (PendingFile*)realloc(*list, newcap * sizeof(PendingFile));
+        if (!tmp) return;
+        *list = tmp;
+        *cap = newcap;
+    }
+    PendingFile *p = &(*list)[(*count)++];
+    strncpy(p->file, file, NAME_MAX);
+    p->file[NAME_MAX] = '\0';
+    p->deleted = deleted;
+    p->kind = WATCH_DENSE;
+    p->loaded = NULL;
+}
+
+/* Event queue overflowed: treat every file, present or remembered, as changed */
+static void add_full_rescan(FolderWatch *w, PendingFile **list, int *count, int *cap) {
+    DIR *dir = opendir(w->folder);
+    if (dir) {
+        struct dirent *ent;
+        while ((ent = readdir(dir)) != NULL) {
+            if (is_matrix_file(ent->d_name)) add_pending(list, count, cap, ent->d_name, 0);
+        }
+        closedir(dir);
+    }
+    for (int i = 0; i < w->count; i++) {
+        char path[WATCH_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%s", w->folder, w->files[i].file);
+        if (access(path, F_OK) != 0) add_pending(list, count, cap, w->files[i].file, 1);
+    }
+}
+
+FolderWatch *folder_watch_start(const char *folder, MatrixCollection *col) {
+    if (!folder || !col) return NULL;
+    FolderWatch *w = (FolderWatch*)calloc(1, sizeof(FolderWatch));
+    if (!w) return NULL;
+    strncpy(w->folder, folder, PATH_MAX - 1);
+
+    /* Register before scanning so nothing written during the scan is missed */
+    w->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (w->fd < 0) { mat_log(MAT_LOG_ERROR, "inotify_init1: %s", strerror(errno)); free(w); return NULL; }
+    w->wd = inotify_add_watch(w->fd, folder, WATCH_EVENTS | IN_ONLYDIR);
+    if (w->wd < 0) {
+        mat_log(MAT_LOG_ERROR, "Cannot watch '%s': %s", folder, strerror(errno));
+        close(w->fd);
+        free(w);
+        return NULL;
+    }
+
+    DIR *dir = opendir(folder);
+    if (!dir) { mat_log(MAT_LOG_ERROR, "opendir: %s", strerror(errno)); folder_watch_stop(w); return NULL; }
+    int loaded = 0, known = 0;
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (!is_matrix_file(ent->d_name)) continue;
+        char path[WATCH_PATH_LEN], name[MAX_NAME_LENGTH];
+        snprintf(path, sizeof(path), "%s/%s", folder, ent->d_name);
+        if (!peek_matrix_name(path, ent->d_name, name)) continue;
+
+        if (in_collection(col, name)) {
+            set_file(w, ent->d_name, name);
+            known++;
+            continue;
+        }
+        WatchKind kind;
+        void *m = load_file(path, &kind, name);
+        if (!m) continue;
+        set_file(w, ent->d_name, name);
+        if (store_loaded(col, m, kind, name)) loaded++;
+        else free_loaded(m, kind);
+    }
+    closedir(dir);
+
+    mat_log(MAT_LOG_INFO, "Watching '%s': %d matrices loaded, %d already in memory.", folder, loaded, known);
+    return w;
+}
+
+int folder_watch_poll(FolderWatch *w, MatrixCollection *col,
+                      MatrixChangeCallback on_change, void *ctx) {
+    if (!w || !col) return 0;
+
+    PendingFile *pending = NULL;
+    int npending = 0, cap = 0, gone = 0;
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    /* Drain the queue; repeated events for one file collapse into one entry */
+    for (;;) {
+        ssize_t len = read(w->fd, buf, sizeof(buf));
+        if (len <= 0) break;
+        for (char *p = buf; p < buf + len; ) {
+            const struct inotify_event *ev = (const struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + ev->len;
+            if (ev->mask & IN_Q_OVERFLOW) {
+                add_full_rescan(w, &pending, &npending, &cap);
+            } else if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                gone = 1;
+            } else if (ev->len > 0 && is_matrix_file(ev->name)) {
+                add_pending(&pending, &npending, &cap, ev->name,
+                            (ev->mask & (IN_DELETE | IN_MOVED_FROM)) != 0);
+            }
+        }
+    }
+
+    /* Reparse the touched files concurrently; only they cost anything */
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int k = 0; k < npending; k++) {
+        if (pending[k].deleted) continue;
+        char path[WATCH_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%s", w->folder, pending[k].file);
+        pending[k].loaded = load_file(path, &pending[k].kind, pending[k].name);
+    }
+
+    int changed = 0;
+    for (int k = 0; k < npending; k++) {
+        PendingFile *p = &pending[k];
+        WatchedFile *f = find_file(w, p->file);
+        char old_name[MAX_NAME_LENGTH] = "";
+        if (f) strcpy(old_name, f->name);
+
+        if (p->deleted) {
+            if (f && remove_any(col, old_name)) {
+                mat_log(MAT_LOG_INFO, "Removed matrix '%s' (%s deleted)", old_name, p->file);
+                if (on_change) on_change(old_name, ctx);
+                changed++;
+            }
+            drop_file(w, p->file);
+            continue;
+        }
+        if (!p->loaded) {
+            mat_log(MAT_LOG_INFO, "Keeping previous contents for %s (file could not be parsed)", p->file);
+            continue;
+        }
+
+        /* The file now provides a different matrix: retire the old one */
+        if (f && strcmp(old_name, p->name) != 0 && remove_any(col, old_name)) {
+            if (on_change) on_change(old_name, ctx);
+            changed++;
+        }
+        if (store_loaded(col, p->loaded, p->kind, p->name)) {
+            set_file(w, p->file, p->name);
+            if (on_change) on_change(p->name, ctx);
+            changed++;
+        } else {
+            free_loaded(p->loaded, p->kind);
+        }
+    }
+    free(pending);
+
+    if (gone) {
+        mat_log(MAT_LOG_INFO, "Watched folder '%s' was removed or moved.", w->folder);
+        return -1;
+    }
+    return changed;
+}
+
+const char *folder_watch_path(const FolderWatch *w) {
+    return w ? w->folder : NULL;
+}
+
+void folder_watch_stop(FolderWatch *w) {
+    if (!w) return;
+    close(w->fd);
+    free(w->files);
+    free(w);
+}
@@ -0,0 +1,42 @@
+#ifndef MATRIX_WATCH_H
+#define MATRIX_WATCH_H
+
+#include "matrix_types.h"
+
+/*
+ * Incremental folder sync (Linux inotify).
+ *
+ * A watch remembers which matrix each .txt/.npy/.mtx file in the folder
+ * provides. Polling drains the pending inotify events and touches only the
+ * files they name: written or moved-in files are reparsed (in parallel) and
+ * replace their matrix in place, deleted or moved-out files drop theirs.
+ * Tagged text files (complex, Toeplitz/circulant, int) go to their own
+ * collection lists, as with read_matrices_from_folder.
+ * Files are picked up when the writer closes them, so half-written files
+ * are never parsed.
+ */
+
+typedef struct FolderWatch FolderWatch;
+
+/* Called once for every matrix name whose contents changed or disappeared */
+typedef void (*MatrixChangeCallback)(const char *name, void *ctx);
+
+/* Start watching folder. Files whose matrix is not in the collection yet are
+ * loaded; matrices already in memory are assumed to be current.
+ * Returns: watch handle or NULL on error
+ */
+FolderWatch *folder_watch_start(const char *folder, MatrixCollection *col);
+
+/* Apply all pending changes to the collection without blocking.
+ * Returns: number of matrices updated/removed, or -1 if the folder itself
+ *          went away (the watch should then be stopped)
+ */
+int folder_watch_poll(FolderWatch *w, MatrixCollection *col,
+                      MatrixChangeCallback on_change, void *ctx);
+
+/* Folder being watched */
+const char *folder_watch_path(const FolderWatch *w);
+
+void folder_watch_stop(FolderWatch *w);
+
+#endif /* MATRIX_WATCH_H */
@@ -3,13 +3,27 @@
 #include <string.h>
 #include <ctype.h>
 #include <signal.h>
+#include <time.h>
 #include "matrix_types.h"
 #include "matrix_file_ops.h"
+#include "matrix_stream.h"
+#include "matrix_watch.h"
+#include "matrix_cache.h"
+#include "matrix_log.h"
+#include "matrix_render.h"
 #include "matrix_arithmetic.h"
 #include "matrix_arithmetic_parallel.h"
 #include "determinant_gauss.h"
 #include "determinant_parallel.h"
 #include "eigen_qr.h"
+#include "eigen_update.h"
+#include "matrix_blocks.h"
+#include "matrix_gf2.h"
+#include "matrix_int.h"
+#include "matrix_morton.h"
+#include "matrix_complex.h"
+#include "matrix_toeplitz.h"
+#include "matrix_resources.h"
 
 /*
  * Professional interactive menu (modular version)
@@ -20,6 +34,12 @@
 
 static volatile sig_atomic_t g_interrupted = 0;
 
+/* Determinant/eigen results of unchanged matrices are reused */
+static ResultCache *g_cache = NULL;
+
+/* Active folder watch (option 16), NULL when off */
+static FolderWatch *g_watch = NULL;
+
 static void on_sigint(int sig) {
     (void)sig;
     g_interrupted = 1;
@@ -91,7 +111,13 @@ static void print_menu(void) {
     puts("  [12] Multiply 2 matrices");
     puts("  [13] Find the determinant of a matrix");
     puts("  [14] Find eigenvalues & eigenvectors of a matrix");
-    puts("  [15] Exit");
+    puts("  [15] Read matrices from a stream (pipe/FIFO, - = stdin)");
+    puts("  [16] Watch a folder for changes (start/stop)");
+    puts("  [17] Boolean / GF(2) operations on 0/1 matrices");
+    puts("  [18] Complex matrices (build, add, multiply, determinant)");
+    puts("  [19] Toeplitz / circulant matrices (FFT multiply, Levinson solve)");
+    puts("  [20] Integer matrices (exact int32/int64 arithmetic)");
+    puts("  [21] Exit");
     puts("");
     puts("════════════════════════════════════════════════════════════");
 }
@@ -164,15 +190,105 @@ static void handle_enter_matrix(MatrixCollection *col) {
     printf("\nMatrix '%s' (%dx%d) added successfully!\n", name, r, c);
 }
 
+/* Window size used when paging through a large matrix */
+#define PAGE_ROWS 20
+#define PAGE_COLS 8
+
+/* Browse a matrix too large for the summary one window at a time */
+static void page_matrix(const Matrix *m) {
+    int row0 = 0, col0 = 0;
+    char cmd[64];
+    for (;;) {
+        int rc = read_line_prompt("[n]ext/[p]rev rows, [r]ight/[l]eft cols, [g]o to row col, "
+                                  "[f]ull dump to file, [q]uit: ", cmd, sizeof(cmd));
+        if (rc <= 0 || cmd[0] == 'q') return;
+        switch (cmd[0]) {
+            case 'n': if (row0 + PAGE_ROWS < m->rows) row0 += PAGE_ROWS; break;
+            case 'p': row0 = row0 > PAGE_ROWS ? row0 - PAGE_ROWS : 0; break;
+            case 'r': if (col0 + PAGE_COLS < m->cols) col0 += PAGE_COLS; break;
+            case 'l': col0 = col0 > PAGE_COLS ? col0 - PAGE_COLS : 0; break;
+            case 'g': {
+                int r, c;
+                if (sscanf(cmd + 1, "%d %d", &r, &c) != 2 || r < 0 || c < 0 ||
+                    r >= m->rows || c >= m->cols) {
+                    printf("Usage: g <row> <col> (0-%d, 0-%d)\n", m->rows - 1, m->cols - 1);
+                    continue;
+                }
+                row0 = r;
+                col0 = c;
+                break;
+            }
+            case 'f': {
+                char path[512];
+                rc = read_line_prompt("Output file: ", path, sizeof(path));
+                if (rc <= 0) { puts("No file given."); continue; }
+                if (render_matrix_to_file(m, path, NULL))
+                    printf("Wrote all %dx%d values to '%s'.\n", m->rows, m->cols, path);
+                else
+                    printf("Could not write '%s'.\n", path);
+                continue;
+            }
+            default: puts("Unknown command."); continue;
+        }
+        render_matrix_window(stdout, m, row0, PAGE_ROWS, col0, PAGE_COLS, NULL);
+    }
+}
+
+/* Toeplitz matrices are shown by their stored diagonals, not expanded */
+static void print_values(const char *label, const double *v, int n) {
+    printf("%s", label);
+    int shown = n > 2 * RENDER_DEFAULT_EDGE ? RENDER_DEFAULT_EDGE : n;
+    for (int k = 0; k < shown; k++) printf(" %10.4f", v[k]);
+    if (shown < n) printf("  ... (%d more)", n - shown);
+    printf("\n");
+}
+
+static void show_toeplitz(const ToeplitzMatrix *t) {
+    int circulant = t->kind == STRUCTURE_CIRCULANT;
+    printf("\nMatrix: %s (%dx%d %s, %d values stored)\n", t->name, t->rows, t->cols,
+           circulant ? "circulant" : "toeplitz", circulant ? t->rows : t->rows + t->cols - 1);
+    print_values("First column:", t->col, t->rows);
+    if (!circulant) print_values("First row:   ", t->row, t->cols);
+}
+
+/* Corners of an integer matrix, printed exactly (no double round trip) */
+static void show_int_matrix(const IntMatrix *m) {
+    const int edge = RENDER_DEFAULT_EDGE;
+    printf("\nMatrix: %s (%dx%d %s)\n", m->name, m->rows, m->cols,
+           m->type == INT_ELEM_I32 ? "int32" : "int64");
+    int width = 1;
+    for (int i = 0; i < m->rows; i++) {
+        for (int j = 0; j < m->cols; j++) {
+            int w = snprintf(NULL, 0, "%lld", (long long)int_matrix_get(m, i, j));
+            if (w > width) width = w;
+        }
+    }
+    for (int i = 0; i < m->rows; i++) {
+        if (m->rows > 2 * edge && i == edge) { puts("  ..."); i = m->rows - edge; }
+        for (int j = 0; j < m->cols; j++) {
+            if (m->cols > 2 * edge && j == edge) { printf(" ..."); j = m->cols - edge; }
+            printf(" %*lld", width, (long long)int_matrix_get(m, i, j));
+        }
+        printf("\n");
+    }
+}
+
 static void handle_display_matrix(MatrixCollection *col) {
     puts("--- Display a Matrix ---");
     char name[MAX_NAME_LENGTH];
     int rc = read_line_prompt("Enter matrix name: ", name, sizeof(name));
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc == 0) { puts("Name cannot be empty."); return; }
+    ComplexMatrix *z = find_complex_matrix(col, name);
+    if (z) { render_complex_summary(stdout, z, NULL); return; }
+    ToeplitzMatrix *t = find_toeplitz_matrix(col, name);
+    if (t) { show_toeplitz(t); return; }
+    IntMatrix *im = find_int_matrix(col, name);
+    if (im) { show_int_matrix(im); return; }
     Matrix *m = find_matrix(col, name);
     if (!m) { printf("Matrix '%s' not found.\n", name); return; }
     display_matrix(m);
+    if (m->rows > 2 * RENDER_DEFAULT_EDGE || m->cols > 2 * RENDER_DEFAULT_EDGE) page_matrix(m);
 }
 
 static void handle_delete_matrix(MatrixCollection *col) {
@@ -182,7 +298,14 @@ static void handle_delete_matrix(MatrixCollection *col) {
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc == 0) { puts("Name cannot be empty."); return; }
     if (remove_matrix(col, name)) {
+        result_cache_invalidate(g_cache, name);
         printf("Matrix '%s' deleted successfully.\n", name);
+    } else if (remove_complex_matrix(col, name)) {
+        printf("Complex matrix '%s' deleted successfully.\n", name);
+    } else if (remove_toeplitz_matrix(col, name)) {
+        printf("Toeplitz matrix '%s' deleted successfully.\n", name);
+    } else if (remove_int_matrix(col, name)) {
+        printf("Integer matrix '%s' deleted successfully.\n", name);
     } else {
         printf("Matrix '%s' not found.\n", name);
     }
@@ -200,23 +323,40 @@ static void handle_modify_matrix(MatrixCollection *col) {
     puts("1. Modify a specific element");
     puts("2. Modify entire row");
     puts("3. Modify entire column");
+    puts("4. Transpose (in place, no copy)");
     int choice; rc = read_int_prompt("Enter choice: ", &choice);
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc != 1) { puts("Invalid input."); return; }
 
+    /* Even a partially applied row/column edit changes the matrix */
+    if (choice >= 2 && choice <= 4) result_cache_mark_modified(g_cache, m->name, NULL);
+
     if (choice == 1) {
         int i, j; double v;
         if (read_int_prompt("Row index: ", &i) != 1 || i < 0 || i >= m->rows) { puts("Invalid row."); return; }
         if (read_int_prompt("Col index: ", &j) != 1 || j < 0 || j >= m->cols) { puts("Invalid column."); return; }
         if (read_double_prompt("New value: ", &v) != 1) { puts("Invalid value."); return; }
-        m->data[i][j] = v;
-        printf("Updated a[%d][%d] = %.4f\n", i, j, v);
+        /* A symmetric edit lets the cached eigenpairs be updated instead of recomputed */
+        int mirror = 0;
+        if (i != j && is_symmetric_matrix(m)) {
+            char answer[8];
+            rc = read_line_prompt("Matrix is symmetric. Set a[j][i] too, to keep it symmetric? [Y/n]: ",
+                                  answer, sizeof(answer));
+            if (rc == -1) { puts("EOF. Exiting..."); return; }
+            mirror = answer[0] != 'n' && answer[0] != 'N';
+        }
+        SymmetricEdit edit = { i, j, v - mat_get(m, i, j) };
+        result_cache_mark_modified(g_cache, m->name, (i == j || mirror) ? &edit : NULL);
+        *mat_at(m, i, j) = v;
+        if (mirror) *mat_at(m, j, i) = v;
+        if (mirror) printf("Updated a[%d][%d] = a[%d][%d] = %.4f\n", i, j, j, i, v);
+        else printf("Updated a[%d][%d] = %.4f\n", i, j, v);
     } else if (choice == 2) {
         int i; if (read_int_prompt("Row index: ", &i) != 1 || i < 0 || i >= m->rows) { puts("Invalid row."); return; }
         for (int j = 0; j < m->cols; j++) {
             char prompt[64]; snprintf(prompt, sizeof(prompt), "value[%d][%d]: ", i, j);
             double v; if (read_double_prompt(prompt, &v) != 1) { puts("Invalid value."); return; }
-            m->data[i][j] = v;
+            *mat_at(m, i, j) = v;
         }
         printf("Row %d updated.\n", i);
     } else if (choice == 3) {
@@ -224,9 +364,13 @@ static void handle_modify_matrix(MatrixCollection *col) {
         for (int i = 0; i < m->rows; i++) {
             char prompt[64]; snprintf(prompt, sizeof(prompt), "value[%d][%d]: ", i, j);
             double v; if (read_double_prompt(prompt, &v) != 1) { puts("Invalid value."); return; }
-            m->data[i][j] = v;
+            *mat_at(m, i, j) = v;
         }
         printf("Column %d updated.\n", j);
+    } else if (choice == 4) {
+        transpose_matrix(m);
+        printf("'%s' is now %dx%d (%s storage).\n", m->name, m->rows, m->cols,
+               m->layout == MAT_COL_MAJOR ? "column-major" : "row-major");
     } else {
         puts("Invalid choice.");
     }
@@ -240,6 +384,37 @@ static void handle_read_from_file(MatrixCollection *col) {
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc == 0) { puts("Path cannot be empty."); return; }
 
+    if (matrix_file_is_complex(path)) {
+        ComplexMatrix *z = read_complex_matrix_from_file(path);
+        if (z && add_complex_matrix(col, z)) {
+            printf("Complex matrix '%s' added to collection.\n", z->name);
+        } else if (z) {
+            printf("Matrix '%s' already exists or failed to add.\n", z->name);
+            free_complex_matrix(z);
+        }
+        return;
+    }
+    if (matrix_file_is_toeplitz(path)) {
+        ToeplitzMatrix *t = read_toeplitz_matrix_from_file(path);
+        if (t && add_toeplitz_matrix(col, t)) {
+            printf("Toeplitz matrix '%s' added to collection.\n", t->name);
+        } else if (t) {
+            printf("Matrix '%s' already exists or failed to add.\n", t->name);
+            free_toeplitz_matrix(t);
+        }
+        return;
+    }
+    if (matrix_file_is_int(path)) {
+        IntMatrix *im = read_int_matrix_from_file(path);
+        if (im && add_int_matrix(col, im)) {
+            printf("Integer matrix '%s' added to collection.\n", im->name);
+        } else if (im) {
+            printf("Matrix '%s' already exists or failed to add.\n", im->name);
+            free_int_matrix(im);
+        }
+        return;
+    }
+
     Matrix *m = read_matrix_from_file(path);
     if (m) {
         if (add_matrix(col, m)) {
@@ -261,6 +436,57 @@ static void handle_read_from_folder(MatrixCollection *col) {
     read_matrices_from_folder(path, col);
 }
 
+static void handle_read_from_stream(MatrixCollection *col) {
+    puts("--- Read Matrices from a Stream ---");
+    char path[512];
+    int rc = read_line_prompt("Enter pipe/FIFO/device path: ", path, sizeof(path));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Path cannot be empty."); return; }
+    if (strcmp(path, "-") == 0) {
+        /* stdin carries the menu input here; piped data goes on the command line */
+        puts("Standard input is in use by the menu; start the program as");
+        puts("  generator | ./menu_demo_v2 -");
+        return;
+    }
+
+    read_matrices_from_stream_path(path, col);
+}
+
+static void on_watched_matrix_changed(const char *name, void *ctx) {
+    (void)ctx;
+    result_cache_invalidate(g_cache, name);
+}
+
+/* Apply pending folder changes, if a watch is active */
+static void poll_folder_watch(MatrixCollection *col) {
+    if (!g_watch) return;
+    int n = folder_watch_poll(g_watch, col, on_watched_matrix_changed, NULL);
+    if (n < 0) {
+        folder_watch_stop(g_watch);
+        g_watch = NULL;
+        puts("Folder watch stopped.");
+    } else if (n > 0) {
+        printf("Folder watch: %d matrices updated.\n", n);
+    }
+}
+
+static void handle_watch_folder(MatrixCollection *col) {
+    puts("--- Watch a Folder for Changes ---");
+    if (g_watch) {
+        printf("Stopped watching '%s'.\n", folder_watch_path(g_watch));
+        folder_watch_stop(g_watch);
+        g_watch = NULL;
+        return;
+    }
+    char path[512];
+    int rc = read_line_prompt("Enter folder path: ", path, sizeof(path));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Path cannot be empty."); return; }
+
+    g_watch = folder_watch_start(path, col);
+    if (g_watch) puts("Changes are applied each time the menu is shown. Select 16 again to stop.");
+}
+
 static void handle_save_to_file(MatrixCollection *col) {
     puts("--- Save Matrix to File ---");
     char name[MAX_NAME_LENGTH];
@@ -269,19 +495,25 @@ static void handle_save_to_file(MatrixCollection *col) {
     if (rc == 0) { puts("Name cannot be empty."); return; }
 
     Matrix *m = find_matrix(col, name);
-    if (!m) { printf("Matrix '%s' not found.\n", name); return; }
+    ComplexMatrix *z = m ? NULL : find_complex_matrix(col, name);
+    ToeplitzMatrix *t = m || z ? NULL : find_toeplitz_matrix(col, name);
+    IntMatrix *im = m || z || t ? NULL : find_int_matrix(col, name);
+    if (!m && !z && !t && !im) { printf("Matrix '%s' not found.\n", name); return; }
 
     char path[512];
     rc = read_line_prompt("Enter file path: ", path, sizeof(path));
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc == 0) { puts("Path cannot be empty."); return; }
 
-    write_matrix_to_file(m, path);
+    if (z) write_complex_matrix_to_file(z, path);
+    else if (t) write_toeplitz_matrix_to_file(t, path);
+    else if (im) write_int_matrix_to_file(im, path);
+    else write_matrix_to_file(m, path);
 }
 
 static void handle_save_all(MatrixCollection *col) {
     puts("--- Save All Matrices to Folder ---");
-    if (col->count == 0) {
+    if (col->count == 0 && col->complex_count == 0 && col->toeplitz_count == 0 && col->int_count == 0) {
         puts("No matrices in memory to save.");
         return;
     }
@@ -291,7 +523,24 @@ static void handle_save_all(MatrixCollection *col) {
     if (rc == -1) { puts("EOF. Exiting..."); return; }
     if (rc == 0) { puts("Path cannot be empty."); return; }
 
-    save_all_matrices_to_folder(col, path);
+    char fmt[16];
+    rc = read_line_prompt("File format (txt/npy) [txt]: ", fmt, sizeof(fmt));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc > 0 && strcmp(fmt, "npy") == 0) {
+        save_all_matrices_to_folder_as(col, path, ".npy");
+    } else {
+        save_all_matrices_to_folder(col, path);
+    }
+}
+
+static void keep_dense_result(MatrixCollection *col, Matrix *result, const char *result_name) {
+    if (!result) { puts("Operation failed."); return; }
+    if (!add_matrix(col, result)) {
+        printf("Warning: Could not add result matrix '%s' to collection.\n", result_name);
+        free_matrix(result);
+    } else {
+        printf("✓ Result matrix '%s' (%dx%d) added to collection.\n", result_name, result->rows, result->cols);
+    }
 }
 
 static void handle_add_matrices(MatrixCollection *col) {
@@ -403,6 +652,20 @@ static void handle_multiply_matrices(MatrixCollection *col) {
     if (!m1) { printf("Matrix '%s' not found.\n", name1); return; }
     if (!m2) { printf("Matrix '%s' not found.\n", name2); return; }
 
+    char method[16];
+    rc = read_line_prompt("Method: [1] Compare single/OpenMP/multiprocess, [2] Recursive Morton-tiled [1]: ",
+                          method, sizeof(method));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (strcmp(method, "2") == 0) {
+        if (m1->cols != m2->rows) { puts("Dimension mismatch: columns of A must equal rows of B."); return; }
+        double secs = 0.0;
+        Matrix *result = multiply_matrices_morton(m1, m2, result_name, 0, &secs);
+        if (result) printf("Morton-tiled product (%dx%d tiles): %.6f s including layout conversion\n",
+                           MORTON_DEFAULT_TILE, MORTON_DEFAULT_TILE, secs);
+        keep_dense_result(col, result, result_name);
+        return;
+    }
+
     // Run all three methods and compare performance
     PerformanceMetrics metrics;
     Matrix *result = run_operation_comparison(m1, m2, result_name, "Multiplication", &metrics);
@@ -419,7 +682,7 @@ static void handle_multiply_matrices(MatrixCollection *col) {
 
 /* ===== Option 13: Determinant (Gaussian elimination with partial pivoting) ===== */
 static void handle_determinant(MatrixCollection *col) {
-    puts("--- Determinant (Gaussian Elimination with Partial Pivoting) ---");
+    puts("--- Determinant (Gaussian Elimination, Recursive LU, Sparse or Blocks) ---");
     puts("(Single-thread vs OpenMP vs Multiprocessing)\n");
     char name[MAX_NAME_LENGTH];
     int rc = read_line_prompt("Enter matrix name: ", name, sizeof(name));
@@ -435,10 +698,23 @@ static void handle_determinant(MatrixCollection *col) {
 
     PerformanceMetrics metrics;
     double det = 0.0;
-    if (!run_determinant_comparison(m, &metrics, &det)) {
+    if (result_cache_get_determinant(g_cache, m->name, &det)) {
+        printf("Determinant of '%s': %.10g (cached, matrix unchanged)\n", m->name, det);
+        return;
+    }
+    char method[16];
+    rc = read_line_prompt("Method: [1] Gaussian elimination, [2] Recursive LU, [3] Sparse (reordered), "
+                          "[4] Block decomposition [1]: ", method, sizeof(method));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    DeterminantBackend backend = DET_BACKEND_GAUSS;
+    if (strcmp(method, "2") == 0) backend = DET_BACKEND_RECURSIVE_LU;
+    else if (strcmp(method, "3") == 0) backend = DET_BACKEND_SPARSE;
+    else if (strcmp(method, "4") == 0) backend = DET_BACKEND_BLOCKS;
+    if (!run_determinant_comparison_backend(m, backend, &metrics, &det)) {
         puts("Failed to compute determinant.");
         return;
     }
+    result_cache_put_determinant(g_cache, m->name, det);
 
     printf("Determinant of '%s': %.10g\n", m->name, det);
 }
@@ -463,41 +739,510 @@ static void handle_eigen(MatrixCollection *col) {
     double tol = 1e-10;
     
     PerformanceMetrics metrics;
-    EigenResult *result = run_eigen_comparison(m, max_iter, tol, &metrics);
-    
-    if (!result) {
-        puts("Failed to compute eigenvalues.");
+    const EigenResult *result = result_cache_get_eigen(g_cache, m->name);
+    if (result) {
+        puts("(cached result, matrix unchanged)");
+    } else {
+        /* After an in-place edit, start from the previous eigenpairs */
+        const SymmetricEdit *edits = NULL;
+        int edit_count = 0;
+        const EigenResult *stale = result_cache_get_stale_eigen(g_cache, m->name, &edits, &edit_count);
+        EigenResult *fresh;
+        if (stale) {
+            static const char *how[] = { "rank-one secular updates", "subspace refinement",
+                                         "full QR iteration (change too large to update)" };
+            EigenUpdateMethod used;
+            double t = 0.0;
+            fresh = eigen_update(m, stale, edits, edit_count, max_iter, tol, &used, &t);
+            if (fresh) printf("(updated from the previous result by %s in %.6f s)\n", how[used], t);
+        } else {
+            /* Reducible matrices split into independent smaller problems */
+            BlockStructure *bs = matrix_block_structure(m);
+            if (bs && bs->nblocks > 1) {
+                printf("(%d independent blocks, largest %dx%d)\n", bs->nblocks, bs->largest, bs->largest);
+                fresh = run_eigen_blocks_comparison(m, bs, max_iter, tol, &metrics);
+            } else {
+                fresh = run_eigen_comparison(m, max_iter, tol, &metrics);
+            }
+            free_block_structure(bs);
+        }
+        if (!fresh) {
+            puts("Failed to compute eigenvalues.");
+            return;
+        }
+        result_cache_put_eigen(g_cache, m->name, fresh);
+        result = fresh;
+    }
+
+    render_eigen_summary(stdout, m->name, result, NULL);
+
+    if (result->n > 2 * RENDER_DEFAULT_EDGE) {
+        char path[512];
+        rc = read_line_prompt("Write all eigenvalues/eigenvectors to a file? (path, or Enter to skip): ",
+                              path, sizeof(path));
+        if (rc > 0) {
+            if (render_eigen_to_file(m->name, result, path)) printf("Full results written to '%s'.\n", path);
+            else printf("Could not write '%s'.\n", path);
+        }
+    }
+}
+
+
+/* ===== Option 17: Boolean / GF(2) operations on 0/1 matrices ===== */
+static BitMatrix *find_bit_matrix(MatrixCollection *col, const char *name) {
+    Matrix *m = find_matrix(col, name);
+    if (!m) { printf("Matrix '%s' not found.\n", name); return NULL; }
+    BitMatrix *b = dense_to_bit_matrix(m);
+    if (!b) printf("Matrix '%s' has entries other than 0 and 1.\n", name);
+    return b;
+}
+
+static void handle_gf2(MatrixCollection *col) {
+    puts("--- Boolean / GF(2) Operations (0/1 matrices, bit-packed) ---");
+    puts("  1) Rank and determinant over GF(2)");
+    puts("  2) Product over GF(2) (AND/XOR)");
+    puts("  3) Boolean product (AND/OR)");
+    puts("  4) Counting product (number of shared ones)");
+    int op = 0;
+    int rc = read_int_prompt("Select operation: ", &op);
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0 || op < 1 || op > 4) { puts("Invalid operation."); return; }
+
+    char name1[MAX_NAME_LENGTH], name2[MAX_NAME_LENGTH], result_name[MAX_NAME_LENGTH];
+    rc = read_line_prompt(op == 1 ? "Enter matrix name: " : "Enter first matrix name: ", name1, sizeof(name1));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+
+    if (op == 1) {
+        BitMatrix *a = find_bit_matrix(col, name1);
+        if (!a) return;
+        printf("Packed %dx%d into %zu bytes (%zu as doubles)\n", a->rows, a->cols,
+               (size_t)a->rows * a->words_per_row * sizeof(uint64_t),
+               (size_t)a->rows * a->cols * sizeof(double));
+        printf("GF(2) rank of '%s': %d\n", name1, gf2_rank(a));
+        if (a->rows == a->cols) printf("GF(2) determinant of '%s': %d\n", name1, gf2_determinant(a));
+        free_bit_matrix(a);
         return;
     }
 
-    printf("\n========================================\n");
-    printf("EIGENVALUE & EIGENVECTOR RESULTS\n");
-    printf("========================================\n");
-    printf("Matrix: %s (%dx%d)\n", m->name, m->rows, m->cols);
-    printf("Converged in %d iterations\n\n", result->iterations);
-    
-    printf("Eigenvalues (%d):\n", result->n);
-    for (int i = 0; i < result->n; ++i) {
-        printf("  λ[%d] = %.10g\n", i, result->eigenvalues[i]);
+    rc = read_line_prompt("Enter second matrix name: ", name2, sizeof(name2));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+    rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+
+    BitMatrix *a = find_bit_matrix(col, name1);
+    BitMatrix *b = a ? find_bit_matrix(col, name2) : NULL;
+    if (!b) { free_bit_matrix(a); return; }
+    if (a->cols != b->rows) {
+        printf("Dimension mismatch: %dx%d times %dx%d.\n", a->rows, a->cols, b->rows, b->cols);
+        free_bit_matrix(a);
+        free_bit_matrix(b);
+        return;
     }
-    
-    // Display full eigenvector matrix (columns are eigenvectors)
-    if (result->eigenvectors) {
-        printf("\nEigenvectors matrix [%dx%d] (columns are eigenvectors):\n", result->n, result->n);
-        for (int r = 0; r < result->n; ++r) {
-            printf("  [");
-            for (int c = 0; c < result->n; ++c) {
-                printf(" % .6f", result->eigenvectors->data[r][c]);
+
+    Matrix *result = NULL;
+    if (op == 4) {
+        result = bit_count_multiply(a, b, result_name);
+    } else {
+        BitMatrix *c = (op == 2) ? gf2_multiply(a, b, result_name) : bool_multiply(a, b, result_name);
+        result = bit_matrix_to_dense(c);
+        free_bit_matrix(c);
+    }
+    free_bit_matrix(a);
+    free_bit_matrix(b);
+
+    if (!result) { puts("Failed to compute product."); return; }
+    if (!add_matrix(col, result)) {
+        printf("Warning: Could not add result matrix '%s' to collection.\n", result_name);
+        free_matrix(result);
+    } else {
+        printf("✓ Result matrix '%s' (%dx%d) added to collection.\n", result_name, result->rows, result->cols);
+    }
+}
+
+/* ===== Option 18: Complex matrices ===== */
+static ComplexMatrix *prompt_complex_matrix(MatrixCollection *col, const char *prompt) {
+    char name[MAX_NAME_LENGTH];
+    int rc = read_line_prompt(prompt, name, sizeof(name));
+    if (rc == -1) { puts("EOF. Exiting..."); return NULL; }
+    if (rc == 0) { puts("Name cannot be empty."); return NULL; }
+    ComplexMatrix *z = find_complex_matrix(col, name);
+    if (!z) printf("Complex matrix '%s' not found.\n", name);
+    return z;
+}
+
+static void keep_complex_result(MatrixCollection *col, ComplexMatrix *result, const char *result_name) {
+    if (!result) { puts("Operation failed."); return; }
+    if (!add_complex_matrix(col, result)) {
+        printf("Warning: Could not add result matrix '%s' to collection.\n", result_name);
+        free_complex_matrix(result);
+    } else {
+        printf("✓ Complex matrix '%s' (%dx%d) added to collection.\n", result_name, result->rows, result->cols);
+    }
+}
+
+static void handle_complex(MatrixCollection *col) {
+    puts("--- Complex Matrices (interleaved complex128) ---");
+    puts("  1) Build from real and imaginary parts");
+    puts("  2) Add two complex matrices");
+    puts("  3) Subtract two complex matrices");
+    puts("  4) Multiply (split emulation vs interleaved 4M vs 3M)");
+    puts("  5) Determinant (complex LU)");
+    puts("  6) Split into real and imaginary parts");
+    int op = 0;
+    int rc = read_int_prompt("Select operation: ", &op);
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0 || op < 1 || op > 6) { puts("Invalid operation."); return; }
+
+    char result_name[MAX_NAME_LENGTH];
+    if (op == 1) {
+        char re_name[MAX_NAME_LENGTH], im_name[MAX_NAME_LENGTH];
+        rc = read_line_prompt("Enter real part matrix name: ", re_name, sizeof(re_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        rc = read_line_prompt("Enter imaginary part matrix name (Enter for zero): ", im_name, sizeof(im_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        Matrix *re = find_matrix(col, re_name);
+        Matrix *im = rc > 0 ? find_matrix(col, im_name) : NULL;
+        if (!re) { printf("Matrix '%s' not found.\n", re_name); return; }
+        if (rc > 0 && !im) { printf("Matrix '%s' not found.\n", im_name); return; }
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        keep_complex_result(col, complex_from_parts(re, im, result_name), result_name);
+        return;
+    }
+
+    ComplexMatrix *a = prompt_complex_matrix(col, (op == 5 || op == 6) ? "Enter complex matrix name: "
+                                                                      : "Enter first complex matrix name: ");
+    if (!a) return;
+
+    if (op == 5) {
+        if (a->rows != a->cols) { printf("Matrix '%s' is not square.\n", a->name); return; }
+        double complex d1, d2;
+        double t1 = 0.0, t2 = 0.0;
+        if (!complex_determinant_single(a, &d1, &t1) || !complex_determinant_openmp(a, &d2, &t2)) {
+            puts("Failed to compute determinant.");
+            return;
+        }
+        printf("det(%s) = %.10g %+.10gi\n", a->name, creal(d2), cimag(d2));
+        printf("Single-threaded: %.6f s, OpenMP: %.6f s (%.2fx)\n", t1, t2, t1 / t2);
+        if (cabs(d1 - d2) > 1e-9 * (cabs(d1) > 1.0 ? cabs(d1) : 1.0)) puts("Warning: results differ.");
+        return;
+    }
+
+    if (op == 6) {
+        char re_name[MAX_NAME_LENGTH], im_name[MAX_NAME_LENGTH];
+        snprintf(re_name, sizeof(re_name), "%.58s_re", a->name);
+        snprintf(im_name, sizeof(im_name), "%.58s_im", a->name);
+        Matrix *parts[2] = { complex_real_part(a, re_name), complex_imag_part(a, im_name) };
+        for (int p = 0; p < 2; p++) {
+            if (parts[p] && add_matrix(col, parts[p])) {
+                printf("✓ Matrix '%s' added to collection.\n", parts[p]->name);
+            } else {
+                printf("Warning: Could not add matrix '%s' to collection.\n", p ? im_name : re_name);
+                free_matrix(parts[p]);
             }
-            printf(" ]\n");
         }
+        return;
     }
-    
-    printf("========================================\n\n");
-    
-    free_eigen_result(result);
+
+    ComplexMatrix *b = prompt_complex_matrix(col, "Enter second complex matrix name: ");
+    if (!b) return;
+    rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+
+    ComplexMatrix *result = NULL;
+    double t = 0.0;
+    if (op == 4) {
+        ComplexMultiplyMetrics metrics;
+        result = run_complex_multiply_comparison(a, b, result_name, &metrics);
+    } else {
+        result = op == 2 ? complex_add_openmp(a, b, result_name, &t)
+                         : complex_subtract_openmp(a, b, result_name, &t);
+        if (result) printf("Completed in %.6f s (OpenMP)\n", t);
+    }
+    keep_complex_result(col, result, result_name);
+}
+
+/* ===== Option 19: Toeplitz / circulant matrices ===== */
+static ToeplitzMatrix *prompt_toeplitz_matrix(MatrixCollection *col) {
+    char name[MAX_NAME_LENGTH];
+    int rc = read_line_prompt("Enter Toeplitz matrix name: ", name, sizeof(name));
+    if (rc == -1) { puts("EOF. Exiting..."); return NULL; }
+    if (rc == 0) { puts("Name cannot be empty."); return NULL; }
+    ToeplitzMatrix *t = find_toeplitz_matrix(col, name);
+    if (!t) printf("Toeplitz matrix '%s' not found.\n", name);
+    return t;
+}
+
+static Matrix *prompt_dense_matrix(MatrixCollection *col, const char *prompt) {
+    char name[MAX_NAME_LENGTH];
+    int rc = read_line_prompt(prompt, name, sizeof(name));
+    if (rc == -1) { puts("EOF. Exiting..."); return NULL; }
+    if (rc == 0) { puts("Name cannot be empty."); return NULL; }
+    Matrix *m = find_matrix(col, name);
+    if (!m) printf("Matrix '%s' not found.\n", name);
+    return m;
+}
+
+/* v[first] .. v[n - 1], one prompt each like handle_enter_matrix.
+ * Returns 1, 0 on an invalid number, -1 on EOF
+ */
+static int read_vector(const char *label, double *v, int first, int n) {
+    for (int k = first; k < n; k++) {
+        char prompt[80];
+        snprintf(prompt, sizeof(prompt), "%s[%d] = ", label, k);
+        int rc = read_double_prompt(prompt, &v[k]);
+        if (rc != 1) return rc;
+    }
+    return 1;
+}
+
+static void keep_toeplitz_result(MatrixCollection *col, ToeplitzMatrix *t) {
+    if (!t) { puts("Operation failed."); return; }
+    if (!add_toeplitz_matrix(col, t)) {
+        printf("Warning: Could not add matrix '%s' to collection.\n", t->name);
+        free_toeplitz_matrix(t);
+    } else {
+        printf("✓ %s matrix '%s' (%dx%d) added to collection.\n",
+               t->kind == STRUCTURE_CIRCULANT ? "Circulant" : "Toeplitz", t->name, t->rows, t->cols);
+    }
+}
+
+static void build_toeplitz(MatrixCollection *col, int circulant) {
+    char name[MAX_NAME_LENGTH];
+    int rows = 0, cols = 0;
+    int rc = read_line_prompt("Enter matrix name: ", name, sizeof(name));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+    rc = read_int_prompt(circulant ? "Enter size n: " : "Enter number of rows: ", &rows);
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc != 1 || rows <= 0) { puts("Invalid rows."); return; }
+    if (circulant) {
+        cols = rows;
+    } else {
+        rc = read_int_prompt("Enter number of columns: ", &cols);
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc != 1 || cols <= 0) { puts("Invalid columns."); return; }
+    }
+
+    ToeplitzMatrix *t = create_toeplitz_matrix(name, rows, cols,
+                                               circulant ? STRUCTURE_CIRCULANT : STRUCTURE_TOEPLITZ);
+    if (!t) { puts("Allocation failed."); return; }
+    puts(circulant ? "\nEnter the first column:" : "\nEnter the first column, then the first row from row[1]:");
+    rc = read_vector("col", t->col, 0, rows);
+    if (rc == 1 && circulant) {
+        t->row[0] = t->col[0];
+        for (int j = 1; j < cols; j++) t->row[j] = t->col[rows - j];
+    } else if (rc == 1) {
+        t->row[0] = t->col[0];
+        rc = read_vector("row", t->row, 1, cols);
+    }
+    if (rc != 1) {
+        puts(rc == -1 ? "EOF. Cancelling." : "Invalid number. Cancelling.");
+        free_toeplitz_matrix(t);
+        return;
+    }
+    keep_toeplitz_result(col, t);
 }
 
+static void handle_toeplitz(MatrixCollection *col) {
+    puts("--- Toeplitz / Circulant Matrices (first column + first row) ---");
+    puts("  1) Compress a dense matrix (detect Toeplitz / circulant)");
+    puts("  2) Build a Toeplitz matrix from its first column and row");
+    puts("  3) Build a circulant from its first column");
+    puts("  4) Multiply by a dense matrix (dense vs FFT)");
+    puts("  5) Solve T X = B (Levinson / FFT for circulants)");
+    puts("  6) Determinant (Levinson / FFT for circulants)");
+    puts("  7) Expand to a dense matrix");
+    int op = 0;
+    int rc = read_int_prompt("Select operation: ", &op);
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0 || op < 1 || op > 7) { puts("Invalid operation."); return; }
+
+    if (op == 2 || op == 3) { build_toeplitz(col, op == 3); return; }
+
+    char result_name[MAX_NAME_LENGTH];
+    if (op == 1) {
+        Matrix *m = prompt_dense_matrix(col, "Enter matrix name: ");
+        if (!m) return;
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        ToeplitzMatrix *t = toeplitz_detect(m, result_name);
+        if (!t) { printf("Matrix '%s' is not Toeplitz (its diagonals are not constant).\n", m->name); return; }
+        printf("%zu bytes dense, %zu bytes structured\n", (size_t)m->rows * m->cols * sizeof(double),
+               ((size_t)t->rows + t->cols) * sizeof(double));
+        keep_toeplitz_result(col, t);
+        return;
+    }
+
+    ToeplitzMatrix *t = prompt_toeplitz_matrix(col);
+    if (!t) return;
+
+    if (op == 6) {
+        if (t->rows != t->cols) { printf("Matrix '%s' is not square.\n", t->name); return; }
+        double det = 0.0, logabs = 0.0, secs = 0.0;
+        if (!toeplitz_determinant(t, &det, &logabs, &secs)) {
+            puts("Failed to compute determinant.");
+            return;
+        }
+        printf("det(%s) = %.10g (log|det| = %.6f)\n", t->name, det, logabs);
+        printf("Computed in %.6f s\n", secs);
+        return;
+    }
+
+    if (op == 7) {
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        keep_dense_result(col, toeplitz_to_dense(t, result_name), result_name);
+        return;
+    }
+
+    Matrix *x = prompt_dense_matrix(col, op == 4 ? "Enter dense matrix name: " : "Enter right-hand side name: ");
+    if (!x) return;
+    rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+
+    Matrix *result = NULL;
+    if (op == 4) {
+        ToeplitzMultiplyMetrics metrics;
+        result = run_toeplitz_multiply_comparison(t, x, result_name, &metrics);
+    } else {
+        double secs = 0.0;
+        result = toeplitz_solve(t, x, result_name, &secs);
+        if (result) printf("Solved in %.6f s\n", secs);
+    }
+    keep_dense_result(col, result, result_name);
+}
+
+/* ===== Option 20: Integer matrices ===== */
+static IntMatrix *prompt_int_matrix(MatrixCollection *col, const char *prompt) {
+    char name[MAX_NAME_LENGTH];
+    int rc = read_line_prompt(prompt, name, sizeof(name));
+    if (rc == -1) { puts("EOF. Exiting..."); return NULL; }
+    if (rc == 0) { puts("Name cannot be empty."); return NULL; }
+    IntMatrix *m = find_int_matrix(col, name);
+    if (!m) printf("Integer matrix '%s' not found.\n", name);
+    return m;
+}
+
+static void keep_int_result(MatrixCollection *col, IntMatrix *result) {
+    if (!result) { puts("Operation failed."); return; }
+    if (!add_int_matrix(col, result)) {
+        printf("Warning: Could not add result matrix '%s' to collection.\n", result->name);
+        free_int_matrix(result);
+    } else {
+        printf("✓ Result matrix '%s' (%dx%d %s) added to collection.\n", result->name, result->rows,
+               result->cols, result->type == INT_ELEM_I32 ? "int32" : "int64");
+    }
+}
+
+static void handle_integer(MatrixCollection *col) {
+    puts("--- Integer Matrices (exact int32/int64) ---");
+    puts("  1) Load a text file with exact integer parsing");
+    puts("  2) Convert an integer-valued dense matrix");
+    puts("  3) Add two integer matrices");
+    puts("  4) Subtract two integer matrices");
+    puts("  5) Multiply two integer matrices");
+    puts("  6) Multiply by a dense matrix (integer * dense or dense * integer)");
+    puts("  7) Add / subtract a dense matrix (integer +- dense)");
+    puts("  8) Convert to a dense matrix");
+    int op = 0;
+    int rc = read_int_prompt("Select operation: ", &op);
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0 || op < 1 || op > 8) { puts("Invalid operation."); return; }
+
+    char result_name[MAX_NAME_LENGTH];
+    if (op == 1) {
+        char path[512];
+        rc = read_line_prompt("Enter file path: ", path, sizeof(path));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Path cannot be empty."); return; }
+        IntMatrix *m = read_int_matrix_from_file(path);
+        if (!m) { puts("Not an integer matrix file."); return; }
+        if (add_int_matrix(col, m)) {
+            printf("Integer matrix '%s' (%dx%d %s) added to collection.\n", m->name, m->rows, m->cols,
+                   m->type == INT_ELEM_I32 ? "int32" : "int64");
+        } else {
+            printf("Matrix '%s' already exists or failed to add.\n", m->name);
+            free_int_matrix(m);
+        }
+        return;
+    }
+
+    if (op == 2) {
+        Matrix *d = prompt_dense_matrix(col, "Enter dense matrix name: ");
+        if (!d) return;
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        IntMatrix *m = int_matrix_from_dense(d);
+        if (!m) { printf("Matrix '%s' has non-integer entries (or entries beyond 2^53).\n", d->name); return; }
+        snprintf(m->name, sizeof(m->name), "%s", result_name);
+        keep_int_result(col, m);
+        return;
+    }
+
+    IntMatrix *a = prompt_int_matrix(col, op >= 6 ? "Enter integer matrix name: " : "Enter first matrix name: ");
+    if (!a) return;
+
+    if (op == 8) {
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        Matrix *d = int_matrix_to_dense(a);
+        if (d) snprintf(d->name, sizeof(d->name), "%s", result_name);
+        keep_dense_result(col, d, result_name);
+        return;
+    }
+
+    if (op == 6 || op == 7) {
+        char answer[8];
+        rc = read_line_prompt(op == 6 ? "Integer matrix on the left or right? [L/r]: "
+                                      : "Add or subtract? [+/-]: ", answer, sizeof(answer));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        /* op 6: dense * integer; op 7: integer - dense */
+        int swapped = op == 6 ? (answer[0] == 'r' || answer[0] == 'R') : answer[0] == '-';
+        Matrix *d = prompt_dense_matrix(col, "Enter dense matrix name: ");
+        if (!d) return;
+        rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+        if (rc == -1) { puts("EOF. Exiting..."); return; }
+        if (rc == 0) { puts("Name cannot be empty."); return; }
+        Matrix *result;
+        if (op == 6) result = swapped ? dense_int_multiply(d, a, result_name) : int_dense_multiply(a, d, result_name);
+        else result = swapped ? int_dense_subtract(a, d, result_name) : int_dense_add(a, d, result_name);
+        keep_dense_result(col, result, result_name);
+        return;
+    }
+
+    IntMatrix *b = prompt_int_matrix(col, "Enter second matrix name: ");
+    if (!b) return;
+    rc = read_line_prompt("Enter result matrix name: ", result_name, sizeof(result_name));
+    if (rc == -1) { puts("EOF. Exiting..."); return; }
+    if (rc == 0) { puts("Name cannot be empty."); return; }
+
+    struct timespec t0, t1;
+    int overflow = 0;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    IntMatrix *c;
+    if (op == 3) c = int_add(a, b, result_name, INT_ACCUM_WIDEN, &overflow);
+    else if (op == 4) c = int_subtract(a, b, result_name, INT_ACCUM_WIDEN, &overflow);
+    else c = int_multiply(a, b, result_name, INT_ACCUM_WIDEN, &overflow);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    if (!c) {
+        puts(overflow ? "The exact result overflows int64." : "Operation failed (dimension mismatch?).");
+        return;
+    }
+    printf("Exact kernel: %.6f s\n", (double)(t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9);
+    keep_int_result(col, c);
+}
 
 static void handle_action(int choice, MatrixCollection *col) {
     switch (choice) {
@@ -515,13 +1260,43 @@ static void handle_action(int choice, MatrixCollection *col) {
         case 12: handle_multiply_matrices(col); break;
         case 13: handle_determinant(col); break;
         case 14: handle_eigen(col); break;
+        case 15: handle_read_from_stream(col); break;
+        case 16: handle_watch_folder(col); break;
+        case 17: handle_gf2(col); break;
+        case 18: handle_complex(col); break;
+        case 19: handle_toeplitz(col); break;
+        case 20: handle_integer(col); break;
         default: puts("→ Unknown action"); break;
     }
 }
 
-int main(void) {
+/* Command-line arguments are stream sources loaded before the menu starts:
+ * files, FIFOs, or "-" for piped stdin. The menu then reads its input from
+ * the controlling terminal, or exits if there is none.
+ */
+static void load_stream_arguments(int argc, char **argv, MatrixCollection *col) {
+    int used_stdin = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-") == 0) used_stdin = 1;
+        read_matrices_from_stream_path(argv[i], col);
+    }
+    if (used_stdin && !freopen("/dev/tty", "r", stdin)) {
+        puts("No terminal available for the menu.");
+    }
+}
+
+int main(int argc, char **argv) {
     MatrixCollection *collection = create_collection();
     if (!collection) { fprintf(stderr, "Failed to initialize collection.\n"); return 1; }
+    g_cache = create_result_cache();
+
+    /* The kernels report through the library logger; show it on the console */
+    mat_set_logger(mat_console_logger, NULL, MAT_LOG_INFO);
+
+    /* Size the OpenMP teams to the container's CPU budget, not the host's */
+    resource_apply_openmp();
+
+    load_stream_arguments(argc, argv, collection);
 
     struct sigaction sa;
     memset(&sa, 0, sizeof(sa));
@@ -532,6 +1307,7 @@ int main(void) {
     while (running && !g_interrupted) {
         clear_screen();
         print_header();
+        poll_folder_watch(collection);
         print_menu();
 
         int choice = 0;
@@ -540,31 +1316,34 @@ int main(void) {
             puts("\nEnd of input detected. Exiting...");
             break;
         } else if (rc == 0) {
-            puts("Invalid input. Please enter a number between 1 and 15.");
+            puts("Invalid input. Please enter a number between 1 and 21.");
             press_enter_to_continue();
             if (feof(stdin)) break;
             continue;
         }
 
-        if (choice == 15) {
+        if (choice == 21) {
             puts("\nExiting program...");
             break;
         }
 
-        if (choice < 1 || choice > 15) {
-            puts("Invalid choice. Please select 1-15.");
+        if (choice < 1 || choice > 21) {
+            puts("Invalid choice. Please select 1-21.");
             press_enter_to_continue();
             if (feof(stdin)) break;
             continue;
         }
 
         puts("");
+        poll_folder_watch(collection);
         handle_action(choice, collection);
         press_enter_to_continue();
         if (feof(stdin)) break;
     }
 
     puts("\nGoodbye.");
+    folder_watch_stop(g_watch);
+    free_result_cache(g_cache);
     free_collection(collection);
     return 0;
 }